@@ -0,0 +1,309 @@
+// Card abstraction quality-versus-cost benchmark
+//
+// Solves Turn Hold'em (one street on a fixed turn board, poker/TurnHoldem.hpp)
+// under every requested abstraction from create_abstraction at each turn
+// bucket count, plus once without abstraction. For each it records the cost
+// (setup time, including clustering for emd and ochs; solve time; solver
+// memory; bucket table memory) and the quality: exploitability of the
+// solved strategy in the game without abstraction, where hands in one
+// bucket can no longer hide behind each other. The unabstracted row is the
+// floor any abstraction approaches as buckets grow.
+//
+// Every solve runs the same number of predictive CFR+ iterations, which
+// brings the abstract games close to their own equilibria, so the gap to
+// the unabstracted row is the abstraction's. With --budget-s and
+// --budget-mb the rows that fit are marked and the best one named.
+//
+// Usage:
+//   ./quantnet_bench_abstraction [options]
+//
+// Options:
+//   --abstractions <list>  Comma-separated names (default: percentile,ehs,emd,ochs)
+//   --buckets <list>       Comma-separated turn bucket counts (default: 8,16,32,64)
+//   --hands <n>            Hole pairs in the game's pool (default: 160)
+//   --iterations <n>       Predictive CFR+ iterations per solve (default: 200)
+//   --seed <n>             Hand pool and clustering seed (default: 0)
+//   --budget-s <s>         Setup plus solve time budget (default: none)
+//   --budget-mb <mb>       Solver plus table memory budget (default: none)
+//   --csv <path>           CSV output (default: bench_abstraction.csv)
+//   --json <path>          Also write the results as JSON
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/ExpectedValue.hpp"
+#include "poker/TurnHoldem.hpp"
+#include "solver/CFR.hpp"
+
+using namespace quantnet;
+using Clock = std::chrono::steady_clock;
+
+struct Args {
+    std::vector<std::string> abstractions = {"percentile", "ehs", "emd", "ochs"};
+    std::vector<int> buckets = {8, 16, 32, 64};
+    int hands = 160;
+    int iterations = 200;
+    uint64_t seed = 0;
+    double budget_s = 0.0;          // 0: no budget
+    double budget_mb = 0.0;
+    std::string csv_path = "bench_abstraction.csv";
+    std::string json_path;
+};
+
+// One solve: an abstraction at one bucket count, or the unabstracted game
+struct Row {
+    std::string abstraction;
+    int buckets = 0;
+    int labels = 0;                 // Distinct buckets the game's hands fall in
+    double setup_s = 0.0;
+    double solve_s = 0.0;
+    double solver_mb = 0.0;
+    double table_mb = 0.0;
+    double abstract_exploitability = 0.0;
+    double exploitability = 0.0;    // In the unabstracted game
+    bool fits = true;
+};
+
+static std::vector<std::string> split_list(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+// create_abstraction falls back to percentile for unknown names, which
+// would report a percentile row under the requested name
+static bool known_abstraction(const std::string& name) {
+    for (const char* known : {"percentile", "ehs", "emd", "ochs"}) {
+        if (name == known) return true;
+    }
+    return false;
+}
+
+static Args parse_args(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        try {
+            if (arg == "--abstractions" && i + 1 < argc) {
+                args.abstractions = split_list(argv[++i]);
+                for (const auto& name : args.abstractions) {
+                    if (!known_abstraction(name)) {
+                        std::cerr << "Unknown abstraction: " << name << " (percentile|ehs|emd|ochs)\n";
+                        std::exit(1);
+                    }
+                }
+            } else if (arg == "--buckets" && i + 1 < argc) {
+                args.buckets.clear();
+                for (const auto& b : split_list(argv[++i])) args.buckets.push_back(std::stoi(b));
+            } else if (arg == "--hands" && i + 1 < argc) {
+                args.hands = std::stoi(argv[++i]);
+            } else if (arg == "--iterations" && i + 1 < argc) {
+                args.iterations = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                args.seed = std::stoull(argv[++i]);
+            } else if (arg == "--budget-s" && i + 1 < argc) {
+                args.budget_s = std::stod(argv[++i]);
+            } else if (arg == "--budget-mb" && i + 1 < argc) {
+                args.budget_mb = std::stod(argv[++i]);
+            } else if (arg == "--csv" && i + 1 < argc) {
+                args.csv_path = argv[++i];
+            } else if (arg == "--json" && i + 1 < argc) {
+                args.json_path = argv[++i];
+            } else if (arg == "--help" || arg == "-h") {
+                std::cout << "Usage: quantnet_bench_abstraction [options]\n\n"
+                          << "Options:\n"
+                          << "  --abstractions <list>  Abstraction names (default: percentile,ehs,emd,ochs)\n"
+                          << "  --buckets <list>       Turn bucket counts (default: 8,16,32,64)\n"
+                          << "  --hands <n>            Hole pairs in the game's pool (default: 160)\n"
+                          << "  --iterations <n>       Predictive CFR+ iterations per solve (default: 200)\n"
+                          << "  --seed <n>             Hand pool and clustering seed (default: 0)\n"
+                          << "  --budget-s <s>         Setup plus solve time budget (default: none)\n"
+                          << "  --budget-mb <mb>       Solver plus table memory budget (default: none)\n"
+                          << "  --csv <path>           CSV output (default: bench_abstraction.csv)\n"
+                          << "  --json <path>          Also write the results as JSON\n";
+                std::exit(0);
+            } else {
+                std::cerr << "Unknown option: " << arg << " (see --help)\n";
+                std::exit(1);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << "\n";
+            std::exit(1);
+        }
+    }
+    return args;
+}
+
+static double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Regret and strategy accumulators of every info set
+static double solver_megabytes(const solver::CFR& cfr) {
+    size_t doubles = 0;
+    for (const auto& [id, data] : cfr.regret_data()) {
+        doubles += data.cumulative_regret.size() + data.cumulative_strategy.size() +
+                   data.prediction.size() + data.instant_regret.size();
+    }
+    return doubles * sizeof(double) / 1e6;
+}
+
+// Solve game and evaluate the result in the unabstracted game
+static void solve(const poker::TurnHoldem& game, const poker::TurnHoldem& exact, int iterations, Row& row) {
+    solver::PredictiveCFRPlus cfr(game);
+    const auto t0 = Clock::now();
+    cfr.solve(iterations);
+    row.solve_s = seconds_since(t0);
+    row.solver_mb = solver_megabytes(cfr);
+    row.labels = game.num_labels();
+
+    const poker::Strategy sigma = cfr.average_strategy();
+    row.abstract_exploitability = poker::compute_infoset_exploitability(game.root(), sigma);
+    row.exploitability = poker::compute_infoset_exploitability(exact.root(), game.unabstracted(sigma));
+}
+
+int main(int argc, char* argv[]) {
+    Args args = parse_args(argc, argv);
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    const auto board = poker::TurnHoldem::DEFAULT_BOARD;
+    std::cout << "Turn Hold'em on ";
+    for (int c : board) std::cout << poker::card_to_string(c);
+    std::cout << ", " << args.hands << " hands, " << args.iterations << " predictive CFR+ iterations, "
+              << threads << " thread(s)\n\n";
+
+    std::vector<Row> rows;
+    auto t0 = Clock::now();
+    const poker::TurnHoldem exact(board, args.hands, args.seed);
+    {
+        Row row;
+        row.abstraction = "none";
+        row.buckets = args.hands;
+        row.setup_s = seconds_since(t0);
+        solve(exact, exact, args.iterations, row);
+        rows.push_back(row);
+    }
+
+    std::cout << std::left << std::setw(12) << "abstraction" << std::right << std::setw(8) << "buckets"
+              << std::setw(8) << "used" << std::setw(10) << "setup s" << std::setw(10) << "solve s"
+              << std::setw(11) << "solver MB" << std::setw(10) << "table MB" << std::setw(13) << "abs. expl"
+              << std::setw(13) << "exploitab." << "\n";
+    auto print = [](const Row& row) {
+        std::cout << std::left << std::setw(12) << row.abstraction << std::right << std::setw(8) << row.buckets
+                  << std::setw(8) << row.labels << std::fixed << std::setprecision(2)
+                  << std::setw(10) << row.setup_s << std::setw(10) << row.solve_s
+                  << std::setw(11) << std::setprecision(3) << row.solver_mb
+                  << std::setw(10) << std::setprecision(1) << row.table_mb
+                  << std::setw(13) << std::setprecision(6) << row.abstract_exploitability
+                  << std::setw(13) << row.exploitability << std::defaultfloat << std::endl;
+    };
+    print(rows.front());
+
+    for (const std::string& name : args.abstractions) {
+        for (int buckets : args.buckets) {
+            Row row;
+            row.abstraction = name;
+            row.buckets = buckets;
+
+            // Only the turn round matters; the rest keep their defaults
+            t0 = Clock::now();
+            auto abstraction = poker::create_abstraction(name, 169, 50, buckets, 50);
+            poker::EMDBuildConfig config;
+            config.rounds = {poker::BettingRound::Turn};
+            config.seed = args.seed;
+            if (auto* emd = dynamic_cast<poker::EMDAbstraction*>(abstraction.get())) {
+                emd->build_clusters(config);
+                row.table_mb = emd->clusters(poker::BettingRound::Turn).size() * sizeof(poker::BucketId) / 1e6;
+            } else if (auto* ochs = dynamic_cast<poker::OCHSAbstraction*>(abstraction.get())) {
+                poker::OCHSBuildConfig ochs_config;
+                ochs_config.rounds = config.rounds;
+                ochs_config.seed = config.seed;
+                ochs->build_clusters(ochs_config);
+                row.table_mb = ochs->clusters(poker::BettingRound::Turn).size() * sizeof(poker::BucketId) / 1e6;
+            }
+            const poker::TurnHoldem game(board, args.hands, args.seed, abstraction.get());
+            row.setup_s = seconds_since(t0);
+
+            solve(game, exact, args.iterations, row);
+            rows.push_back(row);
+            print(row);
+        }
+    }
+
+    // Best quality within the budget; the unabstracted row is only a reference
+    const Row* best = nullptr;
+    for (Row& row : rows) {
+        row.fits = (args.budget_s <= 0.0 || row.setup_s + row.solve_s <= args.budget_s) &&
+                   (args.budget_mb <= 0.0 || row.solver_mb + row.table_mb <= args.budget_mb);
+        if (&row == &rows.front()) continue;
+        if (row.fits && (!best || row.exploitability < best->exploitability)) best = &row;
+    }
+    if (args.budget_s > 0.0 || args.budget_mb > 0.0) {
+        std::cout << "\nWithin budget:";
+        for (size_t i = 1; i < rows.size(); ++i) {
+            if (rows[i].fits) std::cout << " " << rows[i].abstraction << "/" << rows[i].buckets;
+        }
+        std::cout << "\n";
+        if (best) {
+            std::cout << "Best: " << best->abstraction << " with " << best->buckets << " buckets, exploitability "
+                      << best->exploitability << "\n";
+        } else {
+            std::cout << "Nothing fits the budget\n";
+        }
+    }
+
+    std::ofstream csv(args.csv_path);
+    csv << "abstraction,buckets,used_buckets,setup_s,solve_s,solver_mb,table_mb,"
+           "abstract_exploitability,exploitability,fits_budget\n";
+    for (const Row& row : rows) {
+        csv << row.abstraction << "," << row.buckets << "," << row.labels << "," << row.setup_s << ","
+            << row.solve_s << "," << row.solver_mb << "," << row.table_mb << ","
+            << row.abstract_exploitability << "," << row.exploitability << "," << (row.fits ? 1 : 0) << "\n";
+    }
+
+    if (!args.json_path.empty()) {
+        nlohmann::json report;
+        report["threads"] = threads;
+        report["hands"] = args.hands;
+        report["iterations"] = args.iterations;
+        report["seed"] = args.seed;
+        report["rows"] = nlohmann::json::array();
+        for (const Row& row : rows) {
+            report["rows"].push_back({
+                {"abstraction", row.abstraction},
+                {"buckets", row.buckets},
+                {"used_buckets", row.labels},
+                {"setup_s", row.setup_s},
+                {"solve_s", row.solve_s},
+                {"solver_mb", row.solver_mb},
+                {"table_mb", row.table_mb},
+                {"abstract_exploitability", row.abstract_exploitability},
+                {"exploitability", row.exploitability},
+                {"fits_budget", row.fits},
+            });
+        }
+        std::ofstream out(args.json_path);
+        out << report.dump(2) << "\n";
+    }
+    return 0;
+}
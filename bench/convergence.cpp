@@ -0,0 +1,380 @@
+// Cross-method convergence benchmark (time-to-exploitability)
+//
+// Runs every solver on every supported game and records info-set
+// exploitability against solver wall time and against game-tree node visits
+// at fixed checkpoints. Results are written as CSV (one row per checkpoint)
+// and as a JSON report that also records the machine and thread setup, so
+// runs from different commits or machines can be compared directly.
+//
+// Usage:
+//   ./quantnet_bench_convergence [options]
+//
+// Options:
+//   --games <list>         Comma-separated games (default: kuhn,leduc)
+//   --methods <list>       Comma-separated methods (default: all)
+//   --budget-ms <ms>       Solver wall-time budget per game/method (default: 20000)
+//   --csv <path>           CSV output (default: bench_convergence.csv)
+//   --json <path>          JSON output (default: bench_convergence.json)
+//   --baseline <path>      Earlier JSON report; exit 1 on convergence regressions
+//   --tolerance <x>        Relative regression tolerance (default: 0.25)
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "solver/CFR.hpp"
+#include "solver/Hybrid.hpp"
+#include "solver/NewtonSolver.hpp"
+#include "poker/ExpectedValue.hpp"
+#include "poker/KuhnPoker.hpp"
+#include "poker/LeducPoker.hpp"
+#include "poker/QRE.hpp"
+
+using namespace quantnet;
+using Clock = std::chrono::steady_clock;
+
+// One measurement point on a convergence curve
+struct Checkpoint {
+    int iteration = 0;          // Solver iterations (CFR) or Newton steps (QRE)
+    double wall_ms = 0.0;       // Solver time only, exploitability evaluation excluded
+    long long node_visits = 0;  // Game-tree nodes touched by the solver
+    double exploitability = 0.0;
+};
+
+using MethodRunner = std::function<std::vector<Checkpoint>(const poker::PokerGame&, double budget_ms)>;
+
+struct Method {
+    std::string name;
+    MethodRunner run;
+};
+
+static double ms_between(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+// Checkpoints at 1, 2, 5, 10, 20, 50, ... iterations
+static int next_checkpoint(int it) {
+    int scale = 1;
+    while (scale * 10 <= it) scale *= 10;
+    const int lead = it / scale;
+    if (lead < 2) return 2 * scale;
+    if (lead < 5) return 5 * scale;
+    return 10 * scale;
+}
+
+// Any CFR variant: run to each checkpoint until the budget is spent
+template<typename Solver>
+std::vector<Checkpoint> run_cfr(const poker::PokerGame& game, double budget_ms) {
+    std::vector<Checkpoint> curve;
+    Solver cfr(game);
+
+    double solve_ms = 0.0;
+    for (int target = 1; solve_ms < budget_ms; target = next_checkpoint(target)) {
+        auto t0 = Clock::now();
+        cfr.solve(target - cfr.iterations());
+        solve_ms += ms_between(t0, Clock::now());
+
+        Checkpoint cp;
+        cp.iteration = cfr.iterations();
+        cp.wall_ms = solve_ms;
+        cp.node_visits = cfr.node_visits();
+        cp.exploitability = poker::compute_infoset_exploitability(game.root(), cfr.average_strategy());
+        curve.push_back(cp);
+    }
+    return curve;
+}
+
+// Newton on the QRE residual with beta continuation; one checkpoint per beta
+std::vector<Checkpoint> run_newton_qre(const poker::PokerGame& game, double budget_ms) {
+    std::vector<Checkpoint> curve;
+
+    poker::QREResidual qre(game, 0.01);
+    const long long nodes_per_eval = poker::compute_tree_stats(game.root()).total_nodes;
+    long long residual_evals = 0;
+    auto residual_fn = [&qre, &residual_evals](const Eigen::VectorXd& x) {
+        ++residual_evals;
+        return qre(x);
+    };
+
+    solver::NewtonConfig config;
+    config.tol = 1e-8;
+    config.max_iters = 30;
+    solver::NewtonSolver newton(config);
+
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(qre.dim());
+    double solve_ms = 0.0;
+    int newton_iters = 0;
+
+    for (double beta : solver::make_beta_schedule(1e3)) {
+        if (solve_ms >= budget_ms) break;
+        qre.set_beta(beta);
+
+        auto t0 = Clock::now();
+        auto result = newton.solve(residual_fn, w);
+        solve_ms += ms_between(t0, Clock::now());
+        w = result.x;
+        newton_iters += result.iterations;
+
+        Checkpoint cp;
+        cp.iteration = newton_iters;
+        cp.wall_ms = solve_ms;
+        cp.node_visits = residual_evals * nodes_per_eval;
+        cp.exploitability = poker::compute_infoset_exploitability(
+            game.root(), poker::Strategy::from_logits(w, qre.index()));
+        curve.push_back(cp);
+    }
+    return curve;
+}
+
+// Registry of solvers under comparison; new variants are added here
+static std::vector<Method> all_methods() {
+    return {
+        {"newton-qre", run_newton_qre},
+        {"cfr", run_cfr<solver::CFR>},
+        {"cfr+", run_cfr<solver::CFRPlus>},
+        {"pcfr+", run_cfr<solver::PredictiveCFRPlus>},
+    };
+}
+
+static std::unique_ptr<poker::PokerGame> make_game(const std::string& name) {
+    if (name == "kuhn") return std::make_unique<poker::KuhnPoker>();
+    if (name == "leduc") return std::make_unique<poker::LeducPoker>();
+    return nullptr;
+}
+
+static std::vector<std::string> split_list(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+static nlohmann::json machine_info() {
+    nlohmann::json m;
+
+    char host[256] = "unknown";
+#if defined(__unix__) || defined(__APPLE__)
+    if (gethostname(host, sizeof(host)) != 0) host[0] = '\0';
+#endif
+    m["hostname"] = host;
+    m["hardware_threads"] = std::thread::hardware_concurrency();
+#ifdef _OPENMP
+    m["openmp_max_threads"] = omp_get_max_threads();
+#else
+    m["openmp_max_threads"] = 1;
+#endif
+#if defined(__clang__)
+    m["compiler"] = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    m["compiler"] = std::string("gcc ") + __VERSION__;
+#else
+    m["compiler"] = "unknown";
+#endif
+#ifdef NDEBUG
+    m["build"] = "release";
+#else
+    m["build"] = "debug";
+#endif
+    m["timestamp"] = static_cast<long long>(std::time(nullptr));
+    return m;
+}
+
+struct Args {
+    std::vector<std::string> games = {"kuhn", "leduc"};
+    std::vector<std::string> methods;  // Empty = all
+    double budget_ms = 20000.0;
+    std::string csv_path = "bench_convergence.csv";
+    std::string json_path = "bench_convergence.json";
+    std::string baseline_path;
+    double tolerance = 0.25;
+};
+
+static Args parse_args(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        try {
+            if (arg == "--games" && i + 1 < argc) {
+                args.games = split_list(argv[++i]);
+            } else if (arg == "--methods" && i + 1 < argc) {
+                args.methods = split_list(argv[++i]);
+            } else if (arg == "--budget-ms" && i + 1 < argc) {
+                args.budget_ms = std::stod(argv[++i]);
+            } else if (arg == "--csv" && i + 1 < argc) {
+                args.csv_path = argv[++i];
+            } else if (arg == "--json" && i + 1 < argc) {
+                args.json_path = argv[++i];
+            } else if (arg == "--baseline" && i + 1 < argc) {
+                args.baseline_path = argv[++i];
+            } else if (arg == "--tolerance" && i + 1 < argc) {
+                args.tolerance = std::stod(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                std::cout << "Usage: quantnet_bench_convergence [options]\n\n"
+                          << "Options:\n"
+                          << "  --games <list>      Comma-separated games (default: kuhn,leduc)\n"
+                          << "  --methods <list>    Comma-separated methods (default: all)\n"
+                          << "  --budget-ms <ms>    Wall budget per game/method (default: 20000)\n"
+                          << "  --csv <path>        CSV output (default: bench_convergence.csv)\n"
+                          << "  --json <path>       JSON output (default: bench_convergence.json)\n"
+                          << "  --baseline <path>   Earlier JSON report to check for regressions\n"
+                          << "  --tolerance <x>     Relative regression tolerance (default: 0.25)\n";
+                std::exit(0);
+            } else {
+                std::cerr << "Unknown option: " << arg << " (see --help)\n";
+                std::exit(1);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << "\n";
+            std::exit(1);
+        }
+    }
+    return args;
+}
+
+// Compare against a baseline report at the deepest iteration count both runs
+// reached. Returns the number of baseline (game, method) pairs that
+// regressed or could not be compared: missing from the report, or with no
+// checkpoint iteration in common.
+static int check_regressions(const nlohmann::json& report, const nlohmann::json& baseline, double tol) {
+    int regressions = 0;
+
+    for (const auto& base : baseline["runs"]) {
+        const std::string name = base["game"].get<std::string>() + " / " + base["method"].get<std::string>();
+        const nlohmann::json* run = nullptr;
+        for (const auto& r : report["runs"]) {
+            if (r["game"] == base["game"] && r["method"] == base["method"]) run = &r;
+        }
+
+        // Exploitability at the last checkpoint iteration present in both
+        double ours = -1.0, theirs = -1.0;
+        int at_iter = -1;
+        if (run) {
+            for (const auto& cp : (*run)["checkpoints"]) {
+                for (const auto& bcp : base["checkpoints"]) {
+                    if (bcp["iteration"] == cp["iteration"] && cp["iteration"].get<int>() > at_iter) {
+                        at_iter = cp["iteration"];
+                        ours = cp["exploitability"];
+                        theirs = bcp["exploitability"];
+                    }
+                }
+            }
+        }
+        if (at_iter < 0) {
+            std::cout << "MISSING    " << name << (run ? ": no checkpoint in common" : ": not in this run") << "\n";
+            ++regressions;
+            continue;
+        }
+
+        const bool regressed = ours > theirs * (1.0 + tol) + 1e-12;
+        std::cout << (regressed ? "REGRESSION " : "ok         ") << name
+                  << " @ iter " << at_iter << ": " << std::scientific << ours
+                  << " vs baseline " << theirs << "\n";
+        if (regressed) ++regressions;
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    Args args = parse_args(argc, argv);
+
+    std::vector<Method> methods;
+    for (const auto& m : all_methods()) {
+        bool selected = args.methods.empty();
+        for (const auto& name : args.methods) selected = selected || (name == m.name);
+        if (selected) methods.push_back(m);
+    }
+    for (const auto& name : args.methods) {
+        bool known = false;
+        for (const auto& m : methods) known = known || (name == m.name);
+        if (!known) {
+            std::cerr << "Unknown method: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    nlohmann::json report;
+    report["machine"] = machine_info();
+    report["budget_ms"] = args.budget_ms;
+    report["runs"] = nlohmann::json::array();
+
+    std::ofstream csv(args.csv_path);
+    csv << "game,method,iteration,wall_ms,node_visits,exploitability\n";
+
+    for (const auto& game_name : args.games) {
+        auto game = make_game(game_name);
+        if (!game) {
+            std::cerr << "Unknown game: " << game_name << std::endl;
+            return 1;
+        }
+
+        for (const auto& method : methods) {
+            std::cout << game->name() << " / " << method.name << "..." << std::flush;
+            std::vector<Checkpoint> curve = method.run(*game, args.budget_ms);
+
+            nlohmann::json run;
+            run["game"] = game_name;
+            run["method"] = method.name;
+            run["checkpoints"] = nlohmann::json::array();
+            for (const auto& cp : curve) {
+                csv << game_name << "," << method.name << "," << cp.iteration << ","
+                    << cp.wall_ms << "," << cp.node_visits << ","
+                    << std::setprecision(10) << cp.exploitability << "\n";
+                run["checkpoints"].push_back({
+                    {"iteration", cp.iteration},
+                    {"wall_ms", cp.wall_ms},
+                    {"node_visits", cp.node_visits},
+                    {"exploitability", cp.exploitability}
+                });
+            }
+            report["runs"].push_back(run);
+
+            if (!curve.empty()) {
+                std::cout << " " << curve.back().iteration << " iters, "
+                          << std::fixed << std::setprecision(1) << curve.back().wall_ms << " ms, "
+                          << "exploitability " << std::scientific << std::setprecision(3)
+                          << curve.back().exploitability << std::endl;
+            } else {
+                std::cout << " no checkpoints" << std::endl;
+            }
+        }
+    }
+
+    std::ofstream(args.json_path) << report.dump(2) << std::endl;
+    std::cout << "\nWrote " << args.csv_path << " and " << args.json_path << std::endl;
+
+    if (!args.baseline_path.empty()) {
+        std::ifstream in(args.baseline_path);
+        if (!in) {
+            std::cerr << "Cannot read baseline: " << args.baseline_path << std::endl;
+            return 1;
+        }
+        nlohmann::json baseline = nlohmann::json::parse(in);
+        std::cout << "\nBaseline comparison (tolerance " << std::defaultfloat << args.tolerance << "):\n";
+        if (check_regressions(report, baseline, args.tolerance) > 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Range-vs-range equity throughput benchmark
+//
+// Computes full range against full range equity on a fixed flop, turn and
+// river exactly, and preflop by sampling, and reports wall time, runouts per
+// second and hand evaluations per second for each street. Every runout
+// evaluates each live combo once, so evaluations = runouts * live combos.
+//
+// Usage:
+//   ./quantnet_bench_equity [options]
+//
+// Options:
+//   --samples <n>     Preflop runouts to sample (default: 20000)
+//   --seed <n>        Preflop sampling seed (default: 1)
+//   --repeat <n>      Runs per street; the fastest is reported (default: 3)
+//   --json <path>     Also write the results as JSON
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "poker/Equity.hpp"
+#include "poker/TableEvaluator.hpp"
+
+using namespace quantnet;
+using Clock = std::chrono::steady_clock;
+
+struct Args {
+    int samples = 20000;
+    uint64_t seed = 1;
+    int repeat = 3;
+    std::string json_path;
+};
+
+static Args parse_args(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) {
+            args.samples = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            args.seed = std::stoull(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            args.repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            args.json_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: quantnet_bench_equity [options]\n\n"
+                      << "Options:\n"
+                      << "  --samples <n>     Preflop runouts to sample (default: 20000)\n"
+                      << "  --seed <n>        Preflop sampling seed (default: 1)\n"
+                      << "  --repeat <n>      Runs per street, fastest reported (default: 3)\n"
+                      << "  --json <path>     Also write the results as JSON\n";
+            std::exit(0);
+        }
+    }
+    return args;
+}
+
+// Board of the first n cards of Jc 8h 3s Kd 2d
+static poker::CardSet board_of(int n) {
+    const int cards[5] = {
+        poker::make_card(9, 0), poker::make_card(6, 2), poker::make_card(1, 3),
+        poker::make_card(11, 1), poker::make_card(0, 1)
+    };
+    poker::CardSet board;
+    for (int i = 0; i < n; ++i) board.insert(cards[i]);
+    return board;
+}
+
+int main(int argc, char* argv[]) {
+    Args args = parse_args(argc, argv);
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    poker::TableEvaluator::init();
+    const poker::HandRange full = poker::HandRange::full();
+
+    struct Street {
+        std::string name;
+        int board_cards;
+        poker::EquityConfig config;
+    };
+    const std::vector<Street> streets = {
+        {"preflop", 0, {args.samples, args.seed}},
+        {"flop", 3, {}},
+        {"turn", 4, {}},
+        {"river", 5, {}},
+    };
+
+    nlohmann::json report;
+    report["threads"] = threads;
+    report["streets"] = nlohmann::json::array();
+
+    std::cout << "Full range vs full range, " << threads << " thread(s)\n\n"
+              << std::left << std::setw(9) << "street" << std::right
+              << std::setw(10) << "runouts" << std::setw(12) << "ms"
+              << std::setw(14) << "runouts/s" << std::setw(14) << "evals/s"
+              << std::setw(10) << "equity" << "\n";
+
+    for (const auto& street : streets) {
+        const poker::CardSet board = board_of(street.board_cards);
+        const double live_combos = (poker::DECK_SIZE - 5) * (poker::DECK_SIZE - 6) / 2.0;
+
+        double best_ms = 1e300;
+        poker::EquityResult result;
+        for (int r = 0; r < args.repeat; ++r) {
+            auto t0 = Clock::now();
+            result = poker::RangeEquity::compute(full, full, board, {}, street.config);
+            best_ms = std::min(best_ms, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        }
+        const double runouts_per_sec = result.runouts / (best_ms / 1000.0);
+        const double evals_per_sec = runouts_per_sec * live_combos;
+
+        std::cout << std::left << std::setw(9) << street.name << std::right
+                  << std::setw(10) << result.runouts
+                  << std::setw(12) << std::fixed << std::setprecision(2) << best_ms
+                  << std::setw(14) << std::setprecision(0) << runouts_per_sec
+                  << std::setw(13) << std::setprecision(1) << evals_per_sec / 1e6 << "M"
+                  << std::setw(10) << std::setprecision(4) << result.equity << "\n";
+
+        report["streets"].push_back({
+            {"street", street.name},
+            {"exact", result.exact},
+            {"runouts", result.runouts},
+            {"ms", best_ms},
+            {"runouts_per_sec", runouts_per_sec},
+            {"evals_per_sec", evals_per_sec},
+            {"equity", result.equity},
+            {"std_error", result.std_error},
+        });
+    }
+
+    if (!args.json_path.empty()) {
+        std::ofstream out(args.json_path);
+        out << report.dump(2) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,514 @@
+// Hand evaluator throughput benchmark and exhaustive validation
+//
+// Evaluates every one of the 133,784,560 seven-card hands through each
+// evaluation path and at each thread count, and checks the result against
+// the known totals (hands per category, 4,824 distinct hand values) and,
+// hand by hand, against an independent reference. Exits non-zero if any run
+// fails, so an evaluator rewrite must pass this before it lands.
+//
+// The reference ranks each hand as the best of its 21 five-card subsets,
+// with a 5-card ranker that shares no code with the evaluators. Every run
+// sums an order-independent fingerprint of (cards, value) over all hands;
+// a run passes only if its fingerprint equals the reference's, so a single
+// hand ranked differently fails it.
+//
+// Paths:
+//   scalar        HandEvaluator::evaluate over a card span (rank counting)
+//   table         TableEvaluator::evaluate over 7 cards, from scratch
+//   partial       TableEvaluator::PartialHand, one card added per loop level
+//   batch-<isa>   TableEvaluator::evaluate_batch: each 5-card board against
+//                 every hole pair above its highest card, so each 7-card
+//                 hand is seen once; one run per instruction set the CPU has
+//
+// Usage:
+//   ./quantnet_bench_evaluator [options]
+//
+// Options:
+//   --threads <list>  Comma-separated thread counts (default: 1, powers of
+//                     two up to the maximum, and the maximum)
+//   --paths <list>    Comma-separated paths to run (default: all)
+//   --json <path>     Also write the results as JSON
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "parallel/CounterRng.hpp"
+#include "poker/HandEvaluator.hpp"
+#include "poker/TableEvaluator.hpp"
+
+using namespace quantnet;
+using Clock = std::chrono::steady_clock;
+using poker::DECK_SIZE;
+using poker::HandValue;
+using poker::TableEvaluator;
+
+namespace {
+
+constexpr uint64_t TOTAL_HANDS = 133784560;     // C(52, 7)
+constexpr uint64_t DISTINCT_VALUES = 4824;
+constexpr int NUM_CATEGORIES = 9;
+
+// Seven-card hands per category, high card first
+constexpr std::array<uint64_t, NUM_CATEGORIES> EXPECTED = {
+    23294460,   // High card
+    58627800,   // Pair
+    31433400,   // Two pair
+    6461620,    // Three of a kind
+    6180020,    // Straight
+    4047644,    // Flush
+    3473184,    // Full house
+    224848,     // Four of a kind
+    41584,      // Straight flush
+};
+
+constexpr int VALUE_BITS = 24;                  // HandValue fits in 24 bits
+
+uint64_t card_bit(int card) { return uint64_t{1} << card; }
+
+// One thread's share of a run: category counts, a bitset of the values
+// seen and the fingerprint of every (cards, value) pair
+struct Tally {
+    std::array<uint64_t, NUM_CATEGORIES> categories{};
+    uint64_t fingerprint = 0;
+    std::vector<uint64_t> seen = std::vector<uint64_t>((size_t{1} << VALUE_BITS) / 64);
+
+    // cards is the hand's 52-bit card mask
+    void add(uint64_t cards, HandValue v) {
+        ++categories[v.value >> 20];
+        fingerprint += parallel::CounterRng::mix(cards * 0x9E3779B97F4A7C15ULL + v.value);
+        seen[v.value >> 6] |= uint64_t{1} << (v.value & 63);
+    }
+
+    void merge(const Tally& other) {
+        for (int i = 0; i < NUM_CATEGORIES; ++i) categories[i] += other.categories[i];
+        fingerprint += other.fingerprint;
+        for (size_t i = 0; i < seen.size(); ++i) seen[i] |= other.seen[i];
+    }
+
+    uint64_t hands() const {
+        uint64_t n = 0;
+        for (uint64_t c : categories) n += c;
+        return n;
+    }
+
+    uint64_t distinct() const {
+        uint64_t n = 0;
+        for (uint64_t w : seen) n += std::popcount(w);
+        return n;
+    }
+};
+
+// Work is split by the two lowest cards; lower pairs own more hands, so
+// they come first and are handed out dynamically
+std::vector<std::array<int, 2>> work_units(int cards_per_hand) {
+    std::vector<std::array<int, 2>> units;
+    for (int c1 = 0; c1 < DECK_SIZE; ++c1) {
+        for (int c2 = c1 + 1; c2 <= DECK_SIZE - (cards_per_hand - 1); ++c2) units.push_back({c1, c2});
+    }
+    return units;
+}
+
+uint64_t card_mask(const int* cards, int n) {
+    uint64_t mask = 0;
+    for (int i = 0; i < n; ++i) mask |= card_bit(cards[i]);
+    return mask;
+}
+
+// Reference 5-card ranker, written without HandEvaluator's code: ranks are
+// grouped by count (larger groups first, then higher ranks), and the group
+// shape, flush and straight decide the category. Only the HandValue layout
+// is shared: category << 20, then up to five 4-bit ranks.
+uint32_t rank_five(const int* cards) {
+    int counts[poker::NUM_RANKS] = {};
+    uint32_t ranks = 0;
+    bool flush = true;
+    for (int i = 0; i < 5; ++i) {
+        counts[poker::card_rank(cards[i])]++;
+        ranks |= 1u << poker::card_rank(cards[i]);
+        flush = flush && poker::card_suit(cards[i]) == poker::card_suit(cards[0]);
+    }
+    std::array<std::array<int, 2>, 5> groups{};   // {count, rank}
+    int num_groups = 0;
+    for (int r = poker::NUM_RANKS - 1; r >= 0; --r) {
+        if (counts[r] > 0) groups[num_groups++] = {counts[r], r};
+    }
+    std::stable_sort(groups.begin(), groups.begin() + num_groups,
+                     [](const auto& a, const auto& b) { return a[0] > b[0]; });
+
+    int straight = -1;
+    if (num_groups == 5) {
+        if (groups[0][1] - groups[4][1] == 4) straight = groups[0][1];
+        if (ranks == 0x100F) straight = 3;      // A-2-3-4-5 plays 5-high
+    }
+
+    auto value = [&](poker::HandRank category, int num_ranks) {
+        uint32_t v = static_cast<uint32_t>(category) << 20;
+        for (int i = 0; i < num_ranks; ++i) v |= static_cast<uint32_t>(groups[i][1]) << (16 - 4 * i);
+        return v;
+    };
+    using poker::HandRank;
+    if (straight >= 0) {
+        const HandRank category = flush ? HandRank::StraightFlush : HandRank::Straight;
+        return (static_cast<uint32_t>(category) << 20) | (static_cast<uint32_t>(straight) << 16);
+    }
+    if (groups[0][0] == 4) return value(HandRank::FourOfAKind, 2);
+    if (groups[0][0] == 3 && groups[1][0] == 2) return value(HandRank::FullHouse, 2);
+    if (flush) return value(HandRank::Flush, 5);
+    if (groups[0][0] == 3) return value(HandRank::ThreeOfAKind, 3);
+    if (groups[0][0] == 2 && groups[1][0] == 2) return value(HandRank::TwoPair, 3);
+    if (groups[0][0] == 2) return value(HandRank::Pair, 4);
+    return value(HandRank::HighCard, 5);
+}
+
+// C(n, k) for n <= 52, k <= 5
+const std::array<std::array<uint32_t, 6>, DECK_SIZE + 1>& binomials() {
+    static const auto table = [] {
+        std::array<std::array<uint32_t, 6>, DECK_SIZE + 1> c{};
+        for (int n = 0; n <= DECK_SIZE; ++n) {
+            c[n][0] = 1;
+            for (int k = 1; k <= std::min(n, 5); ++k) c[n][k] = c[n - 1][k - 1] + (k < n ? c[n - 1][k] : 0);
+        }
+        return c;
+    }();
+    return table;
+}
+
+// Colexicographic index of five ascending cards, 0 .. C(52, 5) - 1
+uint32_t five_card_index(const int* cards) {
+    const auto& c = binomials();
+    return c[cards[0]][1] + c[cards[1]][2] + c[cards[2]][3] + c[cards[3]][4] + c[cards[4]][5];
+}
+
+// rank_five of every 5-card hand, by five_card_index
+const std::vector<uint32_t>& five_card_values() {
+    static const std::vector<uint32_t> values = [] {
+        std::vector<uint32_t> v(binomials()[DECK_SIZE][5]);
+        int cards[5];
+        for (cards[0] = 0; cards[0] < DECK_SIZE; ++cards[0])
+        for (cards[1] = cards[0] + 1; cards[1] < DECK_SIZE; ++cards[1])
+        for (cards[2] = cards[1] + 1; cards[2] < DECK_SIZE; ++cards[2])
+        for (cards[3] = cards[2] + 1; cards[3] < DECK_SIZE; ++cards[3])
+        for (cards[4] = cards[3] + 1; cards[4] < DECK_SIZE; ++cards[4]) {
+            v[five_card_index(cards)] = rank_five(cards);
+        }
+        return v;
+    }();
+    return values;
+}
+
+// Best of the 21 five-card subsets of seven ascending cards
+HandValue reference_value(const int* cards) {
+    static const auto subsets = [] {
+        std::array<std::array<int, 5>, 21> positions{};
+        int s = 0;
+        for (int skip1 = 0; skip1 < 7; ++skip1) {
+            for (int skip2 = skip1 + 1; skip2 < 7; ++skip2, ++s) {
+                int n = 0;
+                for (int i = 0; i < 7; ++i) {
+                    if (i != skip1 && i != skip2) positions[s][n++] = i;
+                }
+            }
+        }
+        return positions;
+    }();
+    const auto& five = five_card_values();
+    uint32_t best = 0;
+    for (const auto& positions : subsets) {
+        const int subset[5] = {cards[positions[0]], cards[positions[1]], cards[positions[2]],
+                               cards[positions[3]], cards[positions[4]]};
+        best = std::max(best, five[five_card_index(subset)]);
+    }
+    return HandValue(best);
+}
+
+void reference_unit(int c1, int c2, Tally& tally) {
+    int cards[7] = {c1, c2};
+    for (cards[2] = c2 + 1; cards[2] < DECK_SIZE; ++cards[2])
+    for (cards[3] = cards[2] + 1; cards[3] < DECK_SIZE; ++cards[3])
+    for (cards[4] = cards[3] + 1; cards[4] < DECK_SIZE; ++cards[4])
+    for (cards[5] = cards[4] + 1; cards[5] < DECK_SIZE; ++cards[5])
+    for (cards[6] = cards[5] + 1; cards[6] < DECK_SIZE; ++cards[6]) {
+        tally.add(card_mask(cards, 7), reference_value(cards));
+    }
+}
+
+void scalar_unit(int c1, int c2, Tally& tally) {
+    int cards[7] = {c1, c2};
+    for (cards[2] = c2 + 1; cards[2] < DECK_SIZE; ++cards[2])
+    for (cards[3] = cards[2] + 1; cards[3] < DECK_SIZE; ++cards[3])
+    for (cards[4] = cards[3] + 1; cards[4] < DECK_SIZE; ++cards[4])
+    for (cards[5] = cards[4] + 1; cards[5] < DECK_SIZE; ++cards[5])
+    for (cards[6] = cards[5] + 1; cards[6] < DECK_SIZE; ++cards[6]) {
+        tally.add(card_mask(cards, 7), poker::HandEvaluator::evaluate(std::span<const int>(cards, 7)));
+    }
+}
+
+void table_unit(int c1, int c2, Tally& tally) {
+    int cards[7] = {c1, c2};
+    for (cards[2] = c2 + 1; cards[2] < DECK_SIZE; ++cards[2])
+    for (cards[3] = cards[2] + 1; cards[3] < DECK_SIZE; ++cards[3])
+    for (cards[4] = cards[3] + 1; cards[4] < DECK_SIZE; ++cards[4])
+    for (cards[5] = cards[4] + 1; cards[5] < DECK_SIZE; ++cards[5])
+    for (cards[6] = cards[5] + 1; cards[6] < DECK_SIZE; ++cards[6]) {
+        tally.add(card_mask(cards, 7), TableEvaluator::evaluate(cards, 7));
+    }
+}
+
+void partial_unit(int c1, int c2, Tally& tally) {
+    using P = TableEvaluator::PartialHand;
+    const P p2 = TableEvaluator::add(TableEvaluator::add(P{}, c1), c2);
+    const uint64_t m2 = card_bit(c1) | card_bit(c2);
+    for (int c3 = c2 + 1; c3 < DECK_SIZE; ++c3) {
+        const P p3 = TableEvaluator::add(p2, c3);
+        const uint64_t m3 = m2 | card_bit(c3);
+        for (int c4 = c3 + 1; c4 < DECK_SIZE; ++c4) {
+            const P p4 = TableEvaluator::add(p3, c4);
+            const uint64_t m4 = m3 | card_bit(c4);
+            for (int c5 = c4 + 1; c5 < DECK_SIZE; ++c5) {
+                const P p5 = TableEvaluator::add(p4, c5);
+                const uint64_t m5 = m4 | card_bit(c5);
+                for (int c6 = c5 + 1; c6 < DECK_SIZE; ++c6) {
+                    const P p6 = TableEvaluator::add(p5, c6);
+                    const uint64_t m6 = m5 | card_bit(c6);
+                    for (int c7 = c6 + 1; c7 < DECK_SIZE; ++c7) {
+                        tally.add(m6 | card_bit(c7), TableEvaluator::evaluate(TableEvaluator::add(p6, c7)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Hole pairs ordered by lower card, highest first: the pairs above card m
+// are the first C(51 - m, 2)
+const std::vector<TableEvaluator::HolePair>& pairs_high_first() {
+    static const std::vector<TableEvaluator::HolePair> pairs = [] {
+        std::vector<TableEvaluator::HolePair> p;
+        for (int a = DECK_SIZE - 2; a >= 0; --a) {
+            for (int b = a + 1; b < DECK_SIZE; ++b) p.push_back({a, b});
+        }
+        return p;
+    }();
+    return pairs;
+}
+
+void batch_unit(int c1, int c2, Tally& tally, TableEvaluator::BatchIsa isa) {
+    const auto& pairs = pairs_high_first();
+    std::array<HandValue, poker::NUM_HOLE_COMBOS> values;
+    int board[5] = {c1, c2};
+    for (board[2] = c2 + 1; board[2] < DECK_SIZE; ++board[2])
+    for (board[3] = board[2] + 1; board[3] < DECK_SIZE; ++board[3])
+    for (board[4] = board[3] + 1; board[4] < DECK_SIZE - 2; ++board[4]) {
+        const int above = DECK_SIZE - 1 - board[4];
+        const size_t n = static_cast<size_t>(above * (above - 1) / 2);
+        TableEvaluator::evaluate_batch(board, std::span(pairs.data(), n), std::span(values.data(), n), isa);
+        const uint64_t board_mask = card_mask(board, 5);
+        for (size_t i = 0; i < n; ++i) {
+            tally.add(board_mask | card_bit(pairs[i][0]) | card_bit(pairs[i][1]), values[i]);
+        }
+    }
+}
+
+struct Run {
+    std::string path;
+    int threads = 1;
+    double seconds = 0.0;
+    Tally tally;
+};
+
+template <typename Unit>
+Run run_path(const std::string& name, int threads, int cards_per_unit, Unit unit) {
+    const auto units = work_units(cards_per_unit);
+    const int n = static_cast<int>(units.size());
+    std::vector<Tally> tallies(threads);
+
+    auto t0 = Clock::now();
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+#endif
+    for (int u = 0; u < n; ++u) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        unit(units[u][0], units[u][1], tallies[tid]);
+    }
+
+    Run run;
+    run.path = name;
+    run.threads = threads;
+    run.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    for (const auto& t : tallies) run.tally.merge(t);
+    return run;
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+struct Args {
+    std::vector<int> threads;
+    std::vector<std::string> paths;
+    std::string json_path;
+};
+
+Args parse_args(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            for (const auto& t : split(argv[++i])) args.threads.push_back(std::max(1, std::stoi(t)));
+        } else if (arg == "--paths" && i + 1 < argc) {
+            args.paths = split(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            args.json_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: quantnet_bench_evaluator [options]\n\n"
+                      << "Options:\n"
+                      << "  --threads <list>  Comma-separated thread counts (default: 1, 2, 4, ... max)\n"
+                      << "  --paths <list>    Paths to run: scalar, table, partial, batch-<isa> (default: all)\n"
+                      << "  --json <path>     Also write the results as JSON\n";
+            std::exit(0);
+        }
+    }
+    if (args.threads.empty()) {
+        int max_threads = 1;
+#ifdef _OPENMP
+        max_threads = omp_get_max_threads();
+#endif
+        for (int t = 1; t < max_threads; t *= 2) args.threads.push_back(t);
+        args.threads.push_back(max_threads);
+    }
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Args args = parse_args(argc, argv);
+    TableEvaluator::init();
+
+    using Isa = TableEvaluator::BatchIsa;
+    std::vector<std::string> all_paths = {"scalar", "table", "partial"};
+    for (Isa isa : {Isa::Portable, Isa::Avx2, Isa::Avx512}) {
+        if (TableEvaluator::batch_isa_supported(isa)) {
+            all_paths.push_back(std::string("batch-") + TableEvaluator::batch_isa_name(isa));
+        }
+    }
+    std::vector<std::string> paths;
+    for (const auto& p : args.paths.empty() ? all_paths : args.paths) {
+        if (std::find(all_paths.begin(), all_paths.end(), p) == all_paths.end()) {
+            std::cerr << "Unknown or unsupported path: " << p << "\n";
+            return 2;
+        }
+        paths.push_back(p);
+    }
+
+    nlohmann::json report;
+    report["hands"] = TOTAL_HANDS;
+    report["runs"] = nlohmann::json::array();
+
+    std::cout << "All " << TOTAL_HANDS << " seven-card hands per run\n\n"
+              << std::left << std::setw(16) << "path" << std::right
+              << std::setw(8) << "threads" << std::setw(10) << "s"
+              << std::setw(12) << "evals/s" << "  check\n";
+
+    // Check a run against the known totals and the reference fingerprint,
+    // print its row and add it to the report
+    bool all_ok = true;
+    uint64_t reference_fingerprint = 0;
+    auto record = [&](const Run& run) {
+        std::vector<std::string> failures;
+        if (run.tally.hands() != TOTAL_HANDS) failures.push_back("hand count");
+        for (int c = 0; c < NUM_CATEGORIES; ++c) {
+            if (run.tally.categories[c] != EXPECTED[c]) {
+                failures.push_back(poker::hand_rank_to_string(static_cast<poker::HandRank>(c)));
+            }
+        }
+        if (run.tally.distinct() != DISTINCT_VALUES) failures.push_back("distinct values");
+        if (run.tally.fingerprint != reference_fingerprint) failures.push_back("differs from reference");
+        all_ok = all_ok && failures.empty();
+
+        const double evals_per_sec = TOTAL_HANDS / run.seconds;
+        std::string check = "OK";
+        if (!failures.empty()) {
+            check = "FAIL:";
+            for (const auto& f : failures) check += " " + f;
+        }
+        std::cout << std::left << std::setw(16) << run.path << std::right
+                  << std::setw(8) << run.threads
+                  << std::setw(10) << std::fixed << std::setprecision(2) << run.seconds
+                  << std::setw(11) << std::setprecision(1) << evals_per_sec / 1e6 << "M"
+                  << "  " << check << std::endl;
+
+        nlohmann::json categories = nlohmann::json::object();
+        for (int c = 0; c < NUM_CATEGORIES; ++c) {
+            categories[poker::hand_rank_to_string(static_cast<poker::HandRank>(c))] = run.tally.categories[c];
+        }
+        report["runs"].push_back({
+            {"path", run.path},
+            {"threads", run.threads},
+            {"seconds", run.seconds},
+            {"evals_per_sec", evals_per_sec},
+            {"categories", categories},
+            {"distinct_values", run.tally.distinct()},
+            {"fingerprint", run.tally.fingerprint},
+            {"ok", failures.empty()},
+        });
+    };
+
+    // The reference runs once, on the most threads asked for; it must meet
+    // the known totals itself
+    five_card_values();
+    const Run reference = run_path("reference", *std::max_element(args.threads.begin(), args.threads.end()), 7,
+                                   reference_unit);
+    reference_fingerprint = reference.tally.fingerprint;
+    record(reference);
+
+    for (const auto& path : paths) {
+        for (int threads : args.threads) {
+            if (path == "scalar") {
+                record(run_path(path, threads, 7, scalar_unit));
+            } else if (path == "table") {
+                record(run_path(path, threads, 7, table_unit));
+            } else if (path == "partial") {
+                record(run_path(path, threads, 7, partial_unit));
+            } else {
+                Isa isa = Isa::Portable;
+                for (Isa i : {Isa::Portable, Isa::Avx2, Isa::Avx512}) {
+                    if (path == std::string("batch-") + TableEvaluator::batch_isa_name(i)) isa = i;
+                }
+                record(run_path(path, threads, 5, [isa](int c1, int c2, Tally& t) { batch_unit(c1, c2, t, isa); }));
+            }
+        }
+    }
+    report["ok"] = all_ok;
+
+    if (!args.json_path.empty()) {
+        std::ofstream out(args.json_path);
+        out << report.dump(2) << "\n";
+    }
+    std::cout << "\n" << (all_ok ? "All runs match the known totals and the reference" : "VALIDATION FAILED") << "\n";
+    return all_ok ? 0 : 1;
+}
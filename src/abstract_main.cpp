@@ -0,0 +1,289 @@
+// quantnet_abstract: builds a card abstraction into a bucket table file
+//
+// Enumerates the canonical (suit-isomorphic) boards of each round, computes
+// every hand's bucket in parallel chunks of boards (one batched
+// get_buckets call per board), and writes the table read by
+// create_abstraction("table:<path>"). Clustered abstractions (emd, ochs)
+// are clustered first. Both stages checkpoint to disk: rerun an interrupted
+// build with the same options and it resumes where it stopped. Ctrl-C
+// stops cleanly after the current chunk.
+//
+// Usage:
+//   ./quantnet_abstract [options]
+//
+// Options:
+//   --abstraction <name>     percentile|ehs|emd|ochs (default: percentile)
+//   --buckets <p,f,t,r>      Buckets per round (default: 169,50,50,50)
+//   --rounds <list>          Comma-separated rounds to store (default:
+//                            preflop,flop,turn,river)
+//   --output <path>          Bucket table to write (default: abstraction.qnb)
+//   --checkpoint <path>      Table checkpoint (default: <output>.ckpt); the
+//                            clustering checkpoint is <output>.clusters.ckpt.
+//                            Both are removed once the table is written.
+//   --checkpoint-seconds <s> Seconds between checkpoints (default: 60)
+//   --chunk <boards>         Canonical boards per chunk (default: 1024)
+//   --samples <n>            Runouts per hand when clustering (default: 100)
+//   --seed <n>               Clustering seed (default: 0)
+//   --threads <n>            OpenMP threads (default: all)
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "poker/BucketTable.hpp"
+#include "poker/CardAbstraction.hpp"
+
+using namespace quantnet;
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+void on_interrupt(int) {
+    interrupted = true;
+}
+
+struct Args {
+    std::string abstraction = "percentile";
+    std::vector<int> buckets = {169, 50, 50, 50};
+    std::vector<poker::BettingRound> rounds = {poker::BettingRound::Preflop, poker::BettingRound::Flop,
+                                               poker::BettingRound::Turn, poker::BettingRound::River};
+    std::string output = "abstraction.qnb";
+    std::string checkpoint;
+    double checkpoint_seconds = 60.0;
+    uint64_t chunk = 1024;
+    int samples = 100;
+    uint64_t seed = 0;
+    int threads = 0;                        // 0: OpenMP default
+};
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+// create_abstraction falls back to percentile for unknown names, which
+// would build a percentile table under the requested name
+constexpr const char* ABSTRACTIONS[] = {"percentile", "ehs", "emd", "ochs"};
+
+bool known_abstraction(const std::string& name) {
+    for (const char* known : ABSTRACTIONS) {
+        if (name == known) return true;
+    }
+    return false;
+}
+
+poker::BettingRound parse_round(const std::string& name) {
+    for (int r = 0; r < 4; ++r) {
+        const auto round = static_cast<poker::BettingRound>(r);
+        std::string lower = poker::round_to_string(round);
+        for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (name == lower) return round;
+    }
+    std::cerr << "Unknown round: " << name << "\n";
+    std::exit(1);
+}
+
+Args parse_args(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        try {
+            if (arg == "--abstraction" && i + 1 < argc) {
+                args.abstraction = argv[++i];
+                if (!known_abstraction(args.abstraction)) {
+                    std::cerr << "Unknown abstraction: " << args.abstraction << " (percentile|ehs|emd|ochs)\n";
+                    std::exit(1);
+                }
+            } else if (arg == "--buckets" && i + 1 < argc) {
+                args.buckets.clear();
+                for (const auto& b : split(argv[++i])) args.buckets.push_back(std::stoi(b));
+                if (args.buckets.size() != 4) {
+                    std::cerr << "--buckets takes four counts: preflop,flop,turn,river\n";
+                    std::exit(1);
+                }
+                for (int b : args.buckets) {
+                    if (b < 1) {
+                        std::cerr << "Bucket counts must be at least 1\n";
+                        std::exit(1);
+                    }
+                }
+            } else if (arg == "--rounds" && i + 1 < argc) {
+                args.rounds.clear();
+                for (const auto& r : split(argv[++i])) args.rounds.push_back(parse_round(r));
+            } else if (arg == "--output" && i + 1 < argc) {
+                args.output = argv[++i];
+            } else if (arg == "--checkpoint" && i + 1 < argc) {
+                args.checkpoint = argv[++i];
+            } else if (arg == "--checkpoint-seconds" && i + 1 < argc) {
+                args.checkpoint_seconds = std::stod(argv[++i]);
+            } else if (arg == "--chunk" && i + 1 < argc) {
+                args.chunk = std::stoull(argv[++i]);
+            } else if (arg == "--samples" && i + 1 < argc) {
+                args.samples = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                args.seed = std::stoull(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                args.threads = std::stoi(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                std::cout << "quantnet_abstract: build a card abstraction into a bucket table\n\n"
+                          << "Usage: quantnet_abstract [options]\n\n"
+                          << "Options:\n"
+                          << "  --abstraction <name>     percentile|ehs|emd|ochs (default: percentile)\n"
+                          << "  --buckets <p,f,t,r>      Buckets per round (default: 169,50,50,50)\n"
+                          << "  --rounds <list>          Rounds to store (default: preflop,flop,turn,river)\n"
+                          << "  --output <path>          Bucket table to write (default: abstraction.qnb)\n"
+                          << "  --checkpoint <path>      Table checkpoint (default: <output>.ckpt)\n"
+                          << "  --checkpoint-seconds <s> Seconds between checkpoints (default: 60)\n"
+                          << "  --chunk <boards>         Canonical boards per chunk (default: 1024)\n"
+                          << "  --samples <n>            Runouts per hand when clustering (default: 100)\n"
+                          << "  --seed <n>               Clustering seed (default: 0)\n"
+                          << "  --threads <n>            OpenMP threads (default: all)\n"
+                          << "  --help                   Show this help\n\n"
+                          << "Rerun with the same options to resume an interrupted build.\n";
+                std::exit(0);
+            } else {
+                std::cerr << "Unknown option: " << arg << " (see --help)\n";
+                std::exit(1);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << "\n";
+            std::exit(1);
+        }
+    }
+    if (args.checkpoint.empty()) args.checkpoint = args.output + ".ckpt";
+    return args;
+}
+
+std::string format_duration(double seconds) {
+    const long s = static_cast<long>(seconds + 0.5);
+    std::ostringstream out;
+    if (s >= 3600) out << s / 3600 << "h" << std::setw(2) << std::setfill('0') << s / 60 % 60 << "m";
+    else if (s >= 60) out << s / 60 << "m" << std::setw(2) << std::setfill('0') << s % 60 << "s";
+    else out << s << "s";
+    return out.str();
+}
+
+// Cluster the postflop rounds of an EMD or OCHS abstraction; false if stopped
+template <typename Abstraction, typename Config>
+bool cluster(Abstraction& abstraction, Config config, const Args& args) {
+    config.samples_per_hand = args.samples;
+    config.seed = args.seed;
+    config.rounds.clear();
+    for (poker::BettingRound round : args.rounds) {
+        if (round != poker::BettingRound::Preflop) config.rounds.push_back(round);
+    }
+    config.checkpoint_path = args.output + ".clusters.ckpt";
+    config.checkpoint_seconds = args.checkpoint_seconds;
+
+    auto last = std::chrono::steady_clock::now();
+    config.progress = [&](const poker::EMDBuildProgress& p) {
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - last).count() >= 1.0 || interrupted) {
+            last = now;
+            std::cout << "  [" << poker::round_to_string(p.round) << "] ";
+            if (p.assigning) {
+                std::cout << "assigning " << p.boards_done << "/" << p.boards_total << " boards\n";
+            } else {
+                std::cout << "k-means step " << p.iteration << ", " << p.changed << " changed\n";
+            }
+        }
+        return !interrupted;
+    };
+    return abstraction.build_clusters(config);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Args args = parse_args(argc, argv);
+#ifdef _OPENMP
+    if (args.threads > 0) omp_set_num_threads(args.threads);
+    const int threads = omp_get_max_threads();
+#else
+    const int threads = 1;
+#endif
+    std::signal(SIGINT, on_interrupt);
+    std::signal(SIGTERM, on_interrupt);
+
+    auto abstraction = poker::create_abstraction(args.abstraction, args.buckets[0], args.buckets[1],
+                                                 args.buckets[2], args.buckets[3]);
+    std::cout << "Abstraction: " << abstraction->name() << " (" << args.buckets[0] << "/" << args.buckets[1]
+              << "/" << args.buckets[2] << "/" << args.buckets[3] << " buckets), " << threads << " thread"
+              << (threads == 1 ? "" : "s") << "\n";
+
+    try {
+        bool clustered = true;
+        if (auto* emd = dynamic_cast<poker::EMDAbstraction*>(abstraction.get())) {
+            std::cout << "Clustering (checkpoint " << args.output << ".clusters.ckpt)\n";
+            clustered = cluster(*emd, poker::EMDBuildConfig{}, args);
+        } else if (auto* ochs = dynamic_cast<poker::OCHSAbstraction*>(abstraction.get())) {
+            std::cout << "Clustering (checkpoint " << args.output << ".clusters.ckpt)\n";
+            clustered = cluster(*ochs, poker::OCHSBuildConfig{}, args);
+        }
+        if (!clustered) {
+            std::cout << "Stopped; rerun with the same options to resume\n";
+            return 2;
+        }
+
+        poker::TableBuildConfig config;
+        config.rounds = args.rounds;
+        config.boards_per_chunk = args.chunk;
+        config.checkpoint_path = args.checkpoint;
+        config.checkpoint_seconds = args.checkpoint_seconds;
+
+        double last_report = -1.0;
+        config.progress = [&](const poker::TableBuildProgress& p) {
+            const bool round_done = p.boards_done == p.boards_total;
+            if (p.seconds - last_report >= 2.0 || round_done || interrupted) {
+                last_report = p.seconds;
+                const double rate = p.seconds > 0.0 ? (p.hands_done - p.hands_resumed) / p.seconds : 0.0;
+                std::cout << "  [" << poker::round_to_string(p.round) << "] " << p.boards_done << "/"
+                          << p.boards_total << " boards, " << std::fixed << std::setprecision(1)
+                          << 100.0 * p.hands_done / p.hands_total << "% of hands, " << rate / 1e6
+                          << "M hands/s";
+                if (p.seconds >= 1.0 && p.hands_done < p.hands_total) {
+                    std::cout << ", ETA " << format_duration((p.hands_total - p.hands_done) / rate);
+                }
+                std::cout << std::defaultfloat << std::endl;
+            }
+            return !interrupted;
+        };
+
+        std::cout << "Building table (checkpoint " << args.checkpoint << ")\n";
+        const auto t0 = std::chrono::steady_clock::now();
+        if (!poker::TableAbstraction::write(args.output, *abstraction, config)) {
+            std::cout << "Stopped; checkpoint saved to " << args.checkpoint
+                      << ", rerun with the same options to resume\n";
+            return 2;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::error_code ec;
+        std::filesystem::remove(args.output + ".clusters.ckpt", ec);
+
+        const poker::TableAbstraction table(args.output);
+        std::cout << "Wrote " << args.output << " (" << std::fixed << std::setprecision(1)
+                  << table.file_size() / 1e6 << " MB) in " << format_duration(seconds) << "\n"
+                  << "Load with create_abstraction(\"table:" << args.output << "\")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
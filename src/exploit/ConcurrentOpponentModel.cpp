@@ -0,0 +1,242 @@
+#include "ConcurrentOpponentModel.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace quantnet::exploit {
+
+namespace {
+
+struct IdHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+} // namespace
+
+// Stats of one opponent, indexed by info set handle, and the raw profile
+// counts OpponentModel keeps (normalized on read)
+struct ConcurrentOpponentModel::Opponent {
+    std::vector<ActionStats> stats;
+    TendencyProfile counts;
+
+    ActionStats& at(StatsHandle handle) {
+        if (stats.size() <= handle) stats.resize(handle + 1);
+        return stats[handle];
+    }
+};
+
+// One lock and the opponents hashed to it, on its own cache line so
+// neighbouring shards' locks do not share one
+struct alignas(64) ConcurrentOpponentModel::Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<poker::PlayerId, Opponent> opponents;
+
+    // Null if the opponent was never observed; call with the lock held
+    const Opponent* find(poker::PlayerId player) const {
+        auto it = opponents.find(player);
+        return it == opponents.end() ? nullptr : &it->second;
+    }
+};
+
+struct alignas(64) ConcurrentOpponentModel::IdShard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<poker::InfoSetId, StatsHandle, IdHash, std::equal_to<>> handles;
+};
+
+ConcurrentOpponentModel::ConcurrentOpponentModel(const ConcurrentOpponentModelConfig& config) {
+    if (config.shards < 1) {
+        throw std::invalid_argument("Concurrent opponent model needs a positive shard count");
+    }
+    const uint64_t shards = std::bit_ceil(static_cast<uint64_t>(config.shards));
+    shard_bits_ = std::countr_zero(shards);
+    shards_ = std::make_unique<Shard[]>(shards);
+    id_shards_ = std::make_unique<IdShard[]>(shards);
+}
+
+ConcurrentOpponentModel::~ConcurrentOpponentModel() = default;
+
+ConcurrentOpponentModel::Shard& ConcurrentOpponentModel::shard_for(poker::PlayerId player) const {
+    // Ids are often sequential; mixing spreads them over all shards
+    const uint64_t h = parallel::CounterRng::mix(static_cast<uint64_t>(static_cast<uint32_t>(player)));
+    return shards_[shard_bits_ == 0 ? 0 : h >> (64 - shard_bits_)];
+}
+
+ConcurrentOpponentModel::IdShard& ConcurrentOpponentModel::id_shard_for(uint64_t hash) const {
+    const uint64_t h = parallel::CounterRng::mix(hash);
+    return id_shards_[shard_bits_ == 0 ? 0 : h >> (64 - shard_bits_)];
+}
+
+StatsHandle ConcurrentOpponentModel::find(std::string_view info_set) const {
+    const IdShard& s = id_shard_for(IdHash{}(info_set));
+    std::shared_lock lock(s.mutex);
+    auto it = s.handles.find(info_set);
+    return it == s.handles.end() ? INVALID_STATS_HANDLE : it->second;
+}
+
+StatsHandle ConcurrentOpponentModel::intern(std::string_view info_set) {
+    IdShard& s = id_shard_for(IdHash{}(info_set));
+    {
+        std::shared_lock lock(s.mutex);
+        auto it = s.handles.find(info_set);
+        if (it != s.handles.end()) return it->second;
+    }
+    // New ids are rare: take the shard exclusively and check again
+    std::unique_lock lock(s.mutex);
+    auto it = s.handles.find(info_set);
+    if (it != s.handles.end()) return it->second;
+    const StatsHandle handle = next_handle_.fetch_add(1, std::memory_order_acq_rel);
+    s.handles.emplace(poker::InfoSetId(info_set), handle);
+    return handle;
+}
+
+void ConcurrentOpponentModel::observe_action(poker::PlayerId player, const poker::InfoSetId& info_set,
+                                             const std::string& action) {
+    const StatsHandle handle = intern(info_set);
+    Shard& s = shard_for(player);
+    std::unique_lock lock(s.mutex);
+    Opponent& opponent = s.opponents[player];
+    opponent.at(handle).observe(action);
+
+    // Same profile counts as OpponentModel's string overload
+    if (action == "raise" || action == "bet") opponent.counts.pfr += 1;
+    if (action != "fold") opponent.counts.vpip += 1;
+}
+
+void ConcurrentOpponentModel::observe_action(poker::PlayerId player, const poker::InfoSetId& info_set,
+                                             poker::Action action) {
+    observe_action(player, intern(info_set), action);
+}
+
+void ConcurrentOpponentModel::observe_action(poker::PlayerId player, StatsHandle handle, poker::Action action) {
+    if (handle >= num_info_sets()) {
+        throw std::invalid_argument("Stats handle was not interned by this model");
+    }
+    Shard& s = shard_for(player);
+    std::unique_lock lock(s.mutex);
+    Opponent& opponent = s.opponents[player];
+    opponent.at(handle).observe(action);
+    if (action == poker::Action::Bet || action == poker::Action::Raise) opponent.counts.pfr += 1;
+    if (action != poker::Action::Fold) opponent.counts.vpip += 1;
+}
+
+void ConcurrentOpponentModel::observe_hand_result(poker::PlayerId player, bool won, bool went_to_showdown,
+                                                  double /*pot_size*/) {
+    Shard& s = shard_for(player);
+    std::unique_lock lock(s.mutex);
+    TendencyProfile& counts = s.opponents[player].counts;
+    counts.total_hands++;
+    if (went_to_showdown) {
+        counts.went_to_showdown++;
+        if (won) counts.won_at_showdown++;
+    }
+}
+
+void ConcurrentOpponentModel::merge_stats(poker::PlayerId player, StatsHandle handle, const ActionStats& counts) {
+    if (handle >= num_info_sets()) {
+        throw std::invalid_argument("Stats handle was not interned by this model");
+    }
+    Shard& s = shard_for(player);
+    std::unique_lock lock(s.mutex);
+    Opponent& opponent = s.opponents[player];
+    opponent.at(handle).merge(counts);
+    opponent.counts.pfr += counts.raise_count;
+    opponent.counts.vpip += counts.total_observations - counts.fold_count;
+}
+
+ActionStats ConcurrentOpponentModel::get_stats(poker::PlayerId player, const poker::InfoSetId& info_set) const {
+    const StatsHandle handle = find(info_set);
+    if (handle == INVALID_STATS_HANDLE) return ActionStats{};
+    const Shard& s = shard_for(player);
+    std::shared_lock lock(s.mutex);
+    const Opponent* opponent = s.find(player);
+    return opponent && handle < opponent->stats.size() ? opponent->stats[handle] : ActionStats{};
+}
+
+TendencyProfile ConcurrentOpponentModel::get_profile(poker::PlayerId player) const {
+    const Shard& s = shard_for(player);
+    std::shared_lock lock(s.mutex);
+    const Opponent* opponent = s.find(player);
+    if (!opponent) return TendencyProfile{};
+
+    int total_bets = 0, total_calls = 0;
+    for (const ActionStats& stats : opponent->stats) {
+        total_bets += stats.raise_count;
+        total_calls += stats.call_count;
+    }
+    return OpponentModel::normalize_profile(opponent->counts, total_bets, total_calls);
+}
+
+Eigen::VectorXd ConcurrentOpponentModel::predict_action_probs(poker::PlayerId player,
+                                                              const poker::InfoSetId& info_set,
+                                                              int num_actions) const {
+    return OpponentModel::predict_from_stats(get_stats(player, info_set), num_actions);
+}
+
+int ConcurrentOpponentModel::total_observations(poker::PlayerId player) const {
+    const Shard& s = shard_for(player);
+    std::shared_lock lock(s.mutex);
+    const Opponent* opponent = s.find(player);
+    int total = 0;
+    if (opponent) {
+        for (const ActionStats& stats : opponent->stats) total += stats.total_observations;
+    }
+    return total;
+}
+
+OpponentModel ConcurrentOpponentModel::snapshot(poker::PlayerId player) const {
+    Opponent copy;
+    {
+        const Shard& s = shard_for(player);
+        std::shared_lock lock(s.mutex);
+        const Opponent* opponent = s.find(player);
+        if (!opponent) return OpponentModel{};
+        copy = *opponent;
+    }
+
+    // A handle's id never changes, so the names can be looked up afterwards
+    std::vector<const poker::InfoSetId*> ids(copy.stats.size(), nullptr);
+    for (int i = 0; i < num_shards(); ++i) {
+        std::shared_lock lock(id_shards_[i].mutex);
+        for (const auto& [id, handle] : id_shards_[i].handles) {
+            if (handle < ids.size()) ids[handle] = &id;
+        }
+    }
+
+    // Merging each info set's counts also rebuilds vpip and pfr
+    OpponentModel model;
+    for (StatsHandle h = 0; h < copy.stats.size(); ++h) {
+        if (copy.stats[h].total_observations > 0) model.merge_stats(model.intern(player, *ids[h]), copy.stats[h]);
+    }
+    model.observe_hand_results(player, copy.counts.total_hands, static_cast<int>(copy.counts.went_to_showdown),
+                               static_cast<int>(copy.counts.won_at_showdown));
+    return model;
+}
+
+size_t ConcurrentOpponentModel::num_opponents() const {
+    size_t total = 0;
+    for (int i = 0; i < num_shards(); ++i) {
+        std::shared_lock lock(shards_[i].mutex);
+        total += shards_[i].opponents.size();
+    }
+    return total;
+}
+
+void ConcurrentOpponentModel::reset() {
+    for (int i = 0; i < num_shards(); ++i) {
+        std::unique_lock lock(shards_[i].mutex);
+        shards_[i].opponents.clear();
+    }
+    for (int i = 0; i < num_shards(); ++i) {
+        std::unique_lock lock(id_shards_[i].mutex);
+        id_shards_[i].handles.clear();
+    }
+    next_handle_.store(0, std::memory_order_release);
+}
+
+} // namespace quantnet::exploit
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "OpponentModel.hpp"
+
+namespace quantnet::exploit {
+
+struct ConcurrentOpponentModelConfig {
+    int shards = 64;                     // Rounded up to a power of two
+};
+
+// OpponentModel shared by many table threads
+//
+// Info set ids are interned once for all opponents, into a table sharded by
+// a hash of the id; the ids of one game are few and shared, so their
+// lookups stay in cache however many opponents there are. Each opponent
+// keeps a flat array of ActionStats indexed by that handle, and opponents
+// are spread over independently locked shards by a hash of their id.
+//
+// An update takes only its opponent's shard lock, exclusively; a read takes
+// it shared and copies what it returns, so every read is a consistent
+// snapshot of one opponent (a profile never sees half an action). Nothing
+// on the update path is global: threads working on different opponents
+// rarely meet on a lock, so throughput grows with cores as long as
+// opponents outnumber them. Handles from intern() skip the id lookup.
+//
+// Reads agree exactly with an OpponentModel fed the same observations.
+class ConcurrentOpponentModel {
+public:
+    // Throws std::invalid_argument if shards is not positive
+    explicit ConcurrentOpponentModel(const ConcurrentOpponentModelConfig& config = {});
+    ~ConcurrentOpponentModel();
+
+    ConcurrentOpponentModel(const ConcurrentOpponentModel&) = delete;
+    ConcurrentOpponentModel& operator=(const ConcurrentOpponentModel&) = delete;
+
+    // Handle for an info set, the same for every opponent; added if new
+    StatsHandle intern(std::string_view info_set);
+
+    void observe_action(poker::PlayerId player, const poker::InfoSetId& info_set, const std::string& action);
+    void observe_action(poker::PlayerId player, const poker::InfoSetId& info_set, poker::Action action);
+    // Throws std::invalid_argument if handle did not come from intern()
+    void observe_action(poker::PlayerId player, StatsHandle handle, poker::Action action);
+
+    void observe_hand_result(poker::PlayerId player, bool won, bool went_to_showdown, double pot_size);
+
+    // Apply counts gathered in a batch (see OpponentModel::merge_stats)
+    void merge_stats(poker::PlayerId player, StatsHandle handle, const ActionStats& counts);
+
+    // Copies taken under the opponent's shard lock
+    ActionStats get_stats(poker::PlayerId player, const poker::InfoSetId& info_set) const;
+    TendencyProfile get_profile(poker::PlayerId player) const;
+    Eigen::VectorXd predict_action_probs(poker::PlayerId player, const poker::InfoSetId& info_set,
+                                         int num_actions = 2) const;
+    int total_observations(poker::PlayerId player) const;
+
+    // Everything known about one opponent as an OpponentModel, for
+    // ExploitativeStrategy and other single-threaded consumers; empty if
+    // never observed. Costs a pass over the interned ids.
+    OpponentModel snapshot(poker::PlayerId player) const;
+
+    size_t num_opponents() const;
+    size_t num_info_sets() const { return next_handle_.load(std::memory_order_acquire); }
+    int num_shards() const { return 1 << shard_bits_; }
+
+    // Forget every opponent and info set; not concurrently with other calls
+    void reset();
+
+private:
+    struct Opponent;
+    struct Shard;
+    struct IdShard;
+
+    int shard_bits_ = 0;
+    std::unique_ptr<Shard[]> shards_;
+    std::unique_ptr<IdShard[]> id_shards_;
+    std::atomic<StatsHandle> next_handle_{0};
+
+    Shard& shard_for(poker::PlayerId player) const;
+    IdShard& id_shard_for(uint64_t hash) const;
+    StatsHandle find(std::string_view info_set) const;
+};
+
+} // namespace quantnet::exploit
@@ -0,0 +1,237 @@
+#include "HandHistory.hpp"
+#include "../io/MappedFile.hpp"
+#include "../poker/StrategyTable.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace quantnet::exploit {
+
+namespace {
+
+// (player, info set) as it appears in the log, pointing into the text
+struct PairKey {
+    poker::PlayerId player;
+    std::string_view info_set;
+
+    bool operator==(const PairKey& other) const {
+        return player == other.player && info_set == other.info_set;
+    }
+};
+
+struct ResultCounts {
+    int hands = 0;
+    int showdowns = 0;
+    int showdown_wins = 0;
+};
+
+// Everything one chunk contributes. Pairs are kept in first-seen order, so
+// the merge interns in the order a line-by-line pass would, and found
+// through an open-addressing table of indices into pairs (power of two,
+// at most half full), probed by FNV-1a hash like StrategyTable.
+struct ChunkTally {
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    std::vector<uint32_t> slots = std::vector<uint32_t>(1024, EMPTY);
+    std::vector<uint64_t> hashes;
+    std::vector<std::pair<PairKey, ActionStats>> pairs;
+    std::map<poker::PlayerId, ResultCounts> results;
+    uint64_t lines = 0;
+    uint64_t actions = 0;
+    uint64_t result_lines = 0;
+    size_t error_offset = std::string_view::npos;   // Start of the first bad line
+    std::string error;
+
+    ActionStats& counts(const PairKey& key) {
+        const uint64_t hash = poker::StrategyTable::hash_id(key.info_set) ^
+                              (static_cast<uint64_t>(key.player) * 0x9E3779B97F4A7C15ULL);
+        const size_t mask = slots.size() - 1;
+        for (size_t s = hash & mask;; s = (s + 1) & mask) {
+            const uint32_t i = slots[s];
+            if (i == EMPTY) {
+                slots[s] = static_cast<uint32_t>(pairs.size());
+                hashes.push_back(hash);
+                pairs.emplace_back(key, ActionStats{});
+                if (pairs.size() * 2 > slots.size()) grow();
+                return pairs.back().second;
+            }
+            if (hashes[i] == hash && pairs[i].first == key) return pairs[i].second;
+        }
+    }
+
+    void grow() {
+        slots.assign(slots.size() * 2, EMPTY);
+        const size_t mask = slots.size() - 1;
+        for (uint32_t i = 0; i < pairs.size(); ++i) {
+            size_t s = hashes[i] & mask;
+            while (slots[s] != EMPTY) s = (s + 1) & mask;
+            slots[s] = i;
+        }
+    }
+};
+
+// Next space- or tab-separated field of line from pos; empty at the end
+std::string_view next_field(std::string_view line, size_t& pos) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    const size_t start = pos;
+    while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t') ++pos;
+    return line.substr(start, pos - start);
+}
+
+bool parse_player(std::string_view token, poker::PlayerId& player) {
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), player);
+    return ec == std::errc{} && end == token.data() + token.size() && player >= 0;
+}
+
+bool parse_flag(std::string_view token, bool& flag) {
+    if (token != "0" && token != "1") return false;
+    flag = token == "1";
+    return true;
+}
+
+// Parse one line (without its newline) into tally; empty string if valid,
+// otherwise what is wrong with it
+std::string parse_line(std::string_view line, ChunkTally& tally) {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    size_t pos = 0;
+    const std::string_view first = next_field(line, pos);
+    if (first.empty() || first[0] == '#') return {};
+
+    if (first == "result") {
+        poker::PlayerId player = 0;
+        bool won = false;
+        bool showdown = false;
+        double pot = 0.0;
+        const std::string_view player_token = next_field(line, pos);
+        const std::string_view won_token = next_field(line, pos);
+        const std::string_view showdown_token = next_field(line, pos);
+        const std::string_view pot_token = next_field(line, pos);
+        const auto [pot_end, pot_ec] = std::from_chars(pot_token.data(), pot_token.data() + pot_token.size(), pot);
+        if (!parse_player(player_token, player) || !parse_flag(won_token, won) ||
+            !parse_flag(showdown_token, showdown) || pot_token.empty() || pot_ec != std::errc{} ||
+            pot_end != pot_token.data() + pot_token.size() || !next_field(line, pos).empty()) {
+            return "expected 'result <player> <won 0|1> <showdown 0|1> <pot>'";
+        }
+        ResultCounts& counts = tally.results[player];
+        counts.hands++;
+        if (showdown) {
+            counts.showdowns++;
+            if (won) counts.showdown_wins++;
+        }
+        tally.result_lines++;
+        return {};
+    }
+
+    poker::PlayerId player = 0;
+    if (!parse_player(first, player)) return "expected a player number or 'result'";
+    const std::string_view info_set = next_field(line, pos);
+    const std::string_view action_token = next_field(line, pos);
+    if (info_set.empty() || action_token.empty() || !next_field(line, pos).empty()) {
+        return "expected '<player> <info_set> <action>'";
+    }
+    const std::optional<poker::Action> action = parse_action(action_token);
+    if (!action) return "unknown action '" + std::string(action_token) + "'";
+
+    tally.counts({player, info_set}).observe(*action);
+    tally.actions++;
+    return {};
+}
+
+void parse_chunk(std::string_view text, size_t begin, size_t end, ChunkTally& tally) {
+    size_t pos = begin;
+    while (pos < end) {
+        const void* nl = std::memchr(text.data() + pos, '\n', end - pos);
+        const size_t line_end = nl ? static_cast<size_t>(static_cast<const char*>(nl) - text.data()) : end;
+        tally.lines++;
+        std::string error = parse_line(text.substr(pos, line_end - pos), tally);
+        if (!error.empty()) {
+            tally.error_offset = pos;
+            tally.error = std::move(error);
+            return;
+        }
+        pos = line_end + 1;
+    }
+}
+
+} // namespace
+
+std::optional<poker::Action> parse_action(std::string_view token) {
+    if (token.size() == 1) return poker::char_to_action(token[0]);
+    if (token == "check") return poker::Action::Check;
+    if (token == "bet") return poker::Action::Bet;
+    if (token == "call") return poker::Action::Call;
+    if (token == "fold") return poker::Action::Fold;
+    if (token == "raise") return poker::Action::Raise;
+    return std::nullopt;
+}
+
+IngestStats ingest_hand_history(const std::string& path, OpponentModel& model, const IngestConfig& config) {
+    const io::MappedFile file(path);
+    const std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+    return ingest_hand_history_text(text, model, config, path);
+}
+
+IngestStats ingest_hand_history_text(std::string_view text, OpponentModel& model, const IngestConfig& config,
+                                     const std::string& source) {
+    if (config.chunk_bytes == 0) {
+        throw std::invalid_argument("Hand history chunk_bytes must be positive");
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Chunks end just after a newline (or at the end of the text)
+    std::vector<size_t> bounds = {0};
+    while (bounds.back() < text.size()) {
+        size_t next = bounds.back() + std::min(config.chunk_bytes, text.size() - bounds.back());
+        if (next < text.size()) {
+            const size_t nl = text.find('\n', next - 1);
+            next = nl == std::string_view::npos ? text.size() : nl + 1;
+        }
+        bounds.push_back(next);
+    }
+    const auto num_chunks = static_cast<int64_t>(bounds.size() - 1);
+
+    std::vector<ChunkTally> tallies(static_cast<size_t>(num_chunks));
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int64_t c = 0; c < num_chunks; ++c) {
+        parse_chunk(text, bounds[c], bounds[c + 1], tallies[c]);
+    }
+
+    // Report the first bad line before changing the model
+    for (const ChunkTally& tally : tallies) {
+        if (tally.error_offset == std::string_view::npos) continue;
+        const auto line = std::count(text.begin(), text.begin() + tally.error_offset, '\n') + 1;
+        throw std::runtime_error(source + ":" + std::to_string(line) + ": " + tally.error);
+    }
+
+    IngestStats stats;
+    stats.bytes = text.size();
+    std::vector<bool> seen;
+    for (const ChunkTally& tally : tallies) {
+        for (const auto& [key, counts] : tally.pairs) {
+            const StatsHandle handle = model.intern(key.player, key.info_set);
+            model.merge_stats(handle, counts);
+            if (handle >= seen.size()) seen.resize(handle + 1, false);
+            if (!seen[handle]) {
+                seen[handle] = true;
+                stats.info_sets++;
+            }
+        }
+        for (const auto& [player, counts] : tally.results) {
+            model.observe_hand_results(player, counts.hands, counts.showdowns, counts.showdown_wins);
+        }
+        stats.lines += tally.lines;
+        stats.actions += tally.actions;
+        stats.results += tally.result_lines;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+} // namespace quantnet::exploit
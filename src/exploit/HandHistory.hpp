@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "OpponentModel.hpp"
+
+namespace quantnet::exploit {
+
+// Streaming hand-history ingestion into an OpponentModel
+//
+// A log is text, one record per line, fields separated by spaces or tabs:
+//   <player> <info_set> <action>             an action; action is a name
+//                                            (fold, check, call, bet, raise)
+//                                            or its letter (f, c, k, b, r)
+//   result <player> <won> <showdown> <pot>   end of a hand for player; won
+//                                            and showdown are 0 or 1
+// Blank lines and lines starting with '#' are skipped.
+//
+// The file is memory-mapped and split into chunks at line ends. Chunks are
+// parsed in parallel (OpenMP) with string_views into the mapping, and each
+// counts its actions per (player, info set) in a local table, so no id is
+// copied and the model is not touched while parsing. The chunk tables are
+// then merged into the model in file order: one intern() and merge_stats()
+// per distinct pair and chunk, instead of one map lookup per action. The
+// model ends up exactly as if observe_action / observe_hand_result had
+// been called for every line.
+struct IngestConfig {
+    size_t chunk_bytes = size_t{4} << 20;    // Bytes per parallel chunk
+};
+
+struct IngestStats {
+    uint64_t bytes = 0;
+    uint64_t lines = 0;
+    uint64_t actions = 0;
+    uint64_t results = 0;
+    uint64_t info_sets = 0;      // Distinct (player, info set) pairs in the log
+    double seconds = 0.0;
+};
+
+// Action for a name or letter as written in logs, nullopt if unknown.
+// Letters are those of info-set histories (poker::char_to_action).
+std::optional<poker::Action> parse_action(std::string_view token);
+
+// Ingest a log file. Throws std::runtime_error if the file cannot be read
+// or a line is malformed ("path:line: message", for the first bad line; the
+// model is left unchanged), std::invalid_argument if chunk_bytes is 0.
+IngestStats ingest_hand_history(const std::string& path, OpponentModel& model,
+                                const IngestConfig& config = {});
+
+// Ingest log text already in memory; source names it in error messages
+IngestStats ingest_hand_history_text(std::string_view text, OpponentModel& model,
+                                     const IngestConfig& config = {},
+                                     const std::string& source = "<text>");
+
+} // namespace quantnet::exploit
@@ -8,7 +8,7 @@ const ActionStats OpponentModel::empty_stats_ = ActionStats{};
 void OpponentModel::observe_action(poker::PlayerId player,
                                    const poker::InfoSetId& info_set,
                                    const std::string& action) {
-    stats_[player][info_set].observe(action);
+    stats_[intern(player, info_set)].observe(action);
 
     // Update aggregate profile
     auto& profile = profiles_[player];
@@ -20,6 +20,58 @@ void OpponentModel::observe_action(poker::PlayerId player,
     }
 }
 
+StatsHandle OpponentModel::intern(poker::PlayerId player, std::string_view info_set) {
+    HandleMap& handles = handles_[player];
+    auto it = handles.find(info_set);
+    if (it != handles.end()) return it->second;
+
+    const auto handle = static_cast<StatsHandle>(stats_.size());
+    handles.emplace(poker::InfoSetId(info_set), handle);
+    stats_.emplace_back();
+    owners_.push_back(player);
+    ids_.emplace_back(info_set);
+    player_handles_[player].push_back(handle);
+    return handle;
+}
+
+StatsHandle OpponentModel::find(poker::PlayerId player, std::string_view info_set) const {
+    auto pit = handles_.find(player);
+    if (pit == handles_.end()) return INVALID_STATS_HANDLE;
+    auto it = pit->second.find(info_set);
+    return it == pit->second.end() ? INVALID_STATS_HANDLE : it->second;
+}
+
+void OpponentModel::update_profile(StatsHandle handle, poker::Action action) {
+    auto& profile = profiles_[owners_[handle]];
+    if (action == poker::Action::Bet || action == poker::Action::Raise) {
+        profile.pfr += 1;
+    }
+    if (action != poker::Action::Fold) {
+        profile.vpip += 1;
+    }
+}
+
+void OpponentModel::observe_action(poker::PlayerId player,
+                                   const poker::InfoSetId& info_set,
+                                   poker::Action action) {
+    observe_action(intern(player, info_set), action);
+}
+
+void OpponentModel::observe_action(StatsHandle handle, poker::Action action) {
+    stats_[handle].observe(action);
+    update_profile(handle, action);
+}
+
+void OpponentModel::merge_stats(StatsHandle handle, const ActionStats& counts) {
+    stats_[handle].merge(counts);
+
+    // Same profile totals as observing each action: aggressive actions
+    // count toward pfr, everything but folds toward vpip
+    auto& profile = profiles_[owners_[handle]];
+    profile.pfr += counts.raise_count;
+    profile.vpip += counts.total_observations - counts.fold_count;
+}
+
 void OpponentModel::observe_hand_result(poker::PlayerId player,
                                         bool won,
                                         bool went_to_showdown,
@@ -35,15 +87,17 @@ void OpponentModel::observe_hand_result(poker::PlayerId player,
     }
 }
 
+void OpponentModel::observe_hand_results(poker::PlayerId player, int hands, int showdowns, int showdown_wins) {
+    auto& profile = profiles_[player];
+    profile.total_hands += hands;
+    profile.went_to_showdown += showdowns;
+    profile.won_at_showdown += showdown_wins;
+}
+
 const ActionStats& OpponentModel::get_stats(poker::PlayerId player,
                                            const poker::InfoSetId& info_set) const {
-    auto pit = stats_.find(player);
-    if (pit == stats_.end()) return empty_stats_;
-
-    auto iit = pit->second.find(info_set);
-    if (iit == pit->second.end()) return empty_stats_;
-
-    return iit->second;
+    const StatsHandle handle = find(player, info_set);
+    return handle == INVALID_STATS_HANDLE ? empty_stats_ : stats_[handle];
 }
 
 TendencyProfile OpponentModel::get_profile(poker::PlayerId player) const {
@@ -52,8 +106,19 @@ TendencyProfile OpponentModel::get_profile(poker::PlayerId player) const {
         return TendencyProfile{};
     }
 
-    TendencyProfile profile = it->second;
+    // Compute aggression factor from all observed actions
+    int total_bets = 0, total_calls = 0;
+    auto pit = player_handles_.find(player);
+    if (pit != player_handles_.end()) {
+        for (StatsHandle handle : pit->second) {
+            total_bets += stats_[handle].raise_count;
+            total_calls += stats_[handle].call_count;
+        }
+    }
+    return normalize_profile(it->second, total_bets, total_calls);
+}
 
+TendencyProfile OpponentModel::normalize_profile(TendencyProfile profile, int total_bets, int total_calls) {
     // Normalize percentages
     if (profile.total_hands > 0) {
         profile.vpip /= profile.total_hands;
@@ -65,16 +130,6 @@ TendencyProfile OpponentModel::get_profile(poker::PlayerId player) const {
         profile.won_at_showdown /= (profile.went_to_showdown * profile.total_hands);
     }
 
-    // Compute aggression factor from all observed actions
-    int total_bets = 0, total_calls = 0;
-    auto pit = stats_.find(player);
-    if (pit != stats_.end()) {
-        for (const auto& [info_set, stats] : pit->second) {
-            total_bets += stats.raise_count;
-            total_calls += stats.call_count;
-        }
-    }
-
     profile.aggression = (total_calls > 0) ?
         static_cast<double>(total_bets) / total_calls : 1.0;
 
@@ -86,8 +141,10 @@ Eigen::VectorXd OpponentModel::predict_action_probs(
     const poker::InfoSetId& info_set,
     int num_actions) const {
 
-    const ActionStats& stats = get_stats(player, info_set);
+    return predict_from_stats(get_stats(player, info_set), num_actions);
+}
 
+Eigen::VectorXd OpponentModel::predict_from_stats(const ActionStats& stats, int num_actions) {
     Eigen::VectorXd probs(num_actions);
 
     if (num_actions == 2) {
@@ -164,15 +221,19 @@ Eigen::VectorXd OpponentModel::blend_with_nash(
 
 void OpponentModel::reset() {
     stats_.clear();
+    owners_.clear();
+    ids_.clear();
+    handles_.clear();
+    player_handles_.clear();
     profiles_.clear();
 }
 
 int OpponentModel::total_observations(poker::PlayerId player) const {
     int total = 0;
-    auto pit = stats_.find(player);
-    if (pit != stats_.end()) {
-        for (const auto& [info_set, stats] : pit->second) {
-            total += stats.total_observations;
+    auto pit = player_handles_.find(player);
+    if (pit != player_handles_.end()) {
+        for (StatsHandle handle : pit->second) {
+            total += stats_[handle].total_observations;
         }
     }
     return total;
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <Eigen/Dense>
@@ -24,6 +29,21 @@ struct ActionStats {
         total_observations++;
     }
 
+    void observe(poker::Action action) {
+        if (action == poker::Action::Fold) fold_count++;
+        else if (action == poker::Action::Call || action == poker::Action::Check) call_count++;
+        else raise_count++;
+        total_observations++;
+    }
+
+    // Add counts gathered elsewhere (a batch of observations)
+    void merge(const ActionStats& other) {
+        fold_count += other.fold_count;
+        call_count += other.call_count;
+        raise_count += other.raise_count;
+        total_observations += other.total_observations;
+    }
+
     // Frequency estimates with Laplace smoothing
     double fold_freq(double prior = 1.0) const {
         return (fold_count + prior) / (total_observations + 3 * prior);
@@ -71,7 +91,17 @@ struct TendencyProfile {
     }
 };
 
+// Interned (player, info set) pair: index of its ActionStats in the model
+using StatsHandle = uint32_t;
+constexpr StatsHandle INVALID_STATS_HANDLE = UINT32_MAX;
+
 // Opponent model tracks statistics and predicts opponent behavior
+//
+// Each (player, info set) pair is interned once to a StatsHandle; its
+// ActionStats live in a deque, so references from get_stats() stay valid
+// as pairs are added. The handle overloads skip the id lookup entirely,
+// and merge_stats() applies a whole batch of counts (see HandHistory.hpp
+// for bulk ingestion from a log). Not thread-safe: update from one thread.
 class OpponentModel {
 public:
     OpponentModel() = default;
@@ -80,6 +110,21 @@ public:
     void observe_action(poker::PlayerId player,
                         const poker::InfoSetId& info_set,
                         const std::string& action);
+    void observe_action(poker::PlayerId player,
+                        const poker::InfoSetId& info_set,
+                        poker::Action action);
+    void observe_action(StatsHandle handle, poker::Action action);
+
+    // Handle for a (player, info set) pair, added with empty stats if new
+    StatsHandle intern(poker::PlayerId player, std::string_view info_set);
+
+    // Apply counts gathered in a batch, as if each action had been observed
+    void merge_stats(StatsHandle handle, const ActionStats& counts);
+
+    // Player and info set of a handle; number of interned pairs
+    poker::PlayerId handle_player(StatsHandle handle) const { return owners_[handle]; }
+    const poker::InfoSetId& handle_info_set(StatsHandle handle) const { return ids_[handle]; }
+    size_t num_handles() const { return stats_.size(); }
 
     // Observe hand result
     void observe_hand_result(poker::PlayerId player,
@@ -87,18 +132,31 @@ public:
                              bool went_to_showdown,
                              double pot_size);
 
+    // Observe several hand results at once: hands played, of which
+    // showdowns reached, of which won
+    void observe_hand_results(poker::PlayerId player, int hands, int showdowns, int showdown_wins);
+
     // Get action frequencies at info set
     const ActionStats& get_stats(poker::PlayerId player,
                                  const poker::InfoSetId& info_set) const;
+    const ActionStats& get_stats(StatsHandle handle) const { return stats_[handle]; }
 
     // Get player tendency profile
     TendencyProfile get_profile(poker::PlayerId player) const;
 
+    // The profile get_profile reports for raw counts (vpip and pfr as
+    // action counts, showdowns and wins as hand counts) and the player's
+    // bet/raise and check/call totals
+    static TendencyProfile normalize_profile(TendencyProfile counts, int total_bets, int total_calls);
+
     // Predict action distribution
     Eigen::VectorXd predict_action_probs(poker::PlayerId player,
                                          const poker::InfoSetId& info_set,
                                          int num_actions = 2) const;
 
+    // The same from one info set's stats
+    static Eigen::VectorXd predict_from_stats(const ActionStats& stats, int num_actions);
+
     // Check if we have enough data for reliable prediction
     bool has_sufficient_data(poker::PlayerId player,
                             const poker::InfoSetId& info_set,
@@ -120,8 +178,23 @@ public:
     int total_observations(poker::PlayerId player) const;
 
 private:
-    // Stats per player per info set
-    std::map<poker::PlayerId, std::map<poker::InfoSetId, ActionStats>> stats_;
+    // Lookup by string_view without building a std::string
+    struct IdHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+    using HandleMap = std::unordered_map<poker::InfoSetId, StatsHandle, IdHash, std::equal_to<>>;
+
+    // Stats per interned (player, info set), indexed by handle
+    std::deque<ActionStats> stats_;
+    std::vector<poker::PlayerId> owners_;
+    std::vector<poker::InfoSetId> ids_;
+    std::map<poker::PlayerId, HandleMap> handles_;
+    std::map<poker::PlayerId, std::vector<StatsHandle>> player_handles_;
+
+    // INVALID_STATS_HANDLE if the pair was never interned
+    StatsHandle find(poker::PlayerId player, std::string_view info_set) const;
+    void update_profile(StatsHandle handle, poker::Action action);
 
     // Aggregate stats per player
     std::map<poker::PlayerId, TendencyProfile> profiles_;
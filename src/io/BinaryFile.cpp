@@ -0,0 +1,130 @@
+#include "BinaryFile.hpp"
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+namespace quantnet::io {
+
+FileHeader FileHeader::make(const char (&magic)[8], uint32_t version) {
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.byte_order = BYTE_ORDER_MARK;
+    return header;
+}
+
+// ============================================================================
+// BinaryWriter
+// ============================================================================
+
+BinaryWriter::BinaryWriter(const std::string& path, std::string what, bool atomic)
+    : path_(path)
+    , what_(std::move(what))
+    , atomic_(atomic)
+    , written_path_(atomic ? path + ".tmp" : path)
+    , out_(written_path_, std::ios::binary | std::ios::trunc) {
+    if (!out_) {
+        throw std::runtime_error("Cannot write " + what_ + ": " + written_path_);
+    }
+}
+
+void BinaryWriter::header(const char (&magic)[8], uint32_t version) {
+    bytes(magic, sizeof(magic));
+    pod(version);
+    pod(BYTE_ORDER_MARK);
+}
+
+void BinaryWriter::bytes(const void* data, size_t size) {
+    out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+void BinaryWriter::reserve(uint64_t size) {
+    if (size == 0) return;
+    out_.seekp(static_cast<std::streamoff>(size - 1));
+    out_.put('\0');
+}
+
+void BinaryWriter::at(uint64_t offset, const void* data, size_t size) {
+    out_.seekp(static_cast<std::streamoff>(offset));
+    bytes(data, size);
+}
+
+void BinaryWriter::commit() {
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("Failed writing " + what_ + ": " + written_path_);
+    }
+    if (!atomic_) return;
+    std::error_code ec;
+    std::filesystem::rename(written_path_, path_, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot replace " + what_ + " " + path_ + ": " + ec.message());
+    }
+}
+
+// ============================================================================
+// BinaryReader
+// ============================================================================
+
+BinaryReader::BinaryReader(const std::string& path, std::string what)
+    : path_(path)
+    , what_(std::move(what))
+    , in_(path, std::ios::binary) {
+    if (!in_) throw corrupt("cannot open");
+}
+
+std::runtime_error BinaryReader::corrupt(const std::string& reason) const {
+    return std::runtime_error("Invalid " + what_ + " " + path_ + ": " + reason);
+}
+
+void BinaryReader::header(const char (&magic)[8], uint32_t version) {
+    char found[8];
+    in_.read(found, sizeof(found));
+    if (!in_ || std::memcmp(found, magic, sizeof(found)) != 0) throw corrupt("bad magic");
+    uint32_t found_version = 0;
+    uint32_t byte_order = 0;
+    read(found_version);
+    read(byte_order);
+    if (byte_order != BYTE_ORDER_MARK) throw corrupt("wrong byte order");
+    if (found_version != version) throw corrupt("unsupported version " + std::to_string(found_version));
+}
+
+void BinaryReader::bytes(void* data, size_t size) {
+    in_.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (!in_) throw corrupt("truncated");
+}
+
+void BinaryReader::expect_end() {
+    if (in_.peek() != std::ifstream::traits_type::eof()) throw corrupt("trailing data");
+}
+
+// ============================================================================
+// MappedReader
+// ============================================================================
+
+MappedReader::MappedReader(const MappedFile& file, std::string what)
+    : file_(file)
+    , what_(std::move(what)) {}
+
+std::runtime_error MappedReader::corrupt(const std::string& reason) const {
+    return std::runtime_error("Invalid " + what_ + " " + file_.path() + ": " + reason);
+}
+
+void MappedReader::check(const FileHeader& header, const char (&magic)[8], uint32_t version) const {
+    if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0) throw corrupt("bad magic");
+    if (header.byte_order != BYTE_ORDER_MARK) throw corrupt("wrong byte order");
+    if (header.version != version) throw corrupt("unsupported version " + std::to_string(header.version));
+}
+
+void MappedReader::check_size(uint64_t recorded) const {
+    if (recorded != file_.size()) throw corrupt("truncated");
+}
+
+void MappedReader::check_ranges(const uint32_t* offsets, uint64_t n, uint64_t end, const std::string& name) const {
+    for (uint64_t i = 0; i < n; ++i) {
+        if (offsets[i] > offsets[i + 1]) throw corrupt(name + " not in order");
+    }
+    if (offsets[n] != end) throw corrupt("inconsistent " + name);
+}
+
+} // namespace quantnet::io
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MappedFile.hpp"
+
+namespace quantnet::io {
+
+// Shared plumbing of the binary file formats (strategy files, bucket
+// tables, river rank caches, preflop equities and build checkpoints)
+//
+// Every format starts with an 8-byte magic, a uint32 version and a uint32
+// byte order mark written in host byte order, so a file from a machine of
+// the other byte order is rejected instead of misread. Formats read in
+// place (MappedReader) put the rest of their header after these fields and
+// point to 64-byte aligned sections; streamed formats (BinaryReader) follow
+// them with their fields in order.
+//
+// Readers throw std::runtime_error("Invalid <what> <path>: <reason>") on
+// any problem; BinaryWriter throws std::runtime_error naming what and path.
+
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr uint64_t SECTION_ALIGN = 64;
+
+constexpr uint64_t align_up(uint64_t x, uint64_t align = SECTION_ALIGN) {
+    return (x + align - 1) / align * align;
+}
+
+// Leading fields of every header read in place; a format's header struct
+// holds one as its first member
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+
+    static FileHeader make(const char (&magic)[8], uint32_t version);
+};
+
+// Writes a binary file: fields in order after header(), or sections at
+// their offsets after reserve(). With atomic, everything goes to
+// path + ".tmp" and commit() renames it over path, so an interrupted save
+// leaves the previous file intact (checkpoints).
+class BinaryWriter {
+public:
+    // Throws std::runtime_error if the file cannot be created
+    BinaryWriter(const std::string& path, std::string what, bool atomic = false);
+
+    // Magic, version and byte order mark
+    void header(const char (&magic)[8], uint32_t version);
+
+    template <typename T>
+    void pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&value, sizeof(T));
+    }
+
+    void bytes(const void* data, size_t size);
+
+    // Element count (uint64) and the elements
+    template <typename T>
+    void vector(const std::vector<T>& values) {
+        pod(static_cast<uint64_t>(values.size()));
+        bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    // Extend the file to size bytes of zeros, for sections written with at()
+    void reserve(uint64_t size);
+    void at(uint64_t offset, const void* data, size_t size);
+
+    // Throws std::runtime_error if any write failed, or if an atomic file
+    // cannot be moved into place
+    void commit();
+
+private:
+    std::string path_;
+    std::string what_;
+    bool atomic_;
+    std::string written_path_;
+    std::ofstream out_;
+};
+
+// Reads a file written field by field with BinaryWriter
+class BinaryReader {
+public:
+    // Throws if the file cannot be opened
+    BinaryReader(const std::string& path, std::string what);
+
+    std::runtime_error corrupt(const std::string& reason) const;
+
+    // Check the magic, byte order and version
+    void header(const char (&magic)[8], uint32_t version);
+
+    template <typename T>
+    void read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&value, sizeof(T));
+    }
+
+    void bytes(void* data, size_t size);
+
+    // A vector written by BinaryWriter::vector, of at most max_size elements
+    template <typename T>
+    void vector(std::vector<T>& values, uint64_t max_size) {
+        uint64_t size = 0;
+        read(size);
+        if (size > max_size) throw corrupt("section too large");
+        values.resize(size);
+        bytes(values.data(), size * sizeof(T));
+    }
+
+    // Throws unless the whole file has been read
+    void expect_end();
+
+private:
+    std::string path_;
+    std::string what_;
+    std::ifstream in_;
+};
+
+// Validates a mapped file's header and the sections it points to; every
+// count and offset from the file is checked without overflow before use
+class MappedReader {
+public:
+    MappedReader(const MappedFile& file, std::string what);
+
+    std::runtime_error corrupt(const std::string& reason) const;
+
+    // The header at the start of the file, after checking the file holds
+    // one and its magic, byte order and version
+    template <typename Header>
+    const Header& header(const char (&magic)[8], uint32_t version) const {
+        static_assert(std::is_standard_layout_v<Header> && offsetof(Header, file) == 0);
+        if (file_.size() < sizeof(Header)) throw corrupt("too small");
+        check(reinterpret_cast<const Header*>(file_.data())->file, magic, version);
+        return *reinterpret_cast<const Header*>(file_.data());
+    }
+
+    // Throws unless the header's recorded size is the file's
+    void check_size(uint64_t recorded) const;
+
+    // count elements of T at offset: aligned and inside the file
+    template <typename T>
+    const T* section(uint64_t offset, uint64_t count, uint64_t align = SECTION_ALIGN) const {
+        if (offset % align != 0 || offset > file_.size() || count > (file_.size() - offset) / sizeof(T)) {
+            throw corrupt("section out of bounds");
+        }
+        return reinterpret_cast<const T*>(file_.data() + offset);
+    }
+
+    // Range array of n entries: offsets[0..n] non-decreasing and ending at
+    // end, so every range [offsets[i], offsets[i + 1]) lies in [0, end)
+    void check_ranges(const uint32_t* offsets, uint64_t n, uint64_t end, const std::string& name) const;
+
+private:
+    const MappedFile& file_;
+    std::string what_;
+
+    void check(const FileHeader& header, const char (&magic)[8], uint32_t version) const;
+};
+
+} // namespace quantnet::io
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace quantnet::io {
+
+// Read-only memory mapping of a whole file (POSIX mmap)
+//
+// The mapping is shared and page-cache backed: opening is O(1) regardless of
+// file size, pages are faulted in on first touch, and several processes
+// serving the same file share one copy in memory.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    // Map the file; throws std::runtime_error if it cannot be opened or mapped
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const std::byte* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+    bool is_open() const { return data_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    std::string path_;
+
+    void unmap();
+};
+
+} // namespace quantnet::io
@@ -13,6 +13,8 @@
 //   --tol <value>        Convergence tolerance (default: 1e-8)
 //   --max-iters <n>      Max Newton iterations per beta (default: 50)
 //   --output <path>      Output JSON file for visualization (default: viz/solver_output.json)
+//   --save-strategy <path>  Write the final strategy as a binary strategy file
+//   --quantize 8|16      Quantize saved probabilities to 8 or 16 bits
 //   --verbose            Print iteration details
 
 #include <iostream>
@@ -24,9 +26,11 @@
 #include <cmath>
 
 #include "solver/NewtonSolver.hpp"
+#include "solver/Hybrid.hpp"
 #include "poker/KuhnPoker.hpp"
 #include "poker/LeducPoker.hpp"
 #include "poker/Strategy.hpp"
+#include "poker/StrategyFile.hpp"
 #include "poker/QRE.hpp"
 #include "poker/ExpectedValue.hpp"
 #include "network/SimpleTelemetry.hpp"
@@ -41,6 +45,8 @@ struct Args {
     double tol = 1e-8;
     int max_iters = 50;
     std::string output_path = "viz/solver_output.json";
+    std::string strategy_path;  // Empty: don't save
+    poker::ProbFormat strategy_format = poker::ProbFormat::F64;
     bool verbose = false;
 };
 
@@ -58,6 +64,18 @@ Args parse_args(int argc, char* argv[]) {
             args.max_iters = std::stoi(argv[++i]);
         } else if (arg == "--output" && i + 1 < argc) {
             args.output_path = argv[++i];
+        } else if (arg == "--save-strategy" && i + 1 < argc) {
+            args.strategy_path = argv[++i];
+        } else if (arg == "--quantize" && i + 1 < argc) {
+            std::string bits = argv[++i];
+            if (bits == "8") {
+                args.strategy_format = poker::ProbFormat::U8;
+            } else if (bits == "16") {
+                args.strategy_format = poker::ProbFormat::U16;
+            } else {
+                std::cerr << "--quantize takes 8 or 16\n";
+                std::exit(1);
+            }
         } else if (arg == "--verbose") {
             args.verbose = true;
         } else if (arg == "--help" || arg == "-h") {
@@ -69,6 +87,8 @@ Args parse_args(int argc, char* argv[]) {
                       << "  --tol <value>        Convergence tolerance (default: 1e-8)\n"
                       << "  --max-iters <n>      Max Newton iterations per beta (default: 50)\n"
                       << "  --output <path>      JSON file for visualization (default: viz/solver_output.json)\n"
+                      << "  --save-strategy <path>  Write the final strategy as a binary strategy file\n"
+                      << "  --quantize 8|16      Quantize saved probabilities to 8 or 16 bits\n"
                       << "  --verbose            Print iteration details\n"
                       << "  --help               Show this help\n";
             std::exit(0);
@@ -77,26 +97,6 @@ Args parse_args(int argc, char* argv[]) {
     return args;
 }
 
-// Beta continuation schedule: start low, increase to target
-std::vector<double> make_beta_schedule(double target_beta) {
-    std::vector<double> schedule;
-
-    // Start with low beta (near uniform)
-    schedule.push_back(0.01);
-
-    // Geometric progression
-    double beta = 0.05;
-    while (beta < target_beta) {
-        schedule.push_back(beta);
-        beta *= 2.0;
-    }
-
-    // Always include target
-    schedule.push_back(target_beta);
-
-    return schedule;
-}
-
 int main(int argc, char* argv[]) {
     Args args = parse_args(argc, argv);
 
@@ -156,7 +156,7 @@ int main(int argc, char* argv[]) {
     poker::QREResidual qre(*game, 0.01);
 
     // Beta continuation schedule
-    auto beta_schedule = make_beta_schedule(args.target_beta);
+    auto beta_schedule = solver::make_beta_schedule(args.target_beta);
 
     std::cout << "Beta schedule: ";
     for (double b : beta_schedule) {
@@ -255,5 +255,10 @@ int main(int argc, char* argv[]) {
     telemetry.finish(final_exploit, total_iters);
     std::cout << "\nVisualization data written to: " << args.output_path << std::endl;
 
+    if (!args.strategy_path.empty()) {
+        poker::StrategyFile::write(args.strategy_path, final_sigma, index, args.strategy_format);
+        std::cout << "Strategy written to: " << args.strategy_path << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace quantnet::parallel {
+
+// Counter-based random number generator
+//
+// The k-th draw of stream s is a pure function of (seed, s, k): a SplitMix64
+// finalizer applied to a Weyl sequence. Give every Monte Carlo sample its own
+// stream and the samples can be split across any number of threads, in any
+// order, and still reproduce exactly. There is no state to seed or share
+// beyond two integers.
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint64_t stream)
+        : base_(mix(seed + GOLDEN * mix(stream + 1))) {}
+
+    uint64_t next() {
+        return mix(base_ + GOLDEN * ++counter_);
+    }
+
+    // Uniform integer in [0, n)
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+    }
+
+    // Uniform double in [0, 1)
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    static constexpr uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static constexpr uint64_t GOLDEN = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t base_;
+    uint64_t counter_ = 0;
+};
+
+} // namespace quantnet::parallel
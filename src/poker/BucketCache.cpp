@@ -0,0 +1,235 @@
+#include "BucketCache.hpp"
+#include "HandIndexer.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+// One independently locked part of the cache: a fixed array of entries and
+// a linear-probing index over them (power of two, at least twice the
+// entries, so probes stay short and no tombstones are needed)
+struct alignas(64) CachedAbstraction::Shard {
+    mutable std::shared_mutex mutex;
+    uint32_t capacity = 0;
+    uint32_t size = 0;
+    std::vector<uint64_t> keys;
+    std::vector<BucketId> buckets;
+    std::vector<int32_t> index;                     // Entry id, -1 if empty
+    uint64_t mask = 0;
+
+    // LRU: entries in a doubly linked list, most recent first
+    std::vector<int32_t> prev;
+    std::vector<int32_t> next;
+    int32_t head = -1;
+    int32_t tail = -1;
+
+    // CLOCK: reference bits, set by hits under the shared lock
+    std::unique_ptr<std::atomic<uint8_t>[]> referenced;
+    uint32_t hand = 0;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+
+    void init(uint32_t entries, CachePolicy policy) {
+        capacity = entries;
+        keys.resize(entries);
+        buckets.resize(entries);
+        index.assign(std::bit_ceil(uint64_t{2} * entries), -1);
+        mask = index.size() - 1;
+        if (policy == CachePolicy::Lru) {
+            prev.resize(entries);
+            next.resize(entries);
+        } else {
+            referenced = std::make_unique<std::atomic<uint8_t>[]>(entries);
+        }
+    }
+
+    static uint64_t hash(uint64_t key) { return parallel::CounterRng::mix(key); }
+
+    // Index slot holding key, or -1
+    int64_t find(uint64_t key, uint64_t h) const {
+        for (uint64_t p = h & mask;; p = (p + 1) & mask) {
+            if (index[p] < 0) return -1;
+            if (keys[index[p]] == key) return static_cast<int64_t>(p);
+        }
+    }
+
+    void insert_index(uint64_t h, int32_t entry) {
+        uint64_t p = h & mask;
+        while (index[p] >= 0) p = (p + 1) & mask;
+        index[p] = entry;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into
+    // the hole unless that would move them before their home slot
+    void erase_index(uint64_t p) {
+        uint64_t hole = p;
+        for (uint64_t j = (p + 1) & mask; index[j] >= 0; j = (j + 1) & mask) {
+            const uint64_t home = hash(keys[index[j]]) & mask;
+            const bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!stays) {
+                index[hole] = index[j];
+                hole = j;
+            }
+        }
+        index[hole] = -1;
+    }
+
+    void unlink(int32_t e) {
+        if (prev[e] >= 0) next[prev[e]] = next[e]; else head = next[e];
+        if (next[e] >= 0) prev[next[e]] = prev[e]; else tail = prev[e];
+    }
+
+    void push_front(int32_t e) {
+        prev[e] = -1;
+        next[e] = head;
+        if (head >= 0) prev[head] = e; else tail = e;
+        head = e;
+    }
+
+    // Entry to reuse when full
+    int32_t victim(CachePolicy policy) {
+        if (policy == CachePolicy::Lru) {
+            const int32_t e = tail;
+            unlink(e);
+            return e;
+        }
+        while (referenced[hand].load(std::memory_order_relaxed)) {
+            referenced[hand].store(0, std::memory_order_relaxed);
+            hand = (hand + 1) % capacity;
+        }
+        const int32_t e = static_cast<int32_t>(hand);
+        hand = (hand + 1) % capacity;
+        return e;
+    }
+
+    void reset() {
+        size = 0;
+        std::fill(index.begin(), index.end(), -1);
+        head = tail = -1;
+        hand = 0;
+        if (referenced) {
+            for (uint32_t e = 0; e < capacity; ++e) referenced[e].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+CachedAbstraction::CachedAbstraction(std::unique_ptr<CardAbstraction> inner,
+                                     const BucketCacheConfig& config)
+    : inner_(std::move(inner))
+    , policy_(config.policy) {
+    if (!inner_) {
+        throw std::invalid_argument("Bucket cache needs an abstraction to wrap");
+    }
+    if (config.capacity == 0 || config.shards < 1) {
+        throw std::invalid_argument("Bucket cache needs a positive capacity and shard count");
+    }
+
+    const uint64_t shards = std::bit_ceil(static_cast<uint64_t>(config.shards));
+    shard_bits_ = std::countr_zero(shards);
+    const uint64_t per_shard = std::max<uint64_t>(1, (config.capacity + shards - 1) / shards);
+    if (per_shard > (uint64_t{1} << 30)) {
+        throw std::invalid_argument("Bucket cache shards are limited to 2^30 entries");
+    }
+    shards_ = std::make_unique<Shard[]>(shards);
+    for (uint64_t i = 0; i < shards; ++i) shards_[i].init(static_cast<uint32_t>(per_shard), policy_);
+    capacity_ = static_cast<size_t>(per_shard * shards);
+}
+
+CachedAbstraction::~CachedAbstraction() = default;
+
+CachedAbstraction::Shard& CachedAbstraction::shard_for(uint64_t hash) const {
+    // High bits pick the shard, low bits the slot within it
+    return shards_[shard_bits_ == 0 ? 0 : hash >> (64 - shard_bits_)];
+}
+
+BucketId CachedAbstraction::get_bucket(CardSet hole, CardSet board, BettingRound round) const {
+    // Indices of different board sizes overlap, so the key carries both
+    // the board size and the round
+    const uint64_t key = (HoldemIndexer::instance().index(hole, board) << 5) |
+                         (static_cast<uint64_t>(board.size()) << 2) | static_cast<uint64_t>(round);
+    const uint64_t h = Shard::hash(key);
+    Shard& s = shard_for(h);
+
+    if (policy_ == CachePolicy::Clock) {
+        std::shared_lock lock(s.mutex);
+        const int64_t p = s.find(key, h);
+        if (p >= 0) {
+            const int32_t e = s.index[p];
+            s.referenced[e].store(1, std::memory_order_relaxed);
+            s.hits.fetch_add(1, std::memory_order_relaxed);
+            return s.buckets[e];
+        }
+    } else {
+        std::unique_lock lock(s.mutex);
+        const int64_t p = s.find(key, h);
+        if (p >= 0) {
+            const int32_t e = s.index[p];
+            s.unlink(e);
+            s.push_front(e);
+            s.hits.fetch_add(1, std::memory_order_relaxed);
+            return s.buckets[e];
+        }
+    }
+
+    // Miss: compute without holding the lock, then insert unless another
+    // thread got there first
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+    const BucketId bucket = inner_->get_bucket(hole, board, round);
+
+    std::unique_lock lock(s.mutex);
+    if (s.find(key, h) >= 0) return bucket;
+
+    int32_t e = 0;
+    if (s.size < s.capacity) {
+        e = static_cast<int32_t>(s.size++);
+    } else {
+        e = s.victim(policy_);
+        s.erase_index(static_cast<uint64_t>(s.find(s.keys[e], Shard::hash(s.keys[e]))));
+        s.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.keys[e] = key;
+    s.buckets[e] = bucket;
+    s.insert_index(h, e);
+    if (policy_ == CachePolicy::Lru) {
+        s.push_front(e);
+    } else {
+        s.referenced[e].store(0, std::memory_order_relaxed);
+    }
+    return bucket;
+}
+
+BucketCacheStats CachedAbstraction::stats() const {
+    BucketCacheStats stats;
+    stats.capacity = capacity_;
+    for (int i = 0; i < (1 << shard_bits_); ++i) {
+        const Shard& s = shards_[i];
+        stats.hits += s.hits.load(std::memory_order_relaxed);
+        stats.misses += s.misses.load(std::memory_order_relaxed);
+        stats.evictions += s.evictions.load(std::memory_order_relaxed);
+        std::shared_lock lock(s.mutex);
+        stats.size += s.size;
+    }
+    return stats;
+}
+
+void CachedAbstraction::reset_stats() {
+    for (int i = 0; i < (1 << shard_bits_); ++i) {
+        shards_[i].hits.store(0, std::memory_order_relaxed);
+        shards_[i].misses.store(0, std::memory_order_relaxed);
+        shards_[i].evictions.store(0, std::memory_order_relaxed);
+    }
+}
+
+void CachedAbstraction::clear() {
+    for (int i = 0; i < (1 << shard_bits_); ++i) {
+        std::unique_lock lock(shards_[i].mutex);
+        shards_[i].reset();
+    }
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "CardAbstraction.hpp"
+
+namespace quantnet::poker {
+
+enum class CachePolicy {
+    Lru,    // Evict the least recently used entry; a hit reorders the shard's list
+    Clock   // Second chance: a hit only sets a reference bit, under a shared lock
+};
+
+struct BucketCacheConfig {
+    size_t capacity = size_t{1} << 20;   // Entries over all shards
+    int shards = 64;                     // Rounded up to a power of two
+    CachePolicy policy = CachePolicy::Clock;
+};
+
+struct BucketCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+
+    double hit_rate() const {
+        const uint64_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+// Bounded bucket cache in front of another abstraction
+//
+// Without a precomputed table (see TableAbstraction), every get_bucket of
+// Percentile or EHS recomputes hand strength or potential, even though a
+// solver asks about the same hands over and over. This decorator memoizes
+// buckets keyed by (round, HoldemIndexer index), so all suit-isomorphic
+// deals share one entry; the wrapped abstraction must therefore give
+// isomorphic hands the same bucket, as all of ours do.
+//
+// Entries live in independently locked shards picked by a hash of the key,
+// each a fixed slot array with an open-addressing index, so lookups do not
+// allocate and threads rarely meet on a lock. A miss computes the bucket
+// outside the lock and then inserts it, evicting by LRU or CLOCK when the
+// shard is full. Safe to share across solver threads.
+class CachedAbstraction : public CardAbstraction {
+public:
+    // Throws std::invalid_argument if inner is null or capacity or shards
+    // is not positive
+    explicit CachedAbstraction(std::unique_ptr<CardAbstraction> inner,
+                               const BucketCacheConfig& config = {});
+    ~CachedAbstraction() override;
+
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
+                        BettingRound round) const override;
+
+    int num_buckets(BettingRound round) const override { return inner_->num_buckets(round); }
+    int total_buckets() const override { return inner_->total_buckets(); }
+    using CardAbstraction::compute_features;
+    HandFeatures compute_features(CardSet hole, CardSet board) const override {
+        return inner_->compute_features(hole, board);
+    }
+    std::string name() const override { return "Cached(" + inner_->name() + ")"; }
+
+    const CardAbstraction& inner() const { return *inner_; }
+
+    // Counters summed over shards (each read is relaxed, so a snapshot taken
+    // while other threads run is approximate)
+    BucketCacheStats stats() const;
+    void reset_stats();
+
+    // Drop every entry
+    void clear();
+
+private:
+    struct Shard;
+
+    std::unique_ptr<CardAbstraction> inner_;
+    CachePolicy policy_;
+    int shard_bits_ = 0;
+    std::unique_ptr<Shard[]> shards_;
+    size_t capacity_ = 0;
+
+    Shard& shard_for(uint64_t hash) const;
+};
+
+} // namespace quantnet::poker
@@ -0,0 +1,288 @@
+#include "BucketTable.hpp"
+#include "HandIndexer.hpp"
+#include "../io/BinaryFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'N', 'B', 'U', 'C', 'K', 'T', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr int NUM_ROUNDS = 4;
+constexpr size_t SOURCE_CHARS = 32;
+
+struct BucketTableHeader {
+    io::FileHeader file;
+    char source[SOURCE_CHARS];              // Name of the abstraction, NUL-padded
+    uint32_t num_buckets[NUM_ROUNDS];
+    uint64_t entries[NUM_ROUNDS];           // 0 if the round is not stored
+    uint64_t offsets[NUM_ROUNDS];
+    uint64_t file_size;
+};
+
+int board_cards(BettingRound round) {
+    return round == BettingRound::Preflop ? 0 : 2 + static_cast<int>(round);
+}
+
+constexpr char CHECKPOINT_MAGIC[8] = {'Q', 'N', 'B', 'U', 'C', 'K', 'C', 'P'};
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+// Resumable state of a table build
+struct TableCheckpoint {
+    char source[SOURCE_CHARS] = {};
+    std::array<uint32_t, NUM_ROUNDS> num_buckets{};
+    std::array<uint64_t, NUM_ROUNDS> next_board{};              // Canonical boards done
+    std::array<std::vector<uint16_t>, NUM_ROUNDS> tables;       // Empty until started
+
+    bool same_source(const TableCheckpoint& other) const {
+        return std::memcmp(source, other.source, SOURCE_CHARS) == 0 && num_buckets == other.num_buckets;
+    }
+};
+
+// Atomic, so an interrupted save leaves the previous checkpoint intact
+void save_checkpoint(const std::string& path, const TableCheckpoint& state) {
+    io::BinaryWriter out(path, "checkpoint", true);
+    out.header(CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    out.pod(state.source);
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        out.pod(state.num_buckets[r]);
+        out.pod(state.next_board[r]);
+        out.vector(state.tables[r]);
+    }
+    out.commit();
+}
+
+// Returns false if path does not exist
+bool load_checkpoint(const std::string& path, TableCheckpoint& out) {
+    if (!std::filesystem::exists(path)) return false;
+
+    io::BinaryReader in(path, "table checkpoint");
+    in.header(CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    TableCheckpoint ck;
+    in.read(ck.source);
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        in.read(ck.num_buckets[r]);
+        in.read(ck.next_board[r]);
+        const int n = board_cards(static_cast<BettingRound>(r));
+        const uint64_t entries = HoldemIndexer::instance().size(n);
+        in.vector(ck.tables[r], entries);
+        if (!ck.tables[r].empty() && ck.tables[r].size() != entries) throw in.corrupt("wrong entry count");
+        if (ck.next_board[r] > (n == 0 ? 1 : HandIndexer({n}).size(0))) throw in.corrupt("board out of range");
+    }
+    in.expect_end();
+
+    out = std::move(ck);
+    return true;
+}
+
+// Buckets of the canonical boards [begin, end) of a postflop round. Every
+// index is reached from the canonical board of its class; hands sharing an
+// index on one board are isomorphic and get one bucket.
+void fill_boards(const CardAbstraction& source, BettingRound round, const HandIndexer& boards,
+                 int64_t begin, int64_t end, std::vector<uint16_t>& table) {
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (int64_t b = begin; b < end; ++b) {
+        const CardSet board = boards.unindex(0, static_cast<uint64_t>(b))[0];
+        std::array<BucketId, NUM_HOLE_COMBOS> buckets{};
+        source.get_buckets(board, round, buckets);
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            const CardSet hole = CardSet::of(hole_combos()[i]);
+            if (!hole.intersects(board)) table[indexer.index(hole, board)] = buckets[i];
+        }
+    }
+}
+
+// Header and sections of a finished table
+void write_file(const std::string& path, const TableCheckpoint& state) {
+    BucketTableHeader header{};
+    header.file = io::FileHeader::make(MAGIC, VERSION);
+    std::memcpy(header.source, state.source, SOURCE_CHARS);
+
+    uint64_t pos = io::align_up(sizeof(BucketTableHeader));
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        header.num_buckets[r] = state.num_buckets[r];
+        header.entries[r] = state.tables[r].size();
+        if (state.tables[r].empty()) continue;
+        header.offsets[r] = pos;
+        pos = io::align_up(pos + state.tables[r].size() * sizeof(uint16_t));
+    }
+    header.file_size = pos;
+
+    // Zero-filled file of the final size, then each section in place
+    io::BinaryWriter out(path, "bucket table");
+    out.reserve(header.file_size);
+    out.at(0, &header, sizeof(header));
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        if (!state.tables[r].empty()) {
+            out.at(header.offsets[r], state.tables[r].data(), state.tables[r].size() * sizeof(uint16_t));
+        }
+    }
+    out.commit();
+}
+
+} // namespace
+
+void TableAbstraction::write(const std::string& path, const CardAbstraction& source,
+                             const std::vector<BettingRound>& rounds) {
+    TableBuildConfig config;
+    config.rounds = rounds;
+    write(path, source, config);
+}
+
+bool TableAbstraction::write(const std::string& path, const CardAbstraction& source,
+                             const TableBuildConfig& config) {
+    using Clock = std::chrono::steady_clock;
+    if (config.boards_per_chunk == 0) {
+        throw std::invalid_argument("Table builds need at least one board per chunk");
+    }
+
+    TableCheckpoint state;
+    const std::string name = source.name();
+    std::memcpy(state.source, name.data(), std::min(name.size(), SOURCE_CHARS - 1));
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        state.num_buckets[r] = static_cast<uint32_t>(source.num_buckets(static_cast<BettingRound>(r)));
+    }
+    for (BettingRound round : config.rounds) {
+        if (source.num_buckets(round) < 1 || source.num_buckets(round) > 0xFFFF) {
+            throw std::invalid_argument("Bucket tables hold 1-65535 buckets per round");
+        }
+    }
+
+    const bool checkpointing = !config.checkpoint_path.empty();
+    if (checkpointing) {
+        TableCheckpoint saved;
+        if (load_checkpoint(config.checkpoint_path, saved)) {
+            if (!saved.same_source(state)) {
+                throw std::runtime_error("Checkpoint " + config.checkpoint_path +
+                                         " was written for a different abstraction");
+            }
+            state = std::move(saved);
+        }
+    }
+
+    // Canonical boards and hands per board of each requested round
+    std::array<std::unique_ptr<HandIndexer>, NUM_ROUNDS> boards;
+    std::array<uint64_t, NUM_ROUNDS> num_boards{};
+    std::array<uint64_t, NUM_ROUNDS> hands_per_board{};
+    TableBuildProgress progress;
+    for (BettingRound round : config.rounds) {
+        const int r = static_cast<int>(round);
+        const int n = board_cards(round);
+        if (boards[r] || num_boards[r] != 0) continue;
+        if (n == 0) {
+            num_boards[r] = 1;
+            hands_per_board[r] = HoldemIndexer::instance().size(0);
+        } else {
+            boards[r] = std::make_unique<HandIndexer>(std::vector<int>{n});
+            num_boards[r] = boards[r]->size(0);
+            hands_per_board[r] = static_cast<uint64_t>(DECK_SIZE - n) * (DECK_SIZE - n - 1) / 2;
+        }
+        progress.hands_total += num_boards[r] * hands_per_board[r];
+        progress.hands_resumed += state.next_board[r] * hands_per_board[r];
+    }
+    progress.hands_done = progress.hands_resumed;
+
+    const auto start = Clock::now();
+    auto last_save = start;
+    auto save = [&](bool force) {
+        if (!checkpointing) return;
+        const double elapsed = std::chrono::duration<double>(Clock::now() - last_save).count();
+        if (!force && elapsed < config.checkpoint_seconds) return;
+        save_checkpoint(config.checkpoint_path, state);
+        last_save = Clock::now();
+    };
+    auto report = [&]() {
+        progress.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (!config.progress || config.progress(progress)) return true;
+        save(true);
+        return false;
+    };
+
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    for (BettingRound round : config.rounds) {
+        const int r = static_cast<int>(round);
+        std::vector<uint16_t>& table = state.tables[r];
+        if (state.next_board[r] == num_boards[r]) continue;
+        if (table.empty()) table.assign(indexer.size(board_cards(round)), 0);
+
+        progress.round = round;
+        progress.boards_total = num_boards[r];
+        while (state.next_board[r] < num_boards[r]) {
+            const uint64_t begin = state.next_board[r];
+            const uint64_t end = std::min(num_boards[r], begin + config.boards_per_chunk);
+            if (!boards[r]) {
+                for (uint64_t i = 0; i < table.size(); ++i) {
+                    const auto [hole, board] = indexer.unindex(0, i);
+                    table[i] = source.get_bucket(hole, board, round);
+                }
+            } else {
+                fill_boards(source, round, *boards[r], static_cast<int64_t>(begin), static_cast<int64_t>(end), table);
+            }
+            state.next_board[r] = end;
+            progress.boards_done = end;
+            progress.hands_done += (end - begin) * hands_per_board[r];
+            save(false);
+            if (!report()) return false;
+        }
+        save(true);
+    }
+
+    // Rounds not requested (or left in the checkpoint by another run) stay
+    // out of the file
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        if (num_boards[r] == 0) state.tables[r].clear();
+    }
+    write_file(path, state);
+    if (checkpointing) {
+        std::error_code ec;
+        std::filesystem::remove(config.checkpoint_path, ec);
+    }
+    return true;
+}
+
+TableAbstraction::TableAbstraction(const std::string& path) : file_(path) {
+    const io::MappedReader reader(file_, "bucket table");
+    const auto& header = reader.header<BucketTableHeader>(MAGIC, VERSION);
+    reader.check_size(header.file_size);
+
+    source_.assign(header.source, strnlen(header.source, SOURCE_CHARS));
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    for (int r = 0; r < NUM_ROUNDS; ++r) {
+        num_buckets_[r] = static_cast<int>(header.num_buckets[r]);
+        if (header.entries[r] == 0) continue;
+        if (header.entries[r] != indexer.size(board_cards(static_cast<BettingRound>(r)))) {
+            throw reader.corrupt("wrong entry count");
+        }
+        tables_[r] = reader.section<uint16_t>(header.offsets[r], header.entries[r]);
+    }
+}
+
+BucketId TableAbstraction::get_bucket(CardSet hole, CardSet board, BettingRound round) const {
+    const uint16_t* table = tables_[static_cast<int>(round)];
+    if (!table) {
+        throw std::invalid_argument("Bucket table has no " + round_to_string(round) + " section");
+    }
+    if (board.size() != board_cards(round)) {
+        throw std::invalid_argument("Board size does not match the " + round_to_string(round));
+    }
+    return table[HoldemIndexer::instance().index(hole, board)];
+}
+
+int TableAbstraction::num_buckets(BettingRound round) const {
+    return num_buckets_[static_cast<int>(round)];
+}
+
+int TableAbstraction::total_buckets() const {
+    return num_buckets_[0] + num_buckets_[1] + num_buckets_[2] + num_buckets_[3];
+}
+
+} // namespace quantnet::poker
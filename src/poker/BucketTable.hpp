@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "CardAbstraction.hpp"
+#include "../io/MappedFile.hpp"
+
+namespace quantnet::poker {
+
+// Progress of TableAbstraction::write, reported after every chunk of boards.
+// Hands are (hole, board) pairs evaluated: one per preflop class and one per
+// live combo on each canonical board.
+struct TableBuildProgress {
+    BettingRound round = BettingRound::Preflop;
+    uint64_t boards_done = 0;        // Canonical boards of this round done
+    uint64_t boards_total = 0;
+    uint64_t hands_done = 0;         // All requested rounds, resumed work included
+    uint64_t hands_resumed = 0;      // Done before this run, from the checkpoint
+    uint64_t hands_total = 0;
+    double seconds = 0.0;            // Since this run started
+};
+
+// Return false to stop the build; the checkpoint is written first
+using TableBuildCallback = std::function<bool(const TableBuildProgress&)>;
+
+struct TableBuildConfig {
+    std::vector<BettingRound> rounds = {BettingRound::Preflop, BettingRound::Flop,
+                                        BettingRound::Turn, BettingRound::River};
+    uint64_t boards_per_chunk = 1024;
+
+    // Empty: no checkpointing. Otherwise a build resumes from this file if
+    // it exists and saves to it at most every checkpoint_seconds, when a
+    // round completes and when stopped. It is removed once the table is
+    // written.
+    std::string checkpoint_path;
+    double checkpoint_seconds = 60.0;
+
+    TableBuildCallback progress;
+};
+
+// Precomputed bucket table, memory-mapped
+//
+// Abstractions like Percentile and EHS compute hand strength (and EHS hand
+// potential) inside every get_bucket call, which costs microseconds to
+// milliseconds on the solver's hot path. write() evaluates an abstraction
+// once for every suit-isomorphic hand of each round and stores the buckets
+// as flat uint16 arrays indexed by HoldemIndexer:
+//
+//   header        BucketTableHeader (magic, version, source name, bucket
+//                 counts, entries and offset per round)
+//   preflop       uint16[169]
+//   flop          uint16[1,286,792]
+//   turn          uint16[13,960,050]
+//   river         uint16[123,156,254]     (about 276 MB in all)
+//
+// Sections are 64-byte aligned; a round left out of write() has no section.
+// Opening maps the file read-only and validates the header, in O(1); the
+// page cache is shared, so any number of solver processes can serve one
+// table. get_bucket is a HoldemIndexer lookup and one array load.
+class TableAbstraction : public CardAbstraction {
+public:
+    // Evaluate source for every canonical hand of the given rounds and write
+    // the table. Postflop rounds run over canonical boards in parallel, with
+    // one get_buckets call per board, so source must be safe to query from
+    // several threads. Throws std::runtime_error if the file cannot be
+    // written and std::invalid_argument if a bucket count exceeds 65535.
+    static void write(const std::string& path, const CardAbstraction& source,
+                      const std::vector<BettingRound>& rounds = {BettingRound::Preflop, BettingRound::Flop,
+                                                                 BettingRound::Turn, BettingRound::River});
+
+    // Same with full control; returns false, without writing path, if
+    // progress stopped the build. Boards are evaluated in chunks of
+    // boards_per_chunk, each spread over threads, and only completed chunks
+    // are checkpointed. Also throws std::invalid_argument if
+    // boards_per_chunk is 0, and std::runtime_error if the checkpoint is
+    // unreadable or was written for another abstraction (name or bucket
+    // counts).
+    static bool write(const std::string& path, const CardAbstraction& source, const TableBuildConfig& config);
+
+    // Map and validate a table file; throws std::runtime_error if it cannot
+    // be mapped or is not a valid bucket table
+    explicit TableAbstraction(const std::string& path);
+
+    // Throws std::invalid_argument if the round is not in the table, the
+    // board size does not match the round, or the cards are malformed
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
+                        BettingRound round) const override;
+
+    int num_buckets(BettingRound round) const override;
+    int total_buckets() const override;
+    std::string name() const override { return "Table(" + source_ + ")"; }
+
+    bool has_round(BettingRound round) const { return tables_[static_cast<int>(round)] != nullptr; }
+    size_t file_size() const { return file_.size(); }
+
+private:
+    io::MappedFile file_;
+    std::string source_;
+    std::array<int, 4> num_buckets_{};
+    std::array<const uint16_t*, 4> tables_{};
+};
+
+} // namespace quantnet::poker
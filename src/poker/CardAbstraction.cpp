@@ -1,17 +1,34 @@
 #include "CardAbstraction.hpp"
+#include "BucketCache.hpp"
+#include "BucketTable.hpp"
+#include "../parallel/CounterRng.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <numeric>
 #include <set>
+#include <stdexcept>
 
 namespace quantnet::poker {
 
+namespace {
+
+// Equity rank of the hand's class, spread evenly over the preflop buckets;
+// bucket 0 holds AA
+BucketId preflop_rank_bucket(const PreflopEquity& equity, CardSet hole, int num_buckets) {
+    int cards[2];
+    hole.to_cards(cards);
+    const int rank = equity.combo_rank(hole_combo_index(cards[0], cards[1]));
+    return static_cast<BucketId>(rank * num_buckets / PreflopEquity::NUM_CLASSES);
+}
+
+} // namespace
+
 // ============================================================================
 // CardAbstraction base class
 // ============================================================================
 
-HandFeatures CardAbstraction::compute_features(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board) const {
+HandFeatures CardAbstraction::compute_features(CardSet hole, CardSet board) const {
 
     HandFeatures features;
 
@@ -28,18 +45,29 @@ HandFeatures CardAbstraction::compute_features(
     return features;
 }
 
+void CardAbstraction::get_buckets(CardSet board, BettingRound round,
+                                  std::span<BucketId, NUM_HOLE_COMBOS> out) const {
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const CardSet hole = CardSet::of(hole_combos()[i]);
+        if (!hole.intersects(board)) out[i] = get_bucket(hole, board, round);
+    }
+}
+
 // ============================================================================
 // NullAbstraction
 // ============================================================================
 
 BucketId NullAbstraction::get_bucket(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board,
+    CardSet hole,
+    CardSet board,
     BettingRound /*round*/) const {
 
-    // Simple hash based on cards
+    // Simple hash based on cards (in ascending order)
     // This doesn't actually reduce state space much
-    int h = (hole[0] * 52 + hole[1]) % 10000;
+    int h = 0;
+    for (int c : hole) {
+        h = (h * 52 + c) % 10000;
+    }
     for (int c : board) {
         h = (h * 52 + c) % 10000;
     }
@@ -59,103 +87,46 @@ int NullAbstraction::total_buckets() const {
 // ============================================================================
 
 PercentileAbstraction::PercentileAbstraction(int preflop, int flop, int turn, int river)
+    : PercentileAbstraction(preflop, flop, turn, river, nullptr) {}
+
+PercentileAbstraction::PercentileAbstraction(int preflop, int flop, int turn, int river,
+                                             std::shared_ptr<const PreflopEquity> preflop_equity)
     : preflop_buckets_(preflop)
     , flop_buckets_(flop)
     , turn_buckets_(turn)
-    , river_buckets_(river) {
-    initialize_preflop_rankings();
-}
-
-void PercentileAbstraction::initialize_preflop_rankings() {
-    // Pre-computed preflop hand rankings based on equity
-    // Rankings are 0-168 where 0 is strongest (AA) and 168 is weakest
-
-    // For simplicity, we use a basic ranking based on:
-    // 1. Pairs (higher is better)
-    // 2. Suited/unsuited connectors
-    // 3. High cards
-
-    // This is a simplified version - real implementations use
-    // Monte Carlo simulations to compute exact rankings
+    , river_buckets_(river)
+    , preflop_equity_(std::move(preflop_equity)) {}
 
-    std::vector<std::pair<int, double>> hand_scores;
-
-    // Enumerate all 169 canonical hands
-    // Hand ID encoding: high_rank * 14 + low_rank + (suited ? 169 : 0) mapped to [0, 168]
-
-    int hand_id = 0;
-    // Pairs
-    for (int r = 12; r >= 0; --r) {
-        double score = 100.0 + r * 10;  // Pairs score high
-        preflop_rankings_[r * 13 + r] = hand_id++;  // Pair encoding
-    }
+BucketId PercentileAbstraction::get_bucket(
+    CardSet hole,
+    CardSet board,
+    BettingRound round) const {
 
-    // Suited hands (non-pairs), sorted by strength estimate
-    std::vector<std::pair<double, std::pair<int, int>>> suited_hands;
-    for (int r1 = 12; r1 >= 0; --r1) {
-        for (int r2 = r1 - 1; r2 >= 0; --r2) {
-            // Score based on high card + connectivity
-            double score = r1 * 5 + r2 * 2 + ((r1 - r2 <= 4) ? 10 : 0) + 5;
-            suited_hands.push_back({score, {r1, r2}});
-        }
-    }
-    std::sort(suited_hands.rbegin(), suited_hands.rend());
-    for (const auto& [score, hand] : suited_hands) {
-        preflop_rankings_[hand.first * 100 + hand.second + 1000] = hand_id++;
+    if (round == BettingRound::Preflop) {
+        const PreflopEquity& equity = preflop_equity_ ? *preflop_equity_ : PreflopEquity::standard();
+        return preflop_rank_bucket(equity, hole, preflop_buckets_);
     }
 
-    // Unsuited hands (non-pairs)
-    std::vector<std::pair<double, std::pair<int, int>>> unsuited_hands;
-    for (int r1 = 12; r1 >= 0; --r1) {
-        for (int r2 = r1 - 1; r2 >= 0; --r2) {
-            double score = r1 * 5 + r2 * 2 + ((r1 - r2 <= 4) ? 5 : 0);
-            unsuited_hands.push_back({score, {r1, r2}});
-        }
-    }
-    std::sort(unsuited_hands.rbegin(), unsuited_hands.rend());
-    for (const auto& [score, hand] : unsuited_hands) {
-        preflop_rankings_[hand.first * 100 + hand.second] = hand_id++;
-    }
+    // Post-flop: use hand strength
+    return strength_bucket(HandEvaluator::hand_strength(hole, board), round);
 }
 
-int PercentileAbstraction::get_preflop_hand_id(int card1, int card2) const {
-    int r1 = card_rank(card1);
-    int r2 = card_rank(card2);
-    int s1 = card_suit(card1);
-    int s2 = card_suit(card2);
-
-    int high = std::max(r1, r2);
-    int low = std::min(r1, r2);
-    bool suited = (s1 == s2);
+void PercentileAbstraction::get_buckets(
+    CardSet board,
+    BettingRound round,
+    std::span<BucketId, NUM_HOLE_COMBOS> out) const {
 
-    if (high == low) {
-        // Pair
-        return high * 13 + low;
-    } else if (suited) {
-        return high * 100 + low + 1000;
-    } else {
-        return high * 100 + low;
+    if (round == BettingRound::Preflop || board.size() < 3) {
+        CardAbstraction::get_buckets(board, round, out);
+        return;
     }
-}
-
-BucketId PercentileAbstraction::get_bucket(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board,
-    BettingRound round) const {
-
-    if (round == BettingRound::Preflop) {
-        // Use preflop rankings
-        int hand_id = get_preflop_hand_id(hole[0], hole[1]);
-        auto it = preflop_rankings_.find(hand_id);
-        if (it != preflop_rankings_.end()) {
-            // Map rank to bucket
-            int rank = it->second;
-            return static_cast<BucketId>(rank * preflop_buckets_ / 169);
-        }
-        return 0;
+    const auto strengths = HandEvaluator::hand_strengths(board);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        if (strengths[i] >= 0.0) out[i] = strength_bucket(strengths[i], round);
     }
+}
 
-    // Post-flop: use hand strength
+BucketId PercentileAbstraction::strength_bucket(double hs, BettingRound round) const {
     int num_buckets = 0;
     switch (round) {
         case BettingRound::Flop: num_buckets = flop_buckets_; break;
@@ -164,7 +135,6 @@ BucketId PercentileAbstraction::get_bucket(
         default: num_buckets = flop_buckets_;
     }
 
-    double hs = HandEvaluator::hand_strength(hole, board);
     int bucket = static_cast<int>(hs * num_buckets);
     if (bucket >= num_buckets) bucket = num_buckets - 1;
     if (bucket < 0) bucket = 0;
@@ -204,8 +174,8 @@ BucketId EHSAbstraction::discretize(double ehs, int num_buckets) const {
 }
 
 BucketId EHSAbstraction::get_bucket(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board,
+    CardSet hole,
+    CardSet board,
     BettingRound round) const {
 
     HandFeatures features = compute_features(hole, board);
@@ -246,44 +216,19 @@ EMDAbstraction::EMDAbstraction(int preflop, int flop, int turn, int river)
     , turn_buckets_(turn)
     , river_buckets_(river) {}
 
-std::string EMDAbstraction::canonicalize(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board) const {
-
-    // Create canonical string representation
-    // Sort cards within each category
-    std::vector<int> sorted_hole = {hole[0], hole[1]};
-    std::sort(sorted_hole.begin(), sorted_hole.end());
-
-    std::vector<int> sorted_board = board;
-    std::sort(sorted_board.begin(), sorted_board.end());
-
-    std::string result;
-    for (int c : sorted_hole) result += card_to_string(c) + ":";
-    for (int c : sorted_board) result += card_to_string(c) + ":";
-
-    return result;
-}
-
 BucketId EMDAbstraction::get_bucket(
-    const std::array<int, 2>& hole,
-    const std::vector<int>& board,
+    CardSet hole,
+    CardSet board,
     BettingRound round) const {
 
-    // For preflop, use simple ranking
     if (round == BettingRound::Preflop) {
-        // Use hand strength as proxy
-        double hs = HandEvaluator::hand_strength(hole, {});
-        int bucket = static_cast<int>(hs * preflop_buckets_);
-        if (bucket >= preflop_buckets_) bucket = preflop_buckets_ - 1;
-        return static_cast<BucketId>(bucket);
+        return preflop_rank_bucket(PreflopEquity::standard(), hole, preflop_buckets_);
     }
 
     // Check pre-computed clusters
-    std::string key = canonicalize(hole, board);
     int num_buckets = 0;
 
-    const std::map<std::string, BucketId>* clusters = nullptr;
+    const std::vector<BucketId>* clusters = nullptr;
     switch (round) {
         case BettingRound::Flop:
             clusters = &flop_clusters_;
@@ -301,11 +246,8 @@ BucketId EMDAbstraction::get_bucket(
             return 0;
     }
 
-    if (clusters) {
-        auto it = clusters->find(key);
-        if (it != clusters->end()) {
-            return it->second;
-        }
+    if (clusters && !clusters->empty()) {
+        return (*clusters)[canonicalize(hole, board)];
     }
 
     // Fallback to hand strength if no pre-computed bucket
@@ -315,15 +257,231 @@ BucketId EMDAbstraction::get_bucket(
     return static_cast<BucketId>(bucket);
 }
 
-void EMDAbstraction::build_clusters(int /*samples_per_hand*/) {
-    // Full EMD clustering is expensive
-    // This is a placeholder - real implementation would:
-    // 1. For each possible hand+board combo, compute equity distribution
-    // 2. Use k-means or hierarchical clustering with EMD distance
-    // 3. Store cluster assignments
+void EMDAbstraction::build_clusters(int samples_per_hand) {
+    EMDBuildConfig config;
+    config.samples_per_hand = samples_per_hand;
+    build_clusters(config);
+}
 
-    // For now, we skip pre-computation and fall back to hand strength
-    // A real implementation would take hours to compute
+const std::vector<BucketId>& EMDAbstraction::clusters(BettingRound round) const {
+    switch (round) {
+        case BettingRound::Flop: return flop_clusters_;
+        case BettingRound::Turn: return turn_clusters_;
+        case BettingRound::River: return river_clusters_;
+        default: break;
+    }
+    throw std::invalid_argument("EMD clusters exist for postflop rounds only");
+}
+
+namespace {
+
+// One postflop round of a clustered abstraction: its bucket count, the
+// size of a hand's feature vector, how to compute the features of every
+// hand on a board (at out[hole_combo_index * dims], from random stream
+// `stream`), and the table to fill
+struct ClusteredRound {
+    int buckets = 0;
+    int dims = 0;
+    std::function<void(CardSet board, uint64_t stream, std::span<float> out)> features;
+    std::vector<BucketId>* table = nullptr;
+};
+
+// Build pipeline shared by EMDAbstraction and OCHSAbstraction (described
+// at EMDAbstraction). state carries the settings; a checkpoint with the
+// same ones replaces it.
+bool cluster_rounds(const EMDBuildConfig& config, EMDCheckpoint state,
+                    const std::array<ClusteredRound, 3>& rounds) {
+    using Clock = std::chrono::steady_clock;
+    using Stage = EMDCheckpoint::Stage;
+
+    const bool checkpointing = !config.checkpoint_path.empty();
+    if (checkpointing) {
+        EMDCheckpoint saved;
+        if (EMDCheckpoint::load(config.checkpoint_path, saved)) {
+            if (!saved.same_settings(state)) {
+                throw std::runtime_error("Checkpoint " + config.checkpoint_path +
+                                         " was written with different settings");
+            }
+            state = std::move(saved);
+        }
+    }
+
+    auto last_save = Clock::now();
+    auto save = [&](bool force) {
+        if (!checkpointing) return;
+        const double elapsed = std::chrono::duration<double>(Clock::now() - last_save).count();
+        if (!force && elapsed < config.checkpoint_seconds) return;
+        state.save(config.checkpoint_path);
+        last_save = Clock::now();
+    };
+    auto report = [&](const EMDBuildProgress& progress) {
+        if (!config.progress || config.progress(progress)) return true;
+        save(true);
+        return false;
+    };
+
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    for (BettingRound round : config.rounds) {
+        const int r = static_cast<int>(round) - 1;
+        const int board_cards = 2 + static_cast<int>(round);
+        EMDCheckpoint::Round& rs = state.rounds[r];
+        std::vector<BucketId>& table = *rounds[r].table;
+        if (rs.stage == Stage::Done) {
+            table = rs.table;
+            continue;
+        }
+
+        const HandIndexer board_indexer({board_cards});
+        const uint64_t num_boards = board_indexer.size(0);
+        const int holes_per_board = (DECK_SIZE - board_cards) * (DECK_SIZE - board_cards - 1) / 2;
+        const int k = rounds[r].buckets;
+        const int dims = rounds[r].dims;
+        auto board_at = [&](uint64_t b) { return board_indexer.unindex(0, b)[0]; };
+        auto features = [&](CardSet board, uint64_t b, std::vector<float>& out) {
+            rounds[r].features(board, (static_cast<uint64_t>(r) << 32) | b, out);
+        };
+
+        EMDBuildProgress progress;
+        progress.round = round;
+        progress.boards_total = num_boards;
+
+        if (rs.stage == Stage::Pending || rs.stage == Stage::Clustering) {
+            // Training set: every live hand on a seeded sample of boards
+            uint64_t wanted = std::max<uint64_t>(config.max_training_points, static_cast<uint64_t>(k));
+            uint64_t num_training = std::min<uint64_t>(num_boards, (wanted + holes_per_board - 1) / holes_per_board);
+            std::vector<uint64_t> boards(num_boards);
+            std::iota(boards.begin(), boards.end(), 0);
+            parallel::CounterRng rng(config.seed, 0xB0A2D000u + r);
+            for (uint64_t i = 0; i < num_training; ++i) {
+                std::swap(boards[i], boards[i + rng.next() % (num_boards - i)]);
+            }
+            boards.resize(num_training);
+            std::sort(boards.begin(), boards.end());
+
+            std::vector<float> points(num_training * holes_per_board * dims);
+            const int64_t nt = static_cast<int64_t>(num_training);
+#ifdef _OPENMP
+            #pragma omp parallel
+#endif
+            {
+                std::vector<float> hand_features(static_cast<size_t>(NUM_HOLE_COMBOS) * dims);
+#ifdef _OPENMP
+                #pragma omp for schedule(dynamic, 1)
+#endif
+                for (int64_t t = 0; t < nt; ++t) {
+                    const CardSet board = board_at(boards[t]);
+                    features(board, boards[t], hand_features);
+                    float* dst = points.data() + static_cast<size_t>(t) * holes_per_board * dims;
+                    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+                        if (CardSet::of(hole_combos()[i]).intersects(board)) continue;
+                        const float* x = hand_features.data() + static_cast<size_t>(i) * dims;
+                        dst = std::copy(x, x + dims, dst);
+                    }
+                }
+            }
+
+            if (rs.stage == Stage::Pending) {
+                rs.centroids = kmeans_plus_plus(points, dims, k, config.seed + r);
+                rs.iteration = 0;
+                rs.stage = Stage::Clustering;
+                save(false);
+            }
+
+            HamerlyKMeans kmeans(points, dims, rs.centroids);
+            while (rs.iteration < static_cast<uint32_t>(config.max_iterations)) {
+                const uint64_t changed = kmeans.step();
+                ++rs.iteration;
+                rs.centroids = kmeans.centroids();
+                save(false);
+
+                progress.iteration = static_cast<int>(rs.iteration);
+                progress.changed = changed;
+                if (!report(progress)) return false;
+                if (changed == 0) break;
+            }
+
+            rs.stage = Stage::Assigning;
+            rs.next_board = 0;
+            rs.table.assign(indexer.size(board_cards), 0);
+            save(false);
+        }
+
+        // Assign every canonical board, in chunks so a stop loses little
+        const NearestCentroid nearest(rs.centroids, dims);
+        const uint64_t chunk = std::max<uint64_t>(1, num_boards / 64);
+        progress.assigning = true;
+        progress.iteration = static_cast<int>(rs.iteration);
+        while (rs.next_board < num_boards) {
+            const int64_t begin = static_cast<int64_t>(rs.next_board);
+            const int64_t end = static_cast<int64_t>(std::min(num_boards, rs.next_board + chunk));
+#ifdef _OPENMP
+            #pragma omp parallel
+#endif
+            {
+                std::vector<float> hand_features(static_cast<size_t>(NUM_HOLE_COMBOS) * dims);
+#ifdef _OPENMP
+                #pragma omp for schedule(dynamic, 1)
+#endif
+                for (int64_t b = begin; b < end; ++b) {
+                    const CardSet board = board_at(static_cast<uint64_t>(b));
+                    features(board, static_cast<uint64_t>(b), hand_features);
+                    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+                        const auto& [c1, c2] = hole_combos()[i];
+                        if (board.contains(c1) || board.contains(c2)) continue;
+                        const uint64_t idx = indexer.index(CardSet::of(hole_combos()[i]), board);
+                        rs.table[idx] = static_cast<BucketId>(
+                            nearest.nearest(hand_features.data() + static_cast<size_t>(i) * dims));
+                    }
+                }
+            }
+            rs.next_board = static_cast<uint64_t>(end);
+            save(false);
+
+            progress.boards_done = rs.next_board;
+            if (!report(progress)) return false;
+        }
+
+        rs.stage = Stage::Done;
+        table = rs.table;
+        save(true);
+    }
+    return true;
+}
+
+} // namespace
+
+bool EMDAbstraction::build_clusters(const EMDBuildConfig& config) {
+    const int bins = config.histogram_bins;
+    if (bins < 2 || config.samples_per_hand < 0 || config.max_iterations < 0) {
+        throw std::invalid_argument("EMD build needs at least 2 bins and non-negative samples and iterations");
+    }
+    for (BettingRound round : config.rounds) {
+        if (round == BettingRound::Preflop) {
+            throw std::invalid_argument("EMD clustering covers postflop rounds only");
+        }
+        const int k = num_buckets(round);
+        if (k < 1 || k > 0xFFFF) {
+            throw std::invalid_argument("EMD bucket counts must be in [1, 65535]");
+        }
+    }
+
+    auto histograms = [&](CardSet board, uint64_t stream, std::span<float> out) {
+        equity_histograms(board, bins, config.samples_per_hand, config.seed, stream, out);
+    };
+
+    EMDCheckpoint state;
+    state.bins = static_cast<uint32_t>(bins);
+    state.samples = static_cast<uint32_t>(config.samples_per_hand);
+    state.seed = config.seed;
+    state.max_training_points = config.max_training_points;
+    state.buckets = {static_cast<uint32_t>(flop_buckets_), static_cast<uint32_t>(turn_buckets_),
+                     static_cast<uint32_t>(river_buckets_)};
+
+    return cluster_rounds(config, std::move(state), {{
+        {flop_buckets_, bins, histograms, &flop_clusters_},
+        {turn_buckets_, bins, histograms, &turn_clusters_},
+        {river_buckets_, bins, histograms, &river_clusters_},
+    }});
 }
 
 int EMDAbstraction::num_buckets(BettingRound round) const {
@@ -340,6 +498,100 @@ int EMDAbstraction::total_buckets() const {
     return preflop_buckets_ + flop_buckets_ + turn_buckets_ + river_buckets_;
 }
 
+// ============================================================================
+// OCHSAbstraction
+// ============================================================================
+
+OCHSAbstraction::OCHSAbstraction(int preflop, int flop, int turn, int river, int opponent_clusters)
+    : buckets_{preflop, flop, turn, river}
+    , opponents_(OpponentClusters::build(opponent_clusters)) {}
+
+BucketId OCHSAbstraction::get_bucket(
+    CardSet hole,
+    CardSet board,
+    BettingRound round) const {
+
+    if (round == BettingRound::Preflop) {
+        return preflop_rank_bucket(PreflopEquity::standard(), hole, buckets_[0]);
+    }
+    const std::vector<BucketId>& table = tables_[static_cast<int>(round) - 1];
+    if (!table.empty()) return table[HoldemIndexer::instance().index(hole, board)];
+
+    // Until the round is built: bucket by hand strength
+    const int num = num_buckets(round);
+    const double hs = HandEvaluator::hand_strength(hole, board);
+    return static_cast<BucketId>(std::min(num - 1, static_cast<int>(hs * num)));
+}
+
+HandFeatures OCHSAbstraction::compute_features(CardSet hole, CardSet board) const {
+    HandFeatures features = CardAbstraction::compute_features(hole, board);
+    if (board.size() < 3) return features;
+
+    const int k = opponents_.size();
+    std::vector<float> equities(static_cast<size_t>(NUM_HOLE_COMBOS) * k);
+    ochs_equities(board, opponents_, 0, 0, 0, equities);
+    std::array<int, 2> cards;
+    hole.to_cards(cards.data());
+    const float* own = equities.data() + static_cast<size_t>(hole_combo_index(cards[0], cards[1])) * k;
+    std::copy(own, own + k, features.ochs.begin());
+    features.ochs_clusters = k;
+    return features;
+}
+
+bool OCHSAbstraction::build_clusters(const OCHSBuildConfig& config) {
+    const int bins = config.histogram_bins;
+    const int k = opponents_.size();
+    if (bins < 2 || config.samples_per_hand < 0 || config.max_iterations < 0) {
+        throw std::invalid_argument("OCHS build needs at least 2 bins and non-negative samples and iterations");
+    }
+    for (BettingRound round : config.rounds) {
+        if (round == BettingRound::Preflop) {
+            throw std::invalid_argument("OCHS clustering covers postflop rounds only");
+        }
+        const int buckets = num_buckets(round);
+        if (buckets < 1 || buckets > 0xFFFF) {
+            throw std::invalid_argument("OCHS bucket counts must be in [1, 65535]");
+        }
+    }
+
+    auto histograms = [&](CardSet board, uint64_t stream, std::span<float> out) {
+        ochs_histograms(board, opponents_, bins, config.samples_per_hand, config.seed, stream, out);
+    };
+    auto equities = [&](CardSet board, uint64_t stream, std::span<float> out) {
+        ochs_equities(board, opponents_, config.samples_per_hand, config.seed, stream, out);
+    };
+
+    EMDCheckpoint state;
+    state.bins = static_cast<uint32_t>(bins);
+    state.opponent_clusters = static_cast<uint32_t>(k);
+    state.samples = static_cast<uint32_t>(config.samples_per_hand);
+    state.seed = config.seed;
+    state.max_training_points = config.max_training_points;
+    state.buckets = {static_cast<uint32_t>(buckets_[1]), static_cast<uint32_t>(buckets_[2]),
+                     static_cast<uint32_t>(buckets_[3])};
+
+    return cluster_rounds(config, std::move(state), {{
+        {buckets_[1], k * bins, histograms, &tables_[0]},
+        {buckets_[2], k * bins, histograms, &tables_[1]},
+        {buckets_[3], k, equities, &tables_[2]},
+    }});
+}
+
+const std::vector<BucketId>& OCHSAbstraction::clusters(BettingRound round) const {
+    if (round == BettingRound::Preflop) {
+        throw std::invalid_argument("OCHS clusters exist for postflop rounds only");
+    }
+    return tables_[static_cast<int>(round) - 1];
+}
+
+int OCHSAbstraction::num_buckets(BettingRound round) const {
+    return buckets_[static_cast<int>(round)];
+}
+
+int OCHSAbstraction::total_buckets() const {
+    return buckets_[0] + buckets_[1] + buckets_[2] + buckets_[3];
+}
+
 // ============================================================================
 // Factory and utilities
 // ============================================================================
@@ -348,6 +600,12 @@ std::unique_ptr<CardAbstraction> create_abstraction(
     const std::string& name,
     int preflop, int flop, int turn, int river) {
 
+    if (name.rfind("table:", 0) == 0) {
+        return std::make_unique<TableAbstraction>(name.substr(6));
+    }
+    if (name.rfind("cached:", 0) == 0) {
+        return std::make_unique<CachedAbstraction>(create_abstraction(name.substr(7), preflop, flop, turn, river));
+    }
     if (name == "null" || name == "Null") {
         return std::make_unique<NullAbstraction>();
     } else if (name == "percentile" || name == "Percentile") {
@@ -356,6 +614,8 @@ std::unique_ptr<CardAbstraction> create_abstraction(
         return std::make_unique<EHSAbstraction>(preflop, flop, turn, river);
     } else if (name == "emd" || name == "EMD") {
         return std::make_unique<EMDAbstraction>(preflop, flop, turn, river);
+    } else if (name == "ochs" || name == "OCHS") {
+        return std::make_unique<OCHSAbstraction>(preflop, flop, turn, river);
     }
 
     // Default to percentile
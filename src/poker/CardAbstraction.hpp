@@ -4,9 +4,15 @@
 #include <vector>
 #include <map>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
+#include <span>
+#include "EMDClustering.hpp"
 #include "HandEvaluator.hpp"
+#include "HandIndexer.hpp"
+#include "OCHSFeatures.hpp"
+#include "PreflopEquity.hpp"
 
 namespace quantnet::poker {
 
@@ -41,6 +47,11 @@ struct HandFeatures {
     double positive_potential = 0.0; // Probability of improving
     double negative_potential = 0.0; // Probability of being outdrawn
 
+    // Equity against each opponent cluster (OCHS); set by OCHSAbstraction,
+    // which fills the first ochs_clusters entries
+    std::array<float, MAX_OPPONENT_CLUSTERS> ochs{};
+    int ochs_clusters = 0;
+
     // Derived feature: effective hand strength
     // EHS = HS + (1 - HS) * ppot - HS * npot
     double effective_strength() const {
@@ -55,10 +66,24 @@ public:
     virtual ~CardAbstraction() = default;
 
     // Get bucket for a hole hand given the current board
-    virtual BucketId get_bucket(const std::array<int, 2>& hole,
-                                const std::vector<int>& board,
+    BucketId get_bucket(const std::array<int, 2>& hole,
+                        const std::vector<int>& board,
+                        BettingRound round) const {
+        return get_bucket(CardSet::of(hole), CardSet::of(board), round);
+    }
+
+    // Same over card sets; abstractions implement this one, so bucketing
+    // does not allocate
+    virtual BucketId get_bucket(CardSet hole, CardSet board,
                                 BettingRound round) const = 0;
 
+    // Buckets of every hole combo on a board at once, indexed by
+    // hole_combo_index; entries of combos touching the board are left as
+    // they are. The default calls get_bucket per combo; abstractions that
+    // can share work across the hands of a board override it.
+    virtual void get_buckets(CardSet board, BettingRound round,
+                             std::span<BucketId, NUM_HOLE_COMBOS> out) const;
+
     // Get number of buckets for a round
     virtual int num_buckets(BettingRound round) const = 0;
 
@@ -66,8 +91,12 @@ public:
     virtual int total_buckets() const = 0;
 
     // Compute features for a hand
-    virtual HandFeatures compute_features(const std::array<int, 2>& hole,
-                                         const std::vector<int>& board) const;
+    HandFeatures compute_features(const std::array<int, 2>& hole,
+                                  const std::vector<int>& board) const {
+        return compute_features(CardSet::of(hole), CardSet::of(board));
+    }
+
+    virtual HandFeatures compute_features(CardSet hole, CardSet board) const;
 
     // Name of this abstraction
     virtual std::string name() const = 0;
@@ -77,8 +106,8 @@ public:
 // Only useful for very small games or debugging
 class NullAbstraction : public CardAbstraction {
 public:
-    BucketId get_bucket(const std::array<int, 2>& hole,
-                        const std::vector<int>& board,
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
                         BettingRound round) const override;
 
     int num_buckets(BettingRound round) const override;
@@ -88,18 +117,34 @@ public:
 
 // Percentile abstraction: bucket by hand strength percentile
 // Simple but effective for small-medium games
+//
+// Preflop, hands are ranked by all-in equity against a random hand
+// (PreflopEquity), strongest first, and split evenly over the preflop
+// buckets; bucket 0 holds AA. Postflop, buckets are hand strength
+// percentiles, strongest last.
 class PercentileAbstraction : public CardAbstraction {
 public:
-    // buckets_per_round: number of buckets for each round
+    // buckets_per_round: number of buckets for each round. Preflop ranks
+    // come from PreflopEquity::standard(), computed on the first preflop
+    // lookup in the process.
     explicit PercentileAbstraction(int preflop_buckets = 169,
                                     int flop_buckets = 50,
                                     int turn_buckets = 50,
                                     int river_buckets = 50);
 
-    BucketId get_bucket(const std::array<int, 2>& hole,
-                        const std::vector<int>& board,
+    // Same with preflop ranks from a given table (e.g. a cached one from
+    // PreflopEquity::load_or_compute)
+    PercentileAbstraction(int preflop_buckets, int flop_buckets, int turn_buckets, int river_buckets,
+                          std::shared_ptr<const PreflopEquity> preflop_equity);
+
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
                         BettingRound round) const override;
 
+    // Postflop, one hand_strengths sweep serves the whole board
+    void get_buckets(CardSet board, BettingRound round,
+                     std::span<BucketId, NUM_HOLE_COMBOS> out) const override;
+
     int num_buckets(BettingRound round) const override;
     int total_buckets() const override;
     std::string name() const override { return "Percentile"; }
@@ -110,17 +155,62 @@ private:
     int turn_buckets_;
     int river_buckets_;
 
-    // Preflop hand rankings (pre-computed)
-    // Maps canonical hand ID to rank [0, 168]
-    std::map<int, int> preflop_rankings_;
+    // Null: PreflopEquity::standard()
+    std::shared_ptr<const PreflopEquity> preflop_equity_;
+
+    BucketId strength_bucket(double hs, BettingRound round) const;
+};
+
+// Progress of EMDAbstraction::build_clusters, reported after every k-means
+// step and every chunk of boards assigned
+struct EMDBuildProgress {
+    BettingRound round = BettingRound::Flop;
+    bool assigning = false;          // false: clustering the training set
+    int iteration = 0;               // k-means steps so far
+    uint64_t changed = 0;            // Points that changed cluster, last step
+    uint64_t boards_done = 0;        // Canonical boards assigned so far
+    uint64_t boards_total = 0;
+};
+
+// Return false to stop the build; the checkpoint is written first
+using EMDBuildCallback = std::function<bool(const EMDBuildProgress&)>;
+
+struct EMDBuildConfig {
+    int samples_per_hand = 100;          // Runouts per hand, if fewer than all; 0 = all
+    int histogram_bins = 50;
+    int max_iterations = 100;            // k-means steps per round
+    uint64_t max_training_points = 250000;
+    uint64_t seed = 0;
+    std::vector<BettingRound> rounds = {BettingRound::Flop, BettingRound::Turn, BettingRound::River};
+
+    // Empty: no checkpointing. Otherwise a build resumes from this file if
+    // it exists and saves to it at most every checkpoint_seconds, when a
+    // round completes and when stopped.
+    std::string checkpoint_path;
+    double checkpoint_seconds = 60.0;
 
-    void initialize_preflop_rankings();
-    int get_preflop_hand_id(int card1, int card2) const;
+    EMDBuildCallback progress;
 };
 
 // Earth Mover's Distance (EMD) abstraction
 // Groups hands by equity distribution similarity
 // This is the approach used in professional poker AIs
+//
+// build_clusters runs the pipeline per postflop round (after Johanson et
+// al., "Evaluating State-Space Abstractions in Extensive-Form Games", 2013):
+//   1. features   every hand on a board gets a histogram of its river hand
+//                 strength over the runouts to come (sampled on the flop);
+//                 one hand_strengths sweep per runout serves all hands
+//   2. training   the hands of a seeded sample of canonical boards, about
+//                 max_training_points in all, are clustered with k-means++
+//                 seeding and Hamerly-pruned k-means under EMD
+//   3. assignment every canonical board is revisited in parallel and each
+//                 hand written to its nearest centroid in a flat table
+//                 indexed by HoldemIndexer (every index is reached from
+//                 the canonical board of its class)
+// get_bucket then reads the table in O(1). Until a round is built it falls
+// back to bucketing by hand strength. Preflop buckets are equity ranks, as
+// in PercentileAbstraction (from PreflopEquity::standard()).
 class EMDAbstraction : public CardAbstraction {
 public:
     explicit EMDAbstraction(int preflop_buckets = 169,
@@ -128,8 +218,8 @@ public:
                             int turn_buckets = 200,
                             int river_buckets = 200);
 
-    BucketId get_bucket(const std::array<int, 2>& hole,
-                        const std::vector<int>& board,
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
                         BettingRound round) const override;
 
     int num_buckets(BettingRound round) const override;
@@ -140,21 +230,89 @@ public:
     // This should be called once to generate bucket assignments
     void build_clusters(int samples_per_hand = 100);
 
+    // Same with full control; returns false if progress stopped the build.
+    // Throws std::invalid_argument on bad settings or a preflop round, and
+    // std::runtime_error if the checkpoint is unreadable or was written
+    // with different settings.
+    bool build_clusters(const EMDBuildConfig& config);
+
+    // Bucket table of a postflop round, indexed by HoldemIndexer; empty
+    // until built
+    const std::vector<BucketId>& clusters(BettingRound round) const;
+
 private:
     int preflop_buckets_;
     int flop_buckets_;
     int turn_buckets_;
     int river_buckets_;
 
-    // Cluster assignments (computed by build_clusters)
-    // Key: canonical representation, Value: bucket ID
-    std::map<std::string, BucketId> flop_clusters_;
-    std::map<std::string, BucketId> turn_clusters_;
-    std::map<std::string, BucketId> river_clusters_;
+    // Cluster assignments (computed by build_clusters), indexed by
+    // HoldemIndexer: one entry per suit-isomorphic (hole, board). Empty
+    // until built.
+    std::vector<BucketId> flop_clusters_;
+    std::vector<BucketId> turn_clusters_;
+    std::vector<BucketId> river_clusters_;
+
+    // Canonical key for hand + board: card order and suit permutations do
+    // not matter
+    static uint64_t canonicalize(CardSet hole, CardSet board) {
+        return HoldemIndexer::instance().index(hole, board);
+    }
+};
+
+// Settings of OCHSAbstraction::build_clusters: the EMD ones, with
+// histogram_bins counted per opponent cluster
+struct OCHSBuildConfig : EMDBuildConfig {
+    OCHSBuildConfig() { histogram_bins = 10; }
+};
+
+// Opponent cluster hand strength (OCHS) abstraction
+//
+// Clusters hands on their equity against each of a few opponent clusters
+// (see OCHSFeatures.hpp) rather than against one uniform opponent, which
+// tells apart hands that EHS and EMD features merge, so the same number
+// of buckets loses less. build_clusters runs the EMDAbstraction pipeline
+// (training sample, k-means++ and Hamerly k-means, assignment of every
+// canonical board into a table indexed by HoldemIndexer) on these features:
+//   river        the OCHS vector itself, one equity per opponent cluster
+//   flop, turn   potential-aware OCHS: per opponent cluster, the histogram
+//                of river equity over the runouts to come
+// Distances are L1, which on the histograms is a sum of per-cluster earth
+// mover's distances. Until a round is built get_bucket falls back to
+// bucketing by hand strength. Preflop buckets are equity ranks, as in
+// PercentileAbstraction (from PreflopEquity::standard()).
+class OCHSAbstraction : public CardAbstraction {
+public:
+    // Opponent clusters are built on construction (about 0.2 s)
+    explicit OCHSAbstraction(int preflop_buckets = 169,
+                             int flop_buckets = 200,
+                             int turn_buckets = 200,
+                             int river_buckets = 200,
+                             int opponent_clusters = 8);
+
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
+                        BettingRound round) const override;
+
+    int num_buckets(BettingRound round) const override;
+    int total_buckets() const override;
+    std::string name() const override { return "OCHS"; }
+
+    // Adds the hand's OCHS vector (exact on the river, over all runouts
+    // before it) to the base features
+    using CardAbstraction::compute_features;
+    HandFeatures compute_features(CardSet hole, CardSet board) const override;
 
-    // Get canonical string for hand + board
-    std::string canonicalize(const std::array<int, 2>& hole,
-                            const std::vector<int>& board) const;
+    // Same contract as EMDAbstraction::build_clusters
+    bool build_clusters(const OCHSBuildConfig& config = {});
+
+    const std::vector<BucketId>& clusters(BettingRound round) const;
+    const OpponentClusters& opponent_clusters() const { return opponents_; }
+
+private:
+    std::array<int, 4> buckets_;
+    OpponentClusters opponents_;
+    std::array<std::vector<BucketId>, 3> tables_;     // Flop, turn, river
 };
 
 // Effective Hand Strength (EHS) abstraction
@@ -166,8 +324,8 @@ public:
                             int turn_buckets = 10,
                             int river_buckets = 10);
 
-    BucketId get_bucket(const std::array<int, 2>& hole,
-                        const std::vector<int>& board,
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board,
                         BettingRound round) const override;
 
     int num_buckets(BettingRound round) const override;
@@ -185,6 +343,9 @@ private:
 };
 
 // Factory function to create abstractions
+// "table:<path>" maps a bucket table file written by TableAbstraction::write;
+// "cached:<name>" wraps <name> in a CachedAbstraction with default settings.
+// "ochs" gives an OCHSAbstraction, unbuilt like "emd".
 std::unique_ptr<CardAbstraction> create_abstraction(
     const std::string& name,
     int preflop = 169,
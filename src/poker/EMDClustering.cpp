@@ -0,0 +1,424 @@
+#include "EMDClustering.hpp"
+#include "HandIndexer.hpp"
+#include "../io/BinaryFile.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+// Centroid sums are split into this many fixed chunks of points, so the
+// order of additions does not depend on the thread count
+constexpr int NUM_CHUNKS = 64;
+
+// Slack added to every bound update, so float rounding cannot make a bound
+// prune a point Lloyd's algorithm would move
+constexpr float BOUND_SLACK = 1e-5f;
+
+} // namespace
+
+float emd_distance(const float* a, const float* b, int bins) {
+    float sum = 0.0f;
+    for (int i = 0; i < bins; ++i) sum += std::fabs(a[i] - b[i]);
+    return sum / static_cast<float>(bins);
+}
+
+// ============================================================================
+// Equity histograms
+// ============================================================================
+
+std::vector<CardSet> river_runouts(CardSet board, int samples, uint64_t seed, uint64_t stream) {
+    const int board_cards = board.size();
+    if (board_cards < 3 || board_cards > 5) {
+        throw std::invalid_argument("River runouts need a 3-5 card board");
+    }
+
+    std::vector<CardSet> runouts;
+    const int missing = 5 - board_cards;
+    const int live = DECK_SIZE - board_cards;
+    const int all_runouts = missing == 0 ? 1 : missing == 1 ? live : live * (live - 1) / 2;
+    if (samples > 0 && samples < all_runouts) {
+        parallel::CounterRng rng(seed, stream);
+        while (static_cast<int>(runouts.size()) < samples) {
+            CardSet runout;
+            while (runout.size() < missing) {
+                const int c = static_cast<int>(rng.below(DECK_SIZE));
+                if (!board.contains(c)) runout.insert(c);
+            }
+            runouts.push_back(runout);
+        }
+    } else if (missing == 0) {
+        runouts.push_back(CardSet{});
+    } else {
+        const CardSet remaining = ~board;
+        for (int c1 : remaining) {
+            if (missing == 1) {
+                runouts.push_back(CardSet::single(c1));
+                continue;
+            }
+            for (int c2 : remaining) {
+                if (c2 > c1) runouts.push_back(CardSet::single(c1) | CardSet::single(c2));
+            }
+        }
+    }
+    return runouts;
+}
+
+void equity_histograms(CardSet board, int bins, int samples, uint64_t seed,
+                       uint64_t stream, std::span<float> out) {
+    const int board_cards = board.size();
+    if (board_cards < 3 || board_cards > 5) {
+        throw std::invalid_argument("Equity histograms need a 3-5 card board");
+    }
+    if (bins < 1) {
+        throw std::invalid_argument("Equity histograms need at least one bin");
+    }
+    if (out.size() < static_cast<size_t>(NUM_HOLE_COMBOS) * bins) {
+        throw std::invalid_argument("Equity histogram output too small");
+    }
+
+    const std::vector<CardSet> runouts = river_runouts(board, samples, seed, stream);
+
+    std::vector<int> counts(static_cast<size_t>(NUM_HOLE_COMBOS) * bins, 0);
+    std::array<int, NUM_HOLE_COMBOS> totals{};
+    for (CardSet runout : runouts) {
+        const auto strengths = HandEvaluator::hand_strengths(board | runout);
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            if (strengths[i] < 0.0) continue;
+            const int bin = std::min(bins - 1, static_cast<int>(strengths[i] * bins));
+            ++counts[static_cast<size_t>(i) * bins + bin];
+            ++totals[i];
+        }
+    }
+
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        float* cdf = out.data() + static_cast<size_t>(i) * bins;
+        if (totals[i] == 0) {
+            std::fill(cdf, cdf + bins, 0.0f);
+            continue;
+        }
+        int running = 0;
+        for (int b = 0; b < bins; ++b) {
+            running += counts[static_cast<size_t>(i) * bins + b];
+            cdf[b] = static_cast<float>(running) / static_cast<float>(totals[i]);
+        }
+    }
+}
+
+// ============================================================================
+// k-means++
+// ============================================================================
+
+std::vector<float> kmeans_plus_plus(std::span<const float> points, int bins, int k, uint64_t seed) {
+    const int64_t n = static_cast<int64_t>(points.size() / bins);
+    if (k < 1 || n < k) {
+        throw std::invalid_argument("k-means++ needs at least k points");
+    }
+
+    parallel::CounterRng rng(seed, 0);
+    std::vector<float> centroids;
+    centroids.reserve(static_cast<size_t>(k) * bins);
+    auto take = [&](int64_t i) {
+        centroids.insert(centroids.end(), points.data() + i * bins, points.data() + (i + 1) * bins);
+    };
+
+    take(static_cast<int64_t>(rng.next() % static_cast<uint64_t>(n)));
+    std::vector<double> d2(n, std::numeric_limits<double>::infinity());
+    for (int c = 1; c < k; ++c) {
+        const float* last = centroids.data() + static_cast<size_t>(c - 1) * bins;
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (int64_t i = 0; i < n; ++i) {
+            const double d = emd_distance(points.data() + i * bins, last, bins);
+            d2[i] = std::min(d2[i], d * d);
+        }
+
+        double total = 0.0;
+        for (int64_t i = 0; i < n; ++i) total += d2[i];
+        int64_t pick = -1;
+        if (total > 0.0) {
+            double target = rng.uniform() * total;
+            for (int64_t i = 0; i < n; ++i) {
+                if (d2[i] <= 0.0) continue;
+                pick = i;       // Rounding can leave target >= 0; keep the last candidate
+                target -= d2[i];
+                if (target < 0.0) break;
+            }
+        } else {
+            pick = static_cast<int64_t>(rng.next() % static_cast<uint64_t>(n));   // All points coincide
+        }
+        take(pick);
+    }
+    return centroids;
+}
+
+// ============================================================================
+// HamerlyKMeans
+// ============================================================================
+
+HamerlyKMeans::HamerlyKMeans(std::span<const float> points, int bins, std::vector<float> centroids)
+    : points_(points)
+    , bins_(bins)
+    , k_(static_cast<int>(centroids.size() / bins))
+    , n_(points.size() / bins)
+    , centroids_(std::move(centroids))
+    , assign_(n_, -1)
+    , upper_(n_, 0.0f)
+    , lower_(n_, 0.0f) {
+    if (bins < 1 || k_ < 1 || centroids_.size() != static_cast<size_t>(k_) * bins) {
+        throw std::invalid_argument("k-means needs at least one centroid of `bins` values");
+    }
+}
+
+uint64_t HamerlyKMeans::step() {
+    const int k = k_;
+    const int bins = bins_;
+    const int64_t n = static_cast<int64_t>(n_);
+
+    // Half the distance from each centroid to its nearest other centroid
+    std::vector<float> half_gap(k, std::numeric_limits<float>::infinity());
+    for (int a = 0; a < k; ++a) {
+        for (int b = a + 1; b < k; ++b) {
+            const float d = 0.5f * emd_distance(&centroids_[static_cast<size_t>(a) * bins],
+                                                &centroids_[static_cast<size_t>(b) * bins], bins);
+            half_gap[a] = std::min(half_gap[a], d);
+            half_gap[b] = std::min(half_gap[b], d);
+        }
+    }
+
+    uint64_t changed = 0;
+    uint64_t scans = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:changed, scans)
+#endif
+    for (int64_t i = 0; i < n; ++i) {
+        const float* x = points_.data() + i * bins;
+        int a = assign_[i];
+        if (a >= 0) {
+            const float bound = std::max(half_gap[a], lower_[i]) - BOUND_SLACK;
+            if (upper_[i] < bound) continue;
+            upper_[i] = emd_distance(x, &centroids_[static_cast<size_t>(a) * bins], bins);
+            if (upper_[i] < bound) continue;
+        }
+
+        // Full scan: nearest and second nearest, ties to the lower id
+        float best = std::numeric_limits<float>::infinity();
+        float second = std::numeric_limits<float>::infinity();
+        int best_id = 0;
+        for (int c = 0; c < k; ++c) {
+            const float d = emd_distance(x, &centroids_[static_cast<size_t>(c) * bins], bins);
+            if (d < best) {
+                second = best;
+                best = d;
+                best_id = c;
+            } else if (d < second) {
+                second = d;
+            }
+        }
+        ++scans;
+        if (best_id != a) ++changed;
+        assign_[i] = best_id;
+        upper_[i] = best;
+        lower_[i] = second;
+    }
+    full_scans_ = scans;
+
+    // New means, summed per chunk and then in chunk order
+    const int chunks = static_cast<int>(std::min<int64_t>(NUM_CHUNKS, std::max<int64_t>(n, 1)));
+    std::vector<double> sums(static_cast<size_t>(chunks) * k * bins, 0.0);
+    std::vector<uint64_t> counts(static_cast<size_t>(chunks) * k, 0);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int ch = 0; ch < chunks; ++ch) {
+        double* s = sums.data() + static_cast<size_t>(ch) * k * bins;
+        uint64_t* cnt = counts.data() + static_cast<size_t>(ch) * k;
+        for (int64_t i = n * ch / chunks; i < n * (ch + 1) / chunks; ++i) {
+            const float* x = points_.data() + i * bins;
+            double* dst = s + static_cast<size_t>(assign_[i]) * bins;
+            for (int b = 0; b < bins; ++b) dst[b] += x[b];
+            ++cnt[assign_[i]];
+        }
+    }
+
+    std::vector<float> moved(k, 0.0f);
+    for (int c = 0; c < k; ++c) {
+        uint64_t count = 0;
+        std::vector<double> total(bins, 0.0);
+        for (int ch = 0; ch < chunks; ++ch) {
+            count += counts[static_cast<size_t>(ch) * k + c];
+            const double* s = sums.data() + (static_cast<size_t>(ch) * k + c) * bins;
+            for (int b = 0; b < bins; ++b) total[b] += s[b];
+        }
+        if (count == 0) continue;
+        std::vector<float> mean(bins);
+        for (int b = 0; b < bins; ++b) mean[b] = static_cast<float>(total[b] / count);
+        float* centroid = &centroids_[static_cast<size_t>(c) * bins];
+        moved[c] = emd_distance(centroid, mean.data(), bins);
+        std::copy(mean.begin(), mean.end(), centroid);
+    }
+
+    // Loosen the bounds by how far the centroids moved
+    int far1 = 0;
+    for (int c = 1; c < k; ++c) {
+        if (moved[c] > moved[far1]) far1 = c;
+    }
+    float far2 = 0.0f;
+    for (int c = 0; c < k; ++c) {
+        if (c != far1) far2 = std::max(far2, moved[c]);
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < n; ++i) {
+        const int a = assign_[i];
+        upper_[i] += moved[a] + BOUND_SLACK;
+        lower_[i] -= (a == far1 ? far2 : moved[far1]) + BOUND_SLACK;
+    }
+    return changed;
+}
+
+// ============================================================================
+// NearestCentroid
+// ============================================================================
+
+NearestCentroid::NearestCentroid(std::vector<float> centroids, int bins)
+    : centroids_(std::move(centroids))
+    , bins_(bins) {
+    if (bins < 1 || centroids_.empty() || centroids_.size() % bins != 0) {
+        throw std::invalid_argument("Nearest centroid search needs centroids of `bins` values");
+    }
+    const int k = static_cast<int>(centroids_.size() / bins);
+    for (int c = 0; c < k; ++c) {
+        by_mean_.emplace_back(mean_key(&centroids_[static_cast<size_t>(c) * bins]), c);
+    }
+    std::sort(by_mean_.begin(), by_mean_.end());
+}
+
+float NearestCentroid::mean_key(const float* cdf) const {
+    float sum = 0.0f;
+    for (int b = 0; b < bins_; ++b) sum += cdf[b];
+    return sum / static_cast<float>(bins_);
+}
+
+int NearestCentroid::nearest(const float* point) const {
+    const float key = mean_key(point);
+    const int k = static_cast<int>(by_mean_.size());
+    int hi = static_cast<int>(std::lower_bound(by_mean_.begin(), by_mean_.end(),
+                                               std::make_pair(key, -1)) - by_mean_.begin());
+    int lo = hi - 1;
+
+    float best = std::numeric_limits<float>::infinity();
+    int best_id = 0;
+    auto consider = [&](int j) {
+        const int c = by_mean_[j].second;
+        const float d = emd_distance(point, &centroids_[static_cast<size_t>(c) * bins_], bins_);
+        if (d < best || (d == best && c < best_id)) {
+            best = d;
+            best_id = c;
+        }
+    };
+
+    // |mean difference| <= EMD, so stop each side once the gap alone
+    // exceeds the best distance
+    while (lo >= 0 || hi < k) {
+        const float gap_lo = lo >= 0 ? key - by_mean_[lo].first : std::numeric_limits<float>::infinity();
+        const float gap_hi = hi < k ? by_mean_[hi].first - key : std::numeric_limits<float>::infinity();
+        if (std::min(gap_lo, gap_hi) > best + BOUND_SLACK) break;
+        if (gap_lo <= gap_hi) {
+            consider(lo--);
+        } else {
+            consider(hi++);
+        }
+    }
+    return best_id;
+}
+
+// ============================================================================
+// EMDCheckpoint
+// ============================================================================
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = {'Q', 'N', 'E', 'M', 'D', 'C', 'K', '\0'};
+constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+} // namespace
+
+bool EMDCheckpoint::same_settings(const EMDCheckpoint& other) const {
+    return bins == other.bins && opponent_clusters == other.opponent_clusters &&
+           samples == other.samples && seed == other.seed &&
+           max_training_points == other.max_training_points && buckets == other.buckets;
+}
+
+uint64_t EMDCheckpoint::feature_dims(int r) const {
+    if (opponent_clusters == 0) return bins;
+    return r == 2 ? opponent_clusters : static_cast<uint64_t>(opponent_clusters) * bins;
+}
+
+// Atomic, so an interrupted save leaves the previous checkpoint intact
+void EMDCheckpoint::save(const std::string& path) const {
+    io::BinaryWriter out(path, "checkpoint", true);
+    out.header(CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    out.pod(bins);
+    out.pod(opponent_clusters);
+    out.pod(samples);
+    out.pod(seed);
+    out.pod(max_training_points);
+    for (uint32_t b : buckets) out.pod(b);
+    for (const Round& r : rounds) {
+        out.pod(static_cast<uint32_t>(r.stage));
+        out.pod(r.iteration);
+        out.pod(r.next_board);
+        out.vector(r.centroids);
+        out.vector(r.table);
+    }
+    out.commit();
+}
+
+bool EMDCheckpoint::load(const std::string& path, EMDCheckpoint& out) {
+    if (!std::filesystem::exists(path)) return false;
+
+    io::BinaryReader in(path, "EMD checkpoint");
+    in.header(CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+
+    EMDCheckpoint ck;
+    in.read(ck.bins);
+    in.read(ck.opponent_clusters);
+    in.read(ck.samples);
+    in.read(ck.seed);
+    in.read(ck.max_training_points);
+    for (uint32_t& b : ck.buckets) in.read(b);
+    for (int r = 0; r < 3; ++r) {
+        Round& round = ck.rounds[r];
+        uint32_t stage = 0;
+        in.read(stage);
+        if (stage > static_cast<uint32_t>(Stage::Done)) throw in.corrupt("bad stage");
+        round.stage = static_cast<Stage>(stage);
+        in.read(round.iteration);
+        in.read(round.next_board);
+        const uint64_t num_centroids = ck.buckets[r] * ck.feature_dims(r);
+        const uint64_t entries = HoldemIndexer::instance().size(3 + r);
+        in.vector(round.centroids, num_centroids);
+        in.vector(round.table, entries);
+        if (round.stage == Stage::Pending) continue;
+
+        if (round.centroids.size() != num_centroids) throw in.corrupt("wrong centroid count");
+        if (round.next_board > HandIndexer({3 + r}).size(0)) throw in.corrupt("board out of range");
+        if (round.stage != Stage::Clustering && round.table.size() != entries) {
+            throw in.corrupt("wrong entry count");
+        }
+    }
+    in.expect_end();
+
+    out = std::move(ck);
+    return true;
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Equity histograms and k-means under earth mover's distance
+//
+// These are the pieces EMDAbstraction::build_clusters puts together. A
+// hand's feature is the distribution of its river hand strength over the
+// runouts still to come, in `bins` equal-width bins. Histograms are stored
+// as cumulative distributions (bins floats, the last one 1), because in one
+// dimension the earth mover's distance is the L1 distance between the CDFs:
+// a plain sum that vectorizes, obeys the triangle inequality and has the
+// component-wise mean as its centroid.
+
+// Earth mover's distance between two CDFs of `bins` bins, in units of
+// hand strength (0 = same distribution, 1 = all mass moved from 0 to 1)
+float emd_distance(const float* a, const float* b, int bins);
+
+// Runouts that complete a 3-5 card board to the river: all of them, or
+// with samples > 0 and fewer than all, that many drawn from stream `stream`
+// of `seed`. A complete board has one empty runout. Throws
+// std::invalid_argument on a bad board.
+std::vector<CardSet> river_runouts(CardSet board, int samples, uint64_t seed, uint64_t stream);
+
+// CDFs of every live hole combo on a 3-5 card board, written at
+// out[hole_combo_index * bins]; combos touching the board are left zero.
+// Each runout to the river adds the combo's river hand strength. With
+// samples > 0 and fewer than all runouts, that many runouts are drawn
+// instead from stream `stream` of `seed`, the same ones for every combo.
+// Throws std::invalid_argument on a bad board or bin count, or if out is
+// shorter than NUM_HOLE_COMBOS * bins.
+void equity_histograms(CardSet board, int bins, int samples, uint64_t seed,
+                       uint64_t stream, std::span<float> out);
+
+// k-means++ seeding: k centroids drawn from points (n * bins floats), each
+// with probability proportional to its squared distance to the nearest
+// centroid so far. Deterministic for a seed on any thread count.
+// Throws std::invalid_argument if there are fewer than k points.
+std::vector<float> kmeans_plus_plus(std::span<const float> points, int bins, int k, uint64_t seed);
+
+// Lloyd's k-means with Hamerly's bounds (Hamerly, "Making k-means even
+// faster", 2010)
+//
+// Each point keeps an upper bound on the distance to its centroid and a
+// lower bound on the distance to every other one. Centroid moves loosen the
+// bounds; a point is only scanned against all centroids when its upper
+// bound exceeds both its lower bound and half the distance from its centroid
+// to the nearest other centroid. Assignments are exactly Lloyd's. Centroid
+// sums are accumulated in fixed chunks and added in order, so results do
+// not depend on the thread count.
+class HamerlyKMeans {
+public:
+    // points: n * bins floats, kept by reference; centroids: k * bins
+    HamerlyKMeans(std::span<const float> points, int bins, std::vector<float> centroids);
+
+    // Assign every point and move the centroids to their means; returns how
+    // many points changed cluster (all of them on the first step). A
+    // cluster that loses all its points keeps its centroid.
+    uint64_t step();
+
+    const std::vector<float>& centroids() const { return centroids_; }
+    const std::vector<int>& assignments() const { return assign_; }
+
+    // Points whose distance was scanned against every centroid, last step
+    uint64_t full_scans() const { return full_scans_; }
+
+private:
+    std::span<const float> points_;
+    int bins_;
+    int k_;
+    uint64_t n_;
+    std::vector<float> centroids_;
+    std::vector<int> assign_;
+    std::vector<float> upper_;
+    std::vector<float> lower_;
+    uint64_t full_scans_ = 0;
+};
+
+// Exact nearest centroid, searched outward from the centroid of nearest
+// mean. The difference of means bounds the earth mover's distance from
+// below, so the search stops as soon as no centroid further out can be
+// closer. Ties go to the lower centroid id.
+class NearestCentroid {
+public:
+    NearestCentroid(std::vector<float> centroids, int bins);
+
+    int nearest(const float* point) const;
+
+private:
+    std::vector<float> centroids_;
+    int bins_;
+    std::vector<std::pair<float, int>> by_mean_;     // (sum of CDF / bins, id), sorted
+
+    float mean_key(const float* cdf) const;
+};
+
+// Resumable state of an EMD or OCHS build, one entry per postflop round
+struct EMDCheckpoint {
+    enum class Stage : uint32_t { Pending, Clustering, Assigning, Done };
+
+    struct Round {
+        Stage stage = Stage::Pending;
+        uint32_t iteration = 0;             // k-means steps taken
+        uint64_t next_board = 0;            // Canonical boards assigned so far
+        std::vector<float> centroids;       // buckets * feature dimensions
+        std::vector<uint16_t> table;        // HoldemIndexer index -> bucket
+    };
+
+    // Settings the state depends on; a checkpoint only resumes a build
+    // with the same ones
+    uint32_t bins = 0;
+    uint32_t opponent_clusters = 0;         // 0: equity histograms (EMD), else OCHS
+    uint32_t samples = 0;
+    uint64_t seed = 0;
+    uint64_t max_training_points = 0;
+    std::array<uint32_t, 3> buckets{};
+
+    std::array<Round, 3> rounds;            // Flop, turn, river
+
+    bool same_settings(const EMDCheckpoint& other) const;
+
+    // Width of one centroid in round r (0 = flop): bins for equity
+    // histograms; for OCHS, one histogram per opponent cluster, except on
+    // the river, where each cluster contributes a single equity
+    uint64_t feature_dims(int r) const;
+
+    // Written to path + ".tmp" and renamed over path, so an interrupted
+    // save leaves the previous checkpoint intact. Throws
+    // std::runtime_error if the file cannot be written.
+    void save(const std::string& path) const;
+
+    // Returns false if path does not exist; throws std::runtime_error if it
+    // exists but is not a valid checkpoint. Every round past Pending must
+    // hold buckets * feature_dims centroids and a board in range, and every
+    // round past Clustering a full table, so a resumed build can index them.
+    static bool load(const std::string& path, EMDCheckpoint& out);
+};
+
+} // namespace quantnet::poker
@@ -0,0 +1,285 @@
+#include "Equity.hpp"
+#include "TableEvaluator.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace quantnet::poker {
+
+std::pair<double, double> EquityResult::confidence_interval(double z) const {
+    return {std::max(0.0, equity - z * std_error), std::min(1.0, equity + z * std_error)};
+}
+
+namespace {
+
+// Runouts are summed in up to this many chunks, whatever the thread count
+constexpr int NUM_CHUNKS = 64;
+
+// Sums over the runouts of one chunk. Per runout r, with weight products
+// over compatible (hero, villain) pairs:
+//   share_r = wins + ties / 2, total_r = all pairs
+// and the moments a sampled run needs for its standard error.
+struct Accumulator {
+    double win = 0.0;
+    double tie = 0.0;
+    double total = 0.0;
+    double share_sq = 0.0;
+    double total_sq = 0.0;
+    double share_total = 0.0;
+    std::array<double, NUM_HOLE_COMBOS> hand_share{};
+    std::array<double, NUM_HOLE_COMBOS> hand_total{};
+
+    void merge(const Accumulator& o) {
+        win += o.win;
+        tie += o.tie;
+        total += o.total;
+        share_sq += o.share_sq;
+        total_sq += o.total_sq;
+        share_total += o.share_total;
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            hand_share[i] += o.hand_share[i];
+            hand_total[i] += o.hand_total[i];
+        }
+    }
+};
+
+// Combos either range holds, live on the board
+struct Candidates {
+    std::vector<TableEvaluator::HolePair> holes;
+    std::vector<int> index;         // hole_combo_index
+    std::vector<double> hero;
+    std::vector<double> villain;
+};
+
+// Sort keys of (value << 32 | position). Values fit in 24 bits, so three
+// 8-bit counting passes sort a runout's ~1000 hands several times faster
+// than a comparison sort.
+void radix_sort_values(std::vector<uint64_t>& keys) {
+    std::vector<uint64_t> tmp(keys.size());
+    for (int shift = 32; shift < 56; shift += 8) {
+        size_t count[257] = {};
+        for (uint64_t k : keys) ++count[((k >> shift) & 0xFF) + 1];
+        for (int b = 0; b < 256; ++b) count[b + 1] += count[b];
+        for (uint64_t k : keys) tmp[count[(k >> shift) & 0xFF]++] = k;
+        keys.swap(tmp);
+    }
+}
+
+// Settle one full board: evaluate every candidate the runout leaves
+// possible, sort by value and sweep
+void settle_runout(const Candidates& cand, const std::array<int, 5>& full_board,
+                   CardSet runout, Accumulator& acc) {
+    const size_t n = cand.holes.size();
+    std::vector<TableEvaluator::HolePair> holes;
+    std::vector<uint32_t> pos;
+    holes.reserve(n);
+    pos.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto [c1, c2] = cand.holes[i];
+        if (runout.contains(c1) || runout.contains(c2)) continue;
+        holes.push_back(cand.holes[i]);
+        pos.push_back(static_cast<uint32_t>(i));
+    }
+    if (holes.empty()) return;
+
+    std::vector<HandValue> values(holes.size());
+    TableEvaluator::evaluate_batch(full_board, holes, values);
+
+    // Sort by value; the low 32 bits carry the position in holes
+    std::vector<uint64_t> order(holes.size());
+    for (size_t i = 0; i < holes.size(); ++i) {
+        order[i] = (static_cast<uint64_t>(values[i].value) << 32) | i;
+    }
+    radix_sort_values(order);
+
+    // Villain weight per card: in total, strictly below the current value,
+    // and at it
+    double with_card[DECK_SIZE] = {};
+    double total = 0.0;
+    for (size_t i = 0; i < holes.size(); ++i) {
+        const double w = cand.villain[pos[i]];
+        with_card[holes[i][0]] += w;
+        with_card[holes[i][1]] += w;
+        total += w;
+    }
+    double below_card[DECK_SIZE] = {};
+    double tied_card[DECK_SIZE] = {};
+    double below = 0.0;
+
+    // Tolerance for weights that cancel to zero
+    const double eps = 1e-12 * total;
+
+    double win_r = 0.0;
+    double tie_r = 0.0;
+    double total_r = 0.0;
+
+    // Villain combos of {a, b} are those sharing neither card. Only {a, b}
+    // itself holds both, so it is subtracted twice and added back once.
+    for (size_t start = 0; start < order.size();) {
+        const uint32_t value = static_cast<uint32_t>(order[start] >> 32);
+        size_t end = start;
+        double tied = 0.0;
+        while (end < order.size() && static_cast<uint32_t>(order[end] >> 32) == value) {
+            const uint32_t i = static_cast<uint32_t>(order[end]);
+            const double w = cand.villain[pos[i]];
+            tied_card[holes[i][0]] += w;
+            tied_card[holes[i][1]] += w;
+            tied += w;
+            ++end;
+        }
+
+        for (size_t k = start; k < end; ++k) {
+            const uint32_t i = static_cast<uint32_t>(order[k]);
+            const double wh = cand.hero[pos[i]];
+            if (wh == 0.0) continue;
+            const auto [a, b] = holes[i];
+            const double self = cand.villain[pos[i]];
+            const double opponents = total - with_card[a] - with_card[b] + self;
+            if (opponents <= eps) continue;
+            const double wins = below - below_card[a] - below_card[b];
+            const double ties = tied - tied_card[a] - tied_card[b] + self;
+
+            win_r += wh * wins;
+            tie_r += wh * ties;
+            total_r += wh * opponents;
+            acc.hand_share[cand.index[pos[i]]] += wins + 0.5 * ties;
+            acc.hand_total[cand.index[pos[i]]] += opponents;
+        }
+
+        for (size_t k = start; k < end; ++k) {
+            const uint32_t i = static_cast<uint32_t>(order[k]);
+            const double w = cand.villain[pos[i]];
+            below_card[holes[i][0]] += w;
+            below_card[holes[i][1]] += w;
+            tied_card[holes[i][0]] -= w;
+            tied_card[holes[i][1]] -= w;
+        }
+        below += tied;
+        start = end;
+    }
+
+    const double share_r = win_r + 0.5 * tie_r;
+    acc.win += win_r;
+    acc.tie += tie_r;
+    acc.total += total_r;
+    acc.share_sq += share_r * share_r;
+    acc.total_sq += total_r * total_r;
+    acc.share_total += share_r * total_r;
+}
+
+void check_range(const HandRange& range, const char* name) {
+    for (double w : range.weights) {
+        if (!std::isfinite(w) || w < 0.0) {
+            throw std::invalid_argument(std::string(name) + " range has a negative or non-finite weight");
+        }
+    }
+}
+
+} // namespace
+
+EquityResult RangeEquity::compute(const HandRange& hero, const HandRange& villain,
+                                  CardSet board, CardSet dead, const EquityConfig& config) {
+    check_range(hero, "Hero");
+    check_range(villain, "Villain");
+    const int num_board = board.size();
+    if (num_board > 5) {
+        throw std::invalid_argument("Board has more than 5 cards");
+    }
+    if (board.intersects(dead)) {
+        throw std::invalid_argument("Board and dead cards overlap");
+    }
+    const bool exact = config.samples <= 0;
+    if (exact && num_board < 3) {
+        throw std::invalid_argument("Exact range equity needs a flop, turn or river board");
+    }
+
+    Candidates cand;
+    const CardSet blocked = board | dead;
+    const auto& combos = hole_combos();
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        if (hero.weights[i] == 0.0 && villain.weights[i] == 0.0) continue;
+        if (blocked.contains(combos[i][0]) || blocked.contains(combos[i][1])) continue;
+        cand.holes.push_back(combos[i]);
+        cand.index.push_back(i);
+        cand.hero.push_back(hero.weights[i]);
+        cand.villain.push_back(villain.weights[i]);
+    }
+
+    std::array<int, DECK_SIZE> live;
+    const int num_live = (~blocked).to_cards(live.data());
+    std::array<int, 5> board_cards{};
+    board.to_cards(board_cards.data());
+    const int to_come = 5 - num_board;
+
+    // Exact: every runout of the remaining one or two cards (or none)
+    std::vector<std::array<int, 2>> runouts;
+    if (exact) {
+        if (to_come == 0) runouts.push_back({-1, -1});
+        for (int i = 0; i < num_live && to_come > 0; ++i) {
+            if (to_come == 1) {
+                runouts.push_back({live[i], -1});
+                continue;
+            }
+            for (int j = i + 1; j < num_live; ++j) runouts.push_back({live[i], live[j]});
+        }
+    }
+    const int64_t num_runouts = exact ? static_cast<int64_t>(runouts.size()) : config.samples;
+    const uint64_t seed = config.seed;
+
+    const int num_chunks = static_cast<int>(std::min<int64_t>(NUM_CHUNKS, num_runouts));
+    std::vector<Accumulator> chunks(num_chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        const int64_t first = num_runouts * chunk / num_chunks;
+        const int64_t last = num_runouts * (chunk + 1) / num_chunks;
+        for (int64_t r = first; r < last; ++r) {
+            std::array<int, 5> full_board = board_cards;
+            CardSet runout;
+            if (exact) {
+                for (int k = 0; k < to_come; ++k) runout.insert(runouts[r][k]);
+            } else {
+                parallel::CounterRng rng(seed, static_cast<uint64_t>(r));
+                while (runout.size() < to_come) {
+                    runout.insert(live[rng.below(static_cast<uint32_t>(num_live))]);
+                }
+            }
+            runout.to_cards(full_board.data() + num_board);
+            settle_runout(cand, full_board, runout, chunks[chunk]);
+        }
+    }
+
+    Accumulator sum;
+    for (const auto& c : chunks) sum.merge(c);
+    if (sum.total <= 0.0) {
+        throw std::invalid_argument("No hero and villain combos can meet on this board");
+    }
+
+    EquityResult result;
+    result.exact = exact;
+    result.runouts = num_runouts;
+    result.win = sum.win / sum.total;
+    result.tie = sum.tie / sum.total;
+    result.equity = result.win + 0.5 * result.tie;
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        result.hand_equity[i] = (hero.weights[i] > 0.0 && sum.hand_total[i] > 0.0)
+            ? sum.hand_share[i] / sum.hand_total[i] : -1.0;
+    }
+
+    // Ratio estimator: Var(sum share_r / sum total_r) is about
+    // sum (share_r - equity * total_r)^2 / (n (n - 1) mean_total^2)
+    if (!exact && num_runouts > 1) {
+        const double n = static_cast<double>(num_runouts);
+        const double e = result.equity;
+        const double resid = sum.share_sq - 2.0 * e * sum.share_total + e * e * sum.total_sq;
+        const double mean_total = sum.total / n;
+        result.std_error = std::sqrt(std::max(0.0, resid) / (n * (n - 1.0))) / mean_total;
+    }
+    return result;
+}
+
+} // namespace quantnet::poker
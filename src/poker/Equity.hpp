@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Weights over the 1326 hole combos, indexed by hole_combo_index.
+// Weights are relative; a combo of weight 0 is not in the range.
+struct HandRange {
+    std::array<double, NUM_HOLE_COMBOS> weights{};
+
+    // Every combo at weight 1
+    static HandRange full() {
+        HandRange r;
+        r.weights.fill(1.0);
+        return r;
+    }
+
+    double weight(int c1, int c2) const { return weights[hole_combo_index(c1, c2)]; }
+    void set(int c1, int c2, double w) { weights[hole_combo_index(c1, c2)] = w; }
+};
+
+// How RangeEquity counts runouts
+struct EquityConfig {
+    int samples = 0;     // 0 = enumerate every runout exactly (board of 3-5
+                         // cards); otherwise draw this many at random
+    uint64_t seed = 0;   // Sampled mode: the same seed gives the same result
+                         // on any number of threads
+};
+
+struct EquityResult {
+    double equity = 0.0;      // Hero's expected share of the pot
+    double win = 0.0;         // Probability hero wins outright
+    double tie = 0.0;         // Probability the pot is split
+    double std_error = 0.0;   // Standard error of equity (0 when exact)
+    int64_t runouts = 0;      // Runouts enumerated or sampled
+    bool exact = true;
+
+    // Equity of each hero combo against the villain range, -1 for combos
+    // with no weight or no possible opponent
+    std::array<double, NUM_HOLE_COMBOS> hand_equity;
+
+    // equity +- z standard errors, clipped to [0, 1]
+    std::pair<double, double> confidence_interval(double z = 1.96) const;
+};
+
+// Range-vs-range equity
+//
+// Every (hero combo, villain combo, runout) with no card in common counts
+// with weight hero[h] * villain[v]; runouts are equally likely.
+//
+// Each runout is settled with one board-shared batch evaluation of every
+// combo either range holds, a sort by value and one sweep. The sweep keeps
+// the villain weight below and tied with the current value, in total and
+// per card, so each hero combo's wins and ties against the villain combos
+// that share none of its cards take O(1) (as in
+// HandEvaluator::hand_strengths). A full range against a full range on the
+// flop is about 1200 runouts of ~1000 evaluations each.
+//
+// Runouts are split into a fixed number of chunks summed in order, and the
+// chunks are spread over OpenMP threads, so results do not depend on the
+// thread count. Sampled runouts come from parallel::CounterRng streams.
+class RangeEquity {
+public:
+    // Throws std::invalid_argument if a weight is negative or not finite,
+    // the board has more than 5 cards or meets the dead cards, exact mode
+    // is asked for before the flop, or no hero and villain combos can meet.
+    static EquityResult compute(const HandRange& hero, const HandRange& villain,
+                                CardSet board, CardSet dead = {},
+                                const EquityConfig& config = {});
+};
+
+} // namespace quantnet::poker
@@ -2,6 +2,7 @@
 #include <limits>
 #include <cmath>
 #include <map>
+#include <vector>
 
 namespace quantnet::poker {
 
@@ -152,6 +153,114 @@ double br_recursive(
 
 } // namespace detail
 
+namespace {
+
+// State for one infoset-respecting best response computation
+struct BestResponseState {
+    const Strategy& sigma;
+    PlayerId br_player;
+
+    // BR player's nodes grouped by info set, with counterfactual reach
+    // (opponent * chance) of each node
+    std::map<InfoSetId, std::vector<std::pair<const GameNode*, double>>> info_set_nodes;
+
+    // Memoized best action index per info set and value per node
+    std::map<InfoSetId, int> best_action;
+    std::map<const GameNode*, double> node_value;
+
+    void collect(const GameNode* node, double cf_reach) {
+        if (!node) return;
+
+        switch (node->type) {
+            case NodeType::Terminal:
+                return;
+
+            case NodeType::Chance:
+                for (const auto& edge : node->children) {
+                    collect(edge.child.get(), cf_reach * edge.probability);
+                }
+                return;
+
+            case NodeType::Player:
+                if (node->player == br_player) {
+                    info_set_nodes[node->info_set_id].push_back({node, cf_reach});
+                    for (const auto& edge : node->children) {
+                        collect(edge.child.get(), cf_reach);
+                    }
+                } else {
+                    Eigen::VectorXd probs = sigma.probs(node->info_set_id);
+                    for (size_t i = 0; i < node->children.size(); ++i) {
+                        collect(node->children[i].child.get(),
+                                cf_reach * probs(static_cast<int>(i)));
+                    }
+                }
+                return;
+        }
+    }
+
+    int choose_action(const InfoSetId& id) {
+        auto it = best_action.find(id);
+        if (it != best_action.end()) return it->second;
+
+        const auto& nodes = info_set_nodes.at(id);
+        const int num_actions = static_cast<int>(nodes.front().first->children.size());
+
+        int best = 0;
+        double best_cfv = -std::numeric_limits<double>::infinity();
+        for (int a = 0; a < num_actions; ++a) {
+            double cfv = 0.0;
+            for (const auto& [node, cf_reach] : nodes) {
+                cfv += cf_reach * value(node->children[a].child.get());
+            }
+            if (cfv > best_cfv) {
+                best_cfv = cfv;
+                best = a;
+            }
+        }
+
+        best_action[id] = best;
+        return best;
+    }
+
+    // Expected payoff to br_player from node onward (chance and opponent
+    // weighted from here down, BR player following its chosen actions)
+    double value(const GameNode* node) {
+        if (!node) return 0.0;
+
+        auto memo = node_value.find(node);
+        if (memo != node_value.end()) return memo->second;
+
+        double v = 0.0;
+        switch (node->type) {
+            case NodeType::Terminal:
+                v = (br_player == PLAYER_0) ? node->payoff : -node->payoff;
+                break;
+
+            case NodeType::Chance:
+                for (const auto& edge : node->children) {
+                    v += edge.probability * value(edge.child.get());
+                }
+                break;
+
+            case NodeType::Player:
+                if (node->player == br_player) {
+                    v = value(node->children[choose_action(node->info_set_id)].child.get());
+                } else {
+                    Eigen::VectorXd probs = sigma.probs(node->info_set_id);
+                    for (size_t i = 0; i < node->children.size(); ++i) {
+                        v += probs(static_cast<int>(i)) * value(node->children[i].child.get());
+                    }
+                }
+                break;
+        }
+
+        node_value[node] = v;
+        return v;
+    }
+};
+
+} // namespace
+
 double compute_ev(const GameNode* root, const Strategy& sigma) {
     return detail::ev_recursive(root, sigma, 1.0, 1.0, 1.0, std::nullopt);
 }
@@ -237,4 +346,20 @@ double compute_exploitability(const GameNode* root, const Strategy& sigma) {
     return (br0 + br1) / 2.0;
 }
 
+double infoset_best_response_value(
+    const GameNode* root,
+    const Strategy& sigma,
+    PlayerId br_player
+) {
+    BestResponseState state{sigma, br_player, {}, {}, {}};
+    state.collect(root, 1.0);
+    return state.value(root);
+}
+
+double compute_infoset_exploitability(const GameNode* root, const Strategy& sigma) {
+    double br0 = infoset_best_response_value(root, sigma, PLAYER_0);
+    double br1 = infoset_best_response_value(root, sigma, PLAYER_1);
+    return (br0 + br1) / 2.0;
+}
+
 } // namespace quantnet::poker
@@ -53,6 +53,21 @@ double best_response_value(
 // At Nash equilibrium, exploitability = 0
 double compute_exploitability(const GameNode* root, const Strategy& sigma);
 
+// Best response value where the BR player commits to one action per info set,
+// chosen to maximize counterfactual value summed over the histories in it.
+// best_response_value() chooses per history, which lets the BR player see the
+// opponent's private card, so it is an upper bound on this value.
+double infoset_best_response_value(
+    const GameNode* root,
+    const Strategy& sigma,
+    PlayerId br_player
+);
+
+// Exploitability against info-set-respecting best responses
+// Exactly 0 at a Nash equilibrium, so this is the measure to use for
+// time-to-epsilon comparisons between solvers.
+double compute_infoset_exploitability(const GameNode* root, const Strategy& sigma);
+
 // ============================================================================
 // Internal implementation details
 // ============================================================================
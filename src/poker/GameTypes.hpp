@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <optional>
 #include <cstdint>
 
 namespace quantnet::poker {
@@ -49,6 +50,15 @@ inline char action_to_char(Action a) {
     return '?';
 }
 
+// Inverse of action_to_char; nullopt if c is no action's letter
+inline std::optional<Action> char_to_action(char c) {
+    for (int i = 0; i <= static_cast<int>(Action::Raise); ++i) {
+        const Action a = static_cast<Action>(i);
+        if (action_to_char(a) == c) return a;
+    }
+    return std::nullopt;
+}
+
 // Node types in the game tree
 enum class NodeType : uint8_t {
     Chance,    // Nature deals cards
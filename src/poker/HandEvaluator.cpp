@@ -1,12 +1,13 @@
 #include "HandEvaluator.hpp"
+#include "TableEvaluator.hpp"
+#include "../parallel/CounterRng.hpp"
 #include <algorithm>
 #include <stdexcept>
-#include <random>
 
 namespace quantnet::poker {
 
 HandValue HandEvaluator::evaluate(const std::array<int, 7>& cards) {
-    return evaluate(std::vector<int>(cards.begin(), cards.end()));
+    return evaluate(std::span<const int>(cards));
 }
 
 HandValue HandEvaluator::evaluate(const std::array<int, 2>& hole,
@@ -20,7 +21,16 @@ HandValue HandEvaluator::evaluate(const std::array<int, 2>& hole,
     return evaluate(all_cards);
 }
 
-HandValue HandEvaluator::evaluate(const std::vector<int>& cards) {
+HandValue HandEvaluator::evaluate(CardSet cards) {
+    std::array<int, DECK_SIZE> buffer;
+    const int n = cards.to_cards(buffer.data());
+    if (n >= 5 && n <= 7) {
+        return TableEvaluator::evaluate(buffer.data(), n);
+    }
+    return evaluate(std::span<const int>(buffer.data(), n));
+}
+
+HandValue HandEvaluator::evaluate(std::span<const int> cards) {
     if (cards.size() < 5) {
         throw std::invalid_argument("Need at least 5 cards to evaluate");
     }
@@ -41,20 +51,14 @@ HandValue HandEvaluator::evaluate(const std::vector<int>& cards) {
     int flush_suit = find_flush_suit(cards.data(), n);
 
     if (flush_suit >= 0) {
-        // Extract flush cards
-        std::vector<int> flush_cards;
+        // Build flush rank mask
+        uint16_t flush_mask = 0;
         for (int card : cards) {
             if (card_suit(card) == flush_suit) {
-                flush_cards.push_back(card);
+                flush_mask |= (1 << card_rank(card));
             }
         }
 
-        // Build flush rank mask
-        uint16_t flush_mask = 0;
-        for (int card : flush_cards) {
-            flush_mask |= (1 << card_rank(card));
-        }
-
         // Check for straight flush
         int sf_high = find_straight_high(flush_mask);
         if (sf_high >= 0) {
@@ -62,43 +66,48 @@ HandValue HandEvaluator::evaluate(const std::vector<int>& cards) {
         }
 
         // Regular flush - top 5 flush cards
-        std::vector<int> flush_ranks;
-        for (int card : flush_cards) {
-            flush_ranks.push_back(card_rank(card));
+        int flush_ranks[5];
+        int num_flush = 0;
+        for (int r = NUM_RANKS - 1; r >= 0 && num_flush < 5; --r) {
+            if (flush_mask & (1 << r)) flush_ranks[num_flush++] = r;
         }
-        std::sort(flush_ranks.begin(), flush_ranks.end(), std::greater<int>());
 
         return make_value(HandRank::Flush,
                          flush_ranks[0], flush_ranks[1], flush_ranks[2],
                          flush_ranks[3], flush_ranks[4]);
     }
 
-    // Find quads, trips, pairs
-    std::vector<int> quads, trips, pairs, singles;
+    // Find quads, trips, pairs (highest rank first)
+    int quads[NUM_RANKS], trips[NUM_RANKS], pairs[NUM_RANKS], singles[NUM_RANKS];
+    int num_quads = 0, num_trips = 0, num_pairs = 0, num_singles = 0;
     for (int r = NUM_RANKS - 1; r >= 0; --r) {
         switch (rank_counts[r]) {
-            case 4: quads.push_back(r); break;
-            case 3: trips.push_back(r); break;
-            case 2: pairs.push_back(r); break;
-            case 1: singles.push_back(r); break;
+            case 4: quads[num_quads++] = r; break;
+            case 3: trips[num_trips++] = r; break;
+            case 2: pairs[num_pairs++] = r; break;
+            case 1: singles[num_singles++] = r; break;
         }
     }
 
     // Four of a kind
-    if (!quads.empty()) {
-        int kicker = -1;
-        if (!trips.empty()) kicker = trips[0];
-        else if (!pairs.empty()) kicker = pairs[0];
-        else if (!singles.empty()) kicker = singles[0];
+    if (num_quads > 0) {
+        // Kicker: highest other rank, whatever its count
+        int kicker = 0;
+        for (int r = NUM_RANKS - 1; r >= 0; --r) {
+            if (r != quads[0] && rank_counts[r] > 0) {
+                kicker = r;
+                break;
+            }
+        }
         return make_value(HandRank::FourOfAKind, quads[0], kicker);
     }
 
     // Full house (trips + pair, or two trips)
-    if (!trips.empty()) {
-        if (trips.size() >= 2) {
+    if (num_trips > 0) {
+        if (num_trips >= 2) {
             return make_value(HandRank::FullHouse, trips[0], trips[1]);
         }
-        if (!pairs.empty()) {
+        if (num_pairs > 0) {
             return make_value(HandRank::FullHouse, trips[0], pairs[0]);
         }
     }
@@ -109,36 +118,31 @@ HandValue HandEvaluator::evaluate(const std::vector<int>& cards) {
         return make_value(HandRank::Straight, straight_high);
     }
 
-    // Three of a kind
-    if (!trips.empty()) {
-        // Get top 2 kickers
-        std::vector<int> kickers;
-        for (int r : pairs) kickers.push_back(r);
-        for (int r : singles) kickers.push_back(r);
-        std::sort(kickers.begin(), kickers.end(), std::greater<int>());
-
+    // Three of a kind: no pairs here (that would be a full house), so the
+    // kickers are the top two singles
+    if (num_trips > 0) {
         return make_value(HandRank::ThreeOfAKind, trips[0],
-                         kickers.size() > 0 ? kickers[0] : 0,
-                         kickers.size() > 1 ? kickers[1] : 0);
+                         num_singles > 0 ? singles[0] : 0,
+                         num_singles > 1 ? singles[1] : 0);
     }
 
     // Two pair
-    if (pairs.size() >= 2) {
+    if (num_pairs >= 2) {
         // Best kicker from remaining pairs or singles
         int kicker = 0;
-        if (pairs.size() > 2) kicker = pairs[2];
-        else if (!singles.empty()) kicker = singles[0];
+        if (num_pairs > 2) kicker = pairs[2];
+        if (num_singles > 0) kicker = std::max(kicker, singles[0]);
 
         return make_value(HandRank::TwoPair, pairs[0], pairs[1], kicker);
     }
 
     // One pair
-    if (pairs.size() == 1) {
+    if (num_pairs == 1) {
         // Top 3 kickers from singles
         return make_value(HandRank::Pair, pairs[0],
-                         singles.size() > 0 ? singles[0] : 0,
-                         singles.size() > 1 ? singles[1] : 0,
-                         singles.size() > 2 ? singles[2] : 0);
+                         num_singles > 0 ? singles[0] : 0,
+                         num_singles > 1 ? singles[1] : 0,
+                         num_singles > 2 ? singles[2] : 0);
     }
 
     // High card
@@ -160,47 +164,43 @@ int HandEvaluator::compare(const std::array<int, 2>& hand1,
 
 double HandEvaluator::hand_strength(const std::array<int, 2>& hole,
                                     const std::vector<int>& board) {
-    // Mark cards that are used
-    bool used[DECK_SIZE] = {false};
-    used[hole[0]] = true;
-    used[hole[1]] = true;
-    for (int card : board) {
-        used[card] = true;
-    }
-
-    // Build all cards for our hand
-    std::vector<int> our_cards(hole.begin(), hole.end());
-    for (int card : board) {
-        our_cards.push_back(card);
-    }
+    return hand_strength(CardSet::of(hole), CardSet::of(board));
+}
 
+double HandEvaluator::hand_strength(CardSet hole, CardSet board, CardSet dead) {
     // Need 5+ cards to evaluate
-    if (our_cards.size() < 5) {
+    if ((hole | board).size() < 5) {
         return 0.5;  // Not enough cards, return 50%
     }
 
-    HandValue our_value = evaluate(our_cards);
-
-    // Enumerate opponent hands
-    int wins = 0, losses = 0, ties = 0;
-
-    for (int c1 = 0; c1 < DECK_SIZE; ++c1) {
-        if (used[c1]) continue;
-        for (int c2 = c1 + 1; c2 < DECK_SIZE; ++c2) {
-            if (used[c2]) continue;
-
-            // Build opponent hand
-            std::vector<int> opp_cards = {c1, c2};
-            for (int card : board) {
-                opp_cards.push_back(card);
-            }
+    HandValue our_value = evaluate(hole | board);
+
+    // Enumerate opponent hands from the cards nobody holds and evaluate
+    // them against the shared board in one batch
+    const CardSet live = ~(hole | board | dead);
+    std::array<TableEvaluator::HolePair, 1326> opponents;
+    size_t num_opponents = 0;
+    for (int c1 : live) {
+        // Cards above c1
+        const CardSet above(live.bits() & ~((uint64_t{2} << c1) - 1));
+        for (int c2 : above) {
+            opponents[num_opponents++] = {c1, c2};
+        }
+    }
 
-            HandValue opp_value = evaluate(opp_cards);
+    std::array<int, DECK_SIZE> board_cards;
+    const int num_board = board.to_cards(board_cards.data());
+    std::array<HandValue, 1326> opp_values;
+    TableEvaluator::evaluate_batch(
+        std::span<const int>(board_cards.data(), num_board),
+        std::span<const TableEvaluator::HolePair>(opponents.data(), num_opponents),
+        std::span<HandValue>(opp_values.data(), num_opponents));
 
-            if (our_value > opp_value) ++wins;
-            else if (our_value < opp_value) ++losses;
-            else ++ties;
-        }
+    int wins = 0, losses = 0, ties = 0;
+    for (size_t i = 0; i < num_opponents; ++i) {
+        if (our_value > opp_values[i]) ++wins;
+        else if (our_value < opp_values[i]) ++losses;
+        else ++ties;
     }
 
     int total = wins + losses + ties;
@@ -210,137 +210,244 @@ double HandEvaluator::hand_strength(const std::array<int, 2>& hole,
     return (wins + 0.5 * ties) / total;
 }
 
+std::array<double, NUM_HOLE_COMBOS> HandEvaluator::hand_strengths(CardSet board, CardSet dead) {
+    std::array<double, NUM_HOLE_COMBOS> strengths;
+    strengths.fill(-1.0);
+
+    // Every live hole pair against the board
+    const CardSet live = ~(board | dead);
+    std::vector<TableEvaluator::HolePair> holes;
+    holes.reserve(NUM_HOLE_COMBOS);
+    for (const auto& combo : hole_combos()) {
+        if (live.contains(combo[0]) && live.contains(combo[1])) holes.push_back(combo);
+    }
+    if (holes.empty()) return strengths;
+
+    std::array<int, DECK_SIZE> board_cards;
+    const int num_board = board.to_cards(board_cards.data());
+    std::vector<HandValue> values(holes.size());
+    TableEvaluator::evaluate_batch(std::span<const int>(board_cards.data(), num_board), holes, values);
+
+    std::vector<uint32_t> order(holes.size());
+    for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return values[a] < values[b];
+    });
+
+    // Hands per card: in total, strictly below the current value, and at it
+    int with_card[DECK_SIZE] = {};
+    for (const auto& [c1, c2] : holes) {
+        ++with_card[c1];
+        ++with_card[c2];
+    }
+    int below_card[DECK_SIZE] = {};
+    int tied_card[DECK_SIZE] = {};
+    const int num_hands = static_cast<int>(holes.size());
+    int below = 0;
+
+    // Opponents of {a, b} are the hands sharing neither card. Only {a, b}
+    // itself holds both, so it is subtracted twice and added back once.
+    for (size_t start = 0; start < order.size();) {
+        size_t end = start;
+        while (end < order.size() && values[order[end]] == values[order[start]]) {
+            const auto [c1, c2] = holes[order[end]];
+            ++tied_card[c1];
+            ++tied_card[c2];
+            ++end;
+        }
+        const int tied = static_cast<int>(end - start);
+
+        for (size_t i = start; i < end; ++i) {
+            const auto [a, b] = holes[order[i]];
+            const int total = num_hands - with_card[a] - with_card[b] + 1;
+            const int wins = below - below_card[a] - below_card[b];
+            const int ties = tied - tied_card[a] - tied_card[b] + 1;
+            strengths[hole_combo_index(a, b)] = (total == 0) ? 0.5 : (wins + 0.5 * ties) / total;
+        }
+
+        for (size_t i = start; i < end; ++i) {
+            const auto [c1, c2] = holes[order[i]];
+            ++below_card[c1];
+            ++below_card[c2];
+            --tied_card[c1];
+            --tied_card[c2];
+        }
+        below += tied;
+        start = end;
+    }
+    return strengths;
+}
+
 std::pair<double, double> HandEvaluator::hand_potential(
     const std::array<int, 2>& hole,
     const std::vector<int>& board) {
+    return hand_potential(CardSet::of(hole), CardSet::of(board));
+}
 
-    // This is a simplified version - full implementation would enumerate
-    // remaining cards and compute potential
+std::pair<double, double> HandEvaluator::hand_potential(
+    CardSet hole, CardSet board, CardSet dead) {
+    // Exact where it is affordable
+    PotentialConfig config;
+    if (board.size() < 3) config.samples = 10000;
+    return hand_potential(hole, board, dead, config);
+}
 
-    // Mark used cards
-    bool used[DECK_SIZE] = {false};
-    used[hole[0]] = true;
-    used[hole[1]] = true;
-    for (int card : board) {
-        used[card] = true;
-    }
+namespace {
 
-    // Get unused cards
-    std::vector<int> deck;
-    for (int c = 0; c < DECK_SIZE; ++c) {
-        if (!used[c]) deck.push_back(c);
-    }
+// Showdown result from our side
+enum Outcome { AHEAD = 0, TIED = 1, BEHIND = 2 };
 
-    if (board.size() >= 5) {
-        // No more cards to come
-        return {0.0, 0.0};
-    }
+int outcome(HandValue ours, HandValue theirs) {
+    if (ours > theirs) return AHEAD;
+    if (ours == theirs) return TIED;
+    return BEHIND;
+}
+
+// hp[now * 3 + river]: (opponent, runout) pairs by outcome now and at the
+// river
+std::pair<double, double> potential_from_counts(const int64_t* hp) {
+    auto at = [hp](int now, int river) { return static_cast<double>(hp[now * 3 + river]); };
+    auto total = [&](int now) { return at(now, AHEAD) + at(now, TIED) + at(now, BEHIND); };
+
+    // Ppot = (HP[b][a] + HP[b][t]/2 + HP[t][a]/2) / (HPtotal[b] + HPtotal[t]/2)
+    // Npot = (HP[a][b] + HP[a][t]/2 + HP[t][b]/2) / (HPtotal[a] + HPtotal[t]/2)
+    const double behind = total(BEHIND) + total(TIED) / 2;
+    const double ahead = total(AHEAD) + total(TIED) / 2;
+    const double ppot = behind > 0
+        ? (at(BEHIND, AHEAD) + at(BEHIND, TIED) / 2 + at(TIED, AHEAD) / 2) / behind : 0.0;
+    const double npot = ahead > 0
+        ? (at(AHEAD, BEHIND) + at(AHEAD, TIED) / 2 + at(TIED, BEHIND) / 2) / ahead : 0.0;
+    return {ppot, npot};
+}
 
-    // Sample-based estimation for efficiency
-    // Full enumeration would be O(C(45,2) * C(43,5-board_size) * C(remaining,2))
+} // namespace
 
-    // For simplicity, return basic estimates based on board size
-    size_t cards_to_come = 5 - board.size();
+std::pair<double, double> HandEvaluator::hand_potential(
+    CardSet hole, CardSet board, CardSet dead, const PotentialConfig& config) {
 
-    if (cards_to_come == 0) {
+    if (hole.size() != 2) {
+        throw std::invalid_argument("Hand potential needs exactly two hole cards");
+    }
+    if (hole.intersects(board) || hole.intersects(dead) || board.intersects(dead)) {
+        throw std::invalid_argument("Hole, board and dead cards overlap");
+    }
+    const int num_board = board.size();
+    if (num_board >= 5) {
+        // No more cards to come
         return {0.0, 0.0};
     }
-
-    // Build our current hand
-    std::vector<int> our_cards(hole.begin(), hole.end());
-    for (int card : board) {
-        our_cards.push_back(card);
+    if (config.samples <= 0 && num_board < 3) {
+        throw std::invalid_argument("Exact hand potential needs a flop or turn board");
     }
 
-    // Sample opponent hands and future boards
-    const int SAMPLES = 500;
-    int ahead_stays_ahead = 0, ahead_falls_behind = 0;
-    int behind_catches_up = 0, behind_stays_behind = 0;
-    int tied_wins = 0, tied_loses = 0;
-
-    std::vector<int> shuffled_deck = deck;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    for (int sample = 0; sample < SAMPLES; ++sample) {
-        // Shuffle deck for random sampling
-        std::shuffle(shuffled_deck.begin(), shuffled_deck.end(), gen);
-
-        // Pick opponent hole cards
-        int opp1 = shuffled_deck[0];
-        int opp2 = shuffled_deck[1];
+    std::array<int, DECK_SIZE> live;
+    const int num_live = (~(hole | board | dead)).to_cards(live.data());
+    const int to_come = 5 - num_board;
+
+    // Board and hole summed once; each opponent and runout extends them
+    std::array<int, 5> board_cards;
+    board.to_cards(board_cards.data());
+    std::array<int, 2> hole_cards;
+    hole.to_cards(hole_cards.data());
+    using TE = TableEvaluator;
+    const TE::PartialHand board_part = TE::partial(std::span<const int>(board_cards.data(), num_board));
+    const TE::PartialHand our_part = TE::add(TE::add(board_part, hole_cards[0]), hole_cards[1]);
+    const bool made_now = num_board >= 3;
+    const HandValue our_now = made_now ? TE::evaluate(our_part) : HandValue();
+
+    int64_t hp[9] = {};
+
+    if (config.samples > 0) {
+        // Each sample draws the opponent's hole and the runout from its own
+        // counter-based stream, so results do not depend on threading
+        const int64_t samples = config.samples;
+        const uint64_t seed = config.seed;
+
+#ifdef _OPENMP
+        #pragma omp parallel for reduction(+:hp[:9]) schedule(static)
+#endif
+        for (int64_t sample = 0; sample < samples; ++sample) {
+            parallel::CounterRng rng(seed, static_cast<uint64_t>(sample));
+            int drawn[7];
+            CardSet used;
+            for (int k = 0; k < 2 + to_come; ++k) {
+                int c;
+                do {
+                    c = live[rng.below(static_cast<uint32_t>(num_live))];
+                } while (used.contains(c));
+                used.insert(c);
+                drawn[k] = c;
+            }
 
-        // Current hand comparison
-        std::vector<int> opp_cards = {opp1, opp2};
-        for (int card : board) {
-            opp_cards.push_back(card);
+            TE::PartialHand ours = our_part;
+            TE::PartialHand theirs = TE::add(TE::add(board_part, drawn[0]), drawn[1]);
+            const int now = made_now ? outcome(our_now, TE::evaluate(theirs)) : TIED;
+            for (int k = 2; k < 2 + to_come; ++k) {
+                ours = TE::add(ours, drawn[k]);
+                theirs = TE::add(theirs, drawn[k]);
+            }
+            ++hp[now * 3 + outcome(TE::evaluate(ours), TE::evaluate(theirs))];
         }
+        return potential_from_counts(hp);
+    }
 
-        // Fill to 5 cards minimum for evaluation
-        std::vector<int> our_current = our_cards;
-        std::vector<int> opp_current = opp_cards;
-
-        size_t deck_idx = 2;  // Start after opponent cards
+    // Exact: every opponent hole, evaluated now in one batch
+    std::vector<TE::HolePair> opponents;
+    for (int i = 0; i < num_live; ++i) {
+        for (int j = i + 1; j < num_live; ++j) opponents.push_back({live[i], live[j]});
+    }
+    std::vector<HandValue> opp_values(opponents.size());
+    TE::evaluate_batch(std::span<const int>(board_cards.data(), num_board), opponents, opp_values);
+    std::vector<uint8_t> now(opponents.size());
+    for (size_t i = 0; i < opponents.size(); ++i) {
+        now[i] = static_cast<uint8_t>(outcome(our_now, opp_values[i]));
+    }
 
-        while (our_current.size() < 5 && deck_idx < shuffled_deck.size()) {
-            int next_card = shuffled_deck[deck_idx++];
-            our_current.push_back(next_card);
-            opp_current.push_back(next_card);
+    // Every runout: one or two more cards
+    std::vector<std::array<int, 2>> runouts;
+    for (int i = 0; i < num_live; ++i) {
+        if (to_come == 1) {
+            runouts.push_back({live[i], -1});
+            continue;
         }
+        for (int j = i + 1; j < num_live; ++j) runouts.push_back({live[i], live[j]});
+    }
 
-        // Fill remaining board cards
-        while (our_current.size() < 7 && deck_idx < shuffled_deck.size()) {
-            int next_card = shuffled_deck[deck_idx++];
-            our_current.push_back(next_card);
-            opp_current.push_back(next_card);
+    // Per runout: the opponents it leaves possible, all evaluated on the
+    // full board in one batch
+    const int num_runouts = static_cast<int>(runouts.size());
+#ifdef _OPENMP
+    #pragma omp parallel for reduction(+:hp[:9]) schedule(dynamic, 4)
+#endif
+    for (int r = 0; r < num_runouts; ++r) {
+        std::array<int, 5> full_board = board_cards;
+        CardSet runout;
+        TE::PartialHand ours = our_part;
+        for (int k = 0; k < to_come; ++k) {
+            full_board[num_board + k] = runouts[r][k];
+            runout.insert(runouts[r][k]);
+            ours = TE::add(ours, runouts[r][k]);
         }
-
-        // Evaluate with partial board (5 cards)
-        std::vector<int> our_partial(our_cards);
-        std::vector<int> opp_partial(opp_cards);
-
-        // Pad to 5 if needed
-        size_t fill_idx = 2;
-        while (our_partial.size() < 5 && fill_idx < shuffled_deck.size()) {
-            int c = shuffled_deck[fill_idx++];
-            our_partial.push_back(c);
-            opp_partial.push_back(c);
+        const HandValue our_river = TE::evaluate(ours);
+
+        std::array<TE::HolePair, NUM_HOLE_COMBOS> possible;
+        std::array<uint8_t, NUM_HOLE_COMBOS> possible_now;
+        size_t num_possible = 0;
+        for (size_t i = 0; i < opponents.size(); ++i) {
+            if (runout.contains(opponents[i][0]) || runout.contains(opponents[i][1])) continue;
+            possible[num_possible] = opponents[i];
+            possible_now[num_possible++] = now[i];
         }
 
-        HandValue our_val_now = evaluate(our_partial);
-        HandValue opp_val_now = evaluate(opp_partial);
-
-        // Evaluate final
-        HandValue our_val_final = evaluate(our_current);
-        HandValue opp_val_final = evaluate(opp_current);
-
-        // Categorize
-        if (our_val_now > opp_val_now) {
-            // Currently ahead
-            if (our_val_final > opp_val_final) ahead_stays_ahead++;
-            else ahead_falls_behind++;
-        } else if (our_val_now < opp_val_now) {
-            // Currently behind
-            if (our_val_final > opp_val_final) behind_catches_up++;
-            else behind_stays_behind++;
-        } else {
-            // Currently tied
-            if (our_val_final > opp_val_final) tied_wins++;
-            else tied_loses++;
+        std::array<HandValue, NUM_HOLE_COMBOS> river;
+        TE::evaluate_batch(full_board,
+                           std::span<const TE::HolePair>(possible.data(), num_possible),
+                           std::span<HandValue>(river.data(), num_possible));
+        for (size_t i = 0; i < num_possible; ++i) {
+            ++hp[possible_now[i] * 3 + outcome(our_river, river[i])];
         }
     }
-
-    // Positive potential: P(win | currently behind or tied)
-    int behind_total = behind_catches_up + behind_stays_behind;
-    double ppot = behind_total > 0 ?
-        static_cast<double>(behind_catches_up) / behind_total : 0.0;
-
-    // Negative potential: P(lose | currently ahead or tied)
-    int ahead_total = ahead_stays_ahead + ahead_falls_behind;
-    double npot = ahead_total > 0 ?
-        static_cast<double>(ahead_falls_behind) / ahead_total : 0.0;
-
-    return {ppot, npot};
+    return potential_from_counts(hp);
 }
 
 } // namespace quantnet::poker
@@ -3,7 +3,9 @@
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <span>
 #include <string>
 
 namespace quantnet::poker {
@@ -86,6 +88,109 @@ inline std::string card_to_string(int card) {
            std::string(1, suit_char(card_suit(card)));
 }
 
+// Set of cards as a 52-bit mask (bit c = card c)
+//
+// Unions, intersections and dead-card filtering are single bitwise
+// operations, the size is a popcount, and iteration visits cards in
+// ascending order without allocating.
+class CardSet {
+public:
+    static constexpr uint64_t DECK_MASK = (uint64_t{1} << DECK_SIZE) - 1;
+
+    constexpr CardSet() = default;
+    constexpr explicit CardSet(uint64_t bits) : bits_(bits) {}
+
+    static constexpr CardSet single(int card) { return CardSet(uint64_t{1} << card); }
+    static constexpr CardSet full_deck() { return CardSet(DECK_MASK); }
+
+    static constexpr CardSet of(std::span<const int> cards) {
+        CardSet s;
+        for (int c : cards) s.insert(c);
+        return s;
+    }
+
+    constexpr uint64_t bits() const { return bits_; }
+    constexpr int size() const { return std::popcount(bits_); }
+    constexpr bool empty() const { return bits_ == 0; }
+    constexpr bool contains(int card) const { return (bits_ >> card) & 1; }
+    constexpr bool intersects(CardSet other) const { return (bits_ & other.bits_) != 0; }
+
+    constexpr void insert(int card) { bits_ |= uint64_t{1} << card; }
+    constexpr void erase(int card) { bits_ &= ~(uint64_t{1} << card); }
+
+    // Lowest card in a non-empty set
+    constexpr int lowest() const { return std::countr_zero(bits_); }
+
+    // Write the cards in ascending order to out; returns how many
+    constexpr int to_cards(int* out) const {
+        int n = 0;
+        for (int c : *this) out[n++] = c;
+        return n;
+    }
+
+    constexpr CardSet operator|(CardSet o) const { return CardSet(bits_ | o.bits_); }
+    constexpr CardSet operator&(CardSet o) const { return CardSet(bits_ & o.bits_); }
+    constexpr CardSet operator-(CardSet o) const { return CardSet(bits_ & ~o.bits_); }
+    constexpr CardSet operator~() const { return CardSet(~bits_ & DECK_MASK); }
+    constexpr CardSet& operator|=(CardSet o) { bits_ |= o.bits_; return *this; }
+    constexpr CardSet& operator&=(CardSet o) { bits_ &= o.bits_; return *this; }
+    constexpr CardSet& operator-=(CardSet o) { bits_ &= ~o.bits_; return *this; }
+    constexpr bool operator==(const CardSet&) const = default;
+
+    class iterator {
+    public:
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator() = default;
+        constexpr explicit iterator(uint64_t rest) : rest_(rest) {}
+
+        constexpr int operator*() const { return std::countr_zero(rest_); }
+        constexpr iterator& operator++() { rest_ &= rest_ - 1; return *this; }
+        constexpr iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        constexpr bool operator==(const iterator&) const = default;
+
+    private:
+        uint64_t rest_ = 0;
+    };
+
+    constexpr iterator begin() const { return iterator(bits_); }
+    constexpr iterator end() const { return iterator(0); }
+
+private:
+    uint64_t bits_ = 0;
+};
+
+// Two-card hole combos, indexed 0..1325 (colexicographic: {0,1}, {0,2},
+// {1,2}, {0,3}, ...)
+constexpr int NUM_HOLE_COMBOS = DECK_SIZE * (DECK_SIZE - 1) / 2;
+
+inline int hole_combo_index(int c1, int c2) {
+    const int hi = std::max(c1, c2);
+    const int lo = std::min(c1, c2);
+    return hi * (hi - 1) / 2 + lo;
+}
+
+// Cards of each combo, low card first
+inline const std::array<std::array<int, 2>, NUM_HOLE_COMBOS>& hole_combos() {
+    static const auto combos = [] {
+        std::array<std::array<int, 2>, NUM_HOLE_COMBOS> c{};
+        for (int hi = 1; hi < DECK_SIZE; ++hi) {
+            for (int lo = 0; lo < hi; ++lo) c[hole_combo_index(lo, hi)] = {lo, hi};
+        }
+        return c;
+    }();
+    return combos;
+}
+
+// How hand_potential counts (opponent hole, runout) pairs
+struct PotentialConfig {
+    int samples = 0;     // 0 = enumerate all of them exactly (board of 3-4
+                         // cards); otherwise draw this many at random
+    uint64_t seed = 0;   // Sampled mode: the same seed gives the same result
+                         // on any number of threads
+};
+
 // 7-card hand evaluator
 // Evaluates the best 5-card hand from 7 cards (2 hole + 5 board)
 class HandEvaluator {
@@ -99,7 +204,13 @@ public:
                              const std::array<int, 5>& board);
 
     // Evaluate any number of cards (finds best 5-card combination)
-    static HandValue evaluate(const std::vector<int>& cards);
+    static HandValue evaluate(const std::vector<int>& cards) {
+        return evaluate(std::span<const int>(cards));
+    }
+    static HandValue evaluate(std::span<const int> cards);
+
+    // Evaluate a set of 5 or more cards; 5-7 cards use TableEvaluator
+    static HandValue evaluate(CardSet cards);
 
     // Compare two hands given shared board
     // Returns: positive if hand1 wins, negative if hand2 wins, 0 if tie
@@ -112,14 +223,43 @@ public:
     static double hand_strength(const std::array<int, 2>& hole,
                                const std::vector<int>& board);
 
-    // Compute positive/negative potential
+    // Same over card sets (hole holds two cards); opponent hands touching
+    // `dead` are skipped
+    static double hand_strength(CardSet hole, CardSet board, CardSet dead = {});
+
+    // Hand strength of every hole combo on a 3-5 card board at once,
+    // indexed by hole_combo_index. Each live combo is evaluated once and
+    // the values sorted; a sweep then counts the hands each one beats and
+    // ties, less those sharing one of its cards, in O(n log n) overall.
+    // Entry i equals hand_strength(hole i, board, dead); combos touching the
+    // board or dead cards are -1.
+    static std::array<double, NUM_HOLE_COMBOS> hand_strengths(CardSet board, CardSet dead = {});
+
+    // Compute positive/negative potential (Billings et al.)
     // Returns {ppot, npot} where:
-    //   ppot = probability of improving to win
-    //   npot = probability of being outdrawn
+    //   ppot = probability of improving to win when behind (ties half)
+    //   npot = probability of being outdrawn when ahead (ties half)
+    // Exact on the flop and turn; sampled before the flop (see below)
     static std::pair<double, double> hand_potential(
         const std::array<int, 2>& hole,
         const std::vector<int>& board);
 
+    // Same over card sets (hole holds two cards); `dead` cards are never
+    // dealt
+    static std::pair<double, double> hand_potential(
+        CardSet hole, CardSet board, CardSet dead = {});
+
+    // With an explicit counting mode.
+    // Every (opponent hole, runout) pair is classified by whether we are
+    // ahead, tied or behind now and at the river. With fewer than three
+    // board cards nobody has a made hand yet, so every opponent counts as
+    // tied now and ppot / npot become the chances of winning / losing.
+    // Throws std::invalid_argument unless hole holds two cards and hole,
+    // board and dead are disjoint, and for exact mode before the flop,
+    // where there are over a billion (opponent, runout) pairs.
+    static std::pair<double, double> hand_potential(
+        CardSet hole, CardSet board, CardSet dead, const PotentialConfig& config);
+
 private:
     // Count occurrences of each rank
     static void count_ranks(const int* cards, int n, int* rank_counts);
@@ -156,18 +296,18 @@ inline int HandEvaluator::find_flush_suit(const int* cards, int n) {
 }
 
 inline int HandEvaluator::find_straight_high(uint16_t rank_mask) {
-    // Check for wheel (A-2-3-4-5)
-    if ((rank_mask & 0x100F) == 0x100F) {
-        return 3;  // 5-high straight
-    }
-
-    // Check for other straights
+    // Highest straight first, so A-2-3-4-5-6 plays as 6-high
     for (int high = 12; high >= 4; --high) {
         uint16_t straight_mask = 0x1F << (high - 4);
         if ((rank_mask & straight_mask) == straight_mask) {
             return high;
         }
     }
+
+    // Wheel (A-2-3-4-5) only if nothing higher
+    if ((rank_mask & 0x100F) == 0x100F) {
+        return 3;  // 5-high straight
+    }
     return -1;
 }
 
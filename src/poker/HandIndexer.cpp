@@ -0,0 +1,396 @@
+#include "HandIndexer.hpp"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr uint32_t RANK_MASK = (1u << NUM_RANKS) - 1;
+constexpr int KEY_BITS = 16;
+
+// C(n, k); 0 if k > n. Suit groups have at most four suits, so k <= 4 is
+// the hot path and divides only by constants.
+uint64_t choose(uint64_t n, int k) {
+    if (k < 0 || static_cast<uint64_t>(k) > n) return 0;
+    switch (k) {
+        case 0: return 1;
+        case 1: return n;
+        case 2: return n * (n - 1) / 2;
+        case 3: return n * (n - 1) / 2 * (n - 2) / 3;
+        case 4: return n * (n - 1) / 2 * (n - 2) / 3 * (n - 3) / 4;
+    }
+    uint64_t r = 1;
+    for (int j = 1; j <= k; ++j) r = r * (n - k + j) / j;
+    return r;
+}
+
+// C(n, k) for n, k <= 13
+const std::array<std::array<uint32_t, NUM_RANKS + 1>, NUM_RANKS + 1>& small_choose() {
+    static const auto table = [] {
+        std::array<std::array<uint32_t, NUM_RANKS + 1>, NUM_RANKS + 1> t{};
+        for (int n = 0; n <= NUM_RANKS; ++n) {
+            for (int k = 0; k <= NUM_RANKS; ++k) t[n][k] = static_cast<uint32_t>(choose(n, k));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Per 13-bit rank mask: popcount and colex rank among all 13 ranks. Builds
+// carry no -mpopcnt, so a table beats std::popcount here.
+struct RankMaskTables {
+    std::array<uint8_t, 1u << NUM_RANKS> popcount;
+    std::array<uint16_t, 1u << NUM_RANKS> colex;
+};
+
+const RankMaskTables& rank_masks() {
+    static const auto tables = [] {
+        const auto& c = small_choose();
+        auto t = std::make_unique<RankMaskTables>();
+        for (uint32_t mask = 0; mask <= RANK_MASK; ++mask) {
+            t->popcount[mask] = static_cast<uint8_t>(std::popcount(mask));
+            uint32_t rank = 0;
+            int j = 1;
+            for (uint32_t rest = mask; rest; rest &= rest - 1, ++j) rank += c[std::countr_zero(rest)][j];
+            t->colex[mask] = static_cast<uint16_t>(rank);
+        }
+        return t;
+    }();
+    return *tables;
+}
+
+// Colex rank of ranks among the ranks not in used
+uint32_t colex_rank(uint32_t ranks, uint32_t used) {
+    const RankMaskTables& t = rank_masks();
+    if (used == 0) return t.colex[ranks];
+
+    // Compress: rank b moves down by the used ranks below it
+    uint32_t compressed = 0;
+    for (uint32_t rest = ranks; rest; rest &= rest - 1) {
+        const int b = std::countr_zero(rest);
+        compressed |= 1u << (b - t.popcount[used & ((1u << b) - 1)]);
+    }
+    return t.colex[compressed];
+}
+
+// Inverse of colex_rank for m ranks
+uint32_t colex_unrank(uint32_t rank, int m, uint32_t used) {
+    const auto& c = small_choose();
+    uint32_t positions = 0;
+    int position = NUM_RANKS - 1;
+    for (int j = m; j >= 1; --j) {
+        while (c[position][j] > rank) --position;
+        rank -= c[position][j];
+        positions |= 1u << position;
+        --position;
+    }
+
+    // Position p is the p-th rank not in used
+    uint32_t ranks = 0;
+    int p = 0;
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        if (used & (1u << r)) continue;
+        if (positions & (1u << p)) ranks |= 1u << r;
+        ++p;
+    }
+    return ranks;
+}
+
+// Rank of a multiset of k indices in [0, n), given in non-increasing order:
+// a combination with repetition in the combinatorial number system
+uint64_t multiset_rank(const uint64_t* indices, int k) {
+    uint64_t rank = 0;
+    for (int j = 0; j < k; ++j) rank += choose(indices[j] + k - 1 - j, k - j);
+    return rank;
+}
+
+// Inverse of multiset_rank
+void multiset_unrank(uint64_t rank, int k, uint64_t n, uint64_t* indices) {
+    for (int j = 0; j < k; ++j) {
+        // Largest a with C(a, k - j) <= rank
+        const int kk = k - j;
+        uint64_t lo = static_cast<uint64_t>(kk - 1);
+        uint64_t hi = n + k - 1 - j;   // Exclusive
+        while (hi - lo > 1) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (choose(mid, kk) <= rank) lo = mid; else hi = mid;
+        }
+        rank -= choose(lo, kk);
+        indices[j] = lo - (k - 1 - j);
+    }
+}
+
+} // namespace
+
+HandIndexer::HandIndexer(std::vector<int> cards_per_round)
+    : cards_per_round_(std::move(cards_per_round)) {
+    if (cards_per_round_.empty() || static_cast<int>(cards_per_round_.size()) > MAX_ROUNDS) {
+        throw std::invalid_argument("HandIndexer needs 1-4 rounds");
+    }
+    int total = 0;
+    for (int n : cards_per_round_) {
+        if (n < 1) throw std::invalid_argument("Every round must deal at least one card");
+        total += n;
+    }
+    if (total > DECK_SIZE) {
+        throw std::invalid_argument("HandIndexer rounds deal more than 52 cards");
+    }
+
+    rounds_.resize(cards_per_round_.size());
+    for (int r = 0; r < rounds(); ++r) build_round(r);
+}
+
+int HandIndexer::shape_code(int round, const Shape& shape) const {
+    int code = 0;
+    for (int t = round; t >= 0; --t) code = code * (cards_per_round_[t] + 1) + shape[t];
+    return code;
+}
+
+void HandIndexer::build_round(int round) {
+    RoundTables& rt = rounds_[round];
+    const auto& c = small_choose();
+
+    // Every shape one suit can take, in lexicographic order
+    int num_codes = 1;
+    for (int t = 0; t <= round; ++t) num_codes *= cards_per_round_[t] + 1;
+    rt.shape_of_code.assign(num_codes, -1);
+
+    Shape shape{};
+    auto enumerate_shapes = [&](auto&& self, int t, int cards) -> void {
+        if (t > round) {
+            uint64_t sequences = 1;
+            int used = 0;
+            for (int u = 0; u <= round; ++u) {
+                sequences *= c[NUM_RANKS - used][shape[u]];
+                used += shape[u];
+            }
+            rt.shape_of_code[shape_code(round, shape)] = static_cast<int16_t>(rt.shapes.size());
+            rt.shapes.push_back(shape);
+            rt.shape_size.push_back(sequences);
+            return;
+        }
+        for (int m = 0; m <= cards_per_round_[t] && cards + m <= NUM_RANKS; ++m) {
+            shape[t] = static_cast<uint8_t>(m);
+            self(self, t + 1, cards + m);
+        }
+        shape[t] = 0;
+    };
+    enumerate_shapes(enumerate_shapes, 0, 0);
+    if (rt.shapes.size() >= (1u << KEY_BITS)) {
+        throw std::invalid_argument("HandIndexer round structure has too many suit shapes");
+    }
+
+    // Configurations: a non-increasing shape per suit, using up every round
+    std::array<int, MAX_ROUNDS> remaining{};
+    for (int t = 0; t <= round; ++t) remaining[t] = cards_per_round_[t];
+    auto enumerate_configs = [&](auto&& self, int suit, int max_shape, uint64_t key) -> void {
+        if (suit == NUM_SUITS) {
+            for (int t = 0; t <= round; ++t) {
+                if (remaining[t] != 0) return;
+            }
+            rt.keys.push_back(key);
+            return;
+        }
+        for (int s = max_shape; s >= 0; --s) {
+            const Shape& sh = rt.shapes[s];
+            bool fits = true;
+            for (int t = 0; t <= round; ++t) fits = fits && sh[t] <= remaining[t];
+            if (!fits) continue;
+            for (int t = 0; t <= round; ++t) remaining[t] -= sh[t];
+            self(self, suit + 1, s,
+                 key | (static_cast<uint64_t>(s) << (KEY_BITS * (NUM_SUITS - 1 - suit))));
+            for (int t = 0; t <= round; ++t) remaining[t] += sh[t];
+        }
+    };
+    enumerate_configs(enumerate_configs, 0, static_cast<int>(rt.shapes.size()) - 1, 0);
+    std::sort(rt.keys.begin(), rt.keys.end());
+
+    // Each configuration holds one multiset of indices per group of suits
+    // with equal shapes
+    rt.offsets.assign(1, 0);
+    for (uint64_t key : rt.keys) {
+        uint64_t hands = 1;
+        for (int g = 0; g < NUM_SUITS;) {
+            const uint64_t s = (key >> (KEY_BITS * (NUM_SUITS - 1 - g))) & 0xFFFF;
+            int h = g + 1;
+            while (h < NUM_SUITS && ((key >> (KEY_BITS * (NUM_SUITS - 1 - h))) & 0xFFFF) == s) ++h;
+            const int k = h - g;
+            hands *= choose(rt.shape_size[s] + k - 1, k);
+            g = h;
+        }
+        rt.offsets.push_back(rt.offsets.back() + hands);
+    }
+    rt.size = rt.offsets.back();
+}
+
+uint64_t HandIndexer::suit_index(int round, const std::array<uint32_t, MAX_ROUNDS>& ranks) const {
+    const auto& c = small_choose();
+    const RankMaskTables& masks = rank_masks();
+    uint64_t index = 0;
+    uint32_t used = 0;
+    for (int t = 0; t <= round; ++t) {
+        const int available = NUM_RANKS - masks.popcount[used];
+        index = index * c[available][masks.popcount[ranks[t]]] + colex_rank(ranks[t], used);
+        used |= ranks[t];
+    }
+    return index;
+}
+
+std::array<uint32_t, HandIndexer::MAX_ROUNDS> HandIndexer::suit_ranks(
+    int round, const Shape& shape, uint64_t index) const {
+
+    const auto& c = small_choose();
+    std::array<uint64_t, MAX_ROUNDS> digits{};
+    int dealt = 0;
+    for (int t = 0; t <= round; ++t) dealt += shape[t];
+    for (int t = round; t >= 0; --t) {
+        dealt -= shape[t];
+        const uint32_t radix = c[NUM_RANKS - dealt][shape[t]];
+        digits[t] = index % radix;
+        index /= radix;
+    }
+
+    std::array<uint32_t, MAX_ROUNDS> ranks{};
+    uint32_t used = 0;
+    for (int t = 0; t <= round; ++t) {
+        ranks[t] = colex_unrank(static_cast<uint32_t>(digits[t]), shape[t], used);
+        used |= ranks[t];
+    }
+    return ranks;
+}
+
+uint64_t HandIndexer::index(std::span<const CardSet> cards) const {
+    std::array<int, NUM_SUITS> suit_map;
+    return index(cards, suit_map);
+}
+
+uint64_t HandIndexer::index(std::span<const CardSet> cards, std::array<int, NUM_SUITS>& suit_map) const {
+    const int round = static_cast<int>(cards.size()) - 1;
+    if (round < 0 || round >= rounds()) {
+        throw std::invalid_argument("HandIndexer::index: wrong number of rounds");
+    }
+    CardSet seen;
+    for (int t = 0; t <= round; ++t) {
+        if (cards[t].size() != cards_per_round_[t] || cards[t].intersects(seen)) {
+            throw std::invalid_argument("HandIndexer::index: round " + std::to_string(t) +
+                                        " has the wrong number of cards or repeats a card");
+        }
+        seen |= cards[t];
+    }
+
+    const RoundTables& rt = rounds_[round];
+    const RankMaskTables& masks = rank_masks();
+    std::array<SuitPart, NUM_SUITS> parts;
+    for (int s = 0; s < NUM_SUITS; ++s) {
+        std::array<uint32_t, MAX_ROUNDS> ranks{};
+        Shape shape{};
+        for (int t = 0; t <= round; ++t) {
+            ranks[t] = static_cast<uint32_t>(cards[t].bits() >> (NUM_RANKS * s)) & RANK_MASK;
+            shape[t] = masks.popcount[ranks[t]];
+        }
+        parts[s] = {rt.shape_of_code[shape_code(round, shape)], suit_index(round, ranks), s};
+    }
+    std::sort(parts.begin(), parts.end(), [](const SuitPart& a, const SuitPart& b) {
+        return a.shape != b.shape ? a.shape > b.shape : a.index > b.index;
+    });
+
+    uint64_t key = 0;
+    for (int s = 0; s < NUM_SUITS; ++s) {
+        key |= static_cast<uint64_t>(parts[s].shape) << (KEY_BITS * (NUM_SUITS - 1 - s));
+        suit_map[parts[s].suit] = s;
+    }
+    const size_t config = std::lower_bound(rt.keys.begin(), rt.keys.end(), key) - rt.keys.begin();
+
+    uint64_t local = 0;
+    for (int g = 0; g < NUM_SUITS;) {
+        int h = g + 1;
+        while (h < NUM_SUITS && parts[h].shape == parts[g].shape) ++h;
+        const int k = h - g;
+        uint64_t indices[NUM_SUITS];
+        for (int j = 0; j < k; ++j) indices[j] = parts[g + j].index;
+        local = local * choose(rt.shape_size[parts[g].shape] + k - 1, k) + multiset_rank(indices, k);
+        g = h;
+    }
+    return rt.offsets[config] + local;
+}
+
+std::vector<CardSet> HandIndexer::unindex(int round, uint64_t index) const {
+    if (round < 0 || round >= rounds() || index >= rounds_[round].size) {
+        throw std::out_of_range("HandIndexer::unindex: index out of range");
+    }
+    const RoundTables& rt = rounds_[round];
+    const size_t config = std::upper_bound(rt.offsets.begin(), rt.offsets.end(), index)
+                          - rt.offsets.begin() - 1;
+    uint64_t local = index - rt.offsets[config];
+
+    std::array<int, NUM_SUITS> shapes;
+    for (int s = 0; s < NUM_SUITS; ++s) {
+        shapes[s] = static_cast<int>((rt.keys[config] >> (KEY_BITS * (NUM_SUITS - 1 - s))) & 0xFFFF);
+    }
+
+    // Groups were combined first to last, so peel them off last to first
+    std::array<uint64_t, NUM_SUITS> indices{};
+    for (int h = NUM_SUITS; h > 0;) {
+        int g = h - 1;
+        while (g > 0 && shapes[g - 1] == shapes[h - 1]) --g;
+        const int k = h - g;
+        const uint64_t n = rt.shape_size[shapes[g]];
+        const uint64_t count = choose(n + k - 1, k);
+        multiset_unrank(local % count, k, n, indices.data() + g);
+        local /= count;
+        h = g;
+    }
+
+    std::vector<CardSet> cards(round + 1);
+    for (int s = 0; s < NUM_SUITS; ++s) {
+        const auto ranks = suit_ranks(round, rt.shapes[shapes[s]], indices[s]);
+        for (int t = 0; t <= round; ++t) {
+            cards[t] |= CardSet(static_cast<uint64_t>(ranks[t]) << (NUM_RANKS * s));
+        }
+    }
+    return cards;
+}
+
+// ============================================================================
+// HoldemIndexer
+// ============================================================================
+
+HoldemIndexer::HoldemIndexer()
+    : indexers_{HandIndexer({2}), HandIndexer({2, 3}), HandIndexer({2, 4}), HandIndexer({2, 5})} {}
+
+const HoldemIndexer& HoldemIndexer::instance() {
+    static const HoldemIndexer indexer;
+    return indexer;
+}
+
+int HoldemIndexer::slot(int board_cards) {
+    switch (board_cards) {
+        case 0: return 0;
+        case 3: return 1;
+        case 4: return 2;
+        case 5: return 3;
+    }
+    throw std::invalid_argument("Board must have 0, 3, 4 or 5 cards");
+}
+
+uint64_t HoldemIndexer::index(CardSet hole, CardSet board) const {
+    const int s = slot(board.size());
+    const CardSet rounds[2] = {hole, board};
+    return indexers_[s].index(std::span<const CardSet>(rounds, s == 0 ? 1 : 2));
+}
+
+uint64_t HoldemIndexer::size(int board_cards) const {
+    const int s = slot(board_cards);
+    return indexers_[s].size(s == 0 ? 0 : 1);
+}
+
+std::pair<CardSet, CardSet> HoldemIndexer::unindex(int board_cards, uint64_t index) const {
+    const int s = slot(board_cards);
+    std::vector<CardSet> cards = indexers_[s].unindex(s == 0 ? 0 : 1, index);
+    return {cards[0], s == 0 ? CardSet{} : cards[1]};
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Suit-isomorphic hand indexer (after Waugh, "A Fast and Optimal Hand
+// Isomorphism Algorithm", 2013)
+//
+// A hand is dealt in rounds of fixed sizes, e.g. {2, 3, 1, 1} for hole,
+// flop, turn and river. Two hands are isomorphic if a permutation of suits
+// maps one onto the other, round by round. index() maps each hand to a
+// dense integer in [0, size(round)) that is equal exactly for isomorphic
+// hands; unindex() returns a canonical representative.
+//
+// Per suit, the hand is a sequence of disjoint rank sets, one per round.
+// Its shape (how many cards per round) has a fixed number of rank-set
+// sequences, and the sequence gets a mixed-radix index of colex ranks.
+// Suits are then sorted by (shape, index):
+//   configuration   the sorted shapes of the four suits; configurations are
+//                   enumerated up front and own consecutive index ranges
+//   suit group      suits with equal shapes are interchangeable, so their
+//                   indices form a multiset and are ranked as one
+// A lookup is a few popcounts per suit, a sort of four suits and a binary
+// search over the configurations.
+class HandIndexer {
+public:
+    static constexpr int MAX_ROUNDS = 4;
+
+    // cards_per_round: 1-4 rounds, each dealing at least one card, at most
+    // 52 in total. Throws std::invalid_argument otherwise.
+    explicit HandIndexer(std::vector<int> cards_per_round);
+
+    int rounds() const { return static_cast<int>(cards_per_round_.size()); }
+    int cards_in_round(int round) const { return cards_per_round_[round]; }
+
+    // Number of canonical hands after round (0-based)
+    uint64_t size(int round) const { return rounds_[round].size; }
+
+    // Index after round cards.size() - 1; cards[r] holds the cards dealt in
+    // round r. Throws std::invalid_argument if a round has the wrong number
+    // of cards or two rounds share a card.
+    uint64_t index(std::span<const CardSet> cards) const;
+
+    // Same, also returning the suit permutation that maps the hand onto
+    // unindex(round, index): suit s of the hand is suit suit_map[s] there
+    uint64_t index(std::span<const CardSet> cards, std::array<int, NUM_SUITS>& suit_map) const;
+
+    // Canonical hand for an index after round; one card set per round.
+    // Throws std::out_of_range if index >= size(round).
+    std::vector<CardSet> unindex(int round, uint64_t index) const;
+
+private:
+    using Shape = std::array<uint8_t, MAX_ROUNDS>;   // Cards per round in one suit
+
+    struct RoundTables {
+        std::vector<Shape> shapes;                   // Lexicographic order
+        std::vector<uint64_t> shape_size;            // Rank-set sequences per shape
+        std::vector<int16_t> shape_of_code;          // Mixed-radix shape code -> shape id
+
+        // Configurations, sorted by key (shape ids of the four suits,
+        // non-increasing, 16 bits each, first suit highest); each owns
+        // offsets[i] .. offsets[i + 1]
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> offsets;
+        uint64_t size = 0;
+    };
+
+    // One suit's part of a hand
+    struct SuitPart {
+        int shape = 0;
+        uint64_t index = 0;
+        int suit = 0;
+    };
+
+    std::vector<int> cards_per_round_;
+    std::vector<RoundTables> rounds_;
+
+    void build_round(int round);
+    int shape_code(int round, const Shape& shape) const;
+    uint64_t suit_index(int round, const std::array<uint32_t, MAX_ROUNDS>& ranks) const;
+    std::array<uint32_t, MAX_ROUNDS> suit_ranks(int round, const Shape& shape, uint64_t index) const;
+};
+
+// Hold'em indexer over (hole, board) with the board as one unordered set:
+// rounds {2}, {2, 3}, {2, 4} and {2, 5}. Buckets depend only on the cards
+// held, not on which board card came when, so this is the index abstraction
+// tables use (169 / 1,286,792 / 13,960,050 / 123,156,254 hands).
+class HoldemIndexer {
+public:
+    HoldemIndexer();
+
+    // Shared instance (built on first use, thread-safe)
+    static const HoldemIndexer& instance();
+
+    // Throws std::invalid_argument unless hole has 2 cards, the board 0 or
+    // 3-5 cards, and they do not overlap
+    uint64_t index(CardSet hole, CardSet board) const;
+
+    // Canonical hands for a board size
+    uint64_t size(int board_cards) const;
+
+    // Canonical (hole, board) for an index
+    std::pair<CardSet, CardSet> unindex(int board_cards, uint64_t index) const;
+
+private:
+    // [0] preflop, [1..3] flop, turn, river
+    std::array<HandIndexer, 4> indexers_;
+
+    static int slot(int board_cards);
+};
+
+} // namespace quantnet::poker
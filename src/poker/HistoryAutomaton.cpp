@@ -0,0 +1,95 @@
+#include "HistoryAutomaton.hpp"
+#include <map>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+HistoryAutomaton::StateKind kind_of(const GameNode* node) {
+    switch (node->type) {
+        case NodeType::Player:   return HistoryAutomaton::StateKind::Decision;
+        case NodeType::Chance:   return HistoryAutomaton::StateKind::Deal;
+        case NodeType::Terminal: return HistoryAutomaton::StateKind::Terminal;
+    }
+    return HistoryAutomaton::StateKind::Terminal;
+}
+
+} // namespace
+
+HistoryAutomaton::HistoryAutomaton(const PokerGame& game, const InfoSetIndex& index)
+    : deck_size_(game.deck_size()) {
+    const GameNode* root = game.root();
+    if (!root || root->type != NodeType::Chance) {
+        throw std::runtime_error("History automaton needs a root that deals private cards");
+    }
+
+    std::map<std::string, uint32_t> state_of;
+
+    // State for a node's history, created on first sight
+    auto state_for = [&](const GameNode* node) {
+        auto [it, inserted] = state_of.try_emplace(node->history, static_cast<uint32_t>(kind_.size()));
+        if (inserted) {
+            kind_.push_back(kind_of(node));
+            player_.push_back(node->type == NodeType::Player ? node->player : CHANCE);
+            next_.resize(next_.size() + NUM_ACTIONS, NO_STATE);
+            deal_.push_back(NO_STATE);
+            handles_.resize(handles_.size() + static_cast<size_t>(deck_size_) * (deck_size_ + 1),
+                            INVALID_HANDLE);
+            histories_.push_back(node->history);
+        } else if (kind_[it->second] != kind_of(node) ||
+                   (node->type == NodeType::Player && player_[it->second] != node->player)) {
+            throw std::runtime_error("History '" + node->history + "' is not the same kind of state in every deal");
+        }
+        return it->second;
+    };
+
+    // Links a transition, checking every deal agrees
+    auto link = [](uint32_t& slot, uint32_t target, const std::string& history) {
+        if (slot != NO_STATE && slot != target) {
+            throw std::runtime_error("History '" + history + "' has deal-dependent transitions");
+        }
+        slot = target;
+    };
+
+    auto compile = [&](auto& self, const GameNode* node, uint32_t state) -> void {
+        if (node->type == NodeType::Player) {
+            const Card own = (node->player == PLAYER_0) ? node->p0_card : node->p1_card;
+            const int idx = index.info_set_idx(node->info_set_id);
+            if (idx < 0) {
+                throw std::runtime_error("Info set missing from index: " + node->info_set_id);
+            }
+            if (own < 0 || own >= deck_size_ || node->public_card >= deck_size_) {
+                throw std::runtime_error("Card out of range at history '" + node->history + "'");
+            }
+
+            InfoSetHandle& slot = handles_[handle_slot(state, own, node->public_card)];
+            if (slot != INVALID_HANDLE && slot != static_cast<InfoSetHandle>(idx)) {
+                throw std::runtime_error("Info set depends on more than history and cards: " + node->info_set_id);
+            }
+            slot = static_cast<InfoSetHandle>(idx);
+        }
+
+        for (const auto& edge : node->children) {
+            const uint32_t child = state_for(edge.child.get());
+            if (node->type == NodeType::Player) {
+                link(next_[static_cast<size_t>(state) * NUM_ACTIONS + static_cast<size_t>(edge.action)],
+                     child, node->history);
+            } else {
+                link(deal_[state], child, node->history);
+            }
+            self(self, edge.child.get(), child);
+        }
+    };
+
+    for (const auto& deal : root->children) {
+        const uint32_t state = state_for(deal.child.get());
+        if (start_ != NO_STATE && start_ != state) {
+            throw std::runtime_error("Private deals lead to different starting histories");
+        }
+        start_ = state;
+        compile(compile, deal.child.get(), state);
+    }
+}
+
+} // namespace quantnet::poker
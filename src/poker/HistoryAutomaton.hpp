@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameTree.hpp"
+#include "GameTypes.hpp"
+#include "StrategyTable.hpp"
+
+namespace quantnet::poker {
+
+class HistoryCursor;
+
+// Precompiled state machine over public betting histories
+//
+// Resolving an info set at runtime otherwise means rebuilding its id string
+// (make_info_set_id concatenates several strings) and looking it up in a
+// map. The automaton is compiled once from the game tree:
+//   states    one per public history ("", "cb", "cc|", ...)
+//   next_     [state][action] -> state
+//   deal_     [state] -> state after the public card is dealt
+//   handles_  [state][private card][public card + 1] -> info set handle
+//
+// Handles are positions in the InfoSetIndex the automaton was compiled
+// against, i.e. the same handles StrategyTable uses, so
+//   table.probs(cursor.info_set(my_card))
+// serves a decision with a few array reads and no allocation.
+class HistoryAutomaton {
+public:
+    static constexpr uint32_t NO_STATE = UINT32_MAX;
+    static constexpr int NUM_ACTIONS = 5;  // Size of the Action enum
+
+    enum class StateKind : uint8_t { Decision, Deal, Terminal };
+
+    // Compile from the tree below the private-card deal at the root.
+    // Throws std::runtime_error if the tree's info sets depend on more than
+    // (history, own private card, public card), or a history is a decision
+    // in one deal and terminal in another.
+    HistoryAutomaton(const PokerGame& game, const InfoSetIndex& index);
+
+    // Cursor at the first decision, after private cards are dealt
+    HistoryCursor start() const;
+
+    size_t num_states() const { return kind_.size(); }
+    const std::string& history(uint32_t state) const { return histories_[state]; }
+
+private:
+    friend class HistoryCursor;
+
+    int deck_size_ = 0;
+    uint32_t start_ = NO_STATE;
+
+    std::vector<StateKind> kind_;
+    std::vector<PlayerId> player_;
+    std::vector<uint32_t> next_;           // num_states * NUM_ACTIONS
+    std::vector<uint32_t> deal_;           // num_states
+    std::vector<InfoSetHandle> handles_;   // num_states * deck * (deck + 1)
+    std::vector<std::string> histories_;   // For diagnostics only
+
+    size_t handle_slot(uint32_t state, Card private_card, Card public_card) const {
+        return (static_cast<size_t>(state) * deck_size_ + private_card) * (deck_size_ + 1)
+               + (public_card + 1);
+    }
+};
+
+// Position in a hand, advanced one action or deal at a time
+//
+// A cursor is a pointer and two integers; copying it is free, and every
+// operation is O(1) array indexing.
+class HistoryCursor {
+public:
+    HistoryCursor() = default;
+
+    // Advance by a betting action; returns false (and stays put) if the
+    // action is not legal here
+    bool apply(Action a) {
+        const uint32_t next = automaton_->next_[state_ * HistoryAutomaton::NUM_ACTIONS
+                                                + static_cast<uint32_t>(a)];
+        if (next == HistoryAutomaton::NO_STATE) return false;
+        state_ = next;
+        return true;
+    }
+
+    // Advance past the public card deal; returns false if no deal is due
+    bool deal_public(Card c) {
+        const uint32_t next = automaton_->deal_[state_];
+        if (next == HistoryAutomaton::NO_STATE || c < 0 || c >= automaton_->deck_size_) {
+            return false;
+        }
+        state_ = next;
+        public_card_ = c;
+        return true;
+    }
+
+    // Info set of the acting player holding private_card, INVALID_HANDLE if
+    // not at a decision or the cards are out of range
+    InfoSetHandle info_set(Card private_card) const {
+        if (automaton_->kind_[state_] != HistoryAutomaton::StateKind::Decision ||
+            private_card < 0 || private_card >= automaton_->deck_size_) {
+            return INVALID_HANDLE;
+        }
+        return automaton_->handles_[automaton_->handle_slot(state_, private_card, public_card_)];
+    }
+
+    PlayerId to_act() const { return automaton_->player_[state_]; }
+    HistoryAutomaton::StateKind kind() const { return automaton_->kind_[state_]; }
+    bool is_terminal() const { return kind() == HistoryAutomaton::StateKind::Terminal; }
+    uint32_t state() const { return state_; }
+    Card public_card() const { return public_card_; }
+
+private:
+    friend class HistoryAutomaton;
+
+    HistoryCursor(const HistoryAutomaton* automaton, uint32_t state)
+        : automaton_(automaton), state_(state) {}
+
+    const HistoryAutomaton* automaton_ = nullptr;
+    uint32_t state_ = HistoryAutomaton::NO_STATE;
+    Card public_card_ = -1;
+};
+
+inline HistoryCursor HistoryAutomaton::start() const {
+    return HistoryCursor(this, start_);
+}
+
+} // namespace quantnet::poker
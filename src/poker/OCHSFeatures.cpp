@@ -0,0 +1,253 @@
+#include "OCHSFeatures.hpp"
+#include "EMDClustering.hpp"
+#include "HandIndexer.hpp"
+#include "TableEvaluator.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+// Bins of the preflop histograms opponent clusters are built from
+constexpr int PREFLOP_BINS = 50;
+
+constexpr int MAX_KMEANS_STEPS = 100;
+
+// Buffers of one river sweep, reused across runouts
+struct RiverSweep {
+    std::vector<TableEvaluator::HolePair> holes;
+    std::vector<int> combos;                // hole_combo_index of holes[i]
+    std::vector<HandValue> values;
+    std::vector<uint32_t> order;
+    std::vector<float> equities;            // holes.size() * k
+};
+
+// Equity of every hole combo live on a complete board against each
+// opponent cluster, at sweep.equities[i * k + c] for sweep.holes[i]
+void river_equities(CardSet board, const OpponentClusters& clusters, RiverSweep& sweep) {
+    const int k = clusters.size();
+    const CardSet live = ~board;
+    sweep.holes.clear();
+    sweep.combos.clear();
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const auto& combo = hole_combos()[i];
+        if (live.contains(combo[0]) && live.contains(combo[1])) {
+            sweep.holes.push_back(combo);
+            sweep.combos.push_back(i);
+        }
+    }
+    const size_t n = sweep.holes.size();
+
+    std::array<int, DECK_SIZE> board_cards;
+    const int num_board = board.to_cards(board_cards.data());
+    sweep.values.resize(n);
+    TableEvaluator::evaluate_batch(std::span<const int>(board_cards.data(), num_board), sweep.holes, sweep.values);
+
+    sweep.order.resize(n);
+    std::iota(sweep.order.begin(), sweep.order.end(), 0u);
+    std::sort(sweep.order.begin(), sweep.order.end(), [&](uint32_t a, uint32_t b) {
+        return sweep.values[a] < sweep.values[b];
+    });
+
+    // Per cluster: hands in total, strictly below the current value and at
+    // it, overall and per card (indexed card * k + cluster)
+    std::array<int, MAX_OPPONENT_CLUSTERS> in_cluster{};
+    std::array<int, MAX_OPPONENT_CLUSTERS> below{};
+    std::array<int, MAX_OPPONENT_CLUSTERS> tied{};
+    std::array<int, DECK_SIZE * MAX_OPPONENT_CLUSTERS> with_card{};
+    std::array<int, DECK_SIZE * MAX_OPPONENT_CLUSTERS> below_card{};
+    std::array<int, DECK_SIZE * MAX_OPPONENT_CLUSTERS> tied_card{};
+    for (size_t i = 0; i < n; ++i) {
+        const int c = clusters.cluster(sweep.combos[i]);
+        ++in_cluster[c];
+        ++with_card[sweep.holes[i][0] * k + c];
+        ++with_card[sweep.holes[i][1] * k + c];
+    }
+
+    // As in hand_strengths, the hand itself holds both of its cards and is
+    // added back once, in its own cluster only
+    sweep.equities.resize(n * k);
+    for (size_t start = 0; start < n;) {
+        size_t end = start;
+        std::fill(tied.begin(), tied.begin() + k, 0);
+        while (end < n && sweep.values[sweep.order[end]] == sweep.values[sweep.order[start]]) {
+            const uint32_t i = sweep.order[end];
+            const int c = clusters.cluster(sweep.combos[i]);
+            ++tied[c];
+            ++tied_card[sweep.holes[i][0] * k + c];
+            ++tied_card[sweep.holes[i][1] * k + c];
+            ++end;
+        }
+
+        for (size_t j = start; j < end; ++j) {
+            const uint32_t i = sweep.order[j];
+            const int own = clusters.cluster(sweep.combos[i]);
+            const int a = sweep.holes[i][0] * k;
+            const int b = sweep.holes[i][1] * k;
+            float* eq = sweep.equities.data() + static_cast<size_t>(i) * k;
+            for (int c = 0; c < k; ++c) {
+                const int self = c == own ? 1 : 0;
+                const int total = in_cluster[c] - with_card[a + c] - with_card[b + c] + self;
+                const int wins = below[c] - below_card[a + c] - below_card[b + c];
+                const int ties = tied[c] - tied_card[a + c] - tied_card[b + c] + self;
+                eq[c] = total <= 0 ? 0.5f : static_cast<float>((wins + 0.5 * ties) / total);
+            }
+        }
+
+        for (size_t j = start; j < end; ++j) {
+            const uint32_t i = sweep.order[j];
+            const int c = clusters.cluster(sweep.combos[i]);
+            ++below_card[sweep.holes[i][0] * k + c];
+            ++below_card[sweep.holes[i][1] * k + c];
+            --tied_card[sweep.holes[i][0] * k + c];
+            --tied_card[sweep.holes[i][1] * k + c];
+        }
+        for (int c = 0; c < k; ++c) below[c] += tied[c];
+        start = end;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// OpponentClusters
+// ============================================================================
+
+OpponentClusters OpponentClusters::build(int k, int boards, uint64_t seed) {
+    if (k < 1 || k > MAX_OPPONENT_CLUSTERS || boards < 1) {
+        throw std::invalid_argument("Opponent clusters need 1-16 clusters and at least one board");
+    }
+
+    // River hand strength histogram of each preflop class
+    constexpr int NUM_CLASSES = 169;
+    std::array<int, NUM_HOLE_COMBOS> class_of;
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        class_of[i] = static_cast<int>(HoldemIndexer::instance().index(CardSet::of(hole_combos()[i]), CardSet{}));
+    }
+    std::vector<int> counts(static_cast<size_t>(NUM_CLASSES) * PREFLOP_BINS, 0);
+    std::array<int, NUM_CLASSES> totals{};
+    parallel::CounterRng rng(seed, 0x0C450000u);
+    for (int b = 0; b < boards; ++b) {
+        CardSet board;
+        while (board.size() < 5) board.insert(static_cast<int>(rng.below(DECK_SIZE)));
+        const auto strengths = HandEvaluator::hand_strengths(board);
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            if (strengths[i] < 0.0) continue;
+            const int bin = std::min(PREFLOP_BINS - 1, static_cast<int>(strengths[i] * PREFLOP_BINS));
+            ++counts[static_cast<size_t>(class_of[i]) * PREFLOP_BINS + bin];
+            ++totals[class_of[i]];
+        }
+    }
+
+    std::vector<float> points(static_cast<size_t>(NUM_CLASSES) * PREFLOP_BINS, 1.0f);
+    for (int h = 0; h < NUM_CLASSES; ++h) {
+        if (totals[h] == 0) continue;
+        int running = 0;
+        for (int b = 0; b < PREFLOP_BINS; ++b) {
+            running += counts[static_cast<size_t>(h) * PREFLOP_BINS + b];
+            points[static_cast<size_t>(h) * PREFLOP_BINS + b] = static_cast<float>(running) / totals[h];
+        }
+    }
+
+    HamerlyKMeans kmeans(points, PREFLOP_BINS, kmeans_plus_plus(points, PREFLOP_BINS, k, seed));
+    for (int step = 0; step < MAX_KMEANS_STEPS && kmeans.step() > 0; ++step) {}
+
+    // Number clusters from weakest to strongest: more CDF mass is weaker
+    std::vector<std::pair<float, int>> by_strength;
+    for (int c = 0; c < k; ++c) {
+        const float* centroid = kmeans.centroids().data() + static_cast<size_t>(c) * PREFLOP_BINS;
+        by_strength.emplace_back(-std::accumulate(centroid, centroid + PREFLOP_BINS, 0.0f), c);
+    }
+    std::sort(by_strength.begin(), by_strength.end());
+    std::array<int, MAX_OPPONENT_CLUSTERS> rank{};
+    for (int r = 0; r < k; ++r) rank[by_strength[r].second] = r;
+
+    OpponentClusters clusters;
+    clusters.k_ = k;
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        clusters.cluster_[i] = static_cast<uint8_t>(rank[kmeans.assignments()[class_of[i]]]);
+    }
+    return clusters;
+}
+
+// ============================================================================
+// OCHS features
+// ============================================================================
+
+void ochs_equities(CardSet board, const OpponentClusters& clusters, int samples,
+                   uint64_t seed, uint64_t stream, std::span<float> out) {
+    const int k = clusters.size();
+    if (out.size() < static_cast<size_t>(NUM_HOLE_COMBOS) * k) {
+        throw std::invalid_argument("OCHS output too small");
+    }
+    const std::vector<CardSet> runouts = river_runouts(board, samples, seed, stream);
+
+    std::vector<double> sums(static_cast<size_t>(NUM_HOLE_COMBOS) * k, 0.0);
+    std::array<int, NUM_HOLE_COMBOS> totals{};
+    RiverSweep sweep;
+    for (CardSet runout : runouts) {
+        river_equities(board | runout, clusters, sweep);
+        for (size_t i = 0; i < sweep.combos.size(); ++i) {
+            double* dst = sums.data() + static_cast<size_t>(sweep.combos[i]) * k;
+            const float* eq = sweep.equities.data() + i * k;
+            for (int c = 0; c < k; ++c) dst[c] += eq[c];
+            ++totals[sweep.combos[i]];
+        }
+    }
+
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        float* dst = out.data() + static_cast<size_t>(i) * k;
+        for (int c = 0; c < k; ++c) {
+            dst[c] = totals[i] == 0 ? 0.0f : static_cast<float>(sums[static_cast<size_t>(i) * k + c] / totals[i]);
+        }
+    }
+}
+
+void ochs_histograms(CardSet board, const OpponentClusters& clusters, int bins, int samples,
+                     uint64_t seed, uint64_t stream, std::span<float> out) {
+    const int k = clusters.size();
+    if (bins < 1) {
+        throw std::invalid_argument("OCHS histograms need at least one bin");
+    }
+    const size_t dims = static_cast<size_t>(k) * bins;
+    if (out.size() < NUM_HOLE_COMBOS * dims) {
+        throw std::invalid_argument("OCHS histogram output too small");
+    }
+    const std::vector<CardSet> runouts = river_runouts(board, samples, seed, stream);
+
+    std::vector<int> counts(NUM_HOLE_COMBOS * dims, 0);
+    std::array<int, NUM_HOLE_COMBOS> totals{};
+    RiverSweep sweep;
+    for (CardSet runout : runouts) {
+        river_equities(board | runout, clusters, sweep);
+        for (size_t i = 0; i < sweep.combos.size(); ++i) {
+            int* dst = counts.data() + static_cast<size_t>(sweep.combos[i]) * dims;
+            const float* eq = sweep.equities.data() + i * k;
+            for (int c = 0; c < k; ++c) {
+                ++dst[c * bins + std::min(bins - 1, static_cast<int>(eq[c] * bins))];
+            }
+            ++totals[sweep.combos[i]];
+        }
+    }
+
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        for (int c = 0; c < k; ++c) {
+            const size_t base = static_cast<size_t>(i) * dims + static_cast<size_t>(c) * bins;
+            float* cdf = out.data() + base;
+            if (totals[i] == 0) {
+                std::fill(cdf, cdf + bins, 0.0f);
+                continue;
+            }
+            int running = 0;
+            for (int b = 0; b < bins; ++b) {
+                running += counts[base + b];
+                cdf[b] = static_cast<float>(running) / static_cast<float>(totals[i]);
+            }
+        }
+    }
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Opponent cluster hand strength (OCHS) features
+//
+// Hand strength against a uniform opponent hides which hands a holding
+// beats: a set and a weak flush draw can share an equity yet fare very
+// differently against strong and weak ranges. OCHS (Johanson et al.,
+// "Evaluating State-Space Abstractions in Extensive-Form Games", 2013)
+// splits the opponent's hands into a few clusters of similar preflop
+// strength and keeps one equity per cluster.
+//
+// All features here are computed for every hand on a board at once. Each
+// runout to the river evaluates all live hole combos in one batch, sorts
+// them, and settles every (hand, cluster) equity in one sweep with per-card
+// counts for card removal, as HandEvaluator::hand_strengths does for a
+// single range.
+
+constexpr int MAX_OPPONENT_CLUSTERS = 16;
+
+// Partition of the 1326 hole combos into opponent clusters. Suit-isomorphic
+// preflop hands share a cluster; clusters are numbered from weakest to
+// strongest.
+class OpponentClusters {
+public:
+    // Cluster the 169 preflop classes into k by earth mover's distance
+    // between their river hand strength histograms on `boards` sampled
+    // river boards. Deterministic for a seed. Throws std::invalid_argument
+    // unless 1 <= k <= MAX_OPPONENT_CLUSTERS and boards > 0.
+    static OpponentClusters build(int k = 8, int boards = 2000, uint64_t seed = 0);
+
+    int size() const { return k_; }
+
+    // Cluster of a hole combo, by hole_combo_index
+    int cluster(int combo) const { return cluster_[combo]; }
+    const std::array<uint8_t, NUM_HOLE_COMBOS>& assignments() const { return cluster_; }
+
+private:
+    int k_ = 0;
+    std::array<uint8_t, NUM_HOLE_COMBOS> cluster_{};
+};
+
+// Equity of every live hole combo against each opponent cluster, averaged
+// over the runouts to the river, written at out[hole_combo_index * k + c].
+// On the river this is exact OCHS. Runouts are all of them, or with
+// samples > 0 and fewer than all, that many drawn from stream `stream` of
+// `seed` (see river_runouts). Opponents sharing a card with the hand or
+// the runout are removed; an entirely blocked cluster counts as 0.5.
+// Combos touching the board are left zero. Throws std::invalid_argument on
+// a bad board or if out is shorter than NUM_HOLE_COMBOS * k.
+void ochs_equities(CardSet board, const OpponentClusters& clusters, int samples,
+                   uint64_t seed, uint64_t stream, std::span<float> out);
+
+// Potential-aware OCHS: for every live hole combo and opponent cluster, the
+// CDF over runouts of the river equity against that cluster, in `bins`
+// equal-width bins, written at out[(hole_combo_index * k + c) * bins]. The
+// L1 distance between two such vectors is the sum of per-cluster earth
+// mover's distances, so it separates hands whose equity against each
+// cluster is equally good on average but arrives differently. Combos
+// touching the board are left zero. Throws std::invalid_argument on a bad
+// board or bin count, or if out is shorter than NUM_HOLE_COMBOS * k * bins.
+void ochs_histograms(CardSet board, const OpponentClusters& clusters, int bins, int samples,
+                     uint64_t seed, uint64_t stream, std::span<float> out);
+
+} // namespace quantnet::poker
@@ -0,0 +1,162 @@
+#include "PreflopEquity.hpp"
+#include "Equity.hpp"
+#include "HandIndexer.hpp"
+#include "../io/BinaryFile.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'N', 'P', 'R', 'E', 'E', 'Q', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr int NUM_CLASSES = PreflopEquity::NUM_CLASSES;
+constexpr int STANDARD_SAMPLES = 100;
+
+const std::array<uint8_t, NUM_HOLE_COMBOS>& class_table() {
+    static const std::array<uint8_t, NUM_HOLE_COMBOS> table = [] {
+        std::array<uint8_t, NUM_HOLE_COMBOS> t{};
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            t[i] = static_cast<uint8_t>(HoldemIndexer::instance().index(CardSet::of(hole_combos()[i]), CardSet{}));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Combos of every class, by hole_combo_index
+const std::array<std::vector<int>, NUM_CLASSES>& class_combos() {
+    static const std::array<std::vector<int>, NUM_CLASSES> combos = [] {
+        std::array<std::vector<int>, NUM_CLASSES> c;
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) c[class_table()[i]].push_back(i);
+        return c;
+    }();
+    return combos;
+}
+
+// Combos of class v sharing no card with combo h
+int compatible(int h, int v) {
+    const CardSet hole = CardSet::of(hole_combos()[h]);
+    int n = 0;
+    for (int c : class_combos()[v]) n += hole.intersects(CardSet::of(hole_combos()[c])) ? 0 : 1;
+    return n;
+}
+
+} // namespace
+
+int PreflopEquity::hand_class(int combo) {
+    return class_table()[combo];
+}
+
+PreflopEquity PreflopEquity::compute(int samples, uint64_t seed) {
+    if (samples < 1) {
+        throw std::invalid_argument("Preflop equities need at least one sample per class");
+    }
+
+    PreflopEquity table;
+    table.samples_ = samples;
+    table.seed_ = seed;
+    table.matrix_.assign(static_cast<size_t>(NUM_CLASSES) * NUM_CLASSES, 0.0);
+
+    // Column v: every combo against the combos of class v
+    const HandRange everyone = HandRange::full();
+    for (int v = 0; v < NUM_CLASSES; ++v) {
+        HandRange villain;
+        for (int c : class_combos()[v]) villain.weights[c] = 1.0;
+        const EquityConfig config{samples, parallel::CounterRng::mix(seed + static_cast<uint64_t>(v))};
+        const EquityResult result = RangeEquity::compute(everyone, villain, CardSet{}, CardSet{}, config);
+
+        std::array<double, NUM_CLASSES> sum{};
+        std::array<double, NUM_CLASSES> weight{};
+        for (int h = 0; h < NUM_HOLE_COMBOS; ++h) {
+            if (result.hand_equity[h] < 0.0) continue;
+            const int n = compatible(h, v);
+            sum[hand_class(h)] += n * result.hand_equity[h];
+            weight[hand_class(h)] += n;
+        }
+        for (int h = 0; h < NUM_CLASSES; ++h) {
+            table.matrix_[static_cast<size_t>(h) * NUM_CLASSES + v] = weight[h] > 0.0 ? sum[h] / weight[h] : 0.5;
+        }
+    }
+
+    // A class against itself is even by symmetry. Other pairs keep their
+    // own column's estimate: averaging with the transposed one would tie
+    // every entry of row i to the boards of column i, and those shared
+    // errors would not cancel in the equity against a random hand.
+    for (int a = 0; a < NUM_CLASSES; ++a) table.matrix_[static_cast<size_t>(a) * NUM_CLASSES + a] = 0.5;
+
+    table.finish();
+    return table;
+}
+
+void PreflopEquity::finish() {
+    // Against a random hand: each villain class weighted by the combo
+    // pairs it can form with the hero class
+    for (int h = 0; h < NUM_CLASSES; ++h) {
+        double sum = 0.0;
+        double weight = 0.0;
+        for (int v = 0; v < NUM_CLASSES; ++v) {
+            double pairs = 0.0;
+            for (int c : class_combos()[h]) pairs += compatible(c, v);
+            sum += pairs * equity(h, v);
+            weight += pairs;
+        }
+        vs_random_[h] = sum / weight;
+    }
+
+    std::array<int, NUM_CLASSES> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return vs_random_[a] > vs_random_[b]; });
+    for (int r = 0; r < NUM_CLASSES; ++r) rank_[order[r]] = static_cast<uint8_t>(r);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) combo_rank_[i] = rank_[hand_class(i)];
+}
+
+void PreflopEquity::save(const std::string& path) const {
+    io::BinaryWriter out(path, "preflop equities");
+    out.header(MAGIC, VERSION);
+    out.pod(static_cast<uint32_t>(samples_));
+    out.pod(seed_);
+    out.bytes(matrix_.data(), matrix_.size() * sizeof(double));
+    out.commit();
+}
+
+PreflopEquity PreflopEquity::load(const std::string& path) {
+    io::BinaryReader in(path, "preflop equity table");
+    in.header(MAGIC, VERSION);
+
+    PreflopEquity table;
+    uint32_t samples = 0;
+    in.read(samples);
+    in.read(table.seed_);
+    table.samples_ = static_cast<int>(samples);
+    table.matrix_.resize(static_cast<size_t>(NUM_CLASSES) * NUM_CLASSES);
+    in.bytes(table.matrix_.data(), table.matrix_.size() * sizeof(double));
+    in.expect_end();
+    for (double e : table.matrix_) {
+        if (!(e >= 0.0 && e <= 1.0)) throw in.corrupt("equity out of range");
+    }
+
+    table.finish();
+    return table;
+}
+
+PreflopEquity PreflopEquity::load_or_compute(const std::string& path, int samples, uint64_t seed) {
+    if (std::filesystem::exists(path)) {
+        PreflopEquity table = load(path);
+        if (table.samples_ == samples && table.seed_ == seed) return table;
+    }
+    PreflopEquity table = compute(samples, seed);
+    table.save(path);
+    return table;
+}
+
+const PreflopEquity& PreflopEquity::standard() {
+    static const PreflopEquity table = compute(STANDARD_SAMPLES, 0);
+    return table;
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Preflop all-in equities of the 169 suit-isomorphic starting hands
+//
+// Classes are numbered by HoldemIndexer's preflop index. The matrix holds
+// the equity of each class against each other one, over every pair of
+// combos that share no card and every board they leave. Column j comes from
+// one RangeEquity run of all 1326 combos against the combos of class j on
+// sampled boards (parallel over runouts). Each hero combo's equity is then
+// weighted by its number of possible opponents in j. E[i][j] + E[j][i] = 1
+// up to sampling error. Equity against a random hand is the average of
+// row i, weighted by compatible pairs; its entries come from independent
+// columns, so it is far more precise than any single entry.
+//
+// Everything a lookup needs is in flat arrays indexed by class or by
+// hole_combo_index, so ranking a hand is one array load.
+class PreflopEquity {
+public:
+    static constexpr int NUM_CLASSES = 169;
+
+    // Sample `samples` boards per villain class (seeded per class, so the
+    // result does not depend on the thread count); about 7 s on one core
+    // for the default. Throws std::invalid_argument if samples < 1.
+    static PreflopEquity compute(int samples = 1000, uint64_t seed = 0);
+
+    // Binary cache: magic, version, byte order, samples, seed and the
+    // matrix. load throws std::runtime_error if the file is missing or not
+    // a valid table; save throws std::runtime_error if it cannot write.
+    static PreflopEquity load(const std::string& path);
+    void save(const std::string& path) const;
+
+    // Load path if it holds a table computed with these settings, otherwise
+    // compute one and save it there. Throws std::runtime_error if path
+    // exists but is not a valid table.
+    static PreflopEquity load_or_compute(const std::string& path, int samples = 1000, uint64_t seed = 0);
+
+    // Computed once per process on first use, with 100 samples per class
+    // (about 1 s on one core); precise enough to rank hands
+    static const PreflopEquity& standard();
+
+    // Class of a hole combo, by hole_combo_index
+    static int hand_class(int combo);
+
+    double equity(int hero_class, int villain_class) const {
+        return matrix_[static_cast<size_t>(hero_class) * NUM_CLASSES + villain_class];
+    }
+    double equity_vs_random(int hand_class) const { return vs_random_[hand_class]; }
+    double combo_equity(int combo) const { return vs_random_[hand_class(combo)]; }
+
+    // Rank by equity against a random hand, 0 = strongest (AA)
+    int rank(int hand_class) const { return rank_[hand_class]; }
+    int combo_rank(int combo) const { return combo_rank_[combo]; }
+
+    int samples() const { return samples_; }
+    uint64_t seed() const { return seed_; }
+
+private:
+    int samples_ = 0;
+    uint64_t seed_ = 0;
+    std::vector<double> matrix_;                             // NUM_CLASSES^2
+    std::array<double, NUM_CLASSES> vs_random_{};
+    std::array<uint8_t, NUM_CLASSES> rank_{};
+    std::array<uint8_t, NUM_HOLE_COMBOS> combo_rank_{};
+
+    // Derive equity against a random hand and ranks from the matrix
+    void finish();
+};
+
+} // namespace quantnet::poker
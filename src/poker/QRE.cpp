@@ -12,20 +12,88 @@ QREResidual::QREResidual(const PokerGame& game, double beta)
     index_.build(info_sets);
 }
 
+namespace {
+
+// Single traversal that accumulates, for every (info set, action) pair,
+//   sum over h in I of: pi(h) * (v(h.a) - v(h))
+// where pi(h) is the full reach probability and v the P0 value under sigma.
+//
+// Because no history in I is an ancestor of another (perfect recall), playing
+// a deterministically at I changes only the subtrees rooted at h in I, so
+//   EV_override(I, a) = EV(sigma) + sum over h in I of pi(h) * (v(h.a) - v(h))
+// which is exactly what expected_utility() computes with one traversal per pair.
+double accumulate_action_deltas(
+    const GameNode* node,
+    const Strategy& sigma,
+    const InfoSetIndex& index,
+    double reach,
+    std::vector<std::vector<double>>& deltas
+) {
+    if (!node) return 0.0;
+
+    switch (node->type) {
+        case NodeType::Terminal:
+            return node->payoff;
+
+        case NodeType::Chance: {
+            double v = 0.0;
+            for (const auto& edge : node->children) {
+                v += edge.probability * accumulate_action_deltas(
+                    edge.child.get(), sigma, index, reach * edge.probability, deltas);
+            }
+            return v;
+        }
+
+        case NodeType::Player: {
+            const Eigen::VectorXd probs = sigma.probs(node->info_set_id);
+            const int num_actions = static_cast<int>(node->children.size());
+
+            Eigen::VectorXd child_values(num_actions);
+            for (int a = 0; a < num_actions; ++a) {
+                child_values(a) = accumulate_action_deltas(
+                    node->children[a].child.get(), sigma, index, reach * probs(a), deltas);
+            }
+
+            const double v = probs.dot(child_values);
+
+            const int is_idx = index.info_set_idx(node->info_set_id);
+            if (is_idx >= 0 && reach != 0.0) {
+                auto& d = deltas[is_idx];
+                for (int a = 0; a < num_actions; ++a) {
+                    d[a] += reach * (child_values(a) - v);
+                }
+            }
+            return v;
+        }
+    }
+
+    return 0.0;
+}
+
+} // namespace
+
 std::map<InfoSetId, std::map<Action, double>> compute_all_expected_utilities(
     const PokerGame& game,
     const Strategy& sigma,
     const InfoSetIndex& index
 ) {
+    std::vector<std::vector<double>> deltas(index.num_info_sets());
+    for (int i = 0; i < index.num_info_sets(); ++i) {
+        deltas[i].assign(index.info_set(i).legal_actions.size(), 0.0);
+    }
+
+    const double ev = accumulate_action_deltas(game.root(), sigma, index, 1.0, deltas);
+
     std::map<InfoSetId, std::map<Action, double>> result;
 
     for (int i = 0; i < index.num_info_sets(); ++i) {
         const InfoSet& is = index.info_set(i);
         std::map<Action, double> action_eu;
 
-        for (Action a : is.legal_actions) {
-            double eu = expected_utility(game.root(), sigma, is.id, a, is.player);
-            action_eu[a] = eu;
+        for (size_t a = 0; a < is.legal_actions.size(); ++a) {
+            // Same convention as expected_utility(): P0 payoff, negated for P1
+            double eu = ev + deltas[i][a];
+            action_eu[is.legal_actions[a]] = (is.player == PLAYER_1) ? -eu : eu;
         }
 
         result[is.id] = action_eu;
@@ -59,6 +59,9 @@ private:
 
 // Compute expected utilities for all actions at all info sets
 // Returns map: info_set_id -> (action -> EU)
+//
+// Values match expected_utility() for every pair, but are obtained from a single
+// tree traversal instead of one traversal per (info set, action).
 std::map<InfoSetId, std::map<Action, double>> compute_all_expected_utilities(
     const PokerGame& game,
     const Strategy& sigma,
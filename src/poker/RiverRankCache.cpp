@@ -0,0 +1,206 @@
+#include "RiverRankCache.hpp"
+#include "TableEvaluator.hpp"
+#include "../io/BinaryFile.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'N', 'R', 'I', 'V', 'E', 'R', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t ENTRIES_OFFSET = 64;
+
+struct RiverRankFileHeader {
+    io::FileHeader file;
+    uint32_t holes_per_board;
+    uint32_t reserved;
+    uint64_t num_boards;
+    uint64_t entries_offset;
+    uint64_t file_size;
+};
+
+CardSet permute_suits(CardSet cards, const std::array<int, NUM_SUITS>& suit_map) {
+    constexpr uint64_t RANKS = (uint64_t{1} << NUM_RANKS) - 1;
+    uint64_t out = 0;
+    for (int s = 0; s < NUM_SUITS; ++s) {
+        out |= ((cards.bits() >> (NUM_RANKS * s)) & RANKS) << (NUM_RANKS * suit_map[s]);
+    }
+    return CardSet(out);
+}
+
+// Position of a live hole pair among the board's 1081, in colex order of
+// the cards' positions among the 47 live cards
+int hole_slot(CardSet hole, CardSet board) {
+    int p[2];
+    int i = 0;
+    for (int c : hole) {
+        p[i++] = c - std::popcount(board.bits() & ((uint64_t{1} << c) - 1));
+    }
+    return p[1] * (p[1] - 1) / 2 + p[0];
+}
+
+} // namespace
+
+const HandIndexer& RiverRankCache::board_indexer() {
+    static const HandIndexer indexer({5});
+    return indexer;
+}
+
+uint64_t RiverRankCache::num_boards() {
+    return board_indexer().size(0);
+}
+
+RiverRankCache::RiverRankCache()
+    : lazy_(std::make_unique<std::atomic<uint32_t*>[]>(num_boards())) {}
+
+RiverRankCache::RiverRankCache(const std::string& path) : file_(path) {
+    const io::MappedReader reader(file_, "river rank file");
+    const auto& header = reader.header<RiverRankFileHeader>(MAGIC, VERSION);
+    if (header.holes_per_board != HOLES_PER_BOARD || header.num_boards != num_boards()) {
+        throw reader.corrupt("wrong table shape");
+    }
+    reader.check_size(header.file_size);
+    if (header.entries_offset != ENTRIES_OFFSET) throw reader.corrupt("section out of bounds");
+    mapped_ = reader.section<uint32_t>(ENTRIES_OFFSET, num_boards() * HOLES_PER_BOARD);
+}
+
+RiverRankCache::~RiverRankCache() {
+    if (!lazy_) return;
+    for (uint64_t b = 0; b < num_boards(); ++b) delete[] lazy_[b].load(std::memory_order_relaxed);
+}
+
+void RiverRankCache::compute_board(CardSet board, uint32_t* out) {
+    // Live hole pairs in slot order
+    std::array<TableEvaluator::HolePair, HOLES_PER_BOARD> holes;
+    int n = 0;
+    for (const auto& combo : hole_combos()) {
+        if (!board.contains(combo[0]) && !board.contains(combo[1])) holes[n++] = combo;
+    }
+
+    std::array<int, 5> board_cards;
+    board.to_cards(board_cards.data());
+    std::array<HandValue, HOLES_PER_BOARD> values;
+    TableEvaluator::evaluate_batch(board_cards, holes, values);
+
+    std::array<uint64_t, HOLES_PER_BOARD> order;
+    for (int i = 0; i < n; ++i) order[i] = (static_cast<uint64_t>(values[i].value) << 32) | i;
+    std::sort(order.begin(), order.end());
+
+    // Same sweep as HandEvaluator::hand_strengths: hands per card strictly
+    // below and at the current value, so card removal is O(1) per hand
+    int below_card[DECK_SIZE] = {};
+    int tied_card[DECK_SIZE] = {};
+    int below = 0;
+    int rank = 0;
+    for (int start = 0; start < n; ++rank) {
+        const uint32_t value = static_cast<uint32_t>(order[start] >> 32);
+        int end = start;
+        while (end < n && static_cast<uint32_t>(order[end] >> 32) == value) {
+            const auto [c1, c2] = holes[static_cast<uint32_t>(order[end])];
+            ++tied_card[c1];
+            ++tied_card[c2];
+            ++end;
+        }
+        const int tied = end - start;
+
+        for (int k = start; k < end; ++k) {
+            const uint32_t i = static_cast<uint32_t>(order[k]);
+            const auto [a, b] = holes[i];
+            const int wins = below - below_card[a] - below_card[b];
+            const int ties = tied - tied_card[a] - tied_card[b] + 1;
+            out[i] = (static_cast<uint32_t>(rank) << 16) | static_cast<uint32_t>(2 * wins + ties);
+        }
+        for (int k = start; k < end; ++k) {
+            const auto [c1, c2] = holes[static_cast<uint32_t>(order[k])];
+            ++below_card[c1];
+            ++below_card[c2];
+            --tied_card[c1];
+            --tied_card[c2];
+        }
+        below += tied;
+        start = end;
+    }
+}
+
+const uint32_t* RiverRankCache::board_entries(uint64_t board_index) const {
+    if (mapped_) return mapped_ + board_index * HOLES_PER_BOARD;
+
+    uint32_t* entries = lazy_[board_index].load(std::memory_order_acquire);
+    if (entries) return entries;
+
+    auto computed = std::make_unique<uint32_t[]>(HOLES_PER_BOARD);
+    const std::vector<CardSet> canonical = board_indexer().unindex(0, board_index);
+    compute_board(canonical[0], computed.get());
+    if (lazy_[board_index].compare_exchange_strong(entries, computed.get(), std::memory_order_acq_rel)) {
+        return computed.release();
+    }
+    return entries;   // Another thread got there first
+}
+
+uint32_t RiverRankCache::entry(CardSet hole, CardSet board) const {
+    if (board.size() != 5 || hole.size() != 2 || hole.intersects(board)) {
+        throw std::invalid_argument("River rank query needs 2 hole cards off a 5-card board");
+    }
+    std::array<int, NUM_SUITS> suit_map;
+    const uint64_t b = board_indexer().index(std::span<const CardSet>(&board, 1), suit_map);
+    return board_entries(b)[hole_slot(permute_suits(hole, suit_map), permute_suits(board, suit_map))];
+}
+
+int RiverRankCache::compare(CardSet hole1, CardSet hole2, CardSet board) const {
+    if (board.size() != 5 || hole1.size() != 2 || hole2.size() != 2 ||
+        hole1.intersects(board) || hole2.intersects(board)) {
+        throw std::invalid_argument("River rank query needs 2 hole cards off a 5-card board");
+    }
+    std::array<int, NUM_SUITS> suit_map;
+    const uint64_t b = board_indexer().index(std::span<const CardSet>(&board, 1), suit_map);
+    const uint32_t* entries = board_entries(b);
+    const CardSet canonical = permute_suits(board, suit_map);
+    const uint32_t r1 = entries[hole_slot(permute_suits(hole1, suit_map), canonical)] >> 16;
+    const uint32_t r2 = entries[hole_slot(permute_suits(hole2, suit_map), canonical)] >> 16;
+    return (r1 > r2) - (r1 < r2);
+}
+
+void RiverRankCache::build_all() {
+    if (mapped_) return;
+    const int64_t n = static_cast<int64_t>(num_boards());
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int64_t b = 0; b < n; ++b) board_entries(static_cast<uint64_t>(b));
+}
+
+uint64_t RiverRankCache::boards_cached() const {
+    if (mapped_) return num_boards();
+    uint64_t cached = 0;
+    for (uint64_t b = 0; b < num_boards(); ++b) {
+        cached += lazy_[b].load(std::memory_order_relaxed) != nullptr;
+    }
+    return cached;
+}
+
+void RiverRankCache::save(const std::string& path) {
+    build_all();
+
+    RiverRankFileHeader header{};
+    header.file = io::FileHeader::make(MAGIC, VERSION);
+    header.holes_per_board = HOLES_PER_BOARD;
+    header.num_boards = num_boards();
+    header.entries_offset = ENTRIES_OFFSET;
+    header.file_size = ENTRIES_OFFSET + num_boards() * HOLES_PER_BOARD * sizeof(uint32_t);
+
+    io::BinaryWriter out(path, "river rank file");
+    char pad[ENTRIES_OFFSET] = {};
+    std::memcpy(pad, &header, sizeof(header));
+    out.bytes(pad, sizeof(pad));
+    for (uint64_t b = 0; b < num_boards(); ++b) {
+        out.bytes(board_entries(b), HOLES_PER_BOARD * sizeof(uint32_t));
+    }
+    out.commit();
+}
+
+} // namespace quantnet::poker
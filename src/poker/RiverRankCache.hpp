@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "HandEvaluator.hpp"
+#include "HandIndexer.hpp"
+#include "../io/MappedFile.hpp"
+
+namespace quantnet::poker {
+
+// River showdown tables per canonical board
+//
+// On the river a hand's strength and its showdown against another hand
+// depend only on the board, yet hand_strength evaluates the board again for
+// every hole pair and every query. This cache settles each board once:
+// the board is mapped to its suit-isomorphic class (134,459 classes, via
+// HandIndexer), and for each of the 1081 hole pairs the class leaves live
+// it stores one 32-bit entry:
+//   bits  0-15   2 * wins + ties against the 990 other live hole pairs
+//   bits 16-31   dense rank of the hand on the board (0 = worst)
+// A query maps the hole pair through the same suit permutation and reads
+// one entry: hand_strength is entry / 1980 (exactly HandEvaluator's value),
+// and a showdown compares two ranks.
+//
+// Boards are computed lazily on first query (lock-free; concurrent queries
+// may compute the same board twice and one result is kept), or all at once
+// over OpenMP threads with build_all(). save() writes the full table (about
+// 580 MB) to a file; the file constructor maps it read-only and queries it
+// in place.
+class RiverRankCache {
+public:
+    static constexpr int HOLES_PER_BOARD = 1081;    // C(47, 2)
+    static constexpr int OPPONENTS = 990;           // C(45, 2)
+
+    // Empty cache; boards are computed on first use
+    RiverRankCache();
+
+    // Map a file written by save(); throws std::runtime_error if it cannot
+    // be mapped or is not a valid river rank file
+    explicit RiverRankCache(const std::string& path);
+
+    ~RiverRankCache();
+
+    RiverRankCache(const RiverRankCache&) = delete;
+    RiverRankCache& operator=(const RiverRankCache&) = delete;
+
+    // Compute every board not cached yet
+    void build_all();
+
+    // Write the full table, computing missing boards first.
+    // Throws std::runtime_error if the file cannot be written.
+    void save(const std::string& path);
+
+    // Canonical river boards, and how many are cached
+    static uint64_t num_boards();
+    uint64_t boards_cached() const;
+    bool is_mapped() const { return file_.is_open(); }
+
+    // Queries: board has 5 cards and no hole card is on it. Throws
+    // std::invalid_argument otherwise.
+
+    // Same value as HandEvaluator::hand_strength(hole, board)
+    double hand_strength(CardSet hole, CardSet board) const {
+        return (entry(hole, board) & 0xFFFF) / (2.0 * OPPONENTS);
+    }
+
+    // Ordinal of the hand's value among the board's hands; higher wins
+    int rank(CardSet hole, CardSet board) const {
+        return static_cast<int>(entry(hole, board) >> 16);
+    }
+
+    // +1 if hole1 wins the showdown, -1 if hole2 wins, 0 on a split
+    int compare(CardSet hole1, CardSet hole2, CardSet board) const;
+
+private:
+    io::MappedFile file_;
+    const uint32_t* mapped_ = nullptr;
+
+    // Lazily computed boards (unused when mapped)
+    std::unique_ptr<std::atomic<uint32_t*>[]> lazy_;
+
+    uint32_t entry(CardSet hole, CardSet board) const;
+    const uint32_t* board_entries(uint64_t board_index) const;
+
+    static const HandIndexer& board_indexer();
+    static void compute_board(CardSet canonical_board, uint32_t* out);
+};
+
+} // namespace quantnet::poker
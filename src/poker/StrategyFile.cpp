@@ -0,0 +1,268 @@
+#include "StrategyFile.hpp"
+#include "../io/BinaryFile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'N', 'S', 'T', 'R', 'A', 'T', '\0'};
+constexpr uint32_t VERSION = 1;
+
+struct StrategyFileHeader {
+    io::FileHeader file;
+    uint32_t prob_format;
+    uint32_t reserved;
+    uint64_t num_info_sets;
+    uint64_t num_entries;
+    uint64_t hashes_offset;
+    uint64_t offsets_offset;
+    uint64_t actions_offset;
+    uint64_t probs_offset;
+    uint64_t id_offsets_offset;   // 0 if ids are not stored
+    uint64_t id_chars_offset;
+    uint64_t id_chars_size;
+    uint64_t file_size;
+};
+
+size_t prob_width(ProbFormat format) {
+    switch (format) {
+        case ProbFormat::F64: return sizeof(double);
+        case ProbFormat::U16: return sizeof(uint16_t);
+        case ProbFormat::U8:  return sizeof(uint8_t);
+    }
+    throw std::runtime_error("Unknown probability format");
+}
+
+// Quantize one distribution so the values sum to exactly `scale`
+// (largest-remainder rounding)
+template<typename Q>
+void quantize(std::span<const double> probs, double scale, std::vector<Q>& out) {
+    const size_t n = probs.size();
+    std::vector<double> frac(n);
+    std::vector<size_t> order(n);
+    long long total = 0;
+
+    const size_t base = out.size();
+    for (size_t i = 0; i < n; ++i) {
+        const double raw = std::clamp(probs[i], 0.0, 1.0) * scale;
+        const double q = std::floor(raw);
+        out.push_back(static_cast<Q>(q));
+        frac[i] = raw - q;
+        total += static_cast<long long>(q);
+    }
+
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&frac](size_t a, size_t b) { return frac[a] > frac[b]; });
+    long long missing = static_cast<long long>(scale) - total;
+    for (size_t k = 0; missing > 0 && n > 0; k = (k + 1) % n, --missing) {
+        out[base + order[k]] += 1;
+    }
+}
+
+} // namespace
+
+void StrategyFile::write(
+    const std::string& path,
+    const Strategy& sigma,
+    const InfoSetIndex& index,
+    ProbFormat format,
+    bool store_ids
+) {
+    const uint64_t n = static_cast<uint64_t>(index.num_info_sets());
+
+    // Info sets in hash order
+    std::vector<std::pair<uint64_t, int>> by_hash;
+    by_hash.reserve(n);
+    for (int i = 0; i < index.num_info_sets(); ++i) {
+        by_hash.emplace_back(StrategyTable::hash_id(index.info_set(i).id), i);
+    }
+    std::sort(by_hash.begin(), by_hash.end());
+    for (size_t k = 1; k < by_hash.size(); ++k) {
+        if (by_hash[k].first == by_hash[k - 1].first) {
+            throw std::runtime_error("Info set hash collision: " +
+                index.info_set(by_hash[k - 1].second).id + " and " + index.info_set(by_hash[k].second).id);
+        }
+    }
+
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> offsets{0};
+    std::vector<Action> actions;
+    std::vector<double> probs;
+    std::vector<uint16_t> q16;
+    std::vector<uint8_t> q8;
+    std::vector<uint32_t> id_offsets{0};
+    std::string id_chars;
+
+    for (const auto& [hash, i] : by_hash) {
+        const InfoSet& is = index.info_set(i);
+        const int num_actions = static_cast<int>(is.legal_actions.size());
+
+        Eigen::VectorXd p = sigma.has_info_set(is.id)
+            ? sigma.probs(is.id)
+            : Eigen::VectorXd::Constant(num_actions, 1.0 / num_actions);
+        if (p.size() != num_actions) {
+            throw std::invalid_argument("Strategy has wrong action count at: " + is.id);
+        }
+        std::span<const double> row(p.data(), static_cast<size_t>(num_actions));
+
+        switch (format) {
+            case ProbFormat::F64: probs.insert(probs.end(), row.begin(), row.end()); break;
+            case ProbFormat::U16: quantize(row, 65535.0, q16); break;
+            case ProbFormat::U8:  quantize(row, 255.0, q8); break;
+        }
+        actions.insert(actions.end(), is.legal_actions.begin(), is.legal_actions.end());
+        offsets.push_back(static_cast<uint32_t>(actions.size()));
+        hashes.push_back(hash);
+
+        if (store_ids) {
+            id_chars += is.id;
+            id_offsets.push_back(static_cast<uint32_t>(id_chars.size()));
+        }
+    }
+
+    const uint64_t entries = actions.size();
+    const void* prob_data = (format == ProbFormat::F64) ? static_cast<const void*>(probs.data())
+                          : (format == ProbFormat::U16) ? static_cast<const void*>(q16.data())
+                          : static_cast<const void*>(q8.data());
+
+    StrategyFileHeader header{};
+    header.file = io::FileHeader::make(MAGIC, VERSION);
+    header.prob_format = static_cast<uint32_t>(format);
+    header.num_info_sets = n;
+    header.num_entries = entries;
+
+    uint64_t pos = io::align_up(sizeof(StrategyFileHeader));
+    auto place = [&pos](uint64_t bytes) {
+        const uint64_t at = pos;
+        pos = io::align_up(pos + bytes);
+        return at;
+    };
+    header.hashes_offset = place(n * sizeof(uint64_t));
+    header.offsets_offset = place((n + 1) * sizeof(uint32_t));
+    header.actions_offset = place(entries * sizeof(Action));
+    header.probs_offset = place(entries * prob_width(format));
+    if (store_ids) {
+        header.id_offsets_offset = place((n + 1) * sizeof(uint32_t));
+        header.id_chars_offset = place(id_chars.size());
+        header.id_chars_size = id_chars.size();
+    }
+    header.file_size = pos;
+
+    // Zero-filled file of the final size, then each section in place
+    io::BinaryWriter out(path, "strategy file");
+    out.reserve(header.file_size);
+    out.at(0, &header, sizeof(header));
+    out.at(header.hashes_offset, hashes.data(), n * sizeof(uint64_t));
+    out.at(header.offsets_offset, offsets.data(), (n + 1) * sizeof(uint32_t));
+    out.at(header.actions_offset, actions.data(), entries * sizeof(Action));
+    out.at(header.probs_offset, prob_data, entries * prob_width(format));
+    if (store_ids) {
+        out.at(header.id_offsets_offset, id_offsets.data(), (n + 1) * sizeof(uint32_t));
+        out.at(header.id_chars_offset, id_chars.data(), id_chars.size());
+    }
+    out.commit();
+}
+
+StrategyFile::StrategyFile(const std::string& path) : file_(path) {
+    const io::MappedReader reader(file_, "strategy file");
+    const auto& header = reader.header<StrategyFileHeader>(MAGIC, VERSION);
+    if (header.prob_format > static_cast<uint32_t>(ProbFormat::U8)) throw reader.corrupt("bad probability format");
+    reader.check_size(header.file_size);
+
+    format_ = static_cast<ProbFormat>(header.prob_format);
+    num_info_sets_ = header.num_info_sets;
+    num_entries_ = header.num_entries;
+
+    // Sections bound their counts by the file size before any count is
+    // used in arithmetic: the hashes bound n, the actions num_entries
+    const uint64_t n = num_info_sets_;
+    hashes_ = reader.section<uint64_t>(header.hashes_offset, n);
+    offsets_ = reader.section<uint32_t>(header.offsets_offset, n + 1);
+    actions_ = reader.section<Action>(header.actions_offset, num_entries_);
+    probs_ = reader.section<std::byte>(header.probs_offset, num_entries_ * prob_width(format_));
+    reader.check_ranges(offsets_, n, num_entries_, "entry offsets");
+
+    if (header.id_offsets_offset != 0) {
+        id_offsets_ = reader.section<uint32_t>(header.id_offsets_offset, n + 1);
+        id_chars_ = reader.section<char>(header.id_chars_offset, header.id_chars_size);
+        reader.check_ranges(id_offsets_, n, header.id_chars_size, "id offsets");
+    }
+}
+
+InfoSetHandle StrategyFile::find(uint64_t hash) const {
+    if (num_info_sets_ == 0) return INVALID_HANDLE;
+
+    // Interpolation search: hashes are uniform, so the expected position of
+    // a key is proportional to its value
+    size_t lo = 0;
+    size_t hi = num_info_sets_ - 1;
+    while (lo <= hi && hash >= hashes_[lo] && hash <= hashes_[hi]) {
+        size_t pos = lo;
+        if (hashes_[hi] != hashes_[lo]) {
+            const long double fraction = static_cast<long double>(hash - hashes_[lo]) /
+                                         static_cast<long double>(hashes_[hi] - hashes_[lo]);
+            pos = lo + std::min(hi - lo, static_cast<size_t>(fraction * static_cast<long double>(hi - lo)));
+        }
+
+        if (hashes_[pos] == hash) return static_cast<InfoSetHandle>(pos);
+        if (hashes_[pos] < hash) {
+            lo = pos + 1;
+        } else {
+            if (pos == 0) break;
+            hi = pos - 1;
+        }
+    }
+    return INVALID_HANDLE;
+}
+
+double StrategyFile::entry_prob(size_t entry) const {
+    switch (format_) {
+        case ProbFormat::F64: return reinterpret_cast<const double*>(probs_)[entry];
+        case ProbFormat::U16: return reinterpret_cast<const uint16_t*>(probs_)[entry] / 65535.0;
+        case ProbFormat::U8:  return static_cast<uint8_t>(probs_[entry]) / 255.0;
+    }
+    return 0.0;
+}
+
+void StrategyFile::probs(InfoSetHandle h, std::span<double> out) const {
+    const size_t n = num_actions(h);
+    if (out.size() < n) {
+        throw std::invalid_argument("probs: output span too small");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = entry_prob(offsets_[h] + i);
+    }
+}
+
+Strategy StrategyFile::to_strategy() const {
+    if (!has_ids()) {
+        throw std::runtime_error("Strategy file has no info set ids: " + file_.path());
+    }
+
+    std::vector<InfoSet> info_sets;
+    info_sets.reserve(num_info_sets_);
+    for (size_t h = 0; h < num_info_sets_; ++h) {
+        InfoSet is;
+        is.id = std::string(id(static_cast<InfoSetHandle>(h)));
+        is.player = CHANCE;  // Not stored; Strategy does not use it
+        auto acts = actions(static_cast<InfoSetHandle>(h));
+        is.legal_actions.assign(acts.begin(), acts.end());
+        info_sets.push_back(std::move(is));
+    }
+    InfoSetIndex index;
+    index.build(info_sets);
+
+    Eigen::VectorXd w(static_cast<Eigen::Index>(num_entries_));
+    for (size_t e = 0; e < num_entries_; ++e) {
+        w(static_cast<Eigen::Index>(e)) = std::log(std::max(entry_prob(e), 1e-10));
+    }
+    return Strategy::from_logits(w, index);
+}
+
+} // namespace quantnet::poker
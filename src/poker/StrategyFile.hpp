@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include "GameTypes.hpp"
+#include "Strategy.hpp"
+#include "StrategyTable.hpp"
+#include "../io/MappedFile.hpp"
+
+namespace quantnet::poker {
+
+// Storage precision of action probabilities in a strategy file
+enum class ProbFormat : uint32_t {
+    F64 = 0,    // Exact
+    U16 = 1,    // p = q / 65535, max error 1.5e-5 per probability
+    U8 = 2      // p = q / 255, max error 3.9e-3 per probability
+};
+
+// Binary strategy file
+//
+// Strategy::to_json() is the only other way a strategy leaves the process;
+// it stores every probability as text and has to be parsed into maps. This
+// format is flat arrays that are memory-mapped and queried in place:
+//
+//   header        StrategyFileHeader (magic, version, counts, section offsets)
+//   hashes        uint64[n]        FNV-1a of each id, sorted ascending
+//   offsets       uint32[n + 1]    entry range of each info set
+//   actions       uint8[entries]   Action of each entry
+//   probs         f64/u16/u8[entries]
+//   id offsets    uint32[n + 1]    byte range of each id (optional)
+//   id chars      char[]           (optional)
+//
+// Info sets are stored in hash order, so the handle of an info set is the
+// position of its hash and lookups are an interpolation search over
+// uniformly distributed keys (a few probes) with no slot table on disk.
+// Hashes are StrategyTable::hash_id, so engines carry one hash for both.
+// Ids are only needed to list the file or convert it back to a Strategy;
+// leaving them out roughly halves the file.
+//
+// Sections are 64-byte aligned. Quantized probabilities are rounded by
+// largest remainder so each info set's quantized values sum to exactly the
+// scale, and dequantized distributions still sum to 1. The file is written
+// in host byte order; opening a file of the other byte order fails.
+//
+// Opening maps the file, validates the header and checks the offset arrays
+// in one pass; nothing is copied or parsed, so load time is a scan of
+// 8 bytes per info set. Handles are specific to the file, not the
+// InfoSetIndex it was written from.
+class StrategyFile {
+public:
+    // Write sigma over the info sets of index (missing info sets are uniform).
+    // Works for any solver: Newton via Strategy::from_logits, CFR via
+    // average_strategy() with CFR::info_set_index().
+    // Throws std::runtime_error if two ids collide in the 64-bit hash.
+    static void write(
+        const std::string& path,
+        const Strategy& sigma,
+        const InfoSetIndex& index,
+        ProbFormat format = ProbFormat::F64,
+        bool store_ids = true
+    );
+
+    // Map and validate a strategy file; throws std::runtime_error if the file
+    // cannot be mapped or is not a valid strategy file
+    explicit StrategyFile(const std::string& path);
+
+    size_t size() const { return num_info_sets_; }
+    size_t num_entries() const { return num_entries_; }
+    ProbFormat format() const { return format_; }
+    bool has_ids() const { return id_chars_ != nullptr; }
+    size_t file_size() const { return file_.size(); }
+
+    // Handle for an info set, INVALID_HANDLE if not in the file
+    InfoSetHandle find(uint64_t hash) const;
+    InfoSetHandle find(std::string_view id) const { return find(StrategyTable::hash_id(id)); }
+
+    // Id of an info set (empty if the file was written without ids)
+    std::string_view id(InfoSetHandle h) const {
+        if (!id_chars_) return {};
+        return {id_chars_ + id_offsets_[h], id_offsets_[h + 1] - id_offsets_[h]};
+    }
+
+    size_t num_actions(InfoSetHandle h) const { return offsets_[h + 1] - offsets_[h]; }
+
+    std::span<const Action> actions(InfoSetHandle h) const {
+        return {actions_ + offsets_[h], num_actions(h)};
+    }
+
+    // Probability of the i-th action at h (dequantized)
+    double prob(InfoSetHandle h, size_t i) const { return entry_prob(offsets_[h] + i); }
+
+    // All action probabilities at h; out must hold num_actions(h) values
+    void probs(InfoSetHandle h, std::span<double> out) const;
+
+    // Copy into a Strategy (logits = log p, floored at 1e-10) for code that
+    // needs the map-based interface. Throws std::runtime_error without ids.
+    Strategy to_strategy() const;
+
+private:
+    io::MappedFile file_;
+    ProbFormat format_ = ProbFormat::F64;
+    size_t num_info_sets_ = 0;
+    size_t num_entries_ = 0;
+
+    // Section pointers into the mapping
+    const uint64_t* hashes_ = nullptr;
+    const uint32_t* offsets_ = nullptr;
+    const Action* actions_ = nullptr;
+    const std::byte* probs_ = nullptr;
+    const uint32_t* id_offsets_ = nullptr;
+    const char* id_chars_ = nullptr;
+
+    double entry_prob(size_t entry) const;
+};
+
+} // namespace quantnet::poker
@@ -0,0 +1,116 @@
+#include "StrategyTable.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+StrategyTable::StrategyTable(const Strategy& sigma, const InfoSetIndex& index) {
+    const int n = index.num_info_sets();
+    offsets_.reserve(n + 1);
+    ids_.reserve(n);
+    probs_.reserve(index.total_dim());
+    actions_.reserve(index.total_dim());
+
+    offsets_.push_back(0);
+    for (int i = 0; i < n; ++i) {
+        const InfoSet& is = index.info_set(i);
+        const int num_actions = static_cast<int>(is.legal_actions.size());
+
+        Eigen::VectorXd p = sigma.has_info_set(is.id)
+            ? sigma.probs(is.id)
+            : Eigen::VectorXd::Constant(num_actions, 1.0 / num_actions);
+        if (p.size() != num_actions) {
+            throw std::invalid_argument("Strategy has wrong action count at: " + is.id);
+        }
+
+        for (int a = 0; a < num_actions; ++a) {
+            probs_.push_back(p(a));
+            actions_.push_back(is.legal_actions[a]);
+        }
+        offsets_.push_back(static_cast<uint32_t>(probs_.size()));
+        ids_.push_back(is.id);
+    }
+
+    // Power-of-two table at most half full keeps linear probes short
+    const size_t capacity = std::bit_ceil(std::max<size_t>(2 * ids_.size(), 16));
+    slot_keys_.assign(capacity, 0);
+    slot_handles_.assign(capacity, INVALID_HANDLE);
+    slot_mask_ = capacity - 1;
+
+    for (size_t h = 0; h < ids_.size(); ++h) {
+        const uint64_t key = slot_key(hash_id(ids_[h]));
+        uint64_t slot = key & slot_mask_;
+        while (slot_keys_[slot] != 0) {
+            if (slot_keys_[slot] == key) {
+                throw std::runtime_error(
+                    "Info set hash collision: " + ids_[slot_handles_[slot]] + " and " + ids_[h]);
+            }
+            slot = (slot + 1) & slot_mask_;
+        }
+        slot_keys_[slot] = key;
+        slot_handles_[slot] = static_cast<InfoSetHandle>(h);
+    }
+}
+
+InfoSetHandle StrategyTable::find(uint64_t hash) const {
+    if (slot_keys_.empty()) return INVALID_HANDLE;
+
+    const uint64_t key = slot_key(hash);
+    for (uint64_t slot = key & slot_mask_; slot_keys_[slot] != 0; slot = (slot + 1) & slot_mask_) {
+        if (slot_keys_[slot] == key) return slot_handles_[slot];
+    }
+    return INVALID_HANDLE;
+}
+
+double StrategyTable::prob(InfoSetHandle h, Action a) const {
+    for (uint32_t i = offsets_[h]; i < offsets_[h + 1]; ++i) {
+        if (actions_[i] == a) return probs_[i];
+    }
+    return 0.0;
+}
+
+Action StrategyTable::sample(InfoSetHandle h, double u) const {
+    const uint32_t begin = offsets_[h];
+    const uint32_t end = offsets_[h + 1];
+
+    double cumulative = 0.0;
+    for (uint32_t i = begin; i + 1 < end; ++i) {
+        cumulative += probs_[i];
+        if (u < cumulative) return actions_[i];
+    }
+    return actions_[end - 1];  // Also absorbs rounding in the cumulative sum
+}
+
+void StrategyTable::find_batch(std::span<const uint64_t> hashes, std::span<InfoSetHandle> out) const {
+    if (out.size() < hashes.size()) {
+        throw std::invalid_argument("find_batch: output span too small");
+    }
+    if (slot_keys_.empty()) {
+        std::fill(out.begin(), out.begin() + hashes.size(), INVALID_HANDLE);
+        return;
+    }
+
+#if defined(__GNUC__)
+    for (uint64_t hash : hashes) {
+        __builtin_prefetch(&slot_keys_[slot_key(hash) & slot_mask_]);
+    }
+#endif
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        out[i] = find(hashes[i]);
+    }
+}
+
+void StrategyTable::probs_batch(
+    std::span<const InfoSetHandle> handles,
+    std::span<std::span<const double>> out
+) const {
+    if (out.size() < handles.size()) {
+        throw std::invalid_argument("probs_batch: output span too small");
+    }
+    for (size_t i = 0; i < handles.size(); ++i) {
+        out[i] = probs(handles[i]);
+    }
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameTypes.hpp"
+#include "Strategy.hpp"
+
+namespace quantnet::poker {
+
+// Interned information set: position in the InfoSetIndex the table was
+// compiled from
+using InfoSetHandle = uint32_t;
+constexpr InfoSetHandle INVALID_HANDLE = UINT32_MAX;
+
+// Read-only strategy table for serving
+//
+// Strategy::probs() looks the id up in a std::map and recomputes a softmax
+// on every call. StrategyTable compiles a solved strategy once into flat
+// arrays:
+//   offsets_[h] .. offsets_[h + 1]   slice of probs_/actions_ for handle h
+//   probs_                           precomputed probabilities
+//   slots_                           open-addressing hash of id -> handle
+//
+// A lookup by handle is two array reads; a lookup by hash is one or two
+// probes of a power-of-two table at most half full. Nothing is mutated
+// after construction, so any number of threads can query one table
+// without locks.
+//
+// Hashes are 64-bit FNV-1a of the info set id. FNV-1a is incremental, so a
+// game engine can carry the hash along as it appends to the id
+// (hash_append) and never build the string on the query path.
+class StrategyTable {
+public:
+    StrategyTable() = default;
+
+    // Compile sigma over the info sets of index (missing info sets are uniform).
+    // Throws std::runtime_error if two ids collide in the 64-bit hash.
+    StrategyTable(const Strategy& sigma, const InfoSetIndex& index);
+
+    // FNV-1a, usable at compile time
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    static constexpr uint64_t hash_append(uint64_t h, std::string_view s) {
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= FNV_PRIME;
+        }
+        return h;
+    }
+
+    static constexpr uint64_t hash_id(std::string_view id) {
+        return hash_append(FNV_OFFSET, id);
+    }
+
+    // Handle for an info set, INVALID_HANDLE if not in the table
+    InfoSetHandle find(uint64_t hash) const;
+    InfoSetHandle find(std::string_view id) const { return find(hash_id(id)); }
+
+    // Action probabilities and actions for a valid handle
+    std::span<const double> probs(InfoSetHandle h) const {
+        return {probs_.data() + offsets_[h], probs_.data() + offsets_[h + 1]};
+    }
+
+    std::span<const Action> actions(InfoSetHandle h) const {
+        return {actions_.data() + offsets_[h], actions_.data() + offsets_[h + 1]};
+    }
+
+    // Probability of one action (0 if the action is not legal)
+    double prob(InfoSetHandle h, Action a) const;
+
+    // Sample an action from a uniform draw u in [0, 1)
+    Action sample(InfoSetHandle h, double u) const;
+
+    // Batch queries: out[i] corresponds to the i-th input.
+    // find_batch prefetches every probe slot before resolving any of them, so
+    // the cache misses of a large batch overlap.
+    void find_batch(std::span<const uint64_t> hashes, std::span<InfoSetHandle> out) const;
+    void probs_batch(std::span<const InfoSetHandle> handles,
+                     std::span<std::span<const double>> out) const;
+
+    // Number of info sets and total (info set, action) entries
+    size_t size() const { return ids_.size(); }
+    size_t num_entries() const { return probs_.size(); }
+
+    const std::string& id(InfoSetHandle h) const { return ids_[h]; }
+
+private:
+    std::vector<uint32_t> offsets_;   // size() + 1 entries
+    std::vector<double> probs_;
+    std::vector<Action> actions_;
+    std::vector<std::string> ids_;
+
+    // Hash slots: key 0 marks an empty slot, so a hash of 0 is stored as 1
+    std::vector<uint64_t> slot_keys_;
+    std::vector<InfoSetHandle> slot_handles_;
+    uint64_t slot_mask_ = 0;
+
+    static uint64_t slot_key(uint64_t hash) { return hash ? hash : 1; }
+};
+
+} // namespace quantnet::poker
@@ -0,0 +1,365 @@
+#include "TableEvaluator.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+// Vector kernels are compiled with per-function target attributes and
+// chosen at runtime, so the rest of the build stays baseline x86-64
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define QUANTNET_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define QUANTNET_BATCH_X86 0
+#endif
+
+namespace quantnet::poker {
+
+namespace {
+
+// Call visit(counts) for every rank-count vector with `remaining` cards
+// over ranks r..12
+template <typename Visit>
+void enumerate_counts(int r, int remaining, int* counts, Visit& visit) {
+    if (r == NUM_RANKS) {
+        if (remaining == 0) visit(counts);
+        return;
+    }
+    for (int c = 0; c <= std::min(remaining, 4); ++c) {
+        counts[r] = c;
+        enumerate_counts(r + 1, remaining - c, counts, visit);
+    }
+}
+
+} // namespace
+
+TableEvaluator::Tables TableEvaluator::build() {
+    Tables t;
+
+    // ways[m][s]: count vectors of length m with entries 0..4 summing to s
+    uint32_t ways[NUM_RANKS + 1][MAX_CARDS + 1] = {};
+    ways[0][0] = 1;
+    for (int m = 1; m <= NUM_RANKS; ++m) {
+        for (int s = 0; s <= MAX_CARDS; ++s) {
+            for (int c = 0; c <= MAX_PER_RANK && c <= s; ++c) {
+                ways[m][s] += ways[m - 1][s - c];
+            }
+        }
+    }
+
+    // Lexicographic position of a count vector, rank 0 most significant:
+    // sum over ranks r of the vectors that agree before r and have fewer
+    // cards at r. k is the number of cards at ranks r..12.
+    auto position_from = [&](const int* counts, int first, int last, int k) {
+        uint32_t pos = 0;
+        for (int r = first; r < last; ++r) {
+            for (int c = 0; c < counts[r]; ++c) {
+                pos += ways[NUM_RANKS - 1 - r][k - c];
+            }
+            k -= counts[r];
+        }
+        return pos;
+    };
+
+    uint32_t pow5[NUM_RANKS];
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        const int digit = (r < LOW_RANKS) ? r : r - LOW_RANKS;
+        pow5[r] = 1;
+        for (int i = 0; i < digit; ++i) pow5[r] *= 5;
+    }
+
+    for (int card = 0; card < DECK_SIZE; ++card) {
+        const int r = card_rank(card);
+        const int s = card_suit(card);
+        const int shift = (r < LOW_RANKS) ? LOW_SHIFT : HIGH_SHIFT;
+        t.card_key[card] = (static_cast<uint64_t>(pow5[r]) << shift) |
+                           (uint64_t{1} << (SUIT_SHIFT + 4 * s));
+        t.card_bit[card] = uint64_t{1} << (16 * s + r);
+    }
+
+    // Positions per part; keys whose digits exceed 4 or sum past n are
+    // unreachable and stay 0
+    int counts[NUM_RANKS];
+    auto decode = [&](uint32_t key, int first, int last) {
+        int total = 0;
+        for (int r = first; r < last; ++r) {
+            counts[r] = static_cast<int>(key % 5);
+            key /= 5;
+            total += counts[r];
+        }
+        return total;
+    };
+
+    t.high_position.assign(HIGH_KEYS + 1, 0);
+    for (uint32_t key = 0; key < HIGH_KEYS; ++key) {
+        const int k = decode(key, LOW_RANKS, NUM_RANKS);
+        if (k <= MAX_CARDS) {
+            t.high_position[key] = static_cast<uint16_t>(position_from(counts, LOW_RANKS, NUM_RANKS, k));
+        }
+    }
+
+    for (int n = 5; n <= MAX_CARDS; ++n) {
+        t.low_position[n].assign(LOW_KEYS + 1, 0);
+        for (uint32_t key = 0; key < LOW_KEYS; ++key) {
+            if (decode(key, 0, LOW_RANKS) <= n) {
+                t.low_position[n][key] = static_cast<uint16_t>(position_from(counts, 0, LOW_RANKS, n));
+            }
+        }
+    }
+
+    // Unsuited values: every count vector of n cards, with suits dealt
+    // round-robin so no suit reaches five cards
+    for (int n = 5; n <= MAX_CARDS; ++n) {
+        t.unsuited[n].assign(ways[NUM_RANKS][n], 0);
+        std::vector<int> cards;
+        auto visit = [&](const int* c) {
+            uint32_t low = 0;
+            uint32_t high = 0;
+            cards.clear();
+            for (int r = 0; r < NUM_RANKS; ++r) {
+                (r < LOW_RANKS ? low : high) += c[r] * pow5[r];
+                for (int i = 0; i < c[r]; ++i) {
+                    cards.push_back(make_card(r, static_cast<int>(cards.size()) % NUM_SUITS));
+                }
+            }
+            t.unsuited[n][t.low_position[n][low] + t.high_position[high]] =
+                HandEvaluator::evaluate(cards).value;
+        };
+        enumerate_counts(0, n, counts, visit);
+    }
+
+    // Flushes: every 5-7 rank subset of one suit
+    t.flush.assign(1u << NUM_RANKS, 0);
+    std::vector<int> cards;
+    for (uint32_t mask = 0; mask < (1u << NUM_RANKS); ++mask) {
+        const int n = std::popcount(mask);
+        if (n < 5 || n > MAX_CARDS) continue;
+        cards.clear();
+        for (int r = 0; r < NUM_RANKS; ++r) {
+            if (mask & (1u << r)) cards.push_back(make_card(r, 0));
+        }
+        t.flush[mask] = HandEvaluator::evaluate(cards).value;
+    }
+
+    return t;
+}
+
+// ============================================================================
+// Batch evaluation
+// ============================================================================
+
+static_assert(sizeof(TableEvaluator::HolePair) == 2 * sizeof(int));
+static_assert(sizeof(HandValue) == sizeof(uint32_t));
+
+bool TableEvaluator::batch_isa_supported(BatchIsa isa) {
+    switch (isa) {
+        case BatchIsa::Portable: return true;
+#if QUANTNET_BATCH_X86
+        case BatchIsa::Avx2: return __builtin_cpu_supports("avx2");
+        case BatchIsa::Avx512: return __builtin_cpu_supports("avx512f");
+#else
+        case BatchIsa::Avx2: return false;
+        case BatchIsa::Avx512: return false;
+#endif
+    }
+    return false;
+}
+
+TableEvaluator::BatchIsa TableEvaluator::best_batch_isa() {
+    static const BatchIsa best =
+        batch_isa_supported(BatchIsa::Avx512) ? BatchIsa::Avx512 :
+        batch_isa_supported(BatchIsa::Avx2) ? BatchIsa::Avx2 : BatchIsa::Portable;
+    return best;
+}
+
+const char* TableEvaluator::batch_isa_name(BatchIsa isa) {
+    switch (isa) {
+        case BatchIsa::Portable: return "portable";
+        case BatchIsa::Avx2: return "avx2";
+        case BatchIsa::Avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+void TableEvaluator::evaluate_batch(std::span<const int> board,
+                                    std::span<const HolePair> holes,
+                                    std::span<HandValue> out,
+                                    BatchIsa isa) {
+    if (board.size() < 3 || board.size() > 5) {
+        throw std::invalid_argument("Batch evaluation needs a board of 3-5 cards");
+    }
+    if (out.size() < holes.size()) {
+        throw std::invalid_argument("Batch output is shorter than the hole pairs");
+    }
+    // Card keys and bits are table reads, so every card is checked before
+    // the kernels index with it
+    auto bad_card = [](int c) { return static_cast<unsigned>(c) >= DECK_SIZE; };
+    CardSet board_set;
+    for (int c : board) {
+        if (bad_card(c) || board_set.contains(c)) {
+            throw std::invalid_argument("Batch board cards must be distinct cards 0-51");
+        }
+        board_set.insert(c);
+    }
+    for (const auto& [c0, c1] : holes) {
+        if (bad_card(c0) || bad_card(c1) || c0 == c1 || board_set.contains(c0) || board_set.contains(c1)) {
+            throw std::invalid_argument("Batch hole pairs must be two distinct cards 0-51 off the board");
+        }
+    }
+    if (!batch_isa_supported(isa)) {
+        throw std::invalid_argument(std::string("CPU does not support ") + batch_isa_name(isa));
+    }
+
+    const Tables& t = tables();
+    const PartialHand b = partial(board);
+    const int n = b.size + 2;
+
+    switch (isa) {
+        case BatchIsa::Portable: batch_portable(t, n, b.key, b.bits, holes, out.data()); break;
+        case BatchIsa::Avx2: batch_avx2(t, n, b.key, b.bits, holes, out.data()); break;
+        case BatchIsa::Avx512: batch_avx512(t, n, b.key, b.bits, holes, out.data()); break;
+    }
+}
+
+void TableEvaluator::batch_portable(const Tables& t, int n, uint64_t key, uint64_t bits,
+                                    std::span<const HolePair> holes, HandValue* out) {
+    for (size_t i = 0; i < holes.size(); ++i) {
+        const auto [c0, c1] = holes[i];
+        out[i] = from_key(t, n, key + t.card_key[c0] + t.card_key[c1],
+                          bits | t.card_bit[c0] | t.card_bit[c1]);
+    }
+}
+
+// Vector lanes carry the low and high 32 bits of the card keys separately:
+// the rank fields (bits 0-30) never carry into the suit counters. Card keys
+// are read straight out of card_key with a stride of 8 bytes.
+
+#if QUANTNET_BATCH_X86
+
+__attribute__((target("avx2")))
+void TableEvaluator::batch_avx2(const Tables& t, int n, uint64_t key, uint64_t bits,
+                                std::span<const HolePair> holes, HandValue* out) {
+    const int* rank_keys = reinterpret_cast<const int*>(t.card_key.data());
+    const int* suit_keys = rank_keys + 1;
+    const int* low_position = reinterpret_cast<const int*>(t.low_position[n].data());
+    const int* high_position = reinterpret_cast<const int*>(t.high_position.data());
+    const int* unsuited = reinterpret_cast<const int*>(t.unsuited[n].data());
+    const int* hole_cards = reinterpret_cast<const int*>(holes.data());
+
+    const __m256i board_ranks = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(key)));
+    const __m256i board_suits = _mm256_set1_epi32(static_cast<int>(key >> SUIT_SHIFT));
+    const __m256i low_mask = _mm256_set1_epi32(0x3FFF);
+    const __m256i high_mask = _mm256_set1_epi32(0x1FFFF);
+    const __m256i position_mask = _mm256_set1_epi32(0xFFFF);
+    const __m256i flush_add = _mm256_set1_epi32(0x3333);
+    const __m256i flush_test = _mm256_set1_epi32(0x8888);
+
+    size_t i = 0;
+    for (; i + 8 <= holes.size(); i += 8) {
+        // Split 8 pairs into first and second cards: shuffle_ps works per
+        // 128-bit half, leaving pairs in order 0 1 4 5 2 3 6 7
+        const __m256 a = _mm256_castsi256_ps(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hole_cards + 2 * i)));
+        const __m256 b = _mm256_castsi256_ps(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hole_cards + 2 * i + 8)));
+        const __m256i first = _mm256_permute4x64_epi64(
+            _mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256i second = _mm256_permute4x64_epi64(
+            _mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0));
+
+        const __m256i ranks = _mm256_add_epi32(board_ranks, _mm256_add_epi32(
+            _mm256_i32gather_epi32(rank_keys, first, 8), _mm256_i32gather_epi32(rank_keys, second, 8)));
+        const __m256i suits = _mm256_add_epi32(board_suits, _mm256_add_epi32(
+            _mm256_i32gather_epi32(suit_keys, first, 8), _mm256_i32gather_epi32(suit_keys, second, 8)));
+
+        const __m256i low = _mm256_and_si256(_mm256_srli_epi32(ranks, LOW_SHIFT), low_mask);
+        const __m256i high = _mm256_and_si256(ranks, high_mask);
+        const __m256i position = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_i32gather_epi32(low_position, low, 2), position_mask),
+            _mm256_and_si256(_mm256_i32gather_epi32(high_position, high, 2), position_mask));
+        const __m256i values = _mm256_i32gather_epi32(unsuited, position, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+
+        // Redo the flush lanes one at a time
+        const __m256i flush = _mm256_and_si256(_mm256_add_epi32(suits, flush_add), flush_test);
+        unsigned lanes = ~static_cast<unsigned>(_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(flush, _mm256_setzero_si256())))) & 0xFFu;
+        while (lanes) {
+            const size_t j = i + std::countr_zero(lanes);
+            batch_portable(t, n, key, bits, holes.subspan(j, 1), out + j);
+            lanes &= lanes - 1;
+        }
+    }
+    batch_portable(t, n, key, bits, holes.subspan(i), out + i);
+}
+
+// GCC 12's AVX-512 intrinsics pass _mm512_undefined_epi32() as the
+// fallthrough operand, which -Wmaybe-uninitialized reports at every call
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f")))
+void TableEvaluator::batch_avx512(const Tables& t, int n, uint64_t key, uint64_t bits,
+                                  std::span<const HolePair> holes, HandValue* out) {
+    const int* rank_keys = reinterpret_cast<const int*>(t.card_key.data());
+    const int* suit_keys = rank_keys + 1;
+    const int* low_position = reinterpret_cast<const int*>(t.low_position[n].data());
+    const int* high_position = reinterpret_cast<const int*>(t.high_position.data());
+    const int* unsuited = reinterpret_cast<const int*>(t.unsuited[n].data());
+    const int* hole_cards = reinterpret_cast<const int*>(holes.data());
+
+    const __m512i board_ranks = _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(key)));
+    const __m512i board_suits = _mm512_set1_epi32(static_cast<int>(key >> SUIT_SHIFT));
+    const __m512i low_mask = _mm512_set1_epi32(0x3FFF);
+    const __m512i high_mask = _mm512_set1_epi32(0x1FFFF);
+    const __m512i position_mask = _mm512_set1_epi32(0xFFFF);
+    const __m512i flush_add = _mm512_set1_epi32(0x3333);
+    const __m512i flush_test = _mm512_set1_epi32(0x8888);
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+    size_t i = 0;
+    for (; i + 16 <= holes.size(); i += 16) {
+        const __m512i a = _mm512_loadu_si512(hole_cards + 2 * i);
+        const __m512i b = _mm512_loadu_si512(hole_cards + 2 * i + 16);
+        const __m512i first = _mm512_permutex2var_epi32(a, even, b);
+        const __m512i second = _mm512_permutex2var_epi32(a, odd, b);
+
+        const __m512i ranks = _mm512_add_epi32(board_ranks, _mm512_add_epi32(
+            _mm512_i32gather_epi32(first, rank_keys, 8), _mm512_i32gather_epi32(second, rank_keys, 8)));
+        const __m512i suits = _mm512_add_epi32(board_suits, _mm512_add_epi32(
+            _mm512_i32gather_epi32(first, suit_keys, 8), _mm512_i32gather_epi32(second, suit_keys, 8)));
+
+        const __m512i low = _mm512_and_si512(_mm512_srli_epi32(ranks, LOW_SHIFT), low_mask);
+        const __m512i high = _mm512_and_si512(ranks, high_mask);
+        const __m512i position = _mm512_add_epi32(
+            _mm512_and_si512(_mm512_i32gather_epi32(low, low_position, 2), position_mask),
+            _mm512_and_si512(_mm512_i32gather_epi32(high, high_position, 2), position_mask));
+        _mm512_storeu_si512(out + i, _mm512_i32gather_epi32(position, unsuited, 4));
+
+        // Redo the flush lanes one at a time
+        unsigned lanes = _mm512_test_epi32_mask(_mm512_add_epi32(suits, flush_add), flush_test);
+        while (lanes) {
+            const size_t j = i + std::countr_zero(lanes);
+            batch_portable(t, n, key, bits, holes.subspan(j, 1), out + j);
+            lanes &= lanes - 1;
+        }
+    }
+    batch_portable(t, n, key, bits, holes.subspan(i), out + i);
+}
+
+#pragma GCC diagnostic pop
+
+#else
+
+void TableEvaluator::batch_avx2(const Tables& t, int n, uint64_t key, uint64_t bits,
+                                std::span<const HolePair> holes, HandValue* out) {
+    batch_portable(t, n, key, bits, holes, out);
+}
+
+void TableEvaluator::batch_avx512(const Tables& t, int n, uint64_t key, uint64_t bits,
+                                  std::span<const HolePair> holes, HandValue* out) {
+    batch_portable(t, n, key, bits, holes, out);
+}
+
+#endif
+
+} // namespace quantnet::poker
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "HandEvaluator.hpp"
+
+namespace quantnet::poker {
+
+// Table-driven 5-7 card hand evaluator
+//
+// Returns exactly HandEvaluator::evaluate's HandValue for the same cards,
+// without allocating, sorting or branching on the hand category.
+//
+// With at most seven cards a flush beats every hand the other cards could
+// make, so a suit with five or more cards decides the hand on its own:
+//   flush        13-bit rank mask of the flush suit -> value (8192 entries)
+// Otherwise the value depends only on how many cards of each rank there are.
+// The rank counts (each 0-4, summing to n) are hashed to their
+// lexicographic position among all such vectors, which is dense and
+// collision-free (6175 / 18395 / 49205 positions for 5 / 6 / 7 cards):
+//   unsuited[n]  position -> value
+//
+// The position splits into a part for ranks 2-7, which depends on n, and a
+// part for ranks 8-A, which depends only on their own counts. Each part is
+// looked up from the base-5 digits of its counts, and those digits are
+// summed card by card: every card adds one precomputed 64-bit key holding
+// both base-5 numbers and a per-suit counter. An evaluation is n adds and
+// ORs, a flush test and three table reads.
+//
+// Tables are generated with HandEvaluator on first use (about 40 ms,
+// thread-safe) and are read-only afterwards.
+//
+// evaluate_batch() evaluates many hole pairs against one board. The board's
+// key is summed once, and each hand adds its two hole cards. With AVX2 or
+// AVX-512 the keys and table reads of 8 or 16 hands go through vector
+// gathers, and any lanes holding a flush are finished one at a time. The
+// instruction set is picked at runtime, so the build needs no -march flags.
+class TableEvaluator {
+public:
+    using HolePair = std::array<int, 2>;
+
+    enum class BatchIsa { Portable, Avx2, Avx512 };
+
+    static HandValue evaluate(const std::array<int, 7>& cards) {
+        return evaluate_n<7>(cards.data());
+    }
+
+    static HandValue evaluate(const std::array<int, 2>& hole,
+                              const std::array<int, 5>& board) {
+        const std::array<int, 7> cards = {
+            hole[0], hole[1], board[0], board[1], board[2], board[3], board[4]
+        };
+        return evaluate_n<7>(cards.data());
+    }
+
+    // n must be 5, 6 or 7 (unchecked)
+    static HandValue evaluate(const int* cards, int n) {
+        switch (n) {
+            case 5: return evaluate_n<5>(cards);
+            case 6: return evaluate_n<6>(cards);
+            default: return evaluate_n<7>(cards);
+        }
+    }
+
+    // Cards summed so far: rank counts (base-5 keys), suit counts and rank
+    // masks per suit. Adding a card is one add and one OR, so a board can
+    // be summed once and extended by each hand's hole cards or runout.
+    struct PartialHand {
+        uint64_t key = 0;
+        uint64_t bits = 0;
+        int size = 0;
+    };
+
+    static PartialHand partial(std::span<const int> cards) {
+        PartialHand p;
+        for (int c : cards) p = add(p, c);
+        return p;
+    }
+
+    static PartialHand add(PartialHand p, int card) {
+        const Tables& t = tables();
+        return {p.key + t.card_key[card], p.bits | t.card_bit[card], p.size + 1};
+    }
+
+    // p must hold 5-7 distinct cards (unchecked)
+    static HandValue evaluate(const PartialHand& p) {
+        return from_key(tables(), p.size, p.key, p.bits);
+    }
+
+    // out[i] = value of holes[i] plus board. board holds 3-5 distinct
+    // cards, and each hole pair two distinct cards off the board.
+    // Throws std::invalid_argument on any other cards or if out is shorter
+    // than holes.
+    static void evaluate_batch(std::span<const int> board,
+                               std::span<const HolePair> holes,
+                               std::span<HandValue> out) {
+        evaluate_batch(board, holes, out, best_batch_isa());
+    }
+
+    // Same with a chosen instruction set (for tests and benchmarks).
+    // Throws std::invalid_argument if the CPU does not support it.
+    static void evaluate_batch(std::span<const int> board,
+                               std::span<const HolePair> holes,
+                               std::span<HandValue> out,
+                               BatchIsa isa);
+
+    static BatchIsa best_batch_isa();
+    static bool batch_isa_supported(BatchIsa isa);
+    static const char* batch_isa_name(BatchIsa isa);
+
+    // Build the tables now rather than on the first evaluation
+    static void init() { tables(); }
+
+private:
+    static constexpr int MAX_CARDS = 7;
+    static constexpr int MAX_PER_RANK = 4;
+
+    // Ranks [0, LOW_RANKS) form the low part of the position
+    static constexpr int LOW_RANKS = 6;
+    static constexpr uint32_t LOW_KEYS = 15625;     // 5^6
+    static constexpr uint32_t HIGH_KEYS = 78125;    // 5^7
+
+    // Card key layout
+    static constexpr int HIGH_SHIFT = 0;            // 17 bits
+    static constexpr int LOW_SHIFT = 17;            // 14 bits
+    static constexpr int SUIT_SHIFT = 32;           // 4 bits per suit
+
+    struct Tables {
+        std::array<uint64_t, DECK_SIZE> card_key;   // Summed per card
+        std::array<uint64_t, DECK_SIZE> card_bit;   // OR-ed: bit 16 * suit + rank
+
+        // Position tables have one padding entry, so a vector gather can
+        // read 32 bits at any valid 16-bit index
+        std::array<std::vector<uint16_t>, MAX_CARDS + 1> low_position;  // [n][low key]
+        std::vector<uint16_t> high_position;                            // [high key]
+        std::array<std::vector<uint32_t>, MAX_CARDS + 1> unsuited;      // [n][position]
+        std::vector<uint32_t> flush;                                    // [rank mask]
+    };
+
+    static const Tables& tables() {
+        static const Tables t = build();
+        return t;
+    }
+
+    static Tables build();
+
+    // Fixed size so the card loop unrolls
+    template <int N>
+    static HandValue evaluate_n(const int* cards);
+
+    // Value of n cards from their summed keys and OR-ed bits
+    static HandValue from_key(const Tables& t, int n, uint64_t key, uint64_t bits);
+
+    // Batch kernels; each handles every hand it is given
+    static void batch_portable(const Tables& t, int n, uint64_t key, uint64_t bits,
+                               std::span<const HolePair> holes, HandValue* out);
+    static void batch_avx2(const Tables& t, int n, uint64_t key, uint64_t bits,
+                           std::span<const HolePair> holes, HandValue* out);
+    static void batch_avx512(const Tables& t, int n, uint64_t key, uint64_t bits,
+                             std::span<const HolePair> holes, HandValue* out);
+};
+
+template <int N>
+inline HandValue TableEvaluator::evaluate_n(const int* cards) {
+    const Tables& t = tables();
+
+    uint64_t key = 0;
+    uint64_t bits = 0;
+    for (int i = 0; i < N; ++i) {
+        key += t.card_key[cards[i]];
+        bits |= t.card_bit[cards[i]];
+    }
+    return from_key(t, N, key, bits);
+}
+
+inline HandValue TableEvaluator::from_key(const Tables& t, int n, uint64_t key, uint64_t bits) {
+    // Suit counters are at most 7, so adding 3 sets a nibble's top bit
+    // exactly when the suit has five or more cards
+    const uint32_t flush_suits = (static_cast<uint32_t>(key >> SUIT_SHIFT) + 0x3333u) & 0x8888u;
+    if (flush_suits) {
+        const int suit = std::countr_zero(flush_suits) / 4;
+        return HandValue(t.flush[(bits >> (16 * suit)) & 0x1FFF]);
+    }
+
+    const uint32_t low = static_cast<uint32_t>(key >> LOW_SHIFT) & 0x3FFF;
+    const uint32_t high = static_cast<uint32_t>(key >> HIGH_SHIFT) & 0x1FFFF;
+    return HandValue(t.unsuited[n][t.low_position[n][low] + t.high_position[high]]);
+}
+
+} // namespace quantnet::poker
@@ -0,0 +1,254 @@
+#include "TurnHoldem.hpp"
+#include "HandEvaluator.hpp"
+#include "../parallel/CounterRng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+namespace quantnet::poker {
+
+namespace {
+
+constexpr int ANTE = 1;
+constexpr int BET = 2;
+
+// Histories at which each player acts, with their legal actions
+struct Decision {
+    PlayerId player;
+    const char* history;
+    std::vector<Action> actions;
+};
+
+const std::vector<Decision>& decisions() {
+    static const std::vector<Decision> all = {
+        {PLAYER_0, "", {Action::Check, Action::Bet}},
+        {PLAYER_1, "c", {Action::Check, Action::Bet}},
+        {PLAYER_1, "b", {Action::Call, Action::Fold}},
+        {PLAYER_0, "cb", {Action::Call, Action::Fold}},
+    };
+    return all;
+}
+
+} // namespace
+
+TurnHoldem::TurnHoldem(const std::array<int, 4>& board, int num_hands, uint64_t seed,
+                       const CardAbstraction* abstraction)
+    : board_(board), abstracted_(abstraction != nullptr) {
+    CardSet board_set;
+    for (int c : board) {
+        if (c < 0 || c >= DECK_SIZE || board_set.contains(c)) {
+            throw std::invalid_argument("Turn Hold'em board needs 4 distinct cards");
+        }
+        board_set.insert(c);
+    }
+    std::vector<std::array<int, 2>> live;
+    for (const auto& combo : hole_combos()) {
+        if (!CardSet::of(combo).intersects(board_set)) live.push_back(combo);
+    }
+    if (num_hands < 2 || num_hands > static_cast<int>(live.size())) {
+        throw std::invalid_argument("Turn Hold'em needs 2-1128 hands in its pool");
+    }
+
+    // Seeded partial shuffle; the pool is kept in hole_combo_index order
+    parallel::CounterRng rng(seed, 0x7C4E0000u);
+    for (int i = 0; i < num_hands; ++i) {
+        std::swap(live[i], live[i + rng.below(static_cast<uint32_t>(live.size() - i))]);
+    }
+    hands_.assign(live.begin(), live.begin() + num_hands);
+    std::sort(hands_.begin(), hands_.end(), [](const auto& a, const auto& b) {
+        return hole_combo_index(a[0], a[1]) < hole_combo_index(b[0], b[1]);
+    });
+
+    std::set<std::string> distinct;
+    for (const auto& hand : hands_) {
+        if (abstraction) {
+            const BucketId bucket = abstraction->get_bucket(CardSet::of(hand), board_set, BettingRound::Turn);
+            labels_.push_back("b" + std::to_string(bucket));
+        } else {
+            labels_.push_back(card_to_string(hand[0]) + card_to_string(hand[1]));
+        }
+        distinct.insert(labels_.back());
+    }
+    num_labels_ = static_cast<int>(distinct.size());
+
+    name_ = "Turn Hold'em";
+    if (abstraction) name_ += " (" + abstraction->name() + ")";
+
+    // Showdown values from each hand's value on every river
+    const int n = static_cast<int>(hands_.size());
+    std::vector<uint32_t> values(static_cast<size_t>(n) * DECK_SIZE, 0);
+    for (int h = 0; h < n; ++h) {
+        for (int river = 0; river < DECK_SIZE; ++river) {
+            if (board_set.contains(river) || river == hands_[h][0] || river == hands_[h][1]) continue;
+            const std::array<int, 7> cards = {hands_[h][0], hands_[h][1], board[0], board[1],
+                                              board[2], board[3], river};
+            values[static_cast<size_t>(h) * DECK_SIZE + river] = HandEvaluator::evaluate(cards).value;
+        }
+    }
+    showdown_.assign(static_cast<size_t>(n) * n, 0.0);
+    for (int a = 0; a < n; ++a) {
+        const CardSet hand_a = CardSet::of(hands_[a]);
+        for (int b = 0; b < n; ++b) {
+            const CardSet dead = hand_a | CardSet::of(hands_[b]) | board_set;
+            if (dead.size() < 8) continue;
+            int net = 0;
+            int rivers = 0;
+            for (int river : ~dead) {
+                const uint32_t va = values[static_cast<size_t>(a) * DECK_SIZE + river];
+                const uint32_t vb = values[static_cast<size_t>(b) * DECK_SIZE + river];
+                net += (va > vb) - (va < vb);
+                ++rivers;
+            }
+            showdown_[static_cast<size_t>(a) * n + b] = static_cast<double>(net) / rivers;
+        }
+    }
+
+    build_tree();
+}
+
+std::string TurnHoldem::name() const {
+    return name_;
+}
+
+InfoSetId TurnHoldem::make_info_set_id(PlayerId player, const std::string& hand, const std::string& history) {
+    // Format: "P{player}:{hand}:{history}", e.g. "P0:AhKh:", "P1:b7:b"
+    return "P" + std::to_string(player) + ":" + hand + ":" + history;
+}
+
+double TurnHoldem::showdown_value(int hand0, int hand1) const {
+    return showdown_[static_cast<size_t>(hand0) * hands_.size() + hand1];
+}
+
+void TurnHoldem::build_tree() {
+    root_ = std::make_unique<GameNode>();
+    root_->type = NodeType::Chance;
+    root_->player = CHANCE;
+    root_->pot = 2 * ANTE;
+    root_->history = "";
+
+    // Every ordered pair of disjoint hands, equally likely
+    const int n = static_cast<int>(hands_.size());
+    std::vector<std::pair<int, int>> deals;
+    for (int a = 0; a < n; ++a) {
+        for (int b = 0; b < n; ++b) {
+            if (!CardSet::of(hands_[a]).intersects(CardSet::of(hands_[b]))) deals.emplace_back(a, b);
+        }
+    }
+    const double deal_prob = 1.0 / static_cast<double>(deals.size());
+
+    root_->children.reserve(deals.size());
+    for (size_t d = 0; d < deals.size(); ++d) {
+        const auto [hand0, hand1] = deals[d];
+        ChildEdge edge;
+        edge.card = static_cast<Card>(d);
+        edge.probability = deal_prob;
+        edge.child = std::make_unique<GameNode>();
+
+        GameNode* child = edge.child.get();
+        child->type = NodeType::Player;
+        child->player = PLAYER_0;
+        child->p0_card = hand0;
+        child->p1_card = hand1;
+        child->pot = 2 * ANTE;
+        child->history = "";
+        child->legal_actions = {Action::Check, Action::Bet};
+        child->info_set_id = make_info_set_id(PLAYER_0, labels_[hand0], "");
+        build_subtree(child, PLAYER_0, "", hand0, hand1, 2 * ANTE);
+
+        root_->children.push_back(std::move(edge));
+    }
+}
+
+void TurnHoldem::build_subtree(GameNode* node, PlayerId to_act, const std::string& history,
+                               int hand0, int hand1, int pot) {
+    for (Action action : node->legal_actions) {
+        ChildEdge edge;
+        edge.action = action;
+        edge.child = std::make_unique<GameNode>();
+        GameNode* child = edge.child.get();
+        child->p0_card = hand0;
+        child->p1_card = hand1;
+        child->history = history + action_to_char(action);
+
+        const PlayerId other = to_act == PLAYER_0 ? PLAYER_1 : PLAYER_0;
+        const int other_hand = other == PLAYER_0 ? hand0 : hand1;
+        if (action == Action::Check && to_act == PLAYER_0) {
+            child->type = NodeType::Player;
+            child->player = other;
+            child->pot = pot;
+            child->legal_actions = {Action::Check, Action::Bet};
+            child->info_set_id = make_info_set_id(other, labels_[other_hand], child->history);
+            build_subtree(child, other, child->history, hand0, hand1, pot);
+        } else if (action == Action::Bet) {
+            child->type = NodeType::Player;
+            child->player = other;
+            child->pot = pot + BET;
+            child->legal_actions = {Action::Call, Action::Fold};
+            child->info_set_id = make_info_set_id(other, labels_[other_hand], child->history);
+            build_subtree(child, other, child->history, hand0, hand1, pot + BET);
+        } else if (action == Action::Fold) {
+            // The folder loses what it put in: the ante, since bets are
+            // only ever folded to
+            child->type = NodeType::Terminal;
+            child->player = -1;
+            child->pot = pot;
+            child->payoff = to_act == PLAYER_0 ? -ANTE : ANTE;
+        } else {
+            // Check behind or call: showdown over the river
+            child->type = NodeType::Terminal;
+            child->player = -1;
+            child->pot = action == Action::Call ? pot + BET : pot;
+            child->payoff = child->pot / 2.0 * showdown_value(hand0, hand1);
+        }
+
+        node->children.push_back(std::move(edge));
+    }
+}
+
+std::vector<InfoSet> TurnHoldem::get_info_sets() const {
+    // Every label reaches every decision, so the info sets follow from the
+    // labels without walking the tree; sorted by id like the other games
+    std::map<InfoSetId, InfoSet> info_set_map;
+    for (const std::string& label : labels_) {
+        for (const Decision& d : decisions()) {
+            InfoSet is;
+            is.id = make_info_set_id(d.player, label, d.history);
+            is.player = d.player;
+            is.legal_actions = d.actions;
+            info_set_map.emplace(is.id, is);
+        }
+    }
+
+    std::vector<InfoSet> result;
+    for (const auto& [id, is] : info_set_map) result.push_back(is);
+    return result;
+}
+
+Strategy TurnHoldem::unabstracted(const Strategy& sigma) const {
+    if (!abstracted_) return sigma;
+
+    std::vector<InfoSet> info_sets;
+    std::vector<InfoSetId> sources;
+    for (size_t h = 0; h < hands_.size(); ++h) {
+        const std::string cards = card_to_string(hands_[h][0]) + card_to_string(hands_[h][1]);
+        for (const Decision& d : decisions()) {
+            info_sets.push_back({make_info_set_id(d.player, cards, d.history), d.player, d.actions});
+            sources.push_back(make_info_set_id(d.player, labels_[h], d.history));
+        }
+    }
+    InfoSetIndex index;
+    index.build(info_sets);
+
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(index.total_dim());
+    int start = 0;
+    for (size_t i = 0; i < info_sets.size(); ++i) {
+        const Eigen::VectorXd probs = sigma.probs(sources[i]);
+        for (Eigen::Index a = 0; a < probs.size(); ++a) w(start + a) = std::log(std::max(probs(a), 1e-10));
+        start += static_cast<int>(info_sets[i].legal_actions.size());
+    }
+    return Strategy::from_logits(w, index);
+}
+
+} // namespace quantnet::poker
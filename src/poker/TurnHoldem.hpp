@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CardAbstraction.hpp"
+#include "GameTree.hpp"
+#include "GameTypes.hpp"
+#include "Strategy.hpp"
+
+namespace quantnet::poker {
+
+// Turn Hold'em: one street of Hold'em, small enough to solve exactly, for
+// measuring what a card abstraction costs in play
+//
+// Rules:
+// - The turn board (4 cards) is fixed, and each player's hole cards are one
+//   of a pool of num_hands hole pairs drawn (seeded) from the 1128 the board
+//   leaves; every ordered pair of disjoint pool hands is dealt with equal
+//   probability (160 hands: about 25,000 deals)
+// - Each player antes 1
+// - Player 0 acts first: check or bet (2 chips, pot-sized)
+//   - If check: Player 1 can check (showdown) or bet
+//     - If P1 bets: P0 can call or fold
+//   - If bet: Player 1 can call or fold
+// - The river comes from the rest of the full deck and hands are shown
+//   down; terminal payoffs are the expectation over the river
+//
+// Information sets are "P{player}:{hand}:{history}". Without an abstraction
+// hand is the hole cards ("AsKd"). With one, it is the abstraction's turn
+// bucket ("b12"), so every hand in a bucket plays one strategy.
+// unabstracted() carries such a strategy over to the hole-card information
+// sets, where it can be evaluated in the game without abstraction. Hands
+// and runouts are real Hold'em ones, so abstractions see the features they
+// were designed for.
+class TurnHoldem : public PokerGame {
+public:
+    static constexpr std::array<int, 4> DEFAULT_BOARD = {38, 35, 8, 15};   // Ah Jh Tc 4d
+
+    // abstraction is only used while building and may be null. Throws
+    // std::invalid_argument if the board has repeated or invalid cards or
+    // num_hands is outside [2, 1128].
+    explicit TurnHoldem(const std::array<int, 4>& board = DEFAULT_BOARD, int num_hands = 160,
+                        uint64_t seed = 0, const CardAbstraction* abstraction = nullptr);
+
+    void build_tree() override;
+    const GameNode* root() const override { return root_.get(); }
+    std::vector<InfoSet> get_info_sets() const override;
+    std::string name() const override;
+    int deck_size() const override { return DECK_SIZE; }
+
+    // Hole pairs in the pool, and the info set label of each (its
+    // cards, or its bucket under the abstraction)
+    const std::vector<std::array<int, 2>>& hands() const { return hands_; }
+    const std::string& hand_label(int hand) const { return labels_[hand]; }
+    int num_labels() const { return num_labels_; }
+
+    // Strategy of the unabstracted game in which every hand plays sigma at
+    // its label's information sets (sigma itself without an abstraction)
+    Strategy unabstracted(const Strategy& sigma) const;
+
+    // Expected showdown payoff to player 0 per chip each has in the pot,
+    // over the river: P(win) - P(lose)
+    double showdown_value(int hand0, int hand1) const;
+
+    static InfoSetId make_info_set_id(PlayerId player, const std::string& hand, const std::string& history);
+
+private:
+    std::array<int, 4> board_;
+    std::vector<std::array<int, 2>> hands_;
+    std::vector<std::string> labels_;
+    int num_labels_ = 0;
+    bool abstracted_ = false;
+    std::string name_;
+    std::vector<double> showdown_;                 // hands^2, by showdown_value
+    std::unique_ptr<GameNode> root_;
+
+    void build_subtree(GameNode* node, PlayerId to_act, const std::string& history,
+                       int hand0, int hand1, int pot);
+};
+
+} // namespace quantnet::poker
@@ -2,6 +2,7 @@
 #include "../poker/ExpectedValue.hpp"
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
 
 namespace quantnet::solver {
 
@@ -19,6 +20,20 @@ void CFR::initialize() {
     }
 }
 
+void CFR::warm_start(const poker::Strategy& sigma, double weight) {
+    for (auto& [id, data] : info_set_data_) {
+        if (!sigma.has_info_set(id)) continue;
+
+        Eigen::VectorXd probs = sigma.probs(id);
+        if (probs.size() != data.num_actions) {
+            throw std::invalid_argument("Warm start strategy has wrong action count at: " + id);
+        }
+
+        data.cumulative_regret = weight * probs;
+        data.cumulative_strategy = weight * probs;
+    }
+}
+
 poker::Strategy CFR::current_strategy() const {
     Eigen::VectorXd w = Eigen::VectorXd::Zero(index_.total_dim());
 
@@ -107,6 +122,7 @@ double CFR::cfr_recursive(
     double reach_chance
 ) {
     if (!node) return 0.0;
+    ++node_visits_;
 
     switch (node->type) {
         case poker::NodeType::Terminal: {
@@ -135,7 +151,7 @@ double CFR::cfr_recursive(
             const int num_actions = static_cast<int>(node->legal_actions.size());
 
             // Get current strategy via regret matching
-            Eigen::VectorXd strategy = data.regret_matching_strategy();
+            Eigen::VectorXd strategy = iteration_strategy(data);
 
             // Compute counterfactual value for each action
             Eigen::VectorXd action_values(num_actions);
@@ -165,16 +181,14 @@ double CFR::cfr_recursive(
                 // due to opponent and chance (not traverser's actions)
                 double cf_reach = counterfactual_reach(traverser, reach_p0, reach_p1) * reach_chance;
 
-                for (int a = 0; a < num_actions; ++a) {
-                    // Regret = counterfactual value of action - node value
-                    double regret = cf_reach * (action_values(a) - node_value);
-                    data.cumulative_regret(a) += regret;
-                }
+                // Regret = counterfactual value of action - node value
+                Eigen::VectorXd regret = cf_reach * (action_values.array() - node_value).matrix();
+                accumulate_regret(data, regret);
             }
 
             // Accumulate strategy for average (weighted by player's reach)
             double player_reach = (node->player == poker::PLAYER_0) ? reach_p0 : reach_p1;
-            data.cumulative_strategy += player_reach * strategy;
+            accumulate_strategy(data, node->player == traverser, player_reach, strategy);
 
             return node_value;
         }
@@ -227,4 +241,80 @@ double CFRPlus::cfr_plus_recursive(
     return cfr_recursive(node, traverser, reach_p0, reach_p1, reach_chance);
 }
 
+// ============================================================================
+// Predictive CFR+ Implementation
+// ============================================================================
+
+PredictiveCFRPlus::PredictiveCFRPlus(const poker::PokerGame& game) : CFR(game) {
+    for (const auto& is : index_.all_info_sets()) {
+        auto& data = info_set_data_[is.id];
+        data.prediction = Eigen::VectorXd::Zero(data.num_actions);
+        data.instant_regret = Eigen::VectorXd::Zero(data.num_actions);
+    }
+}
+
+Eigen::VectorXd PredictiveCFRPlus::iteration_strategy(const InfoSetData& data) const {
+    Eigen::VectorXd positive = (data.cumulative_regret + data.prediction).cwiseMax(0.0);
+    double sum = positive.sum();
+
+    if (sum > 0) {
+        return positive / sum;
+    }
+    return Eigen::VectorXd::Constant(data.num_actions, 1.0 / data.num_actions);
+}
+
+void PredictiveCFRPlus::accumulate_regret(InfoSetData& data, const Eigen::VectorXd& regret) {
+    data.instant_regret += regret;
+}
+
+void PredictiveCFRPlus::accumulate_strategy(
+    InfoSetData& data, bool is_traverser,
+    double player_reach, const Eigen::VectorXd& strategy
+) {
+    // Only the traversal that updates this player's regrets uses its current
+    // strategy; the other traversal sees it mid-iteration
+    if (!is_traverser) return;
+
+    const double t = static_cast<double>(iterations_);
+    data.cumulative_strategy += (t * t * player_reach) * strategy;
+}
+
+void PredictiveCFRPlus::apply_regret_update(poker::PlayerId player) {
+    for (const auto& is : index_.all_info_sets()) {
+        if (is.player != player) continue;
+
+        auto& data = info_set_data_[is.id];
+        data.cumulative_regret = (data.cumulative_regret + data.instant_regret).cwiseMax(0.0);
+        data.prediction = data.instant_regret;
+        data.instant_regret.setZero();
+    }
+}
+
+void PredictiveCFRPlus::solve(int iterations) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    for (int iter = 0; iter < iterations; ++iter) {
+        iterations_++;
+
+        // Alternating updates: the second traversal plays against the first
+        // player's updated strategy
+        for (poker::PlayerId player : {poker::PLAYER_0, poker::PLAYER_1}) {
+            cfr_recursive(game_.root(), player, 1.0, 1.0, 1.0);
+            apply_regret_update(player);
+        }
+
+        if (callback_ && (iter % 10 == 0 || iter == iterations - 1)) {
+            auto now = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time);
+
+            CFRStats stats;
+            stats.iteration = iterations_;
+            stats.exploitability = exploitability();
+            stats.wall_time_ms = static_cast<double>(duration.count());
+
+            (*callback_)(stats);
+        }
+    }
+}
+
 } // namespace quantnet::solver
@@ -18,6 +18,12 @@ struct InfoSetData {
     Eigen::VectorXd cumulative_strategy;  // Sum of reach-weighted strategies
     int num_actions = 0;
 
+    // Predictive CFR+ only (empty otherwise): last iteration's instantaneous
+    // regret, used as the prediction, and the regret being accumulated for
+    // the current iteration
+    Eigen::VectorXd prediction;
+    Eigen::VectorXd instant_regret;
+
     InfoSetData() = default;
 
     explicit InfoSetData(int n_actions)
@@ -71,6 +77,7 @@ using CFRCallback = std::function<void(const CFRStats&)>;
 class CFR {
 public:
     explicit CFR(const poker::PokerGame& game);
+    virtual ~CFR() = default;
 
     // Run CFR for specified number of iterations
     void solve(int iterations);
@@ -78,6 +85,13 @@ public:
     // Set callback for progress updates
     void set_callback(CFRCallback callback) { callback_ = callback; }
 
+    // Seed regrets and average strategy from an existing strategy
+    // (e.g. a high-beta QRE solution). Both accumulators are set to
+    // weight * sigma(I), so regret matching reproduces sigma immediately and
+    // the average strategy starts as if sigma had been played `weight` times.
+    // Larger weights keep CFR closer to the seed for longer.
+    void warm_start(const poker::Strategy& sigma, double weight = 1.0);
+
     // Get current strategy (regret matching)
     poker::Strategy current_strategy() const;
 
@@ -90,6 +104,12 @@ public:
     // Get iteration count
     int iterations() const { return iterations_; }
 
+    // Game-tree nodes visited by all iterations so far (for benchmarking)
+    long long node_visits() const { return node_visits_; }
+
+    // Info sets in solver order (e.g. for poker::StrategyFile::write)
+    const poker::InfoSetIndex& info_set_index() const { return index_; }
+
     // Access regret data (for analysis)
     const std::map<poker::InfoSetId, InfoSetData>& regret_data() const {
         return info_set_data_;
@@ -100,6 +120,7 @@ protected:
     poker::InfoSetIndex index_;
     std::map<poker::InfoSetId, InfoSetData> info_set_data_;
     int iterations_ = 0;
+    long long node_visits_ = 0;
     std::optional<CFRCallback> callback_;
 
     // Initialize data structures
@@ -115,6 +136,25 @@ protected:
         double reach_chance
     );
 
+    // Per-variant hooks used by cfr_recursive at player nodes.
+    // Defaults are vanilla CFR: regret matching on cumulative regret, regrets
+    // applied immediately, uniformly weighted average strategy for both
+    // players on every traversal.
+    virtual Eigen::VectorXd iteration_strategy(const InfoSetData& data) const {
+        return data.regret_matching_strategy();
+    }
+
+    virtual void accumulate_regret(InfoSetData& data, const Eigen::VectorXd& regret) {
+        data.cumulative_regret += regret;
+    }
+
+    virtual void accumulate_strategy(
+        InfoSetData& data, bool /*is_traverser*/,
+        double player_reach, const Eigen::VectorXd& strategy
+    ) {
+        data.cumulative_strategy += player_reach * strategy;
+    }
+
     // Compute counterfactual reach probability
     double counterfactual_reach(poker::PlayerId player, double reach_p0, double reach_p1) const {
         return (player == poker::PLAYER_0) ? reach_p1 : reach_p0;
@@ -139,4 +179,36 @@ private:
     );
 };
 
+// Predictive CFR+ (Farina, Kroer & Sandholm 2021)
+//
+// Regret matching+ with a prediction of the next instantaneous regret:
+//   σ_t(a) ∝ max(R_{t-1}(a) + m_t(a), 0),  m_t = r_{t-1}
+//   R_t(a) = max(R_{t-1}(a) + r_t(a), 0)
+// With the last regret as the prediction, the regret bound depends on how
+// much consecutive regrets differ rather than on their size, which is
+// small once play settles. The average strategy uses quadratic weights
+// (iteration t counts t²).
+//
+// Regrets for an iteration are buffered in InfoSetData::instant_regret and
+// applied after each player's traversal, so every node of an information
+// set sees the same strategy within an iteration.
+class PredictiveCFRPlus : public CFR {
+public:
+    explicit PredictiveCFRPlus(const poker::PokerGame& game);
+
+    void solve(int iterations);
+
+protected:
+    Eigen::VectorXd iteration_strategy(const InfoSetData& data) const override;
+    void accumulate_regret(InfoSetData& data, const Eigen::VectorXd& regret) override;
+    void accumulate_strategy(
+        InfoSetData& data, bool is_traverser,
+        double player_reach, const Eigen::VectorXd& strategy
+    ) override;
+
+private:
+    // Fold this iteration's regret into R and make it the next prediction
+    void apply_regret_update(poker::PlayerId player);
+};
+
 } // namespace quantnet::solver
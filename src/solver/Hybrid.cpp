@@ -0,0 +1,91 @@
+#include "Hybrid.hpp"
+#include "../poker/QRE.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quantnet::solver {
+
+std::vector<double> make_beta_schedule(double target_beta) {
+    std::vector<double> schedule;
+
+    // Start with low beta (near uniform)
+    schedule.push_back(0.01);
+
+    // Geometric progression
+    double beta = 0.05;
+    while (beta < target_beta) {
+        schedule.push_back(beta);
+        beta *= 2.0;
+    }
+
+    // Always include target
+    schedule.push_back(target_beta);
+
+    return schedule;
+}
+
+Eigen::VectorXd strategy_to_logits(
+    const poker::Strategy& sigma,
+    const poker::InfoSetIndex& index,
+    double prob_floor
+) {
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(index.total_dim());
+
+    for (int i = 0; i < index.num_info_sets(); ++i) {
+        const poker::InfoSet& is = index.info_set(i);
+        if (!sigma.has_info_set(is.id)) continue;  // Uniform (zero logits)
+
+        Eigen::VectorXd probs = sigma.probs(is.id).cwiseMax(prob_floor);
+        probs /= probs.sum();
+
+        // Shift so the logits are centred; softmax is shift-invariant and
+        // centred logits keep Newton's steps well scaled
+        Eigen::VectorXd logits = probs.array().log();
+        logits.array() -= logits.mean();
+
+        const int start = index.info_set_start(i);
+        for (int a = 0; a < logits.size(); ++a) {
+            w(start + a) = logits(a);
+        }
+    }
+
+    return w;
+}
+
+ContinuationResult solve_qre_continuation(
+    const poker::PokerGame& game,
+    const std::vector<double>& betas,
+    const Eigen::VectorXd& w0,
+    const NewtonConfig& config
+) {
+    if (betas.empty()) {
+        throw std::invalid_argument("Beta schedule must not be empty");
+    }
+
+    poker::QREResidual qre(game, betas.front());
+    if (w0.size() != qre.dim()) {
+        throw std::invalid_argument("Warm start logits have wrong dimension");
+    }
+
+    NewtonSolver newton(config);
+
+    ContinuationResult result;
+    result.w = w0;
+
+    for (double beta : betas) {
+        qre.set_beta(beta);
+
+        auto newton_result = newton.solve(
+            [&qre](const Eigen::VectorXd& x) { return qre(x); }, result.w);
+
+        result.w = newton_result.x;  // Warm start for next beta
+        result.newton_iterations += newton_result.iterations;
+        result.converged = newton_result.converged;
+        result.final_beta = beta;
+    }
+
+    return result;
+}
+
+} // namespace quantnet::solver
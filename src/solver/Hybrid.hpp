@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <vector>
+#include "NewtonSolver.hpp"
+#include "../poker/GameTree.hpp"
+#include "../poker/GameTypes.hpp"
+#include "../poker/Strategy.hpp"
+
+namespace quantnet::solver {
+
+// Hybrid QRE-Newton / CFR solving
+//
+// The two solvers are strong in different places:
+// - Newton on the QRE residual converges quadratically, but only near a
+//   smooth solution; beta continuation gets it to a high-beta QRE cheaply.
+// - CFR makes steady O(1/sqrt(T)) progress towards Nash from anywhere, but
+//   spends most of its iterations getting close.
+//
+// Seeding one with the other lets each spend its budget where it is
+// strongest:
+//   QRE -> CFR:    CFR::warm_start(Strategy::from_logits(result.w, index))
+//   CFR -> Newton: solve_qre_continuation(game, betas,
+//                      strategy_to_logits(cfr.average_strategy(), index))
+
+// Beta continuation schedule: start low, increase geometrically to target
+std::vector<double> make_beta_schedule(double target_beta);
+
+// Convert a strategy profile to a flat logit vector for Newton
+//
+// Probabilities are floored at prob_floor before taking logs. CFR average
+// strategies put (near) zero mass on dominated actions, and logits near
+// log(0) saturate the softmax so the finite-difference Jacobian loses rank
+// and Newton stalls. Newton moves the floored actions back down by itself.
+Eigen::VectorXd strategy_to_logits(
+    const poker::Strategy& sigma,
+    const poker::InfoSetIndex& index,
+    double prob_floor = 1e-2
+);
+
+// Result of a beta continuation run
+struct ContinuationResult {
+    Eigen::VectorXd w;          // Logits at the last beta
+    double final_beta = 0.0;
+    int newton_iterations = 0;  // Summed over all betas
+    bool converged = false;     // Converged at the last beta
+};
+
+// Solve QRE by Newton along a beta schedule, warm-starting each step from
+// the previous solution (or from w0 for the first step)
+ContinuationResult solve_qre_continuation(
+    const poker::PokerGame& game,
+    const std::vector<double>& betas,
+    const Eigen::VectorXd& w0,
+    const NewtonConfig& config = {}
+);
+
+} // namespace quantnet::solver
@@ -0,0 +1,296 @@
+#include "SubgameSolver.hpp"
+#include "CFR.hpp"
+#include "../poker/ExpectedValue.hpp"
+#include <map>
+#include <stdexcept>
+
+namespace quantnet::solver {
+
+namespace {
+
+// Prefix for the opponent's gadget decision info sets
+const std::string GADGET_PREFIX = "G:";
+
+// A history at the subgame root with its blueprint reach probabilities
+struct RootHistory {
+    const poker::GameNode* node;
+    double reach_p0;
+    double reach_p1;
+    double reach_chance;
+};
+
+void collect_root_histories(
+    const poker::GameNode* node,
+    const PublicState& state,
+    const poker::Strategy& blueprint,
+    double reach_p0,
+    double reach_p1,
+    double reach_chance,
+    std::vector<RootHistory>& out
+) {
+    if (!node || node->type == poker::NodeType::Terminal) return;
+
+    // Histories only grow, so nothing below a non-prefix can match
+    if (state.history.compare(0, node->history.size(), node->history) != 0) return;
+
+    if (node->type == poker::NodeType::Player &&
+        node->history == state.history && node->public_card == state.public_card) {
+        out.push_back({node, reach_p0, reach_p1, reach_chance});
+        return;
+    }
+
+    if (node->type == poker::NodeType::Chance) {
+        for (const auto& edge : node->children) {
+            collect_root_histories(edge.child.get(), state, blueprint,
+                                   reach_p0, reach_p1, reach_chance * edge.probability, out);
+        }
+        return;
+    }
+
+    Eigen::VectorXd probs = blueprint.probs(node->info_set_id);
+    for (size_t i = 0; i < node->children.size(); ++i) {
+        const double p = probs(static_cast<int>(i));
+        collect_root_histories(
+            node->children[i].child.get(), state, blueprint,
+            node->player == poker::PLAYER_0 ? reach_p0 * p : reach_p0,
+            node->player == poker::PLAYER_1 ? reach_p1 * p : reach_p1,
+            reach_chance, out);
+    }
+}
+
+poker::Card private_card(const poker::GameNode* node, poker::PlayerId player) {
+    return (player == poker::PLAYER_0) ? node->p0_card : node->p1_card;
+}
+
+} // namespace
+
+std::vector<poker::InfoSet> SubgameGame::get_info_sets() const {
+    std::map<poker::InfoSetId, poker::InfoSet> info_set_map;
+
+    poker::traverse_tree(root_.get(), [&info_set_map](const poker::GameNode* node, int) {
+        if (node->type == poker::NodeType::Player &&
+            info_set_map.find(node->info_set_id) == info_set_map.end()) {
+            poker::InfoSet is;
+            is.id = node->info_set_id;
+            is.player = node->player;
+            is.legal_actions = node->legal_actions;
+            info_set_map[is.id] = is;
+        }
+    });
+
+    std::vector<poker::InfoSet> result;
+    for (const auto& [id, is] : info_set_map) {
+        result.push_back(is);
+    }
+    return result;
+}
+
+SubgameSolver::SubgameSolver(
+    const poker::PokerGame& game,
+    const poker::Strategy& blueprint,
+    const SubgameConfig& config
+) : game_(game), blueprint_(blueprint), config_(config) {}
+
+std::unique_ptr<poker::GameNode> SubgameSolver::clone_subtree(
+    const poker::GameNode* node,
+    int depth
+) const {
+    auto copy = std::make_unique<poker::GameNode>();
+    copy->type = node->type;
+    copy->player = node->player;
+    copy->info_set_id = node->info_set_id;
+    copy->legal_actions = node->legal_actions;
+    copy->payoff = node->payoff;
+    copy->pot = node->pot;
+    copy->history = node->history;
+    copy->p0_card = node->p0_card;
+    copy->p1_card = node->p1_card;
+    copy->public_card = node->public_card;
+
+    if (node->type == poker::NodeType::Terminal) return copy;
+
+    // Depth-limit leaf: the rest of the game is played by the blueprint
+    if (config_.max_depth >= 0 && depth >= config_.max_depth) {
+        copy->type = poker::NodeType::Terminal;
+        copy->player = -1;
+        copy->info_set_id.clear();
+        copy->legal_actions.clear();
+        copy->payoff = poker::compute_ev(node, blueprint_);
+        return copy;
+    }
+
+    const int child_depth = (node->type == poker::NodeType::Player) ? depth + 1 : depth;
+    for (const auto& edge : node->children) {
+        poker::ChildEdge child_edge;
+        child_edge.action = edge.action;
+        child_edge.card = edge.card;
+        child_edge.probability = edge.probability;
+        child_edge.child = clone_subtree(edge.child.get(), child_depth);
+        copy->children.push_back(std::move(child_edge));
+    }
+    return copy;
+}
+
+std::unique_ptr<SubgameGame> SubgameSolver::build_gadget(const PublicState& state) const {
+    std::vector<RootHistory> roots;
+    collect_root_histories(game_.root(), state, blueprint_, 1.0, 1.0, 1.0, roots);
+    if (roots.empty()) {
+        throw std::invalid_argument(
+            "No decision node matches public state: '" + state.history + "'");
+    }
+
+    const poker::PlayerId self = (config_.resolving_player == poker::CHANCE)
+        ? roots.front().node->player : config_.resolving_player;
+    const poker::PlayerId opponent = (self == poker::PLAYER_0) ? poker::PLAYER_1 : poker::PLAYER_0;
+
+    // Gadget chance weights: the re-solving player's and chance's reach for
+    // the safe gadget, the full blueprint reach for the unsafe one
+    std::vector<double> weights;
+    double total = 0.0;
+    for (const auto& h : roots) {
+        double w = ((self == poker::PLAYER_0) ? h.reach_p0 : h.reach_p1) * h.reach_chance;
+        if (config_.gadget == SubgameGadget::Unsafe) {
+            w *= (opponent == poker::PLAYER_0) ? h.reach_p0 : h.reach_p1;
+        }
+        weights.push_back(w);
+        total += w;
+    }
+    if (total <= 0.0) {
+        // Blueprint never reaches this state: fall back to chance alone
+        total = 0.0;
+        for (size_t i = 0; i < roots.size(); ++i) {
+            weights[i] = roots[i].reach_chance;
+            total += weights[i];
+        }
+    }
+
+    // Opponent's counterfactual best-response value against the blueprint
+    // per private card: a chance node over the histories where it holds the
+    // card (weighted as in the gadget) with the opponent best-responding.
+    // Using the value of its best response rather than of its blueprint play
+    // is what makes the gadget safe.
+    std::map<poker::Card, double> cbv;
+    if (config_.gadget == SubgameGadget::Resolve) {
+        std::map<poker::Card, std::vector<size_t>> by_card;
+        for (size_t i = 0; i < roots.size(); ++i) {
+            by_card[private_card(roots[i].node, opponent)].push_back(i);
+        }
+
+        for (const auto& [card, members] : by_card) {
+            double group_weight = 0.0;
+            for (size_t i : members) group_weight += weights[i];
+
+            poker::GameNode range_root;
+            range_root.type = poker::NodeType::Chance;
+            range_root.player = poker::CHANCE;
+            for (size_t i : members) {
+                poker::ChildEdge edge;
+                edge.probability = (group_weight > 0.0)
+                    ? weights[i] / group_weight : 1.0 / static_cast<double>(members.size());
+                edge.child = clone_subtree(roots[i].node, 0);
+                range_root.children.push_back(std::move(edge));
+            }
+            cbv[card] = poker::infoset_best_response_value(&range_root, blueprint_, opponent);
+        }
+    }
+
+    auto root = std::make_unique<poker::GameNode>();
+    root->type = poker::NodeType::Chance;
+    root->player = poker::CHANCE;
+    root->history = state.history;
+    root->public_card = state.public_card;
+    root->pot = roots.front().node->pot;
+
+    for (size_t i = 0; i < roots.size(); ++i) {
+        const poker::GameNode* h = roots[i].node;
+
+        poker::ChildEdge edge;
+        edge.card = static_cast<poker::Card>(i);
+        edge.probability = weights[i] / total;
+
+        if (config_.gadget == SubgameGadget::Unsafe) {
+            edge.child = clone_subtree(h, 0);
+            root->children.push_back(std::move(edge));
+            continue;
+        }
+
+        const poker::Card card = private_card(h, opponent);
+
+        edge.child = std::make_unique<poker::GameNode>();
+        poker::GameNode* choice = edge.child.get();
+        choice->type = poker::NodeType::Player;
+        choice->player = opponent;
+        choice->info_set_id = GADGET_PREFIX + "P" + std::to_string(opponent) + ":" + std::to_string(card);
+        choice->legal_actions = {poker::Action::Fold, poker::Action::Call};
+        choice->history = h->history;
+        choice->p0_card = h->p0_card;
+        choice->p1_card = h->p1_card;
+        choice->public_card = h->public_card;
+        choice->pot = h->pot;
+
+        // Fold: terminate with the best-response value (payoffs are to P0)
+        poker::ChildEdge terminate;
+        terminate.action = poker::Action::Fold;
+        terminate.child = std::make_unique<poker::GameNode>();
+        terminate.child->type = poker::NodeType::Terminal;
+        terminate.child->player = -1;
+        terminate.child->payoff = (opponent == poker::PLAYER_0) ? cbv[card] : -cbv[card];
+        terminate.child->history = h->history;
+        terminate.child->pot = h->pot;
+
+        // Call: follow into the subgame
+        poker::ChildEdge follow;
+        follow.action = poker::Action::Call;
+        follow.child = clone_subtree(h, 0);
+
+        choice->children.push_back(std::move(terminate));
+        choice->children.push_back(std::move(follow));
+        root->children.push_back(std::move(edge));
+    }
+
+    return std::make_unique<SubgameGame>(
+        std::move(root), game_.name() + " subgame '" + state.history + "'",
+        game_.deck_size(), self);
+}
+
+SubgameResult SubgameSolver::solve(const PublicState& state, Clock::time_point deadline) const {
+    const auto start = Clock::now();
+
+    std::unique_ptr<SubgameGame> gadget = build_gadget(state);
+
+    SubgameResult result;
+    result.root_histories = static_cast<int>(gadget->root()->children.size());
+    result.subgame_nodes = poker::compute_tree_stats(gadget->root()).total_nodes;
+
+    PredictiveCFRPlus cfr(*gadget);
+    while (cfr.iterations() < config_.max_iterations && Clock::now() < deadline) {
+        cfr.solve(1);
+    }
+    result.iterations = cfr.iterations();
+
+    // Keep the resolving player's info sets (the gadget decisions belong to
+    // the opponent)
+    std::vector<poker::InfoSet> subgame_info_sets;
+    for (const auto& is : gadget->get_info_sets()) {
+        if (is.player == gadget->resolving_player()) {
+            subgame_info_sets.push_back(is);
+        }
+    }
+    poker::InfoSetIndex index;
+    index.build(subgame_info_sets);
+    result.strategy = poker::Strategy::from_logits(
+        cfr.average_strategy().to_flat_logits(index), index);
+
+    result.wall_time_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+poker::Strategy overlay_strategy(const poker::Strategy& blueprint, const poker::Strategy& refined) {
+    poker::Strategy result = blueprint;
+    for (const auto& id : refined.info_set_ids()) {
+        result.set_logits(id, refined.logits(id));
+    }
+    return result;
+}
+
+} // namespace quantnet::solver
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../poker/GameTree.hpp"
+#include "../poker/GameTypes.hpp"
+#include "../poker/Strategy.hpp"
+
+namespace quantnet::solver {
+
+// Depth-limited subgame re-solving
+//
+// At decision time the whole game is too large to re-solve, so only the
+// subtree below the current public state is refined. The blueprint supplies
+// everything outside it:
+// - the reach probabilities of each history at the subgame root (ranges)
+// - the opponent's counterfactual best-response values for entering it
+// - values at depth-limit leaves, where the subtree is cut off
+//
+// Re-solve gadget (Burch, Johanson & Bowling 2014): a chance node deals the
+// root histories in proportion to the re-solving player's and chance's
+// reach. The opponent then chooses, per private card, to take its best-
+// response value against the blueprint (Fold = terminate) or to play the
+// subgame (Call = follow). Following only pays if the refined strategy is
+// worse for us than the blueprint there, so the re-solve can only reduce
+// the opponent's counterfactual values (up to CFR convergence).
+//
+// Only the re-solving player's strategy is returned: the opponent's subgame
+// strategy is a response to our range with its own range discarded, so it
+// is not meant to be played. Info set ids are kept, so the refined strategy
+// drops into the blueprint
+// with overlay_strategy(). Where the game's info sets span several public
+// states (Leduc ids drop suits), the refinement applies to all of them.
+//
+// The unsafe gadget instead deals the root histories in proportion to the
+// full blueprint reach (both players' ranges) and assumes the opponent keeps
+// to that range. It converges to a better response to the blueprint
+// opponent, but without the guarantee.
+//
+// Depth-limit leaves take the blueprint's value for the rest of the game,
+// which assumes both players continue with the blueprint there.
+
+// Public state: the point in the game every root history shares
+struct PublicState {
+    std::string history;             // GameNode::history, e.g. "cb" or "cc|"
+    poker::Card public_card = -1;    // Board card, -1 if none dealt
+};
+
+enum class SubgameGadget {
+    Resolve,    // Safe: opponent may take its blueprint value instead
+    Unsafe      // Opponent range fixed to the blueprint's
+};
+
+struct SubgameConfig {
+    SubgameGadget gadget = SubgameGadget::Resolve;
+    int max_depth = -1;              // Actions below the root before leaves take
+                                     // blueprint values (-1 = to the end)
+    int max_iterations = 100000;     // Upper bound alongside the deadline
+    poker::PlayerId resolving_player = poker::CHANCE;  // CHANCE = player to act
+};
+
+struct SubgameResult {
+    poker::Strategy strategy;        // Refined strategy, resolving player's
+                                     // subgame info sets only
+    int iterations = 0;
+    double wall_time_ms = 0.0;       // Gadget construction plus CFR
+    int root_histories = 0;          // Histories in the public state
+    int subgame_nodes = 0;           // Nodes in the gadget game
+};
+
+// Game wrapper around a gadget tree so the CFR solvers can run on it
+class SubgameGame : public poker::PokerGame {
+public:
+    SubgameGame(
+        std::unique_ptr<poker::GameNode> root, std::string name,
+        int deck_size, poker::PlayerId resolving_player
+    ) : root_(std::move(root)), name_(std::move(name)),
+        deck_size_(deck_size), resolving_player_(resolving_player) {}
+
+    void build_tree() override {}  // Built by SubgameSolver
+    const poker::GameNode* root() const override { return root_.get(); }
+    std::vector<poker::InfoSet> get_info_sets() const override;
+    std::string name() const override { return name_; }
+    int deck_size() const override { return deck_size_; }
+
+    // Player whose strategy the gadget protects
+    poker::PlayerId resolving_player() const { return resolving_player_; }
+
+private:
+    std::unique_ptr<poker::GameNode> root_;
+    std::string name_;
+    int deck_size_;
+    poker::PlayerId resolving_player_;
+};
+
+class SubgameSolver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // game and blueprint must outlive the solver
+    SubgameSolver(
+        const poker::PokerGame& game,
+        const poker::Strategy& blueprint,
+        const SubgameConfig& config = {}
+    );
+
+    // Refine the strategy below `state`, running predictive CFR+ on the
+    // gadget game until the deadline or max_iterations.
+    // Throws std::invalid_argument if no decision node matches `state`.
+    SubgameResult solve(const PublicState& state, Clock::time_point deadline) const;
+
+    // Build the gadget game for `state` without solving it
+    std::unique_ptr<SubgameGame> build_gadget(const PublicState& state) const;
+
+    const SubgameConfig& config() const { return config_; }
+
+private:
+    const poker::PokerGame& game_;
+    const poker::Strategy& blueprint_;
+    SubgameConfig config_;
+
+    // Copy the subtree at node, cutting it off max_depth actions below the
+    // subgame root
+    std::unique_ptr<poker::GameNode> clone_subtree(const poker::GameNode* node, int depth) const;
+};
+
+// Blueprint with the refined info sets replaced
+poker::Strategy overlay_strategy(const poker::Strategy& blueprint, const poker::Strategy& refined);
+
+} // namespace quantnet::solver
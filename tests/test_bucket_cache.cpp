@@ -0,0 +1,223 @@
+// Tests for the sharded bucket cache
+// Verifies that cached buckets match the wrapped abstraction, that hits,
+// misses and evictions are counted, and that capacity bounds hold under
+// both eviction policies and under concurrent use
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "poker/BucketCache.hpp"
+#include "poker/CardAbstraction.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace quantnet::poker;
+
+namespace {
+
+std::pair<CardSet, CardSet> deal(std::mt19937& rng, int board_cards) {
+    std::vector<int> deck(DECK_SIZE);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    return {CardSet::of(std::span(deck.data(), 2)), CardSet::of(std::span(deck.data() + 2, board_cards))};
+}
+
+// Abstraction that counts how often it is asked
+class CountingAbstraction : public CardAbstraction {
+public:
+    using CardAbstraction::get_bucket;
+    BucketId get_bucket(CardSet hole, CardSet board, BettingRound round) const override {
+        ++calls;
+        return inner.get_bucket(hole, board, round);
+    }
+    int num_buckets(BettingRound round) const override { return inner.num_buckets(round); }
+    int total_buckets() const override { return inner.total_buckets(); }
+    std::string name() const override { return "Counting"; }
+
+    PercentileAbstraction inner{169, 20, 30, 40};
+    mutable std::atomic<int> calls{0};
+};
+
+} // namespace
+
+TEST_CASE("Cached buckets match the wrapped abstraction", "[bucket_cache]") {
+    for (CachePolicy policy : {CachePolicy::Lru, CachePolicy::Clock}) {
+        PercentileAbstraction percentile(169, 20, 30, 40);
+        CachedAbstraction cached(std::make_unique<PercentileAbstraction>(169, 20, 30, 40),
+                                 {.capacity = 512, .shards = 4, .policy = policy});
+        REQUIRE(cached.name() == "Cached(Percentile)");
+        REQUIRE(cached.num_buckets(BettingRound::Turn) == 30);
+        REQUIRE(cached.total_buckets() == percentile.total_buckets());
+
+        // Far more distinct hands than entries, each asked twice
+        std::mt19937 rng(69);
+        for (int trial = 0; trial < 2000; ++trial) {
+            const int board_cards = trial % 4 == 0 ? 0 : 2 + trial % 4;
+            const auto round = static_cast<BettingRound>(trial % 4);
+            const auto [hole, board] = deal(rng, board_cards);
+            const BucketId expected = percentile.get_bucket(hole, board, round);
+            REQUIRE(cached.get_bucket(hole, board, round) == expected);
+            REQUIRE(cached.get_bucket(hole, board, round) == expected);
+        }
+
+        const BucketCacheStats stats = cached.stats();
+        REQUIRE(stats.capacity == 512);
+        REQUIRE(stats.size <= stats.capacity);
+        REQUIRE(stats.hits + stats.misses == 4000);
+        REQUIRE(stats.hits >= 2000 - 512);
+        REQUIRE(stats.evictions > 0);
+    }
+
+    REQUIRE_THROWS_AS(CachedAbstraction(nullptr), std::invalid_argument);
+    REQUIRE_THROWS_AS(CachedAbstraction(std::make_unique<NullAbstraction>(), {.capacity = 0}),
+                      std::invalid_argument);
+    REQUIRE(create_abstraction("cached:percentile")->name() == "Cached(Percentile)");
+}
+
+TEST_CASE("Isomorphic hands share a cache entry", "[bucket_cache]") {
+    auto counting = std::make_unique<CountingAbstraction>();
+    const CountingAbstraction& inner = *counting;
+    CachedAbstraction cached(std::move(counting), {.capacity = 1024, .shards = 1});
+
+    // Ah Kh on Qh Jh 2c, then the same hand with suits permuted
+    const CardSet hole = CardSet::of(std::array{make_card(12, 0), make_card(11, 0)});
+    const CardSet board = CardSet::of(std::array{make_card(10, 0), make_card(9, 0), make_card(0, 1)});
+    const CardSet hole2 = CardSet::of(std::array{make_card(12, 2), make_card(11, 2)});
+    const CardSet board2 = CardSet::of(std::array{make_card(10, 2), make_card(9, 2), make_card(0, 3)});
+
+    const BucketId bucket = cached.get_bucket(hole, board, BettingRound::Flop);
+    REQUIRE(cached.get_bucket(hole2, board2, BettingRound::Flop) == bucket);
+    REQUIRE(inner.calls == 1);
+    REQUIRE(cached.stats().hits == 1);
+
+    // A different round is a different entry even for the same cards
+    cached.get_bucket(hole, board, BettingRound::Turn);
+    REQUIRE(inner.calls == 2);
+
+    cached.reset_stats();
+    REQUIRE(cached.stats().hits == 0);
+    REQUIRE(cached.stats().size == 2);
+    cached.clear();
+    REQUIRE(cached.stats().size == 0);
+    cached.get_bucket(hole, board, BettingRound::Flop);
+    REQUIRE(inner.calls == 3);
+}
+
+TEST_CASE("Eviction follows the cache policy", "[bucket_cache]") {
+    // One shard of four entries, filled with four distinct preflop hands
+    std::vector<CardSet> holes;
+    for (int rank = 12; rank >= 7; --rank) {
+        holes.push_back(CardSet::of(std::array{make_card(rank, 0), make_card(rank, 1)}));
+    }
+
+    SECTION("LRU evicts the least recently used entry") {
+        auto counting = std::make_unique<CountingAbstraction>();
+        const CountingAbstraction& inner = *counting;
+        CachedAbstraction cached(std::move(counting), {.capacity = 4, .shards = 1, .policy = CachePolicy::Lru});
+        for (int i = 0; i < 4; ++i) cached.get_bucket(holes[i], CardSet{}, BettingRound::Preflop);
+        cached.get_bucket(holes[0], CardSet{}, BettingRound::Preflop);   // 1 is now oldest
+        cached.get_bucket(holes[4], CardSet{}, BettingRound::Preflop);   // Evicts 1
+        REQUIRE(inner.calls == 5);
+
+        cached.get_bucket(holes[0], CardSet{}, BettingRound::Preflop);
+        cached.get_bucket(holes[2], CardSet{}, BettingRound::Preflop);
+        REQUIRE(inner.calls == 5);
+        cached.get_bucket(holes[1], CardSet{}, BettingRound::Preflop);
+        REQUIRE(inner.calls == 6);
+        REQUIRE(cached.stats().evictions == 2);
+        REQUIRE(cached.stats().size == 4);
+    }
+
+    SECTION("CLOCK gives referenced entries a second chance") {
+        auto counting = std::make_unique<CountingAbstraction>();
+        const CountingAbstraction& inner = *counting;
+        CachedAbstraction cached(std::move(counting), {.capacity = 4, .shards = 1, .policy = CachePolicy::Clock});
+        for (int i = 0; i < 4; ++i) cached.get_bucket(holes[i], CardSet{}, BettingRound::Preflop);
+        cached.get_bucket(holes[0], CardSet{}, BettingRound::Preflop);   // References 0
+        cached.get_bucket(holes[4], CardSet{}, BettingRound::Preflop);   // Skips 0, evicts 1
+        REQUIRE(inner.calls == 5);
+
+        cached.get_bucket(holes[0], CardSet{}, BettingRound::Preflop);
+        REQUIRE(inner.calls == 5);
+        cached.get_bucket(holes[1], CardSet{}, BettingRound::Preflop);
+        REQUIRE(inner.calls == 6);
+        REQUIRE(cached.stats().size == 4);
+    }
+}
+
+TEST_CASE("Bucket cache is consistent across threads", "[bucket_cache]") {
+    for (CachePolicy policy : {CachePolicy::Lru, CachePolicy::Clock}) {
+        PercentileAbstraction percentile(169, 20, 30, 40);
+        CachedAbstraction cached(std::make_unique<PercentileAbstraction>(169, 20, 30, 40),
+                                 {.capacity = 256, .shards = 8, .policy = policy});
+
+        // A small pool of hands, so threads keep hitting, missing and
+        // evicting the same shards
+        std::mt19937 rng(70);
+        std::vector<std::pair<CardSet, CardSet>> hands;
+        std::vector<BucketId> expected;
+        for (int i = 0; i < 600; ++i) {
+            hands.push_back(deal(rng, 3));
+            expected.push_back(percentile.get_bucket(hands.back().first, hands.back().second, BettingRound::Flop));
+        }
+
+        std::atomic<int> mismatches{0};
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(4) schedule(static, 1)
+#endif
+        for (int i = 0; i < 20000; ++i) {
+            const size_t h = (static_cast<size_t>(i) * 7919) % hands.size();
+            if (cached.get_bucket(hands[h].first, hands[h].second, BettingRound::Flop) != expected[h]) {
+                ++mismatches;
+            }
+        }
+        REQUIRE(mismatches == 0);
+        const BucketCacheStats stats = cached.stats();
+        REQUIRE(stats.hits + stats.misses == 20000);
+        REQUIRE(stats.size <= stats.capacity);
+    }
+}
+
+// Cost of on-the-fly bucketing with and without the cache under a solver-like
+// access pattern: hands drawn from a skewed distribution over a fixed pool
+// (benchmark, not a test)
+TEST_CASE("Bucket cache throughput", "[bucket_cache][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 rng(71);
+    for (int board_cards : {3, 5}) {
+        const auto round = static_cast<BettingRound>(board_cards - 2);
+        std::vector<std::pair<CardSet, CardSet>> pool;
+        for (int i = 0; i < 200000; ++i) pool.push_back(deal(rng, board_cards));
+        std::vector<size_t> queries;
+        std::geometric_distribution<size_t> skew(1e-4);
+        for (int i = 0; i < 400000; ++i) queries.push_back(std::min(skew(rng), pool.size() - 1));
+
+        for (CachePolicy policy : {CachePolicy::Lru, CachePolicy::Clock}) {
+            CachedAbstraction cached(std::make_unique<PercentileAbstraction>(),
+                                     {.capacity = 1 << 15, .policy = policy});
+            uint64_t sink = 0;
+            const auto t0 = Clock::now();
+            for (size_t q : queries) sink += cached.get_bucket(pool[q].first, pool[q].second, round);
+            const double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+            const BucketCacheStats stats = cached.stats();
+            std::cout << round_to_string(round) << (policy == CachePolicy::Lru ? " LRU" : " CLOCK")
+                      << ": " << secs / queries.size() * 1e9 << " ns per lookup, hit rate "
+                      << stats.hit_rate() << ", " << stats.evictions << " evictions" << std::endl;
+            if (sink == 0) std::cout << sink;
+        }
+
+        PercentileAbstraction percentile;
+        uint64_t sink = 0;
+        const auto t0 = Clock::now();
+        for (size_t i = 0; i < 5000; ++i) sink += percentile.get_bucket(pool[queries[i]].first, pool[queries[i]].second, round);
+        std::cout << round_to_string(round) << " uncached: "
+                  << std::chrono::duration<double>(Clock::now() - t0).count() / 5000 * 1e9 << " ns per lookup" << std::endl;
+        if (sink == 0) std::cout << sink;
+    }
+}
@@ -0,0 +1,215 @@
+// Tests for memory-mapped bucket tables
+// Verifies that a written table answers exactly like the abstraction it was
+// built from, and that malformed files and queries are rejected
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+
+#include "poker/BucketTable.hpp"
+#include "poker/CardAbstraction.hpp"
+
+using namespace quantnet::poker;
+
+namespace {
+
+std::pair<CardSet, CardSet> deal(std::mt19937& rng, int board_cards) {
+    std::vector<int> deck(DECK_SIZE);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    return {CardSet::of(std::span(deck.data(), 2)), CardSet::of(std::span(deck.data() + 2, board_cards))};
+}
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST_CASE("Board-wide buckets match single lookups", "[bucket_table]") {
+    PercentileAbstraction percentile(169, 20, 30, 40);
+    std::mt19937 rng(68);
+    for (int trial = 0; trial < 30; ++trial) {
+        const int board_cards = 3 + trial % 3;
+        const auto round = static_cast<BettingRound>(board_cards - 2);
+        const CardSet board = deal(rng, board_cards).second;
+
+        std::array<BucketId, NUM_HOLE_COMBOS> buckets;
+        buckets.fill(0xFFFF);
+        percentile.get_buckets(board, round, buckets);
+        for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+            const CardSet hole = CardSet::of(hole_combos()[i]);
+            if (hole.intersects(board)) {
+                REQUIRE(buckets[i] == 0xFFFF);
+            } else {
+                REQUIRE(buckets[i] == percentile.get_bucket(hole, board, round));
+            }
+        }
+    }
+}
+
+TEST_CASE("Bucket table answers like its source", "[bucket_table]") {
+    const std::string path = temp_path("qn_bucket_table.bin");
+    PercentileAbstraction percentile(169, 20, 30, 40);
+    TableAbstraction::write(path, percentile, {BettingRound::Preflop, BettingRound::Flop});
+
+    TableAbstraction table(path);
+    REQUIRE(table.name() == "Table(Percentile)");
+    REQUIRE(table.has_round(BettingRound::Preflop));
+    REQUIRE(table.has_round(BettingRound::Flop));
+    REQUIRE_FALSE(table.has_round(BettingRound::Turn));
+    REQUIRE(table.num_buckets(BettingRound::Flop) == 20);
+    REQUIRE(table.num_buckets(BettingRound::River) == 40);
+    REQUIRE(table.total_buckets() == percentile.total_buckets());
+
+    for (const auto& combo : hole_combos()) {
+        const CardSet hole = CardSet::of(combo);
+        REQUIRE(table.get_bucket(hole, CardSet{}, BettingRound::Preflop) ==
+                percentile.get_bucket(hole, CardSet{}, BettingRound::Preflop));
+    }
+    std::mt19937 rng(69);
+    for (int trial = 0; trial < 3000; ++trial) {
+        const auto [hole, board] = deal(rng, 3);
+        REQUIRE(table.get_bucket(hole, board, BettingRound::Flop) ==
+                percentile.get_bucket(hole, board, BettingRound::Flop));
+    }
+
+    const auto [hole, flop] = deal(rng, 3);
+    REQUIRE_THROWS_AS(table.get_bucket(hole, flop | CardSet::single(*(~(hole | flop)).begin()),
+                                       BettingRound::Turn), std::invalid_argument);
+    REQUIRE_THROWS_AS(table.get_bucket(hole, flop, BettingRound::Preflop), std::invalid_argument);
+
+    // The factory maps the same file
+    auto shared = create_abstraction("table:" + path);
+    REQUIRE(shared->name() == "Table(Percentile)");
+    REQUIRE(shared->get_bucket(hole, flop, BettingRound::Flop) == percentile.get_bucket(hole, flop, BettingRound::Flop));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Bucket table rejects invalid files", "[bucket_table]") {
+    const std::string path = temp_path("qn_bucket_table_bad.bin");
+    PercentileAbstraction percentile(169, 20, 30, 40);
+    TableAbstraction::write(path, percentile, {BettingRound::Preflop});
+    REQUIRE_NOTHROW(TableAbstraction(path));
+
+    // Truncated
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+    REQUIRE_THROWS_AS(TableAbstraction(path), std::runtime_error);
+
+    // Not a table at all
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string junk(4096, 'x');
+        out.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+    }
+    REQUIRE_THROWS_AS(TableAbstraction(path), std::runtime_error);
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(TableAbstraction(path), std::runtime_error);
+}
+
+TEST_CASE("Bucket table build stops and resumes from its checkpoint", "[bucket_table]") {
+    const std::string path = temp_path("qn_bucket_table_resume.bin");
+    const std::string whole_path = temp_path("qn_bucket_table_whole.bin");
+    const std::string checkpoint = temp_path("qn_bucket_table_resume.ckpt");
+    std::filesystem::remove(path);
+    std::filesystem::remove(checkpoint);
+    PercentileAbstraction percentile(169, 20, 30, 40);
+    TableAbstraction::write(whole_path, percentile, {BettingRound::Preflop, BettingRound::Flop});
+
+    TableBuildConfig config;
+    config.rounds = {BettingRound::Preflop, BettingRound::Flop};
+    config.boards_per_chunk = 100;
+    config.checkpoint_path = checkpoint;
+    std::vector<TableBuildProgress> reports;
+    config.progress = [&](const TableBuildProgress& p) {
+        reports.push_back(p);
+        return !(p.round == BettingRound::Flop && p.boards_done >= 500);
+    };
+    REQUIRE_FALSE(TableAbstraction::write(path, percentile, config));
+    REQUIRE_FALSE(std::filesystem::exists(path));
+    REQUIRE(std::filesystem::exists(checkpoint));
+
+    // Preflop is one chunk of 169 hands; flop chunks cover 100 boards of 1176 hands
+    REQUIRE(reports.size() == 6);
+    REQUIRE(reports[0].round == BettingRound::Preflop);
+    REQUIRE(reports[0].hands_done == 169);
+    REQUIRE(reports.back().boards_done == 500);
+    REQUIRE(reports.back().hands_done == 169 + 500 * 1176);
+    REQUIRE(reports.back().hands_total == 169 + reports.back().boards_total * 1176);
+    REQUIRE(reports.back().hands_resumed == 0);
+
+    reports.clear();
+    config.progress = [&](const TableBuildProgress& p) {
+        reports.push_back(p);
+        return true;
+    };
+    REQUIRE(TableAbstraction::write(path, percentile, config));
+    REQUIRE(reports.front().round == BettingRound::Flop);
+    REQUIRE(reports.front().boards_done == 600);
+    REQUIRE(reports.front().hands_resumed == 169 + 500 * 1176);
+    REQUIRE(reports.back().hands_done == reports.back().hands_total);
+    REQUIRE_FALSE(std::filesystem::exists(checkpoint));
+
+    // The resumed build wrote exactly what one uninterrupted build does
+    auto contents = [](const std::string& p) {
+        std::ifstream in(p, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    };
+    REQUIRE(contents(path) == contents(whole_path));
+
+    // A checkpoint only resumes a build of the same abstraction
+    config.progress = [](const TableBuildProgress& p) { return p.round == BettingRound::Preflop; };
+    REQUIRE_FALSE(TableAbstraction::write(path, percentile, config));
+    PercentileAbstraction other(169, 20, 31, 40);
+    REQUIRE_THROWS_AS(TableAbstraction::write(path, other, config), std::runtime_error);
+    config.boards_per_chunk = 0;
+    REQUIRE_THROWS_AS(TableAbstraction::write(path, percentile, config), std::invalid_argument);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(whole_path);
+    std::filesystem::remove(checkpoint);
+}
+
+// Lookup cost of a mapped table against computing the bucket (benchmark,
+// not a test; builds the full river table)
+TEST_CASE("Bucket table lookup throughput", "[bucket_table][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    const std::string path = temp_path("qn_bucket_table_full.bin");
+    PercentileAbstraction percentile;
+
+    auto t0 = Clock::now();
+    TableAbstraction::write(path, percentile);
+    std::cout << "Full Percentile table: "
+              << std::chrono::duration<double>(Clock::now() - t0).count() << " s" << std::endl;
+    TableAbstraction table(path);
+    std::cout << "File size: " << table.file_size() / 1e6 << " MB" << std::endl;
+
+    std::mt19937 rng(70);
+    for (int board_cards : {3, 5}) {
+        const auto round = static_cast<BettingRound>(board_cards - 2);
+        std::vector<std::pair<CardSet, CardSet>> hands;
+        for (int i = 0; i < 100000; ++i) hands.push_back(deal(rng, board_cards));
+
+        uint64_t sink = 0;
+        for (const auto& [hole, board] : hands) sink += table.get_bucket(hole, board, round);   // Fault pages in
+        t0 = Clock::now();
+        for (const auto& [hole, board] : hands) sink += table.get_bucket(hole, board, round);
+        const double table_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        t0 = Clock::now();
+        for (size_t i = 0; i < 2000; ++i) sink += percentile.get_bucket(hands[i].first, hands[i].second, round);
+        const double direct_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        std::cout << round_to_string(round) << " get_bucket: table " << table_secs / hands.size() * 1e9
+                  << " ns, computed " << direct_secs / 2000 * 1e9 << " ns" << std::endl;
+        if (sink == 0) std::cout << sink;
+    }
+    std::filesystem::remove(path);
+}
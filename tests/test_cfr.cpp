@@ -5,10 +5,14 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
+#include <functional>
 
 #include "solver/CFR.hpp"
 #include "solver/NewtonSolver.hpp"
+#include "solver/Hybrid.hpp"
 #include "poker/KuhnPoker.hpp"
+#include "poker/LeducPoker.hpp"
 #include "poker/QRE.hpp"
 #include "poker/ExpectedValue.hpp"
 
@@ -102,6 +106,41 @@ TEST_CASE("CFR and Newton find same equilibrium", "[cfr][newton]") {
     }
 }
 
+TEST_CASE("Predictive CFR+ converges faster than CFR+", "[cfr][cfr+][pcfr+]") {
+    poker::KuhnPoker kuhn;
+    poker::LeducPoker leduc;
+
+    for (const poker::PokerGame* game : {static_cast<const poker::PokerGame*>(&kuhn),
+                                         static_cast<const poker::PokerGame*>(&leduc)}) {
+        solver::CFRPlus cfr_plus(*game);
+        solver::PredictiveCFRPlus pcfr_plus(*game);
+
+        cfr_plus.solve(100);
+        pcfr_plus.solve(100);
+
+        double plus_exploit = poker::compute_infoset_exploitability(
+            game->root(), cfr_plus.average_strategy());
+        double predictive_exploit = poker::compute_infoset_exploitability(
+            game->root(), pcfr_plus.average_strategy());
+
+        INFO(game->name() << ": CFR+ " << plus_exploit << ", PCFR+ " << predictive_exploit);
+        REQUIRE(predictive_exploit < plus_exploit);
+    }
+}
+
+TEST_CASE("Predictive CFR+ average strategy is valid", "[cfr][pcfr+]") {
+    poker::KuhnPoker kuhn;
+    solver::PredictiveCFRPlus pcfr(kuhn);
+    pcfr.solve(50);
+
+    poker::Strategy avg = pcfr.average_strategy();
+    for (const auto& is : kuhn.get_info_sets()) {
+        Eigen::VectorXd probs = avg.probs(is.id);
+        REQUIRE_THAT(probs.sum(), WithinAbs(1.0, 1e-9));
+        REQUIRE(probs.minCoeff() >= 0.0);
+    }
+}
+
 TEST_CASE("CFR regret matching produces valid strategy", "[cfr]") {
     poker::KuhnPoker kuhn;
     solver::CFR cfr(kuhn);
@@ -141,6 +180,68 @@ TEST_CASE("CFR average strategy improves over time", "[cfr]") {
     REQUIRE(exploits.back() < exploits.front());
 }
 
+TEST_CASE("Info-set exploitability goes to zero under CFR", "[cfr][exploit]") {
+    poker::KuhnPoker kuhn;
+    solver::CFR cfr(kuhn);
+    cfr.solve(2000);
+
+    poker::Strategy avg = cfr.average_strategy();
+    double infoset_exploit = poker::compute_infoset_exploitability(kuhn.root(), avg);
+
+    REQUIRE(infoset_exploit >= -1e-12);
+    REQUIRE(infoset_exploit < 0.01);
+
+    // The per-history best response sees hidden cards, so it bounds this from above
+    REQUIRE(infoset_exploit <= poker::compute_exploitability(kuhn.root(), avg) + 1e-12);
+}
+
+TEST_CASE("CFR warm start reproduces the seed strategy", "[cfr][hybrid]") {
+    poker::KuhnPoker kuhn;
+
+    solver::CFR reference(kuhn);
+    reference.solve(1000);
+    poker::Strategy seed = reference.average_strategy();
+    double seed_exploit = poker::compute_infoset_exploitability(kuhn.root(), seed);
+
+    solver::CFRPlus cfr(kuhn);
+    cfr.warm_start(seed, 100.0);
+
+    // Before any iteration both strategies equal the seed
+    for (const auto& id : seed.info_set_ids()) {
+        Eigen::VectorXd expected = seed.probs(id);
+        Eigen::VectorXd avg = cfr.regret_data().at(id).average_strategy();
+        Eigen::VectorXd cur = cfr.regret_data().at(id).regret_matching_strategy();
+        for (int a = 0; a < expected.size(); ++a) {
+            REQUIRE_THAT(avg(a), WithinAbs(expected(a), 1e-12));
+            REQUIRE_THAT(cur(a), WithinAbs(expected(a), 1e-12));
+        }
+    }
+
+    // Continuing from a good seed must not throw away its quality
+    cfr.solve(100);
+    double warm_exploit = poker::compute_infoset_exploitability(kuhn.root(), cfr.average_strategy());
+    REQUIRE(warm_exploit < seed_exploit * 2.0);
+}
+
+TEST_CASE("CFR strategy converted to logits warm-starts Newton", "[cfr][newton][hybrid]") {
+    poker::KuhnPoker kuhn;
+
+    solver::CFR cfr(kuhn);
+    cfr.solve(500);
+
+    poker::QREResidual qre(kuhn, 2.0);
+    Eigen::VectorXd w0 = solver::strategy_to_logits(cfr.average_strategy(), qre.index());
+    REQUIRE(w0.size() == qre.dim());
+    REQUIRE(w0.allFinite());
+
+    solver::NewtonConfig config;
+    config.tol = 1e-10;
+    auto result = solver::solve_qre_continuation(kuhn, {2.0}, w0, config);
+
+    REQUIRE(result.converged);
+    REQUIRE(qre(result.w).norm() < 1e-8);
+}
+
 // Convergence comparison benchmark (not a test, for analysis)
 TEST_CASE("Convergence comparison: Newton vs CFR", "[cfr][newton][.benchmark]") {
     poker::KuhnPoker kuhn;
@@ -186,3 +287,107 @@ TEST_CASE("Convergence comparison: Newton vs CFR", "[cfr][newton][.benchmark]")
                   << std::setw(15) << newton_exploit << "\n";
     }
 }
+
+// Time-to-epsilon comparison of pure CFR+, pure QRE continuation and the
+// QRE -> CFR+ hybrid (benchmark, not a test)
+TEST_CASE("Time to epsilon: CFR+ vs QRE vs hybrid", "[cfr][newton][hybrid][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+
+    poker::KuhnPoker kuhn;
+    poker::LeducPoker leduc;
+
+    struct Case { const poker::PokerGame* game; double epsilon; double qre_beta; double budget_ms; };
+    const std::vector<Case> cases = {{&kuhn, 1e-3, 20.0, 10e3}, {&leduc, 1e-2, 1.0, 120e3}};
+
+    std::cout << "\n=== Time to epsilon (infoset exploitability) ===\n";
+    std::cout << std::setw(14) << "Game" << std::setw(10) << "Epsilon"
+              << std::setw(16) << "CFR+ ms" << std::setw(16) << "QRE ms"
+              << std::setw(16) << "Hybrid ms" << "\n";
+
+    for (const auto& c : cases) {
+        const poker::PokerGame& game = *c.game;
+        // Run CFR+ in chunks until epsilon is reached; returns ms or -1
+        auto run_cfr = [&](solver::CFRPlus& cfr, Clock::time_point t0) {
+            while (ms_since(t0) < c.budget_ms) {
+                cfr.solve(10);
+                if (poker::compute_infoset_exploitability(game.root(), cfr.average_strategy()) < c.epsilon) {
+                    return ms_since(t0);
+                }
+            }
+            return -1.0;
+        };
+
+        // Pure CFR+
+        auto t0 = Clock::now();
+        solver::CFRPlus pure(game);
+        double cfr_ms = run_cfr(pure, t0);
+
+        // Pure QRE continuation: walk beta up until epsilon is reached
+        poker::InfoSetIndex index;
+        index.build(game.get_info_sets());
+        solver::NewtonConfig config;
+        config.tol = 1e-8;
+        config.max_iters = 30;
+
+        t0 = Clock::now();
+        double qre_ms = -1.0;
+        Eigen::VectorXd w = Eigen::VectorXd::Zero(index.total_dim());
+        for (double beta : solver::make_beta_schedule(64.0 * c.qre_beta)) {
+            if (ms_since(t0) > c.budget_ms) break;
+            w = solver::solve_qre_continuation(game, {beta}, w, config).w;
+            poker::Strategy sigma = poker::Strategy::from_logits(w, index);
+            if (poker::compute_infoset_exploitability(game.root(), sigma) < c.epsilon) {
+                qre_ms = ms_since(t0);
+                break;
+            }
+        }
+
+        // Hybrid: QRE continuation to a moderate beta, then CFR+ from there
+        t0 = Clock::now();
+        auto qre = solver::solve_qre_continuation(
+            game, solver::make_beta_schedule(c.qre_beta),
+            Eigen::VectorXd::Zero(index.total_dim()), config);
+        solver::CFRPlus hybrid(game);
+        hybrid.warm_start(poker::Strategy::from_logits(qre.w, index), 10.0);
+        double hybrid_ms = run_cfr(hybrid, t0);
+
+        std::cout << std::setw(14) << game.name()
+                  << std::setw(10) << std::scientific << std::setprecision(1) << c.epsilon
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << cfr_ms << std::setw(16) << qre_ms
+                  << std::setw(16) << hybrid_ms << "\n";
+    }
+    std::cout << "(-1 = epsilon not reached within the time budget)\n";
+}
+
+// Exploitability per iteration for CFR+ and predictive CFR+
+// (benchmark, not a test)
+TEST_CASE("Convergence comparison: CFR+ vs predictive CFR+", "[cfr][cfr+][pcfr+][.benchmark]") {
+    poker::KuhnPoker kuhn;
+    poker::LeducPoker leduc;
+
+    for (const poker::PokerGame* game : {static_cast<const poker::PokerGame*>(&kuhn),
+                                         static_cast<const poker::PokerGame*>(&leduc)}) {
+        solver::CFRPlus cfr_plus(*game);
+        solver::PredictiveCFRPlus pcfr_plus(*game);
+
+        std::cout << "\n=== " << game->name() << ": infoset exploitability ===\n";
+        std::cout << std::setw(10) << "Iter" << std::setw(15) << "CFR+"
+                  << std::setw(15) << "PCFR+" << "\n";
+
+        for (int iters : {10, 30, 100, 300, 1000}) {
+            cfr_plus.solve(iters - cfr_plus.iterations());
+            pcfr_plus.solve(iters - pcfr_plus.iterations());
+
+            std::cout << std::setw(10) << iters
+                      << std::setw(15) << std::scientific << std::setprecision(3)
+                      << poker::compute_infoset_exploitability(game->root(), cfr_plus.average_strategy())
+                      << std::setw(15)
+                      << poker::compute_infoset_exploitability(game->root(), pcfr_plus.average_strategy())
+                      << "\n";
+        }
+    }
+}
@@ -0,0 +1,231 @@
+// Tests for the sharded concurrent opponent model
+// Verifies that it keeps exactly what one OpponentModel per opponent
+// would, under concurrent updates, and that reads are consistent snapshots
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "exploit/ConcurrentOpponentModel.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace quantnet;
+using namespace quantnet::exploit;
+
+namespace {
+
+constexpr poker::Action ACTIONS[] = {poker::Action::Fold, poker::Action::Check, poker::Action::Call,
+                                     poker::Action::Bet, poker::Action::Raise};
+
+poker::InfoSetId info_set_name(int i) {
+    return "P1:" + std::to_string(i) + ":cb";
+}
+
+bool consistent(const ActionStats& s) {
+    return s.fold_count + s.call_count + s.raise_count == s.total_observations;
+}
+
+} // namespace
+
+TEST_CASE("Concurrent model keeps what per-opponent models keep", "[concurrent_opponent]") {
+    ConcurrentOpponentModel model({.shards = 8});
+    std::vector<OpponentModel> expected(50);
+    std::mt19937 rng(75);
+    for (int i = 0; i < 20000; ++i) {
+        const int player = static_cast<int>(rng() % 50);
+        const poker::InfoSetId id = info_set_name(static_cast<int>(rng() % 30));
+        const poker::Action action = ACTIONS[rng() % 5];
+        if (i % 3 == 0) {
+            model.observe_action(player, id, poker::action_to_string(action));
+            expected[player].observe_action(player, id, poker::action_to_string(action));
+        } else {
+            model.observe_action(player, id, action);
+            expected[player].observe_action(player, id, action);
+        }
+        if (i % 10 == 0) {
+            model.observe_hand_result(player, i % 20 == 0, i % 30 == 0, 4.0);
+            expected[player].observe_hand_result(player, i % 20 == 0, i % 30 == 0, 4.0);
+        }
+    }
+
+    REQUIRE(model.num_opponents() == 50);
+    for (int player = 0; player < 50; ++player) {
+        REQUIRE(model.total_observations(player) == expected[player].total_observations(player));
+        const TendencyProfile a = model.get_profile(player);
+        const TendencyProfile b = expected[player].get_profile(player);
+        REQUIRE(a.vpip == b.vpip);
+        REQUIRE(a.pfr == b.pfr);
+        REQUIRE(a.aggression == b.aggression);
+        REQUIRE(a.total_hands == b.total_hands);
+        for (int i = 0; i < 30; ++i) {
+            const ActionStats s = model.get_stats(player, info_set_name(i));
+            REQUIRE(s.raise_count == expected[player].get_stats(player, info_set_name(i)).raise_count);
+            REQUIRE(s.total_observations == expected[player].get_stats(player, info_set_name(i)).total_observations);
+            REQUIRE(model.predict_action_probs(player, info_set_name(i), 3).isApprox(
+                expected[player].predict_action_probs(player, info_set_name(i), 3)));
+        }
+    }
+
+    for (int player : {0, 17, 49}) {
+        const OpponentModel snap = model.snapshot(player);
+        REQUIRE(snap.num_handles() == expected[player].num_handles());
+        REQUIRE(snap.get_profile(player).vpip == expected[player].get_profile(player).vpip);
+        REQUIRE(snap.get_profile(player).went_to_showdown == expected[player].get_profile(player).went_to_showdown);
+        for (int i = 0; i < 30; ++i) {
+            REQUIRE(snap.get_stats(player, info_set_name(i)).call_count ==
+                    expected[player].get_stats(player, info_set_name(i)).call_count);
+        }
+    }
+
+    // Unknown opponents read as empty
+    REQUIRE(model.get_stats(999, info_set_name(0)).total_observations == 0);
+    REQUIRE(model.total_observations(999) == 0);
+    REQUIRE(model.snapshot(999).num_handles() == 0);
+    REQUIRE(model.predict_action_probs(999, info_set_name(0), 2).isApprox(
+        OpponentModel{}.predict_action_probs(999, info_set_name(0), 2)));
+
+    model.reset();
+    REQUIRE(model.num_opponents() == 0);
+    REQUIRE(model.total_observations(0) == 0);
+}
+
+TEST_CASE("Concurrent model handles and snapshots", "[concurrent_opponent]") {
+    REQUIRE(ConcurrentOpponentModel({.shards = 5}).num_shards() == 8);
+    REQUIRE(ConcurrentOpponentModel({.shards = 1}).num_shards() == 1);
+    REQUIRE_THROWS_AS(ConcurrentOpponentModel({.shards = 0}), std::invalid_argument);
+
+    // Handles are shared by all opponents
+    ConcurrentOpponentModel model;
+    const StatsHandle king = model.intern("P0:K:");
+    REQUIRE(model.intern("P0:K:") == king);
+    REQUIRE(model.num_info_sets() == 1);
+    model.observe_action(7, king, poker::Action::Bet);
+    model.observe_action(7, king, poker::Action::Bet);
+    model.observe_action(8, king, poker::Action::Fold);
+    model.merge_stats(7, king, ActionStats{.fold_count = 1, .total_observations = 1});
+    REQUIRE(model.get_stats(7, "P0:K:").raise_count == 2);
+    REQUIRE(model.get_stats(7, "P0:K:").total_observations == 3);
+    REQUIRE(model.get_stats(8, "P0:K:").fold_count == 1);
+    REQUIRE(model.get_stats(7, "P0:Q:").total_observations == 0);
+    REQUIRE_THROWS_AS(model.observe_action(7, king + 1, poker::Action::Bet), std::invalid_argument);
+    REQUIRE_THROWS_AS(model.merge_stats(7, king + 1, ActionStats{}), std::invalid_argument);
+    model.observe_hand_result(7, true, true, 4.0);
+
+    // A snapshot is an independent OpponentModel with the same reads
+    OpponentModel copy = model.snapshot(7);
+    const TendencyProfile profile = model.get_profile(7);
+    model.reset();
+    REQUIRE(model.num_info_sets() == 0);
+    REQUIRE(copy.num_handles() == 1);
+    REQUIRE(copy.handle_info_set(0) == "P0:K:");
+    REQUIRE(copy.get_stats(7, "P0:K:").raise_count == 2);
+    REQUIRE(copy.get_profile(7).vpip == profile.vpip);
+    REQUIRE(copy.get_profile(7).pfr == profile.pfr);
+    REQUIRE(copy.get_profile(7).won_at_showdown == profile.won_at_showdown);
+    REQUIRE(copy.get_profile(7).aggression == profile.aggression);
+    ExploitativeStrategy strategy(copy);
+    REQUIRE(strategy.compute_exploit_probs(0, 7, "P0:K:", 2).sum() > 0.99);
+}
+
+TEST_CASE("Concurrent model is exact and consistent across threads", "[concurrent_opponent]") {
+    ConcurrentOpponentModel model({.shards = 4});
+    constexpr int threads = 4;
+    constexpr int per_thread = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    // Writers share opponents, so they meet on the same shards; a reader
+    // checks every snapshot it takes while they run
+    std::thread reader([&] {
+        while (!done) {
+            for (int player = 0; player < 16; ++player) {
+                if (!consistent(model.get_stats(player, info_set_name(player % 4)))) ++torn;
+                const OpponentModel snap = model.snapshot(player);
+                int sum = 0;
+                for (StatsHandle h = 0; h < snap.num_handles(); ++h) {
+                    if (!consistent(snap.get_stats(h))) ++torn;
+                    sum += snap.get_stats(h).total_observations;
+                }
+                if (sum != snap.total_observations(player)) ++torn;
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t] {
+            std::mt19937 rng(100 + t);
+            for (int i = 0; i < per_thread; ++i) {
+                const int player = static_cast<int>(rng() % 16);
+                model.observe_action(player, info_set_name(player % 4 + static_cast<int>(rng() % 2)),
+                                     ACTIONS[rng() % 5]);
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+    done = true;
+    reader.join();
+
+    REQUIRE(torn == 0);
+    int total = 0;
+    for (int player = 0; player < 16; ++player) total += model.total_observations(player);
+    REQUIRE(total == threads * per_thread);
+}
+
+// Update throughput against one OpponentModel behind a global mutex, with
+// each thread playing its own opponents (benchmark, not a test)
+TEST_CASE("Concurrent opponent model throughput", "[concurrent_opponent][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int opponents = 4096;
+    constexpr int per_thread = 1'000'000;
+    std::vector<poker::InfoSetId> ids;
+    for (int i = 0; i < 64; ++i) ids.push_back(info_set_name(i));
+
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+#ifdef _OPENMP
+    max_threads = omp_get_max_threads();
+#endif
+    for (int threads = 1; threads <= std::max(1, max_threads); threads *= 2) {
+        auto run = [&](auto&& observe) {
+            std::vector<std::thread> workers;
+            const auto t0 = Clock::now();
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(200 + t);
+                    for (int i = 0; i < per_thread; ++i) {
+                        const int player = t + threads * static_cast<int>(rng() % (opponents / threads));
+                        observe(player, ids[rng() % ids.size()], ACTIONS[rng() % 5]);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+            return threads * per_thread / std::chrono::duration<double>(Clock::now() - t0).count() / 1e6;
+        };
+
+        ConcurrentOpponentModel sharded;
+        const double sharded_rate = run([&](int p, const poker::InfoSetId& id, poker::Action a) {
+            sharded.observe_action(p, id, a);
+        });
+        ConcurrentOpponentModel by_handle;
+        std::vector<StatsHandle> handles;
+        for (const auto& id : ids) handles.push_back(by_handle.intern(id));
+        const double handle_rate = run([&](int p, const poker::InfoSetId& id, poker::Action a) {
+            by_handle.observe_action(p, handles[&id - ids.data()], a);
+        });
+        OpponentModel single;
+        std::mutex global;
+        const double global_rate = run([&](int p, const poker::InfoSetId& id, poker::Action a) {
+            std::lock_guard lock(global);
+            single.observe_action(p, id, a);
+        });
+        std::cout << threads << " thread(s): sharded " << sharded_rate << "M updates/s, by handle "
+                  << handle_rate << "M/s, global lock " << global_rate << "M/s" << std::endl;
+    }
+}
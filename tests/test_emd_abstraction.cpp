@@ -0,0 +1,332 @@
+// Tests for the EMD abstraction pipeline
+// Verifies equity histograms, that Hamerly-pruned k-means and the pruned
+// nearest-centroid search match brute force, and that a checkpointed build
+// resumes to the same tables
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <random>
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/EMDClustering.hpp"
+#include "poker/HandIndexer.hpp"
+
+using namespace quantnet::poker;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+// Random CDFs: clusters of noisy step distributions
+std::vector<float> random_cdfs(std::mt19937& rng, int n, int bins) {
+    std::uniform_int_distribution<int> center(0, bins - 1);
+    std::normal_distribution<float> noise(0.0f, 2.0f);
+    std::vector<float> points;
+    for (int i = 0; i < n; ++i) {
+        std::vector<float> hist(bins, 0.0f);
+        const int c = center(rng) / 4 * 4;
+        for (int s = 0; s < 20; ++s) {
+            const int b = std::clamp(c + static_cast<int>(noise(rng)), 0, bins - 1);
+            hist[b] += 1.0f / 20;
+        }
+        float running = 0.0f;
+        for (int b = 0; b < bins; ++b) {
+            running += hist[b];
+            points.push_back(b == bins - 1 ? 1.0f : running);
+        }
+    }
+    return points;
+}
+
+int brute_nearest(const std::vector<float>& centroids, const float* x, int bins) {
+    const int k = static_cast<int>(centroids.size() / bins);
+    int best_id = 0;
+    float best = std::numeric_limits<float>::infinity();
+    for (int c = 0; c < k; ++c) {
+        const float d = emd_distance(x, &centroids[static_cast<size_t>(c) * bins], bins);
+        if (d < best) {
+            best = d;
+            best_id = c;
+        }
+    }
+    return best_id;
+}
+
+EMDBuildConfig small_flop_config() {
+    EMDBuildConfig config;
+    config.samples_per_hand = 4;
+    config.histogram_bins = 20;
+    config.max_iterations = 6;
+    config.max_training_points = 20000;
+    config.seed = 7;
+    config.rounds = {BettingRound::Flop};
+    config.checkpoint_seconds = 0.0;
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Equity histograms", "[emd]") {
+    const int bins = 10;
+    std::vector<float> hist(NUM_HOLE_COMBOS * bins);
+
+    // River: all mass in the bin of the hand's strength
+    CardSet river = CardSet::of(std::array{0, 14, 28, 42, 7});
+    equity_histograms(river, bins, 0, 0, 0, hist);
+    const auto strengths = HandEvaluator::hand_strengths(river);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const float* cdf = &hist[i * bins];
+        if (strengths[i] < 0) {
+            REQUIRE(cdf[bins - 1] == 0.0f);
+            continue;
+        }
+        const int bin = std::min(bins - 1, static_cast<int>(strengths[i] * bins));
+        for (int b = 0; b < bins; ++b) REQUIRE(cdf[b] == (b >= bin ? 1.0f : 0.0f));
+    }
+
+    // Turn: CDFs are monotone and end at 1; the mean matches the average
+    // river strength over the 46 live rivers
+    CardSet turn = CardSet::of(std::array{0, 14, 28, 42});
+    equity_histograms(turn, bins, 0, 0, 0, hist);
+    const int hole = hole_combo_index(12, 25);     // Ac Ad
+    const float* cdf = &hist[hole * bins];
+    for (int b = 1; b < bins; ++b) REQUIRE(cdf[b] >= cdf[b - 1]);
+    REQUIRE(cdf[bins - 1] == 1.0f);
+    REQUIRE(emd_distance(cdf, cdf, bins) == 0.0f);
+
+    // Sampled runouts reproduce for a seed and stream
+    CardSet flop = CardSet::of(std::array{0, 14, 28});
+    std::vector<float> again(hist.size());
+    equity_histograms(flop, bins, 30, 5, 9, hist);
+    equity_histograms(flop, bins, 30, 5, 9, again);
+    REQUIRE(hist == again);
+    equity_histograms(flop, bins, 30, 5, 10, again);
+    REQUIRE(hist != again);
+
+    REQUIRE_THROWS_AS(equity_histograms(CardSet::of(std::array{0, 1}), bins, 0, 0, 0, hist),
+                      std::invalid_argument);
+    std::vector<float> small(10);
+    REQUIRE_THROWS_AS(equity_histograms(flop, bins, 0, 0, 0, small), std::invalid_argument);
+}
+
+TEST_CASE("Hamerly k-means matches Lloyd's algorithm", "[emd]") {
+    std::mt19937 rng(67);
+    const int bins = 16;
+    const int n = 4000;
+    const int k = 12;
+    const std::vector<float> points = random_cdfs(rng, n, bins);
+
+    const std::vector<float> seeds = kmeans_plus_plus(points, bins, k, 3);
+    REQUIRE(seeds.size() == static_cast<size_t>(k * bins));
+    REQUIRE(kmeans_plus_plus(points, bins, k, 3) == seeds);
+    REQUIRE_THROWS_AS(kmeans_plus_plus(std::span(points.data(), 5 * bins), bins, k, 3),
+                      std::invalid_argument);
+
+    HamerlyKMeans kmeans(points, bins, seeds);
+    std::vector<float> lloyd = seeds;
+    uint64_t last_scans = n;
+    for (int step = 0; step < 15; ++step) {
+        kmeans.step();
+
+        // Plain Lloyd step
+        std::vector<int> assign(n);
+        std::vector<double> sums(k * bins, 0.0);
+        std::vector<int> counts(k, 0);
+        for (int i = 0; i < n; ++i) {
+            assign[i] = brute_nearest(lloyd, &points[i * bins], bins);
+            ++counts[assign[i]];
+            for (int b = 0; b < bins; ++b) sums[assign[i] * bins + b] += points[i * bins + b];
+        }
+        for (int c = 0; c < k; ++c) {
+            if (counts[c] == 0) continue;
+            for (int b = 0; b < bins; ++b) lloyd[c * bins + b] = static_cast<float>(sums[c * bins + b] / counts[c]);
+        }
+
+        REQUIRE(kmeans.assignments() == assign);
+        for (int j = 0; j < k * bins; ++j) REQUIRE_THAT(kmeans.centroids()[j], WithinAbs(lloyd[j], 1e-5));
+        last_scans = kmeans.full_scans();
+    }
+    // The bounds spare most points a full scan once centroids settle
+    REQUIRE(last_scans < n / 4);
+}
+
+TEST_CASE("Pruned nearest centroid matches brute force", "[emd]") {
+    std::mt19937 rng(68);
+    const int bins = 16;
+    const std::vector<float> centroids = random_cdfs(rng, 50, bins);
+    const std::vector<float> queries = random_cdfs(rng, 2000, bins);
+    const NearestCentroid nearest(centroids, bins);
+    for (int i = 0; i < 2000; ++i) {
+        const float* q = &queries[i * bins];
+        REQUIRE(nearest.nearest(q) == brute_nearest(centroids, q, bins));
+    }
+}
+
+TEST_CASE("EMD abstraction builds a flat flop table", "[emd]") {
+    EMDAbstraction abstraction(169, 8, 8, 8);
+    REQUIRE(abstraction.clusters(BettingRound::Flop).empty());
+    REQUIRE(abstraction.build_clusters(small_flop_config()));
+
+    const auto& table = abstraction.clusters(BettingRound::Flop);
+    REQUIRE(table.size() == HoldemIndexer::instance().size(3));
+    REQUIRE(*std::max_element(table.begin(), table.end()) < 8);
+    REQUIRE(abstraction.clusters(BettingRound::Turn).empty());
+    REQUIRE_THROWS_AS(abstraction.clusters(BettingRound::Preflop), std::invalid_argument);
+
+    // get_bucket reads the table; isomorphic hands share it
+    std::mt19937 rng(69);
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<int> deck(DECK_SIZE);
+        std::iota(deck.begin(), deck.end(), 0);
+        std::shuffle(deck.begin(), deck.end(), rng);
+        CardSet hole = CardSet::of(std::span(deck.data(), 2));
+        CardSet board = CardSet::of(std::span(deck.data() + 2, 3));
+        const BucketId bucket = abstraction.get_bucket(hole, board, BettingRound::Flop);
+        REQUIRE(bucket == table[HoldemIndexer::instance().index(hole, board)]);
+
+        std::shuffle(perm.begin(), perm.end(), rng);
+        CardSet p_hole, p_board;
+        for (int c : hole) p_hole.insert(make_card(card_rank(c), perm[card_suit(c)]));
+        for (int c : board) p_board.insert(make_card(card_rank(c), perm[card_suit(c)]));
+        REQUIRE(abstraction.get_bucket(p_hole, p_board, BettingRound::Flop) == bucket);
+    }
+
+    // Top set and a dead hand land in different buckets
+    CardSet board = CardSet::of(std::array{make_card(12, 0), make_card(5, 1), make_card(0, 2)});
+    CardSet top_set = CardSet::of(std::array{make_card(12, 1), make_card(12, 2)});
+    CardSet air = CardSet::of(std::array{make_card(1, 3), make_card(6, 3)});
+    REQUIRE(abstraction.get_bucket(top_set, board, BettingRound::Flop) !=
+            abstraction.get_bucket(air, board, BettingRound::Flop));
+
+    // Preflop buckets follow equity ranks: AA first, 72o near the end
+    const CardSet aces = CardSet::of(std::array{make_card(12, 0), make_card(12, 1)});
+    const CardSet seven_deuce = CardSet::of(std::array{make_card(5, 0), make_card(0, 1)});
+    REQUIRE(abstraction.get_bucket(aces, CardSet{}, BettingRound::Preflop) == 0);
+    REQUIRE(abstraction.get_bucket(seven_deuce, CardSet{}, BettingRound::Preflop) > 150);
+    EMDAbstraction coarse(10, 8, 8, 8);
+    REQUIRE(coarse.get_bucket(aces, CardSet{}, BettingRound::Preflop) !=
+            coarse.get_bucket(seven_deuce, CardSet{}, BettingRound::Preflop));
+
+    EMDBuildConfig bad = small_flop_config();
+    bad.rounds = {BettingRound::Preflop};
+    REQUIRE_THROWS_AS(abstraction.build_clusters(bad), std::invalid_argument);
+}
+
+TEST_CASE("EMD build resumes from a checkpoint", "[emd]") {
+    const auto path = std::filesystem::temp_directory_path() / "qn_emd_checkpoint.bin";
+    std::filesystem::remove(path);
+
+    EMDAbstraction reference(169, 8, 8, 8);
+    REQUIRE(reference.build_clusters(small_flop_config()));
+
+    // Stop mid-clustering, then mid-assignment, then finish
+    EMDBuildConfig config = small_flop_config();
+    config.checkpoint_path = path.string();
+    int stops = 0;
+    config.progress = [&stops](const EMDBuildProgress& p) {
+        if (stops == 0 && !p.assigning && p.iteration == 2) return ++stops, false;
+        if (stops == 1 && p.assigning && p.boards_done * 2 >= p.boards_total) return ++stops, false;
+        return true;
+    };
+    EMDAbstraction first(169, 8, 8, 8);
+    REQUIRE_FALSE(first.build_clusters(config));
+    REQUIRE(first.clusters(BettingRound::Flop).empty());
+    REQUIRE(std::filesystem::exists(path));
+
+    EMDAbstraction second(169, 8, 8, 8);
+    REQUIRE_FALSE(second.build_clusters(config));
+    EMDAbstraction third(169, 8, 8, 8);
+    REQUIRE(third.build_clusters(config));
+    REQUIRE(stops == 2);
+    REQUIRE(third.clusters(BettingRound::Flop) == reference.clusters(BettingRound::Flop));
+
+    // A finished round is read back without recomputing
+    EMDAbstraction reloaded(169, 8, 8, 8);
+    config.progress = [](const EMDBuildProgress&) { FAIL("finished round was rebuilt"); return true; };
+    REQUIRE(reloaded.build_clusters(config));
+    REQUIRE(reloaded.clusters(BettingRound::Flop) == reference.clusters(BettingRound::Flop));
+
+    // Different settings do not resume
+    EMDAbstraction other(169, 9, 8, 8);
+    config.progress = nullptr;
+    REQUIRE_THROWS_AS(other.build_clusters(config), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Inconsistent EMD checkpoints are rejected", "[emd]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "qn_emd_checkpoint_bad.bin").string();
+    using Stage = EMDCheckpoint::Stage;
+
+    // OCHS settings: flop centroids are 3 histograms of 20 bins, river
+    // centroids 3 equities
+    EMDCheckpoint good;
+    good.bins = 20;
+    good.opponent_clusters = 3;
+    good.buckets = {8, 8, 8};
+    good.rounds[0].stage = Stage::Assigning;
+    good.rounds[0].next_board = 100;
+    good.rounds[0].centroids.assign(8 * 60, 0.5f);
+    good.rounds[0].table.assign(HoldemIndexer::instance().size(3), 0);
+    good.rounds[2].stage = Stage::Clustering;
+    good.rounds[2].centroids.assign(8 * 3, 0.5f);
+    REQUIRE(good.feature_dims(0) == 60);
+    REQUIRE(good.feature_dims(2) == 3);
+
+    good.save(path);
+    EMDCheckpoint loaded;
+    REQUIRE(EMDCheckpoint::load(path, loaded));
+    REQUIRE(loaded.same_settings(good));
+    REQUIRE(loaded.rounds[0].table.size() == good.rounds[0].table.size());
+
+    // Each of these would let a resumed build index past the table
+    auto write_corrupt = [&](auto&& corrupt) {
+        EMDCheckpoint bad = good;
+        corrupt(bad);
+        bad.save(path);
+    };
+    write_corrupt([](EMDCheckpoint& ck) { ck.rounds[0].table.resize(1000); });
+    REQUIRE_THROWS_AS(EMDCheckpoint::load(path, loaded), std::runtime_error);
+    write_corrupt([](EMDCheckpoint& ck) { ck.rounds[0].centroids.resize(8 * 20); });
+    REQUIRE_THROWS_AS(EMDCheckpoint::load(path, loaded), std::runtime_error);
+    write_corrupt([](EMDCheckpoint& ck) { ck.rounds[2].centroids.clear(); });
+    REQUIRE_THROWS_AS(EMDCheckpoint::load(path, loaded), std::runtime_error);
+    write_corrupt([](EMDCheckpoint& ck) { ck.rounds[0].next_board = HandIndexer({3}).size(0) + 1; });
+    REQUIRE_THROWS_AS(EMDCheckpoint::load(path, loaded), std::runtime_error);
+    write_corrupt([](EMDCheckpoint& ck) {
+        ck.rounds[0].stage = Stage::Done;
+        ck.rounds[0].table.clear();
+    });
+    REQUIRE_THROWS_AS(EMDCheckpoint::load(path, loaded), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+// Full default build of every postflop round (slow, not part of the
+// default run)
+TEST_CASE("EMD abstraction full build", "[emd][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    EMDAbstraction abstraction;
+    EMDBuildConfig config;
+    auto last = Clock::now();
+    auto t0 = last;
+    config.progress = [&](const EMDBuildProgress& p) {
+        const auto now = Clock::now();
+        if (std::chrono::duration<double>(now - last).count() > 10.0 || (p.assigning && p.boards_done == p.boards_total)) {
+            std::cout << round_to_string(p.round) << (p.assigning ? " assign " : " k-means ")
+                      << (p.assigning ? p.boards_done : p.iteration) << " after "
+                      << std::chrono::duration<double>(now - t0).count() << " s" << std::endl;
+            last = now;
+        }
+        return true;
+    };
+    REQUIRE(abstraction.build_clusters(config));
+    for (BettingRound round : {BettingRound::Flop, BettingRound::Turn, BettingRound::River}) {
+        REQUIRE(abstraction.clusters(round).size() == HoldemIndexer::instance().size(2 + static_cast<int>(round)));
+    }
+}
@@ -0,0 +1,191 @@
+// Tests for range-vs-range equity
+// Verifies exact enumeration against brute force and Monte Carlo estimates
+// against exact values
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "poker/Equity.hpp"
+#include "poker/HandEvaluator.hpp"
+#include "poker/TableEvaluator.hpp"
+
+using namespace quantnet::poker;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+// "Ah" -> card index
+int card(const char* s) {
+    const std::string ranks = "23456789TJQKA";
+    const std::string suits = "cdhs";
+    return make_card(static_cast<int>(ranks.find(s[0])), static_cast<int>(suits.find(s[1])));
+}
+
+CardSet cards(std::initializer_list<const char*> names) {
+    CardSet set;
+    for (const char* n : names) set.insert(card(n));
+    return set;
+}
+
+// Every combo of two ranks (a pair if equal)
+HandRange ranks_range(int r1, int r2) {
+    HandRange range;
+    for (int s1 = 0; s1 < NUM_SUITS; ++s1) {
+        for (int s2 = 0; s2 < NUM_SUITS; ++s2) {
+            const int c1 = make_card(r1, s1);
+            const int c2 = make_card(r2, s2);
+            if (c1 != c2) range.set(c1, c2, 1.0);
+        }
+    }
+    return range;
+}
+
+} // namespace
+
+TEST_CASE("Exact equity matches brute force", "[equity]") {
+    CardSet board = cards({"Kh", "9h", "4c", "2d"});
+
+    // Weighted ranges sharing cards with each other and the board
+    HandRange hero = ranks_range(12, 12);    // AA
+    hero.set(card("Ah"), card("Th"), 2.0);
+    hero.set(card("Kc"), card("Qc"), 0.5);
+    hero.set(card("Kh"), card("Qh"), 1.0);   // Blocked by the board
+    HandRange villain = ranks_range(11, 11); // KK (two left)
+    villain.set(card("Ah"), card("Jh"), 1.5);
+    villain.set(card("9c"), card("9s"), 1.0);
+    villain.set(card("Ts"), card("8s"), 3.0);
+
+    double win = 0.0, tie = 0.0, total = 0.0;
+    const auto& combos = hole_combos();
+    for (int h = 0; h < NUM_HOLE_COMBOS; ++h) {
+        for (int v = 0; v < NUM_HOLE_COMBOS; ++v) {
+            const double w = hero.weights[h] * villain.weights[v];
+            CardSet hs = CardSet::of(combos[h]);
+            CardSet vs = CardSet::of(combos[v]);
+            if (w == 0.0 || hs.intersects(vs) || hs.intersects(board) || vs.intersects(board)) continue;
+            for (int river : ~(hs | vs | board)) {
+                CardSet full = board;
+                full.insert(river);
+                HandValue ours = HandEvaluator::evaluate(hs | full);
+                HandValue theirs = HandEvaluator::evaluate(vs | full);
+                win += w * (ours > theirs);
+                tie += w * (ours == theirs);
+                total += w;
+            }
+        }
+    }
+
+    EquityResult result = RangeEquity::compute(hero, villain, board);
+    REQUIRE(result.exact);
+    REQUIRE(result.runouts == 48);
+    REQUIRE(result.std_error == 0.0);
+    REQUIRE_THAT(result.win, WithinAbs(win / total, 1e-12));
+    REQUIRE_THAT(result.tie, WithinAbs(tie / total, 1e-12));
+    REQUIRE_THAT(result.equity, WithinAbs((win + 0.5 * tie) / total, 1e-12));
+
+    // Only hero combos get a per-hand equity
+    REQUIRE(result.hand_equity[hole_combo_index(card("Ah"), card("Th"))] >= 0.0);
+    REQUIRE(result.hand_equity[hole_combo_index(card("Ah"), card("Jh"))] == -1.0);
+    REQUIRE(result.hand_equity[hole_combo_index(card("Kc"), card("Qc"))] >= 0.0);
+    REQUIRE(result.hand_equity[hole_combo_index(card("Kh"), card("Qh"))] == -1.0);
+}
+
+TEST_CASE("Equity of symmetric ranges and single hands", "[equity]") {
+    CardSet flop = cards({"Jc", "8h", "3s"});
+
+    EquityResult sym = RangeEquity::compute(HandRange::full(), HandRange::full(), flop);
+    REQUIRE_THAT(sym.equity, WithinAbs(0.5, 1e-12));
+
+    // Against a full range on the river, per-hand equity is hand strength
+    CardSet river = flop | cards({"2d", "Kd"});
+    EquityResult all = RangeEquity::compute(HandRange::full(), HandRange::full(), river);
+    REQUIRE(all.runouts == 1);
+    auto strengths = HandEvaluator::hand_strengths(river);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        REQUIRE_THAT(all.hand_equity[i], WithinAbs(strengths[i], 1e-12));
+    }
+
+    // One combo against another: a set against an overpair
+    HandRange set, overpair;
+    set.set(card("8c"), card("8d"), 1.0);
+    overpair.set(card("Ac"), card("Ad"), 1.0);
+    EquityResult one = RangeEquity::compute(set, overpair, river);
+    REQUIRE(one.equity == 1.0);
+    REQUIRE(one.win == 1.0);
+    REQUIRE(RangeEquity::compute(overpair, set, flop).equity < 0.1);
+
+    // Same hand, different suits: always a split on this river
+    HandRange ak1, ak2;
+    ak1.set(card("Ac"), card("Kc"), 1.0);
+    ak2.set(card("Ah"), card("Ks"), 1.0);
+    REQUIRE(RangeEquity::compute(ak1, ak2, river).tie == 1.0);
+}
+
+TEST_CASE("Sampled equity is reproducible and brackets the exact value", "[equity]") {
+    CardSet flop = cards({"Ts", "7d", "2s"});
+    HandRange hero = ranks_range(8, 8);      // TT
+    hero.weights[hole_combo_index(card("As"), card("Ks"))] = 1.0;
+    HandRange villain = HandRange::full();
+
+    EquityConfig sampled{4000, 7};
+    EquityResult a = RangeEquity::compute(hero, villain, flop, {}, sampled);
+    EquityResult b = RangeEquity::compute(hero, villain, flop, {}, sampled);
+    REQUIRE(!a.exact);
+    REQUIRE(a.equity == b.equity);
+    REQUIRE(a.std_error == b.std_error);
+    REQUIRE(a.std_error > 0.0);
+
+    EquityResult exact = RangeEquity::compute(hero, villain, flop);
+    REQUIRE(std::abs(a.equity - exact.equity) < 4.0 * a.std_error);
+    auto [lo, hi] = a.confidence_interval(4.0);
+    REQUIRE(lo <= exact.equity);
+    REQUIRE(hi >= exact.equity);
+
+    // Preflop AA against KK wins about 82%
+    EquityResult preflop = RangeEquity::compute(ranks_range(12, 12), ranks_range(11, 11), CardSet{}, {},
+                                                EquityConfig{20000, 1});
+    REQUIRE_THAT(preflop.equity, WithinAbs(0.82, 0.01));
+    REQUIRE(preflop.std_error < 0.005);
+}
+
+TEST_CASE("Equity rejects bad arguments", "[equity]") {
+    HandRange full = HandRange::full();
+    CardSet flop = cards({"Jc", "8h", "3s"});
+
+    REQUIRE_THROWS_AS(RangeEquity::compute(full, full, CardSet{}), std::invalid_argument);
+    REQUIRE_THROWS_AS(RangeEquity::compute(full, full, flop, cards({"Jc"})), std::invalid_argument);
+
+    HandRange negative = full;
+    negative.weights[3] = -1.0;
+    REQUIRE_THROWS_AS(RangeEquity::compute(negative, full, flop), std::invalid_argument);
+
+    // Every hero combo blocks every villain combo
+    HandRange hero, villain;
+    hero.set(card("Ac"), card("Kc"), 1.0);
+    villain.set(card("Ac"), card("Qd"), 1.0);
+    REQUIRE_THROWS_AS(RangeEquity::compute(hero, villain, flop), std::invalid_argument);
+}
+
+// Full range against full range (benchmark, not a test)
+TEST_CASE("Range equity throughput", "[equity][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+    TableEvaluator::init();
+    HandRange full = HandRange::full();
+
+    auto t0 = Clock::now();
+    EquityResult flop = RangeEquity::compute(full, full, cards({"Jc", "8h", "3s"}));
+    double flop_ms = ms_since(t0);
+
+    t0 = Clock::now();
+    EquityResult preflop = RangeEquity::compute(full, full, CardSet{}, {}, EquityConfig{10000, 1});
+    double preflop_ms = ms_since(t0);
+
+    std::cout << "Full range vs full range: flop exact (" << flop.runouts << " runouts) " << flop_ms
+              << " ms, preflop " << preflop.runouts << " samples " << preflop_ms << " ms" << std::endl;
+}
@@ -3,8 +3,15 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <random>
 
+#include "poker/CardAbstraction.hpp"
 #include "poker/HandEvaluator.hpp"
+#include "poker/TableEvaluator.hpp"
 
 using namespace quantnet::poker;
 using Catch::Matchers::WithinAbs;
@@ -202,6 +209,45 @@ TEST_CASE("Straight flush ranks correctly", "[hand_eval]") {
     REQUIRE(sw > qd);   // Any straight flush beats quads
 }
 
+TEST_CASE("A six on top of a wheel makes a 6-high straight", "[hand_eval]") {
+    // A-2-3-4-5-6 plus a king must not play as the wheel
+    auto six_wheel = make_hand({"Ac", "2d", "3h", "4s", "5c", "6d", "Kh"});
+    auto six_high = make_hand({"2c", "3d", "4h", "5s", "6c", "Kd", "Qh"});
+    HandValue sw = HandEvaluator::evaluate(six_wheel);
+    HandValue sh = HandEvaluator::evaluate(six_high);
+    REQUIRE(sw.rank() == HandRank::Straight);
+    REQUIRE(sw == sh);
+    REQUIRE(sw > HandEvaluator::evaluate(make_hand({"Ac", "2d", "3h", "4s", "5c", "Kd", "Qh"})));
+    REQUIRE(TableEvaluator::evaluate(six_wheel.data(), 7) == sw);
+
+    // Same for a straight flush
+    auto steel_six = make_hand({"Ah", "2h", "3h", "4h", "5h", "6h", "Kc"});
+    auto six_flush = make_hand({"2h", "3h", "4h", "5h", "6h", "Kc", "Qd"});
+    HandValue ss = HandEvaluator::evaluate(steel_six);
+    REQUIRE(ss.rank() == HandRank::StraightFlush);
+    REQUIRE(ss == HandEvaluator::evaluate(six_flush));
+    REQUIRE(ss > HandEvaluator::evaluate(make_hand({"Ah", "2h", "3h", "4h", "5h", "Kc", "Qd"})));
+    REQUIRE(TableEvaluator::evaluate(steel_six.data(), 7) == ss);
+}
+
+TEST_CASE("Quads kicker is the highest remaining card", "[hand_eval]") {
+    // A pair below the kicker must not play
+    auto kicker_over_pair = make_hand({"9h", "9c", "9d", "9s", "Kh", "2c", "2d"});
+    auto kicker_only = make_hand({"9h", "9c", "9d", "9s", "Kh"});
+
+    HandValue v = HandEvaluator::evaluate(kicker_over_pair);
+    REQUIRE(v.rank() == HandRank::FourOfAKind);
+    REQUIRE(v == HandEvaluator::evaluate(kicker_only));
+}
+
+TEST_CASE("Two pair kicker compares the third pair with singles", "[hand_eval]") {
+    // K-K-Q-Q with 3-3 and a 9: the 9 plays, not the 3
+    auto three_pairs = make_hand({"Kh", "Kc", "Qd", "Qs", "3h", "3c", "9d"});
+    auto nine_kicker = make_hand({"Kh", "Kc", "Qd", "Qs", "9d"});
+
+    REQUIRE(HandEvaluator::evaluate(three_pairs) == HandEvaluator::evaluate(nine_kicker));
+}
+
 TEST_CASE("7-card evaluation finds best hand", "[hand_eval]") {
     // 7 cards with flush possible
     auto seven_with_flush = make_hand({
@@ -273,3 +319,507 @@ TEST_CASE("Hand rank to string works", "[hand_eval]") {
     REQUIRE(hand_rank_to_string(HandRank::TwoPair) == "Two Pair");
     REQUIRE(hand_rank_to_string(HandRank::StraightFlush) == "Straight Flush");
 }
+
+namespace {
+
+// n distinct random cards
+std::vector<int> random_cards(std::mt19937& rng, int n) {
+    std::array<int, DECK_SIZE> deck;
+    for (int c = 0; c < DECK_SIZE; ++c) deck[c] = c;
+    for (int i = 0; i < n; ++i) {
+        std::uniform_int_distribution<int> pick(i, DECK_SIZE - 1);
+        std::swap(deck[i], deck[pick(rng)]);
+    }
+    return std::vector<int>(deck.begin(), deck.begin() + n);
+}
+
+} // namespace
+
+TEST_CASE("Table evaluator matches the scalar evaluator", "[hand_eval][table_eval]") {
+    std::mt19937 rng(2024);
+    for (int n = 5; n <= 7; ++n) {
+        for (int i = 0; i < 200000; ++i) {
+            auto cards = random_cards(rng, n);
+            HandValue expected = HandEvaluator::evaluate(cards);
+            HandValue actual = TableEvaluator::evaluate(cards.data(), n);
+            if (actual != expected) {
+                std::string hand;
+                for (int c : cards) hand += card_to_string(c) + " ";
+                FAIL("Mismatch on " << hand << ": " << actual.value << " vs " << expected.value);
+            }
+        }
+    }
+}
+
+TEST_CASE("Table evaluator matches on every flush", "[hand_eval][table_eval]") {
+    // Every 5-7 card rank set in one suit, with off-suit filler
+    for (uint32_t mask = 0; mask < (1u << NUM_RANKS); ++mask) {
+        const int n = std::popcount(mask);
+        if (n < 5 || n > 7) continue;
+
+        std::vector<int> cards;
+        for (int r = 0; r < NUM_RANKS; ++r) {
+            if (mask & (1u << r)) cards.push_back(make_card(r, 2));
+        }
+        REQUIRE(TableEvaluator::evaluate(cards.data(), n) == HandEvaluator::evaluate(cards));
+
+        // Two more cards of other suits when room is left
+        if (n == 5) {
+            cards.push_back(make_card(12, 0));
+            cards.push_back(make_card(12, 1));
+            REQUIRE(TableEvaluator::evaluate(cards.data(), 7) == HandEvaluator::evaluate(cards));
+        }
+    }
+}
+
+TEST_CASE("Table evaluator array overloads", "[hand_eval][table_eval]") {
+    std::array<int, 2> hole = {make_card_from_string("Ah"), make_card_from_string("Kh")};
+    std::array<int, 5> board = {
+        make_card_from_string("Qh"), make_card_from_string("Jh"),
+        make_card_from_string("Th"), make_card_from_string("2c"), make_card_from_string("2d")
+    };
+    std::array<int, 7> all = {hole[0], hole[1], board[0], board[1], board[2], board[3], board[4]};
+
+    REQUIRE(TableEvaluator::evaluate(hole, board).rank() == HandRank::StraightFlush);
+    REQUIRE(TableEvaluator::evaluate(all) == HandEvaluator::evaluate(all));
+}
+
+TEST_CASE("CardSet set operations", "[hand_eval][card_set]") {
+    auto hand = make_hand({"Ah", "Kd", "2c"});
+    CardSet s = CardSet::of(hand);
+
+    REQUIRE(s.size() == 3);
+    REQUIRE(s.contains(make_card_from_string("Ah")));
+    REQUIRE_FALSE(s.contains(make_card_from_string("As")));
+    REQUIRE(s.lowest() == make_card_from_string("2c"));
+
+    CardSet other = CardSet::of(make_hand({"Ah", "Qs"}));
+    REQUIRE((s | other).size() == 4);
+    REQUIRE((s & other) == CardSet::single(make_card_from_string("Ah")));
+    REQUIRE((s - other).size() == 2);
+    REQUIRE(s.intersects(other));
+    REQUIRE((~s).size() == DECK_SIZE - 3);
+    REQUIRE_FALSE((~s).intersects(s));
+    REQUIRE(CardSet::full_deck().size() == DECK_SIZE);
+    REQUIRE((~CardSet::full_deck()).empty());
+
+    s.erase(make_card_from_string("Kd"));
+    s.insert(make_card_from_string("Ts"));
+    REQUIRE(s.size() == 3);
+
+    // Ascending iteration
+    std::vector<int> cards(s.begin(), s.end());
+    std::vector<int> expected = make_hand({"2c", "Ah", "Ts"});
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(cards == expected);
+
+    int buffer[DECK_SIZE];
+    REQUIRE(s.to_cards(buffer) == 3);
+    REQUIRE(std::vector<int>(buffer, buffer + 3) == expected);
+}
+
+TEST_CASE("Card-set evaluation matches vector evaluation", "[hand_eval][card_set]") {
+    std::mt19937 rng(59);
+    for (int n = 5; n <= 9; ++n) {
+        for (int i = 0; i < 2000; ++i) {
+            auto cards = random_cards(rng, n);
+            REQUIRE(HandEvaluator::evaluate(CardSet::of(cards)) == HandEvaluator::evaluate(cards));
+        }
+    }
+    REQUIRE_THROWS_AS(HandEvaluator::evaluate(CardSet::of(make_hand({"Ah", "Kh"}))),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Card-set hand strength matches and filters dead cards", "[hand_eval][card_set]") {
+    std::array<int, 2> kings = {make_card_from_string("Kh"), make_card_from_string("Ks")};
+    std::vector<int> board = make_hand({"Qd", "9c", "5s", "3h", "2d"});
+    CardSet hole_set = CardSet::of(kings);
+    CardSet board_set = CardSet::of(board);
+
+    double hs = HandEvaluator::hand_strength(kings, board);
+    REQUIRE(HandEvaluator::hand_strength(hole_set, board_set) == hs);
+
+    // Dead cards never reach the opponent: with every card but two dead the
+    // opponent holds exactly those two
+    auto only = [&](std::initializer_list<std::string> cards) {
+        return ~(hole_set | board_set | CardSet::of(make_hand(cards)));
+    };
+    REQUIRE(HandEvaluator::hand_strength(hole_set, board_set, only({"7c", "8c"})) == 1.0);
+    REQUIRE(HandEvaluator::hand_strength(hole_set, board_set, only({"Ac", "Ad"})) == 0.0);
+    REQUIRE(HandEvaluator::hand_strength(hole_set, board_set, only({"Kc", "Kd"})) == 0.5);
+}
+
+TEST_CASE("Card-set bucketing matches vector bucketing", "[hand_eval][card_set]") {
+    std::array<int, 2> hole = {make_card_from_string("Ah"), make_card_from_string("Jd")};
+    std::vector<int> board = make_hand({"Jc", "8h", "4s", "Td", "2h"});
+
+    for (const std::string name : {"null", "percentile", "ehs", "emd"}) {
+        auto abstraction = create_abstraction(name, 10, 10, 10, 10);
+        INFO(name);
+        REQUIRE(abstraction->get_bucket(hole, board, BettingRound::River) ==
+                abstraction->get_bucket(CardSet::of(hole), CardSet::of(board), BettingRound::River));
+
+        REQUIRE(abstraction->get_bucket(hole, {board[0], board[1], board[2]}, BettingRound::Flop) ==
+                abstraction->get_bucket(CardSet::of(hole), CardSet::of(std::span(board).first(3)),
+                                        BettingRound::Flop));
+        REQUIRE(abstraction->get_bucket(hole, {}, BettingRound::Preflop) ==
+                abstraction->get_bucket(CardSet::of(hole), CardSet{}, BettingRound::Preflop));
+    }
+}
+
+TEST_CASE("Batch evaluation matches the scalar evaluator", "[hand_eval][table_eval]") {
+    using Isa = TableEvaluator::BatchIsa;
+    std::mt19937 rng(60);
+
+    // Random boards plus a monotone one, where most lanes hold a flush
+    std::vector<std::vector<int>> boards;
+    for (int size = 3; size <= 5; ++size) {
+        for (int i = 0; i < 20; ++i) boards.push_back(random_cards(rng, size));
+    }
+    boards.push_back(make_hand({"Ah", "9h", "6h", "2h"}));
+
+    for (const auto& board : boards) {
+        // Every live hole pair, in an order that is not a multiple of the
+        // vector width
+        CardSet live = ~CardSet::of(board);
+        std::vector<TableEvaluator::HolePair> holes;
+        for (int c1 : live) {
+            for (int c2 : live) {
+                if (c1 < c2) holes.push_back({c2, c1});
+            }
+        }
+        std::shuffle(holes.begin(), holes.end(), rng);
+        holes.resize(holes.size() - 3);
+
+        std::vector<HandValue> expected(holes.size());
+        for (size_t i = 0; i < holes.size(); ++i) {
+            std::vector<int> cards = board;
+            cards.push_back(holes[i][0]);
+            cards.push_back(holes[i][1]);
+            expected[i] = HandEvaluator::evaluate(cards);
+        }
+
+        for (Isa isa : {Isa::Portable, Isa::Avx2, Isa::Avx512}) {
+            if (!TableEvaluator::batch_isa_supported(isa)) continue;
+            INFO(TableEvaluator::batch_isa_name(isa) << ", board size " << board.size());
+            std::vector<HandValue> out(holes.size());
+            TableEvaluator::evaluate_batch(board, holes, out, isa);
+            REQUIRE(out == expected);
+        }
+    }
+}
+
+TEST_CASE("Partial hands extend incrementally", "[hand_eval][table_eval]") {
+    std::mt19937 rng(61);
+    for (int i = 0; i < 1000; ++i) {
+        auto cards = random_cards(rng, 7);
+        auto flop = TableEvaluator::partial(std::span(cards).first(3));
+        auto turn = TableEvaluator::add(flop, cards[3]);
+
+        auto with_hole = TableEvaluator::add(TableEvaluator::add(flop, cards[5]), cards[6]);
+        REQUIRE(with_hole.size == 5);
+        REQUIRE(TableEvaluator::evaluate(with_hole) ==
+                HandEvaluator::evaluate(std::vector<int>{cards[0], cards[1], cards[2], cards[5], cards[6]}));
+
+        auto river = TableEvaluator::add(turn, cards[4]);
+        auto seven = TableEvaluator::add(TableEvaluator::add(river, cards[5]), cards[6]);
+        REQUIRE(TableEvaluator::evaluate(seven) == HandEvaluator::evaluate(cards));
+    }
+}
+
+TEST_CASE("All-hands strength matches hand_strength per hand", "[hand_eval][card_set]") {
+    std::mt19937 rng(611);
+    for (int board_size = 3; board_size <= 5; ++board_size) {
+        for (int trial = 0; trial < 2; ++trial) {
+            auto cards = random_cards(rng, board_size + 2);
+            CardSet board = CardSet::of(std::span(cards).first(board_size));
+            CardSet dead = (trial == 1) ? CardSet::of(std::span(cards).last(2)) : CardSet{};
+
+            auto strengths = HandEvaluator::hand_strengths(board, dead);
+            int live = 0;
+            for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+                const auto [c1, c2] = hole_combos()[i];
+                REQUIRE(hole_combo_index(c1, c2) == i);
+                CardSet hole = CardSet::of(hole_combos()[i]);
+                if (hole.intersects(board | dead)) {
+                    REQUIRE(strengths[i] == -1.0);
+                    continue;
+                }
+                ++live;
+                REQUIRE(strengths[i] == HandEvaluator::hand_strength(hole, board, dead));
+            }
+            REQUIRE(live == (DECK_SIZE - (board | dead).size()) * (DECK_SIZE - (board | dead).size() - 1) / 2);
+        }
+    }
+}
+
+TEST_CASE("Exact hand potential matches brute force", "[hand_eval][potential]") {
+    std::array<int, 2> hole = {make_card_from_string("Ah"), make_card_from_string("Th")};
+    std::vector<int> board = make_hand({"Kh", "9h", "4c", "2d"});
+    CardSet hole_set = CardSet::of(hole);
+    CardSet board_set = CardSet::of(board);
+
+    // Reference: every opponent hole and river card with the scalar evaluator
+    auto outcome = [](HandValue ours, HandValue theirs) {
+        return ours > theirs ? 0 : ours == theirs ? 1 : 2;
+    };
+    double hp[3][3] = {};
+    double total[3] = {};
+    std::vector<int> live;
+    for (int c : ~(hole_set | board_set)) live.push_back(c);
+    for (size_t i = 0; i < live.size(); ++i) {
+        for (size_t j = i + 1; j < live.size(); ++j) {
+            std::vector<int> ours = {hole[0], hole[1]};
+            std::vector<int> theirs = {live[i], live[j]};
+            ours.insert(ours.end(), board.begin(), board.end());
+            theirs.insert(theirs.end(), board.begin(), board.end());
+            int now = outcome(HandEvaluator::evaluate(ours), HandEvaluator::evaluate(theirs));
+            for (int river : live) {
+                if (river == live[i] || river == live[j]) continue;
+                ours.push_back(river);
+                theirs.push_back(river);
+                ++hp[now][outcome(HandEvaluator::evaluate(ours), HandEvaluator::evaluate(theirs))];
+                ++total[now];
+                ours.pop_back();
+                theirs.pop_back();
+            }
+        }
+    }
+    double ppot = (hp[2][0] + hp[2][1] / 2 + hp[1][0] / 2) / (total[2] + total[1] / 2);
+    double npot = (hp[0][2] + hp[0][1] / 2 + hp[1][2] / 2) / (total[0] + total[1] / 2);
+
+    auto [exact_ppot, exact_npot] = HandEvaluator::hand_potential(hole_set, board_set);
+    REQUIRE_THAT(exact_ppot, WithinAbs(ppot, 1e-12));
+    REQUIRE_THAT(exact_npot, WithinAbs(npot, 1e-12));
+
+    // The vector overload is the same computation
+    auto [vec_ppot, vec_npot] = HandEvaluator::hand_potential(hole, board);
+    REQUIRE(vec_ppot == exact_ppot);
+    REQUIRE(vec_npot == exact_npot);
+
+    // No cards to come, no potential
+    std::vector<int> river_board = board;
+    river_board.push_back(make_card_from_string("3s"));
+    REQUIRE(HandEvaluator::hand_potential(hole, river_board) == std::pair<double, double>{0.0, 0.0});
+}
+
+TEST_CASE("Sampled hand potential is reproducible and converges", "[hand_eval][potential]") {
+    CardSet hole = CardSet::of(make_hand({"9s", "8s"}));
+    CardSet flop = CardSet::of(make_hand({"Ts", "7d", "2s"}));
+
+    PotentialConfig sampled{200000, 42};
+    auto a = HandEvaluator::hand_potential(hole, flop, {}, sampled);
+    auto b = HandEvaluator::hand_potential(hole, flop, {}, sampled);
+    REQUIRE(a == b);
+
+    PotentialConfig other_seed{200000, 43};
+    REQUIRE(HandEvaluator::hand_potential(hole, flop, {}, other_seed) != a);
+
+    auto exact = HandEvaluator::hand_potential(hole, flop);
+    REQUIRE_THAT(a.first, WithinAbs(exact.first, 0.01));
+    REQUIRE_THAT(a.second, WithinAbs(exact.second, 0.01));
+
+    // A straight and flush draw behind most hands improves often
+    REQUIRE(exact.first > 0.3);
+
+    // Exact mode needs a flop
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(hole, CardSet{}, {}, PotentialConfig{}),
+                      std::invalid_argument);
+
+    // Two hole cards, disjoint from the board and dead cards
+    const CardSet three = hole | CardSet::of(make_hand({"Ah"}));
+    const CardSet dead = CardSet::of(make_hand({"Ah"}));
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(three, flop, {}, sampled), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(CardSet::of(make_hand({"9s"})), flop), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(hole, flop, hole), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(hole, flop | dead, dead), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandEvaluator::hand_potential(CardSet::of(make_hand({"Ts", "8s"})), flop),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Preflop hand potential", "[hand_eval][potential]") {
+    // Before the flop everyone counts as tied, so ppot / npot are the chances
+    // of winning / losing at showdown
+    auto aces = HandEvaluator::hand_potential(CardSet::of(make_hand({"Ac", "Ad"})), CardSet{});
+    auto junk = HandEvaluator::hand_potential(CardSet::of(make_hand({"7c", "2d"})), CardSet{});
+    REQUIRE(aces.first > 0.8);
+    REQUIRE(aces.second < 0.2);
+    REQUIRE(junk.first < junk.second);
+
+    // Deterministic by default
+    REQUIRE(HandEvaluator::hand_potential(CardSet::of(make_hand({"7c", "2d"})), CardSet{}) == junk);
+}
+
+TEST_CASE("Batch evaluation rejects bad arguments", "[hand_eval][table_eval]") {
+    std::vector<TableEvaluator::HolePair> holes = {{0, 1}, {2, 3}};
+    std::vector<HandValue> out(2);
+    std::vector<HandValue> short_out(1);
+
+    REQUIRE_THROWS_AS(TableEvaluator::evaluate_batch(make_hand({"Ah", "Kh"}), holes, out),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(TableEvaluator::evaluate_batch(make_hand({"Ah", "Kh", "Qh"}), holes, short_out),
+                      std::invalid_argument);
+
+    // Cards off the deck, repeated, or shared between a hole and the board
+    const std::vector<int> board = make_hand({"Ah", "Kh", "Qh"});
+    const std::vector<int> repeated_board = make_hand({"Ah", "Kh", "Ah"});
+    const std::vector<int> off_board = {0, 1, DECK_SIZE};
+    REQUIRE_THROWS_AS(TableEvaluator::evaluate_batch(repeated_board, holes, out), std::invalid_argument);
+    REQUIRE_THROWS_AS(TableEvaluator::evaluate_batch(off_board, holes, out), std::invalid_argument);
+    for (const TableEvaluator::HolePair& bad : std::vector<TableEvaluator::HolePair>{
+             {0, DECK_SIZE}, {-1, 0}, {4, 4}, {0, board[1]}}) {
+        const std::vector<TableEvaluator::HolePair> one = {bad};
+        REQUIRE_THROWS_AS(TableEvaluator::evaluate_batch(board, one, out), std::invalid_argument);
+    }
+    REQUIRE_NOTHROW(TableEvaluator::evaluate_batch(board, holes, out));
+    REQUIRE(TableEvaluator::batch_isa_supported(TableEvaluator::BatchIsa::Portable));
+}
+
+// Evaluation throughput, table vs scalar (benchmark, not a test)
+TEST_CASE("Hand evaluation throughput", "[hand_eval][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+
+    std::mt19937 rng(7);
+    const int num_hands = 1 << 20;
+    std::vector<std::array<int, 7>> hands(num_hands);
+    for (auto& h : hands) {
+        auto cards = random_cards(rng, 7);
+        std::copy(cards.begin(), cards.end(), h.begin());
+    }
+    TableEvaluator::init();
+
+    auto evals_per_sec = [&](auto&& eval, int passes) {
+        uint64_t sink = 0;
+        auto t0 = Clock::now();
+        for (int p = 0; p < passes; ++p) {
+            for (const auto& h : hands) sink += eval(h).value;
+        }
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (sink == 0) std::cout << sink;  // Keep the evaluations alive
+        return static_cast<double>(num_hands) * passes / secs;
+    };
+
+    double scalar = evals_per_sec([](const auto& h) { return HandEvaluator::evaluate(h); }, 1);
+    double table = evals_per_sec([](const auto& h) { return TableEvaluator::evaluate(h); }, 10);
+
+    std::cout << "7-card evaluations/s: scalar " << scalar / 1e6 << "M, table "
+              << table / 1e6 << "M (" << table / scalar << "x)" << std::endl;
+}
+
+// Board-shared batch throughput per instruction set (benchmark, not a test)
+TEST_CASE("Batch evaluation throughput", "[hand_eval][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    using Isa = TableEvaluator::BatchIsa;
+
+    std::mt19937 rng(8);
+    std::vector<std::vector<int>> boards;
+    for (int i = 0; i < 64; ++i) boards.push_back(random_cards(rng, 5));
+
+    // The hole pairs live on each board (duplicate cards are not valid input)
+    std::vector<std::vector<TableEvaluator::HolePair>> holes(boards.size());
+    size_t num_hands = 0;
+    for (size_t b = 0; b < boards.size(); ++b) {
+        CardSet board = CardSet::of(boards[b]);
+        for (const auto& combo : hole_combos()) {
+            if (!CardSet::of(combo).intersects(board)) holes[b].push_back(combo);
+        }
+        num_hands += holes[b].size();
+    }
+    std::vector<HandValue> out(NUM_HOLE_COMBOS);
+    TableEvaluator::init();
+
+    auto evals_per_sec = [&](auto&& run_board) {
+        uint64_t sink = 0;
+        const int passes = 200;
+        auto t0 = Clock::now();
+        for (int p = 0; p < passes; ++p) {
+            for (size_t b = 0; b < boards.size(); ++b) {
+                run_board(boards[b], holes[b]);
+                sink += out[p % holes[b].size()].value;
+            }
+        }
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (sink == 0) std::cout << sink;  // Keep the evaluations alive
+        return static_cast<double>(num_hands) * passes / secs;
+    };
+
+    using Holes = std::vector<TableEvaluator::HolePair>;
+    double single = evals_per_sec([&](const std::vector<int>& board, const Holes& live) {
+        std::array<int, 7> cards = {0, 0, board[0], board[1], board[2], board[3], board[4]};
+        for (size_t i = 0; i < live.size(); ++i) {
+            cards[0] = live[i][0];
+            cards[1] = live[i][1];
+            out[i] = TableEvaluator::evaluate(cards);
+        }
+    });
+    std::cout << "7-card evaluations/s, one at a time: " << single / 1e6 << "M" << std::endl;
+
+    for (Isa isa : {Isa::Portable, Isa::Avx2, Isa::Avx512}) {
+        if (!TableEvaluator::batch_isa_supported(isa)) continue;
+        double batch = evals_per_sec([&](const std::vector<int>& board, const Holes& live) {
+            TableEvaluator::evaluate_batch(board, live, out, isa);
+        });
+        std::cout << "7-card evaluations/s, batch " << TableEvaluator::batch_isa_name(isa) << ": "
+                  << batch / 1e6 << "M (" << batch / single << "x)" << std::endl;
+    }
+}
+
+// All-hands strength vs one hand_strength call per hand (benchmark, not a test)
+TEST_CASE("All-hands strength throughput", "[hand_eval][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+
+    std::mt19937 rng(9);
+    CardSet board = CardSet::of(random_cards(rng, 5));
+    TableEvaluator::init();
+
+    auto t0 = Clock::now();
+    double sum_per_hand = 0.0;
+    for (const auto& combo : hole_combos()) {
+        CardSet hole = CardSet::of(combo);
+        if (!hole.intersects(board)) sum_per_hand += HandEvaluator::hand_strength(hole, board);
+    }
+    double per_hand_ms = ms_since(t0);
+
+    t0 = Clock::now();
+    const int reps = 100;
+    double sum_all = 0.0;
+    for (int r = 0; r < reps; ++r) {
+        for (double hs : HandEvaluator::hand_strengths(board)) sum_all += std::max(hs, 0.0);
+    }
+    double all_ms = ms_since(t0) / reps;
+
+    std::cout << "River strengths of all 1081 hands: per hand " << per_hand_ms << " ms, all at once "
+              << all_ms << " ms (" << per_hand_ms / all_ms << "x)" << std::endl;
+    if (sum_all + sum_per_hand < 0) std::cout << sum_all;  // Keep both loops alive
+}
+
+// Exact and sampled hand potential timings (benchmark, not a test)
+TEST_CASE("Hand potential throughput", "[hand_eval][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+
+    CardSet hole = CardSet::of(make_hand({"Qs", "Js"}));
+    std::vector<int> board = make_hand({"Ts", "7d", "2s", "Kh"});
+    TableEvaluator::init();
+
+    auto t0 = Clock::now();
+    auto flop = HandEvaluator::hand_potential(hole, CardSet::of(std::span(board).first(3)));
+    double flop_ms = ms_since(t0);
+
+    t0 = Clock::now();
+    auto turn = HandEvaluator::hand_potential(hole, CardSet::of(board));
+    double turn_ms = ms_since(t0);
+
+    t0 = Clock::now();
+    auto preflop = HandEvaluator::hand_potential(hole, CardSet{}, {}, PotentialConfig{1000000, 1});
+    double preflop_ms = ms_since(t0);
+
+    std::cout << "Exact hand potential: flop " << flop_ms << " ms, turn " << turn_ms
+              << " ms; preflop 1M samples " << preflop_ms << " ms" << std::endl;
+    if (flop.first + turn.first + preflop.first < 0) std::cout << flop.first;
+}
@@ -0,0 +1,255 @@
+// Tests for hand-history ingestion
+// Verifies that ingesting a log leaves the OpponentModel exactly as
+// observing its lines one by one does, for any chunk size, and that
+// malformed logs are rejected with their line number
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "exploit/HandHistory.hpp"
+
+using namespace quantnet;
+using namespace quantnet::exploit;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// A log of random actions at num_info_sets info sets per player
+std::string random_log(int lines, int num_info_sets, uint32_t seed) {
+    static const char* actions[] = {"fold", "check", "call", "bet", "raise", "f", "c", "k", "b", "r"};
+    std::mt19937 rng(seed);
+    std::ostringstream out;
+    out << "# generated\n";
+    for (int i = 0; i < lines; ++i) {
+        const int player = static_cast<int>(rng() % 2);
+        if (rng() % 10 == 0) {
+            out << "result " << player << " " << rng() % 2 << " " << rng() % 2 << " " << rng() % 40 << ".5\n";
+        } else {
+            out << player << (rng() % 2 ? "\t" : " ") << "P" << player << ":" << rng() % num_info_sets
+                << ":b " << actions[rng() % 10] << (rng() % 8 == 0 ? "\r\n" : "\n");
+        }
+        if (rng() % 50 == 0) out << "\n";
+    }
+    out << "1 P1:0:b call";           // No trailing newline
+    return out.str();
+}
+
+// The same log fed through observe_action / observe_hand_result
+OpponentModel observe_lines(const std::string& log) {
+    OpponentModel model;
+    std::istringstream in(log);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') continue;
+        if (first == "result") {
+            int player, won, showdown;
+            double pot;
+            fields >> player >> won >> showdown >> pot;
+            model.observe_hand_result(player, won == 1, showdown == 1, pot);
+        } else {
+            std::string info_set, action;
+            fields >> info_set >> action;
+            model.observe_action(std::stoi(first), info_set, *parse_action(action));
+        }
+    }
+    return model;
+}
+
+void require_same(const OpponentModel& a, const OpponentModel& b) {
+    REQUIRE(a.num_handles() == b.num_handles());
+    for (StatsHandle h = 0; h < a.num_handles(); ++h) {
+        REQUIRE(a.handle_player(h) == b.handle_player(h));
+        REQUIRE(a.handle_info_set(h) == b.handle_info_set(h));
+        const ActionStats& sa = a.get_stats(h);
+        const ActionStats& sb = b.get_stats(h);
+        REQUIRE(sa.fold_count == sb.fold_count);
+        REQUIRE(sa.call_count == sb.call_count);
+        REQUIRE(sa.raise_count == sb.raise_count);
+        REQUIRE(sa.total_observations == sb.total_observations);
+    }
+    for (poker::PlayerId p : {0, 1}) {
+        const TendencyProfile pa = a.get_profile(p);
+        const TendencyProfile pb = b.get_profile(p);
+        REQUIRE(pa.total_hands == pb.total_hands);
+        REQUIRE(pa.vpip == pb.vpip);
+        REQUIRE(pa.pfr == pb.pfr);
+        REQUIRE(pa.aggression == pb.aggression);
+        REQUIRE(pa.went_to_showdown == pb.went_to_showdown);
+        REQUIRE(pa.won_at_showdown == pb.won_at_showdown);
+        REQUIRE(a.total_observations(p) == b.total_observations(p));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Actions parse from names and letters", "[hand_history]") {
+    REQUIRE(parse_action("fold") == poker::Action::Fold);
+    REQUIRE(parse_action("check") == poker::Action::Check);
+    REQUIRE(parse_action("call") == poker::Action::Call);
+    REQUIRE(parse_action("bet") == poker::Action::Bet);
+    REQUIRE(parse_action("raise") == poker::Action::Raise);
+    for (poker::Action a : {poker::Action::Check, poker::Action::Bet, poker::Action::Call,
+                            poker::Action::Fold, poker::Action::Raise}) {
+        REQUIRE(parse_action(std::string(1, poker::action_to_char(a))) == a);
+        REQUIRE(poker::char_to_action(poker::action_to_char(a)) == a);
+        REQUIRE(parse_action(poker::action_to_string(a)) == a);
+    }
+    REQUIRE_FALSE(parse_action("allin"));
+    REQUIRE_FALSE(parse_action("x"));
+    REQUIRE_FALSE(poker::char_to_action('?'));
+    REQUIRE_FALSE(parse_action(""));
+}
+
+TEST_CASE("Enum and string observations agree", "[hand_history]") {
+    OpponentModel by_string;
+    OpponentModel by_enum;
+    OpponentModel by_handle;
+    const StatsHandle handle = by_handle.intern(0, "P0:K:");
+    for (const char* action : {"fold", "check", "call", "bet", "raise", "bet"}) {
+        by_string.observe_action(0, "P0:K:", action);
+        by_enum.observe_action(0, "P0:K:", *parse_action(action));
+        by_handle.observe_action(handle, *parse_action(action));
+    }
+    by_string.observe_hand_result(0, true, true, 4.0);
+    by_enum.observe_hand_result(0, true, true, 4.0);
+    by_handle.observe_hand_results(0, 1, 1, 1);
+    require_same(by_string, by_enum);
+    require_same(by_string, by_handle);
+    REQUIRE(by_handle.intern(0, "P0:K:") == handle);
+    REQUIRE(by_handle.intern(1, "P0:K:") != handle);
+    REQUIRE(by_handle.get_stats(0, "P0:K:").raise_count == 3);
+    REQUIRE(by_handle.get_stats(1, "P0:Q:").total_observations == 0);
+
+    // A copy owns its ids: it reads the same after its source is gone
+    OpponentModel copy;
+    {
+        const OpponentModel source = by_handle;
+        copy = source;
+    }
+    REQUIRE(copy.handle_info_set(handle) == "P0:K:");
+    REQUIRE(copy.get_stats(0, "P0:K:").raise_count == 3);
+}
+
+TEST_CASE("Ingestion matches line-by-line observation", "[hand_history]") {
+    const std::string log = random_log(5000, 40, 74);
+    const OpponentModel expected = observe_lines(log);
+
+    for (size_t chunk : {size_t{1}, size_t{7}, size_t{100}, size_t{4096}, size_t{1} << 20}) {
+        OpponentModel model;
+        const IngestStats stats = ingest_hand_history_text(log, model, {chunk});
+        require_same(model, expected);
+        REQUIRE(stats.bytes == log.size());
+        REQUIRE(stats.actions + stats.results ==
+                static_cast<uint64_t>(expected.total_observations(0) + expected.total_observations(1) +
+                                      expected.get_profile(0).total_hands + expected.get_profile(1).total_hands));
+        REQUIRE(stats.info_sets == model.num_handles());
+    }
+
+    // Ingesting into a model with data adds to it
+    OpponentModel twice = observe_lines(log);
+    ingest_hand_history_text(log, twice);
+    REQUIRE(twice.total_observations(0) == 2 * expected.total_observations(0));
+    REQUIRE(twice.num_handles() == expected.num_handles());
+}
+
+TEST_CASE("Ingestion reads log files", "[hand_history]") {
+    const std::string path = temp_path("qn_hand_history.log");
+    const std::string log = random_log(2000, 10, 75);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << log;
+    }
+    OpponentModel model;
+    ingest_hand_history(path, model, {512});
+    require_same(model, observe_lines(log));
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(ingest_hand_history(path, model), std::runtime_error);
+    REQUIRE_THROWS_AS(ingest_hand_history_text(log, model, {0}), std::invalid_argument);
+
+    // An empty file is an empty log
+    { std::ofstream out(path); }
+    OpponentModel empty;
+    REQUIRE(ingest_hand_history(path, empty).lines == 0);
+    REQUIRE(empty.num_handles() == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Malformed logs are rejected with the first bad line", "[hand_history]") {
+    const std::string good = "0 P0:K: bet\n1 P1:Q:b call\n# comment\n\nresult 0 1 1 4\n";
+    for (size_t chunk : {size_t{1}, size_t{16}, size_t{4096}}) {
+        OpponentModel model;
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "0 P0:J: allin\n0 P0:J:\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6: unknown action 'allin'"));
+        REQUIRE(model.num_handles() == 0);
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "x P0:J: bet\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "0 P0:J:\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "0 P0:J: bet extra\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "result 0 2 1 4\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "result 0 1 1\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE_THROWS_WITH(ingest_hand_history_text(good + "-1 P0:J: bet\n", model, {chunk}, "log"),
+                            Catch::Matchers::StartsWith("log:6:"));
+        REQUIRE(model.num_handles() == 0);
+    }
+}
+
+// Ingestion throughput against observe_action per line (benchmark, not a
+// test; writes a log of about 200 MB)
+TEST_CASE("Hand history ingestion throughput", "[hand_history][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    const std::string path = temp_path("qn_hand_history_bench.log");
+    const int lines = 10'000'000;
+    {
+        std::mt19937 rng(76);
+        std::ofstream out(path, std::ios::binary);
+        static const char* actions[] = {"fold", "call", "bet", "check", "raise"};
+        std::string buffer;
+        for (int i = 0; i < lines; ++i) {
+            const int player = static_cast<int>(rng() % 2);
+            buffer += std::to_string(player) + "\tP" + std::to_string(player) + ":" +
+                      std::to_string(rng() % 5000) + ":cb\t" + actions[rng() % 5] + "\n";
+            if (buffer.size() > (1 << 20)) {
+                out << buffer;
+                buffer.clear();
+            }
+        }
+        out << buffer;
+    }
+
+    OpponentModel model;
+    const IngestStats stats = ingest_hand_history(path, model);
+    std::cout << "Ingested " << stats.actions << " actions (" << stats.bytes / 1e6 << " MB, "
+              << stats.info_sets << " info sets) in " << stats.seconds << " s: "
+              << stats.actions / stats.seconds / 1e6 << "M actions/s" << std::endl;
+
+    // One observe_action per line, as callers did before
+    std::ifstream in(path);
+    std::vector<std::tuple<int, std::string, std::string>> parsed;
+    std::string player, info_set, action;
+    while (parsed.size() < 1'000'000 && in >> player >> info_set >> action) {
+        parsed.emplace_back(std::stoi(player), info_set, action);
+    }
+    OpponentModel reference;
+    const auto t0 = Clock::now();
+    for (const auto& [p, id, a] : parsed) reference.observe_action(p, id, a);
+    const double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::cout << "observe_action (strings already parsed): " << parsed.size() / secs / 1e6 << "M actions/s"
+              << std::endl;
+    std::filesystem::remove(path);
+}
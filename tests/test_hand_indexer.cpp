@@ -0,0 +1,163 @@
+// Tests for the suit-isomorphic hand indexer
+// Verifies the canonical hand counts, that isomorphic hands share an index
+// and that unindex inverts index
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/HandIndexer.hpp"
+
+using namespace quantnet::poker;
+
+namespace {
+
+// Deal the rounds of an indexer from a shuffled deck
+std::vector<CardSet> deal(std::mt19937& rng, const HandIndexer& indexer, int round) {
+    std::vector<int> deck(DECK_SIZE);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    std::vector<CardSet> cards(round + 1);
+    int next = 0;
+    for (int t = 0; t <= round; ++t) {
+        for (int i = 0; i < indexer.cards_in_round(t); ++i) cards[t].insert(deck[next++]);
+    }
+    return cards;
+}
+
+CardSet permute_suits(CardSet cards, const std::array<int, NUM_SUITS>& perm) {
+    CardSet out;
+    for (int c : cards) out.insert(make_card(card_rank(c), perm[card_suit(c)]));
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Canonical hand counts", "[hand_indexer]") {
+    HandIndexer holdem({2, 3, 1, 1});
+    REQUIRE(holdem.size(0) == 169);
+    REQUIRE(holdem.size(1) == 1286792);
+    REQUIRE(holdem.size(2) == 55190538);
+    REQUIRE(holdem.size(3) == 2428287420ULL);
+
+    const HoldemIndexer& unordered = HoldemIndexer::instance();
+    REQUIRE(unordered.size(0) == 169);
+    REQUIRE(unordered.size(3) == 1286792);
+    REQUIRE(unordered.size(4) == 13960050);
+    REQUIRE(unordered.size(5) == 123156254);
+
+    // Boards alone
+    REQUIRE(HandIndexer({3}).size(0) == 1755);
+    REQUIRE(HandIndexer({4}).size(0) == 16432);
+    REQUIRE(HandIndexer({5}).size(0) == 134459);
+
+    REQUIRE_THROWS_AS(HandIndexer({}), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandIndexer({2, 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(HandIndexer({2, 3, 1, 1, 1}), std::invalid_argument);
+}
+
+TEST_CASE("Preflop indices match the 169 canonical hole hands", "[hand_indexer]") {
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    std::map<std::tuple<int, int, bool>, uint64_t> seen;
+    for (const auto& [c1, c2] : hole_combos()) {
+        const uint64_t i = indexer.index(CardSet::of(std::array{c1, c2}), CardSet{});
+        REQUIRE(i < 169);
+        auto canonical = canonicalize_hole_cards(c1, c2);
+        auto [it, inserted] = seen.emplace(canonical, i);
+        REQUIRE(it->second == i);
+    }
+    REQUIRE(seen.size() == 169);
+}
+
+TEST_CASE("Every flop index round-trips", "[hand_indexer]") {
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    for (uint64_t i = 0; i < indexer.size(3); ++i) {
+        auto [hole, board] = indexer.unindex(3, i);
+        REQUIRE(hole.size() == 2);
+        REQUIRE(board.size() == 3);
+        REQUIRE(!hole.intersects(board));
+        if (indexer.index(hole, board) != i) FAIL("index " << i << " does not round-trip");
+    }
+}
+
+TEST_CASE("Isomorphic hands share an index", "[hand_indexer]") {
+    std::mt19937 rng(64);
+    HandIndexer indexer({2, 3, 1, 1});
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+
+    for (int trial = 0; trial < 20000; ++trial) {
+        const int round = trial % 4;
+        auto cards = deal(rng, indexer, round);
+        const uint64_t i = indexer.index(cards);
+        REQUIRE(i < indexer.size(round));
+
+        std::shuffle(perm.begin(), perm.end(), rng);
+        std::vector<CardSet> permuted;
+        for (CardSet c : cards) permuted.push_back(permute_suits(c, perm));
+        REQUIRE(indexer.index(permuted) == i);
+
+        // The canonical hand is isomorphic and indexes back to i
+        auto canonical = indexer.unindex(round, i);
+        REQUIRE(indexer.index(canonical) == i);
+
+        // suit_map carries the hand onto that representative
+        std::array<int, NUM_SUITS> suit_map;
+        REQUIRE(indexer.index(cards, suit_map) == i);
+        for (size_t t = 0; t < cards.size(); ++t) {
+            REQUIRE(permute_suits(cards[t], suit_map) == canonical[t]);
+        }
+    }
+
+    // Swapping clubs and diamonds leaves 2c 2d in the hole, so these flops
+    // are the same situation
+    CardSet hole = CardSet::of(std::array{0, 13});
+    CardSet flop = CardSet::of(std::array{1, 2, 26});
+    CardSet turn = CardSet::single(27);
+    CardSet mirrored_flop = CardSet::of(std::array{14, 15, 26});
+    REQUIRE(indexer.index(std::vector{hole, flop, turn}) ==
+            indexer.index(std::vector{hole, mirrored_flop, turn}));
+
+    // Rounds are ordered: the same cards split differently are different
+    // hands
+    CardSet other_flop = CardSet::of(std::array{1, 2, 27});
+    CardSet other_turn = CardSet::single(26);
+    REQUIRE(indexer.index(std::vector{hole, flop, turn}) !=
+            indexer.index(std::vector{hole, other_flop, other_turn}));
+}
+
+TEST_CASE("Indexer rejects malformed hands", "[hand_indexer]") {
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    CardSet hole = CardSet::of(std::array{0, 1});
+    REQUIRE_THROWS_AS(indexer.index(hole, CardSet::of(std::array{2, 3})), std::invalid_argument);
+    REQUIRE_THROWS_AS(indexer.index(hole, CardSet::of(std::array{1, 2, 3})), std::invalid_argument);
+    REQUIRE_THROWS_AS(indexer.index(CardSet::single(0), CardSet{}), std::invalid_argument);
+    REQUIRE_THROWS_AS(indexer.unindex(3, indexer.size(3)), std::out_of_range);
+}
+
+// Index throughput on random river hands (benchmark, not a test)
+TEST_CASE("Hand indexer throughput", "[hand_indexer][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    const HoldemIndexer& indexer = HoldemIndexer::instance();
+    std::mt19937 rng(65);
+    HandIndexer two_rounds({2, 5});
+
+    std::vector<std::pair<CardSet, CardSet>> hands;
+    for (int i = 0; i < 100000; ++i) {
+        auto cards = deal(rng, two_rounds, 1);
+        hands.emplace_back(cards[0], cards[1]);
+    }
+
+    uint64_t sink = 0;
+    auto t0 = Clock::now();
+    for (int pass = 0; pass < 10; ++pass) {
+        for (const auto& [hole, board] : hands) sink += indexer.index(hole, board);
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::cout << "River hand indices/s: " << hands.size() * 10 / secs / 1e6 << "M" << std::endl;
+    if (sink == 0) std::cout << sink;
+}
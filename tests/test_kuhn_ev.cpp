@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "poker/KuhnPoker.hpp"
+#include "poker/LeducPoker.hpp"
 #include "poker/Strategy.hpp"
 #include "poker/ExpectedValue.hpp"
 #include "poker/QRE.hpp"
@@ -216,3 +217,31 @@ TEST_CASE("Higher beta increases strategy sharpness", "[kuhn][qre]") {
     // Higher beta should give lower entropy (sharper distribution)
     REQUIRE(entropy_high <= entropy_low);
 }
+
+TEST_CASE("Single-pass expected utilities match per-action overrides", "[kuhn][leduc][qre]") {
+    KuhnPoker kuhn;
+    LeducPoker leduc;
+
+    for (const PokerGame* game : {static_cast<const PokerGame*>(&kuhn),
+                                  static_cast<const PokerGame*>(&leduc)}) {
+        InfoSetIndex index;
+        index.build(game->get_info_sets());
+
+        // Non-uniform strategy so every info set has distinct action values
+        Eigen::VectorXd w(index.total_dim());
+        for (int i = 0; i < w.size(); ++i) {
+            w(i) = std::sin(0.7 * i);
+        }
+        Strategy sigma = Strategy::from_logits(w, index);
+
+        auto all_eu = compute_all_expected_utilities(*game, sigma, index);
+        REQUIRE(static_cast<int>(all_eu.size()) == index.num_info_sets());
+
+        for (const auto& is : index.all_info_sets()) {
+            for (Action a : is.legal_actions) {
+                double expected = expected_utility(game->root(), sigma, is.id, a, is.player);
+                REQUIRE_THAT(all_eu[is.id][a], WithinAbs(expected, 1e-10));
+            }
+        }
+    }
+}
@@ -0,0 +1,249 @@
+// Tests for opponent cluster hand strength (OCHS) features
+// Verifies the opponent clusters, that the batched sweep matches direct
+// evaluation against every opponent, and that OCHSAbstraction builds a flat
+// table that respects suit isomorphism
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/OCHSFeatures.hpp"
+
+using namespace quantnet::poker;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+CardSet random_board(std::mt19937& rng, int cards) {
+    std::vector<int> deck(DECK_SIZE);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    return CardSet::of(std::span(deck.data(), cards));
+}
+
+// Equity of a hand against each cluster on a river board, one opponent at a time
+std::vector<double> direct_ochs(CardSet hole, CardSet board, const OpponentClusters& clusters) {
+    const int k = clusters.size();
+    std::vector<double> score(k, 0.0);
+    std::vector<int> count(k, 0);
+    const HandValue mine = HandEvaluator::evaluate(hole | board);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const CardSet opp = CardSet::of(hole_combos()[i]);
+        if (opp.intersects(hole | board)) continue;
+        const HandValue theirs = HandEvaluator::evaluate(opp | board);
+        const int c = clusters.cluster(i);
+        score[c] += mine > theirs ? 1.0 : mine == theirs ? 0.5 : 0.0;
+        ++count[c];
+    }
+    for (int c = 0; c < k; ++c) score[c] = count[c] == 0 ? 0.5 : score[c] / count[c];
+    return score;
+}
+
+OCHSBuildConfig small_flop_config() {
+    OCHSBuildConfig config;
+    config.samples_per_hand = 4;
+    config.histogram_bins = 4;
+    config.max_iterations = 6;
+    config.max_training_points = 20000;
+    config.seed = 7;
+    config.rounds = {BettingRound::Flop};
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Opponent clusters partition preflop hands by strength", "[ochs]") {
+    const OpponentClusters clusters = OpponentClusters::build(8, 500, 3);
+    REQUIRE(clusters.size() == 8);
+
+    std::set<int> used(clusters.assignments().begin(), clusters.assignments().end());
+    REQUIRE(used.size() == 8);
+
+    // Isomorphic preflop hands share a cluster
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const auto& [a, b] = hole_combos()[i];
+        const int swapped = hole_combo_index(make_card(card_rank(a), (card_suit(a) + 1) % 4),
+                                             make_card(card_rank(b), (card_suit(b) + 1) % 4));
+        REQUIRE(clusters.cluster(i) == clusters.cluster(swapped));
+    }
+
+    // Numbered weakest to strongest
+    REQUIRE(clusters.cluster(hole_combo_index(make_card(12, 0), make_card(12, 1))) == 7);
+    REQUIRE(clusters.cluster(hole_combo_index(make_card(5, 0), make_card(0, 1))) == 0);
+
+    const OpponentClusters again = OpponentClusters::build(8, 500, 3);
+    REQUIRE(again.assignments() == clusters.assignments());
+    REQUIRE_THROWS_AS(OpponentClusters::build(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(OpponentClusters::build(MAX_OPPONENT_CLUSTERS + 1), std::invalid_argument);
+}
+
+TEST_CASE("River OCHS matches direct evaluation", "[ochs]") {
+    const OpponentClusters clusters = OpponentClusters::build(6, 300, 1);
+    std::mt19937 rng(70);
+    std::vector<float> equities(static_cast<size_t>(NUM_HOLE_COMBOS) * 6);
+    for (int trial = 0; trial < 5; ++trial) {
+        const CardSet board = random_board(rng, 5);
+        ochs_equities(board, clusters, 0, 0, 0, equities);
+        for (int i = 0; i < NUM_HOLE_COMBOS; i += 7) {
+            const CardSet hole = CardSet::of(hole_combos()[i]);
+            if (hole.intersects(board)) {
+                for (int c = 0; c < 6; ++c) REQUIRE(equities[static_cast<size_t>(i) * 6 + c] == 0.0f);
+                continue;
+            }
+            const auto expected = direct_ochs(hole, board, clusters);
+            for (int c = 0; c < 6; ++c) {
+                REQUIRE_THAT(equities[static_cast<size_t>(i) * 6 + c], WithinAbs(expected[c], 1e-6));
+            }
+        }
+    }
+
+    // One cluster is plain hand strength
+    const OpponentClusters single = OpponentClusters::build(1, 10, 0);
+    const CardSet board = random_board(rng, 5);
+    std::vector<float> one(NUM_HOLE_COMBOS);
+    ochs_equities(board, single, 0, 0, 0, one);
+    const auto strengths = HandEvaluator::hand_strengths(board);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        if (strengths[i] >= 0.0) REQUIRE_THAT(one[i], WithinAbs(strengths[i], 1e-6));
+    }
+
+    std::vector<float> small(10);
+    REQUIRE_THROWS_AS(ochs_equities(board, clusters, 0, 0, 0, small), std::invalid_argument);
+    REQUIRE_THROWS_AS(ochs_equities(CardSet{}, clusters, 0, 0, 0, equities), std::invalid_argument);
+}
+
+TEST_CASE("Potential-aware OCHS histograms", "[ochs]") {
+    const OpponentClusters clusters = OpponentClusters::build(4, 300, 2);
+    constexpr int k = 4;
+    constexpr int bins = 8;
+    std::mt19937 rng(71);
+    const CardSet turn = random_board(rng, 4);
+
+    std::vector<float> cdfs(static_cast<size_t>(NUM_HOLE_COMBOS) * k * bins);
+    std::vector<float> means(static_cast<size_t>(NUM_HOLE_COMBOS) * k);
+    ochs_histograms(turn, clusters, bins, 0, 0, 0, cdfs);
+    ochs_equities(turn, clusters, 0, 0, 0, means);
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const bool dead = CardSet::of(hole_combos()[i]).intersects(turn);
+        for (int c = 0; c < k; ++c) {
+            const float* cdf = cdfs.data() + (static_cast<size_t>(i) * k + c) * bins;
+            if (dead) {
+                REQUIRE(cdf[bins - 1] == 0.0f);
+                continue;
+            }
+            REQUIRE_THAT(cdf[bins - 1], WithinAbs(1.0, 1e-6));
+            for (int b = 1; b < bins; ++b) REQUIRE(cdf[b] >= cdf[b - 1]);
+
+            // The histogram's mean is within a bin of the average equity
+            double mean = 0.0;
+            for (int b = 0; b < bins; ++b) mean += (b + 0.5) / bins * (cdf[b] - (b > 0 ? cdf[b - 1] : 0.0f));
+            REQUIRE_THAT(mean, WithinAbs(means[static_cast<size_t>(i) * k + c], 1.0 / bins));
+        }
+    }
+
+    // Sampled runouts are reproducible per stream
+    std::vector<float> a(cdfs.size());
+    std::vector<float> b(cdfs.size());
+    const CardSet flop = random_board(rng, 3);
+    ochs_histograms(flop, clusters, bins, 10, 5, 9, a);
+    ochs_histograms(flop, clusters, bins, 10, 5, 9, b);
+    REQUIRE(a == b);
+    REQUIRE_THROWS_AS(ochs_histograms(flop, clusters, 0, 10, 5, 9, a), std::invalid_argument);
+}
+
+TEST_CASE("OCHS abstraction builds a flat flop table", "[ochs]") {
+    OCHSAbstraction abstraction(169, 8, 8, 8, 4);
+    REQUIRE(abstraction.name() == "OCHS");
+    REQUIRE(abstraction.total_buckets() == 169 + 24);
+    REQUIRE(abstraction.clusters(BettingRound::Flop).empty());
+
+    CardSet board = CardSet::of(std::array{make_card(12, 0), make_card(5, 1), make_card(0, 2)});
+    CardSet top_set = CardSet::of(std::array{make_card(12, 1), make_card(12, 2)});
+    CardSet air = CardSet::of(std::array{make_card(1, 3), make_card(6, 3)});
+    REQUIRE(abstraction.get_bucket(top_set, board, BettingRound::Flop) < 8);    // Unbuilt fallback
+
+    // Preflop buckets follow equity ranks: AA first, 72o near the end
+    const CardSet aces = CardSet::of(std::array{make_card(12, 0), make_card(12, 1)});
+    const CardSet seven_deuce = CardSet::of(std::array{make_card(5, 0), make_card(0, 1)});
+    REQUIRE(abstraction.get_bucket(aces, CardSet{}, BettingRound::Preflop) == 0);
+    REQUIRE(abstraction.get_bucket(seven_deuce, CardSet{}, BettingRound::Preflop) > 150);
+    OCHSAbstraction coarse(10, 8, 8, 8, 4);
+    REQUIRE(coarse.get_bucket(aces, CardSet{}, BettingRound::Preflop) !=
+            coarse.get_bucket(seven_deuce, CardSet{}, BettingRound::Preflop));
+
+    REQUIRE(abstraction.build_clusters(small_flop_config()));
+    const auto& table = abstraction.clusters(BettingRound::Flop);
+    REQUIRE(table.size() == HoldemIndexer::instance().size(3));
+    REQUIRE(*std::max_element(table.begin(), table.end()) < 8);
+    REQUIRE(abstraction.clusters(BettingRound::River).empty());
+
+    std::mt19937 rng(72);
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+    for (int trial = 0; trial < 200; ++trial) {
+        const CardSet cards = random_board(rng, 5);
+        std::array<int, 5> c;
+        cards.to_cards(c.data());
+        const CardSet hole = CardSet::of(std::array{c[0], c[1]});
+        const CardSet flop = CardSet::of(std::array{c[2], c[3], c[4]});
+        const BucketId bucket = abstraction.get_bucket(hole, flop, BettingRound::Flop);
+        REQUIRE(bucket == table[HoldemIndexer::instance().index(hole, flop)]);
+
+        std::shuffle(perm.begin(), perm.end(), rng);
+        CardSet p_hole, p_flop;
+        for (int x : hole) p_hole.insert(make_card(card_rank(x), perm[card_suit(x)]));
+        for (int x : flop) p_flop.insert(make_card(card_rank(x), perm[card_suit(x)]));
+        REQUIRE(abstraction.get_bucket(p_hole, p_flop, BettingRound::Flop) == bucket);
+    }
+    REQUIRE(abstraction.get_bucket(top_set, board, BettingRound::Flop) !=
+            abstraction.get_bucket(air, board, BettingRound::Flop));
+
+    // Features carry the hand's equity against each opponent cluster
+    const CardSet river = board | CardSet::of(std::array{make_card(9, 3), make_card(3, 0)});
+    const HandFeatures features = abstraction.compute_features(top_set, river);
+    REQUIRE(features.ochs_clusters == 4);
+    const auto expected = direct_ochs(top_set, river, abstraction.opponent_clusters());
+    for (int c = 0; c < 4; ++c) REQUIRE_THAT(features.ochs[c], WithinAbs(expected[c], 1e-6));
+    REQUIRE(features.ochs[0] > 0.9f);
+
+    OCHSBuildConfig bad = small_flop_config();
+    bad.rounds = {BettingRound::Preflop};
+    REQUIRE_THROWS_AS(abstraction.build_clusters(bad), std::invalid_argument);
+    REQUIRE(create_abstraction("ochs")->name() == "OCHS");
+}
+
+// Cost of the batched features per board, against one hand_strengths sweep
+// per runout (benchmark, not a test)
+TEST_CASE("OCHS feature throughput", "[ochs][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    const OpponentClusters clusters = OpponentClusters::build();
+    std::cout << "Opponent clusters: " << std::chrono::duration<double>(Clock::now() - t0).count() << " s" << std::endl;
+
+    std::mt19937 rng(73);
+    std::vector<float> out(static_cast<size_t>(NUM_HOLE_COMBOS) * clusters.size() * 10);
+    for (int board_cards : {3, 4, 5}) {
+        const int boards = board_cards == 5 ? 2000 : 50;
+        std::vector<CardSet> sample;
+        for (int i = 0; i < boards; ++i) sample.push_back(random_board(rng, board_cards));
+        const int samples = board_cards == 3 ? 100 : 0;
+
+        auto t = Clock::now();
+        for (CardSet board : sample) ochs_equities(board, clusters, samples, 0, 0, out);
+        const double ochs_ms = std::chrono::duration<double>(Clock::now() - t).count() * 1e3 / boards;
+        t = Clock::now();
+        for (CardSet board : sample) ochs_histograms(board, clusters, 10, samples, 0, 0, out);
+        const double hist_ms = std::chrono::duration<double>(Clock::now() - t).count() * 1e3 / boards;
+        t = Clock::now();
+        for (CardSet board : sample) equity_histograms(board, 10, samples, 0, 0, out);
+        const double emd_ms = std::chrono::duration<double>(Clock::now() - t).count() * 1e3 / boards;
+
+        std::cout << board_cards << "-card board: OCHS " << ochs_ms << " ms, potential-aware OCHS "
+                  << hist_ms << " ms, EMD histograms " << emd_ms << " ms per board (all hands)" << std::endl;
+    }
+}
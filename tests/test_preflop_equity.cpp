@@ -0,0 +1,151 @@
+// Tests for preflop equity tables
+// Verifies the class-vs-class matrix against known all-in equities, the
+// binary cache, and that Percentile preflop buckets follow equity ranks
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/PreflopEquity.hpp"
+
+using namespace quantnet::poker;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+const PreflopEquity& table() {
+    static const PreflopEquity t = PreflopEquity::compute(200, 5);
+    return t;
+}
+
+int class_of(int rank1, int suit1, int rank2, int suit2) {
+    return PreflopEquity::hand_class(hole_combo_index(make_card(rank1, suit1), make_card(rank2, suit2)));
+}
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST_CASE("Preflop equity matrix", "[preflop_equity]") {
+    const PreflopEquity& eq = table();
+    const int aa = class_of(12, 0, 12, 1);
+    const int kk = class_of(11, 0, 11, 1);
+    const int aks = class_of(12, 0, 11, 0);
+    const int seven_two = class_of(5, 0, 0, 1);
+    const int three_two = class_of(1, 0, 0, 1);
+
+    // Equities of each pair of classes add up to one, up to sampling error
+    double deviation = 0.0;
+    for (int a = 0; a < PreflopEquity::NUM_CLASSES; ++a) {
+        REQUIRE(eq.equity(a, a) == 0.5);
+        for (int b = 0; b < PreflopEquity::NUM_CLASSES; ++b) {
+            REQUIRE_THAT(eq.equity(a, b) + eq.equity(b, a), WithinAbs(1.0, 0.3));
+            deviation += std::abs(eq.equity(a, b) + eq.equity(b, a) - 1.0);
+        }
+    }
+    REQUIRE(deviation / (PreflopEquity::NUM_CLASSES * PreflopEquity::NUM_CLASSES) < 0.05);
+
+    // Well-known all-in equities
+    REQUIRE_THAT(eq.equity(aa, kk), WithinAbs(0.82, 0.04));
+    REQUIRE_THAT(eq.equity(kk, aks), WithinAbs(0.66, 0.05));
+    REQUIRE_THAT(eq.equity_vs_random(aa), WithinAbs(0.852, 0.005));
+    REQUIRE_THAT(eq.equity_vs_random(seven_two), WithinAbs(0.346, 0.005));
+    REQUIRE_THAT(eq.equity_vs_random(three_two), WithinAbs(0.323, 0.005));
+
+    REQUIRE(eq.rank(aa) == 0);
+    REQUIRE(eq.rank(kk) == 1);
+    REQUIRE(eq.rank(three_two) >= 165);
+    REQUIRE(eq.combo_rank(hole_combo_index(make_card(12, 2), make_card(12, 3))) == 0);
+    REQUIRE(eq.combo_equity(hole_combo_index(make_card(12, 2), make_card(12, 3))) == eq.equity_vs_random(aa));
+
+    // Seeded, so reproducible
+    const PreflopEquity again = PreflopEquity::compute(200, 5);
+    for (int a = 0; a < PreflopEquity::NUM_CLASSES; ++a) {
+        REQUIRE(again.equity(a, kk) == eq.equity(a, kk));
+    }
+    REQUIRE_THROWS_AS(PreflopEquity::compute(0), std::invalid_argument);
+}
+
+TEST_CASE("Preflop equity cache file", "[preflop_equity]") {
+    const std::string path = temp_path("qn_preflop_equity.bin");
+    std::filesystem::remove(path);
+    table().save(path);
+
+    const PreflopEquity loaded = PreflopEquity::load(path);
+    REQUIRE(loaded.samples() == 200);
+    REQUIRE(loaded.seed() == 5);
+    for (int a = 0; a < PreflopEquity::NUM_CLASSES; ++a) {
+        REQUIRE(loaded.rank(a) == table().rank(a));
+        REQUIRE(loaded.equity_vs_random(a) == table().equity_vs_random(a));
+        for (int b = 0; b < PreflopEquity::NUM_CLASSES; ++b) REQUIRE(loaded.equity(a, b) == table().equity(a, b));
+    }
+
+    // Matching settings load; others are recomputed and overwrite the file
+    REQUIRE(PreflopEquity::load_or_compute(path, 200, 5).equity(0, 1) == table().equity(0, 1));
+    const PreflopEquity other = PreflopEquity::load_or_compute(path, 2, 9);
+    REQUIRE(other.samples() == 2);
+    REQUIRE(PreflopEquity::load(path).seed() == 9);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    REQUIRE_THROWS_AS(PreflopEquity::load(path), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not an equity table";
+    }
+    REQUIRE_THROWS_AS(PreflopEquity::load(path), std::runtime_error);
+    REQUIRE_THROWS_AS(PreflopEquity::load_or_compute(path, 2, 9), std::runtime_error);
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(PreflopEquity::load(path), std::runtime_error);
+}
+
+TEST_CASE("Percentile preflop buckets follow equity ranks", "[preflop_equity]") {
+    auto shared = std::make_shared<const PreflopEquity>(table());
+    PercentileAbstraction full(169, 10, 10, 10, shared);
+    PercentileAbstraction coarse(10, 10, 10, 10, shared);
+
+    for (int i = 0; i < NUM_HOLE_COMBOS; ++i) {
+        const CardSet hole = CardSet::of(hole_combos()[i]);
+        const int rank = table().combo_rank(i);
+        REQUIRE(full.get_bucket(hole, CardSet{}, BettingRound::Preflop) == rank);
+        REQUIRE(coarse.get_bucket(hole, CardSet{}, BettingRound::Preflop) == rank * 10 / 169);
+    }
+
+    // The default table ranks the same obvious hands first and last
+    PercentileAbstraction standard;
+    const CardSet aces = CardSet::of(std::array{make_card(12, 0), make_card(12, 3)});
+    const CardSet trash = CardSet::of(std::array{make_card(1, 0), make_card(0, 3)});
+    REQUIRE(standard.get_bucket(aces, CardSet{}, BettingRound::Preflop) == 0);
+    REQUIRE(standard.get_bucket(trash, CardSet{}, BettingRound::Preflop) >= 160);
+}
+
+// Cost of a full-precision table and of a preflop lookup (benchmark, not a
+// test)
+TEST_CASE("Preflop equity throughput", "[preflop_equity][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+    const PreflopEquity eq = PreflopEquity::compute();
+    std::cout << "Preflop equities, 1000 samples per class: "
+              << std::chrono::duration<double>(Clock::now() - t0).count() << " s" << std::endl;
+    std::cout << "AA vs KK " << eq.equity(class_of(12, 0, 12, 1), class_of(11, 0, 11, 1))
+              << ", AA vs random " << eq.equity_vs_random(class_of(12, 0, 12, 1)) << std::endl;
+
+    PercentileAbstraction percentile(169, 10, 10, 10, std::make_shared<const PreflopEquity>(eq));
+    uint64_t sink = 0;
+    t0 = Clock::now();
+    for (int rep = 0; rep < 1000; ++rep) {
+        for (const auto& combo : hole_combos()) {
+            sink += percentile.get_bucket(CardSet::of(combo), CardSet{}, BettingRound::Preflop);
+        }
+    }
+    std::cout << "Preflop get_bucket: "
+              << std::chrono::duration<double>(Clock::now() - t0).count() / (1000.0 * NUM_HOLE_COMBOS) * 1e9
+              << " ns" << std::endl;
+    if (sink == 0) std::cout << sink;
+}
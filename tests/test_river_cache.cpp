@@ -0,0 +1,148 @@
+// Tests for the per-board river rank cache
+// Verifies cached strengths and showdowns against the evaluator, and that a
+// saved table maps back with the same answers
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "poker/HandEvaluator.hpp"
+#include "poker/RiverRankCache.hpp"
+
+using namespace quantnet::poker;
+
+namespace {
+
+struct RiverDeal {
+    CardSet hole1;
+    CardSet hole2;
+    CardSet board;
+};
+
+RiverDeal deal(std::mt19937& rng) {
+    std::vector<int> deck(DECK_SIZE);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    return {CardSet::of(std::span(deck.data(), 2)),
+            CardSet::of(std::span(deck.data() + 2, 2)),
+            CardSet::of(std::span(deck.data() + 4, 5))};
+}
+
+} // namespace
+
+TEST_CASE("Cached river strength matches the evaluator", "[river_cache]") {
+    RiverRankCache cache;
+    REQUIRE(RiverRankCache::num_boards() == 134459);
+    REQUIRE(cache.boards_cached() == 0);
+
+    std::mt19937 rng(65);
+    for (int trial = 0; trial < 300; ++trial) {
+        auto [hole1, hole2, board] = deal(rng);
+        REQUIRE(cache.hand_strength(hole1, board) == HandEvaluator::hand_strength(hole1, board));
+
+        const HandValue v1 = HandEvaluator::evaluate(hole1 | board);
+        const HandValue v2 = HandEvaluator::evaluate(hole2 | board);
+        const int expected = (v1 > v2) - (v1 < v2);
+        REQUIRE(cache.compare(hole1, hole2, board) == expected);
+        REQUIRE(cache.compare(hole2, hole1, board) == -expected);
+        REQUIRE((cache.rank(hole1, board) > cache.rank(hole2, board)) == (v1 > v2));
+    }
+    REQUIRE(cache.boards_cached() > 0);
+    REQUIRE(cache.boards_cached() <= 300);
+}
+
+TEST_CASE("Isomorphic rivers share cache entries", "[river_cache]") {
+    RiverRankCache cache;
+    std::mt19937 rng(66);
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+    auto permute = [&perm](CardSet cards) {
+        CardSet out;
+        for (int c : cards) out.insert(make_card(card_rank(c), perm[card_suit(c)]));
+        return out;
+    };
+
+    for (int trial = 0; trial < 50; ++trial) {
+        auto [hole, other, board] = deal(rng);
+        std::shuffle(perm.begin(), perm.end(), rng);
+        REQUIRE(cache.hand_strength(permute(hole), permute(board)) == cache.hand_strength(hole, board));
+        REQUIRE(cache.rank(permute(hole), permute(board)) == cache.rank(hole, board));
+    }
+    // Every permuted board hit a board already computed
+    REQUIRE(cache.boards_cached() <= 50);
+}
+
+TEST_CASE("River cache rejects malformed queries", "[river_cache]") {
+    RiverRankCache cache;
+    CardSet board = CardSet::of(std::array{0, 1, 2, 3, 4});
+    REQUIRE_THROWS_AS(cache.rank(CardSet::of(std::array{4, 5}), board), std::invalid_argument);
+    REQUIRE_THROWS_AS(cache.rank(CardSet::single(5), board), std::invalid_argument);
+    REQUIRE_THROWS_AS(cache.rank(CardSet::of(std::array{5, 6}), CardSet::of(std::array{0, 1, 2, 3})),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(cache.compare(CardSet::of(std::array{5, 6}), CardSet::of(std::array{0, 7}), board),
+                      std::invalid_argument);
+}
+
+TEST_CASE("River cache rejects invalid files", "[river_cache]") {
+    const auto path = std::filesystem::temp_directory_path() / "qn_river_invalid.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::string junk(4096, 'x');
+        out.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+    }
+    REQUIRE_THROWS_AS(RiverRankCache(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(RiverRankCache(path.string()), std::runtime_error);
+}
+
+// Builds all boards, writes the ~580 MB table and maps it back (slow, not
+// part of the default run)
+TEST_CASE("River cache build, save and map", "[river_cache][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    const auto path = std::filesystem::temp_directory_path() / "qn_river_ranks.bin";
+
+    RiverRankCache cache;
+    auto t0 = Clock::now();
+    cache.build_all();
+    double build_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    REQUIRE(cache.boards_cached() == RiverRankCache::num_boards());
+    std::cout << "River cache build: " << build_secs << " s" << std::endl;
+
+    cache.save(path.string());
+    RiverRankCache mapped(path.string());
+    REQUIRE(mapped.is_mapped());
+
+    std::mt19937 rng(67);
+    std::vector<RiverDeal> deals;
+    for (int i = 0; i < 100000; ++i) deals.push_back(deal(rng));
+    for (int i = 0; i < 1000; ++i) {
+        const auto& d = deals[i];
+        REQUIRE(mapped.hand_strength(d.hole1, d.board) == cache.hand_strength(d.hole1, d.board));
+        REQUIRE(mapped.compare(d.hole1, d.hole2, d.board) == cache.compare(d.hole1, d.hole2, d.board));
+    }
+
+    // Second pass: the mapped pages are resident
+    double sink = 0;
+    for (const auto& d : deals) sink += mapped.compare(d.hole1, d.hole2, d.board);
+    t0 = Clock::now();
+    for (const auto& d : deals) sink += mapped.compare(d.hole1, d.hole2, d.board);
+    double compare_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    t0 = Clock::now();
+    for (const auto& d : deals) sink += mapped.hand_strength(d.hole1, d.board);
+    double cached_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    t0 = Clock::now();
+    for (size_t i = 0; i < 10000; ++i) sink += HandEvaluator::hand_strength(deals[i].hole1, deals[i].board);
+    double eval_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::cout << "Cached showdowns/s: " << deals.size() / compare_secs / 1e6 << "M" << std::endl;
+    std::cout << "River hand_strength/s: cached " << deals.size() / cached_secs / 1e6 << "M, evaluated "
+              << 10000 / eval_secs / 1e6 << "M" << std::endl;
+    if (sink < 0) std::cout << sink;
+    std::filesystem::remove(path);
+}
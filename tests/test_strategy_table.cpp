@@ -0,0 +1,569 @@
+// Tests for the compiled strategy table used to serve strategies
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "poker/StrategyTable.hpp"
+#include "poker/StrategyFile.hpp"
+#include "poker/HistoryAutomaton.hpp"
+#include "poker/KuhnPoker.hpp"
+#include "poker/LeducPoker.hpp"
+#include "solver/CFR.hpp"
+
+using namespace quantnet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+poker::Strategy solved_leduc(const poker::LeducPoker& leduc) {
+    solver::CFRPlus cfr(leduc);
+    cfr.solve(20);
+    return cfr.average_strategy();
+}
+
+poker::InfoSetIndex make_index(const poker::PokerGame& game) {
+    poker::InfoSetIndex index;
+    index.build(game.get_info_sets());
+    return index;
+}
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST_CASE("Strategy table matches Strategy::probs", "[strategy_table]") {
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::Strategy sigma = solved_leduc(leduc);
+    poker::StrategyTable table(sigma, index);
+
+    REQUIRE(table.size() == static_cast<size_t>(index.num_info_sets()));
+    REQUIRE(table.num_entries() == static_cast<size_t>(index.total_dim()));
+
+    for (int i = 0; i < index.num_info_sets(); ++i) {
+        const poker::InfoSet& is = index.info_set(i);
+        poker::InfoSetHandle h = table.find(is.id);
+        REQUIRE(h == static_cast<poker::InfoSetHandle>(i));
+        REQUIRE(table.id(h) == is.id);
+
+        Eigen::VectorXd expected = sigma.probs(is.id);
+        auto probs = table.probs(h);
+        auto actions = table.actions(h);
+        REQUIRE(probs.size() == static_cast<size_t>(expected.size()));
+        for (size_t a = 0; a < probs.size(); ++a) {
+            REQUIRE(probs[a] == expected(static_cast<int>(a)));
+            REQUIRE(actions[a] == is.legal_actions[a]);
+            REQUIRE(table.prob(h, actions[a]) == probs[a]);
+        }
+    }
+}
+
+TEST_CASE("Strategy table lookups by hash and in batches", "[strategy_table]") {
+    poker::KuhnPoker kuhn;
+    poker::InfoSetIndex index = make_index(kuhn);
+    poker::StrategyTable table(poker::Strategy::uniform(index), index);
+
+    // Incremental hashing gives the same handle as hashing the whole id
+    uint64_t hash = poker::StrategyTable::hash_append(poker::StrategyTable::FNV_OFFSET, "P1:K:");
+    hash = poker::StrategyTable::hash_append(hash, "b");
+    REQUIRE(hash == poker::StrategyTable::hash_id("P1:K:b"));
+    REQUIRE(table.find(hash) == table.find("P1:K:b"));
+
+    REQUIRE(table.find("P1:K:x") == poker::INVALID_HANDLE);
+    REQUIRE(poker::StrategyTable().find("P1:K:b") == poker::INVALID_HANDLE);
+
+    std::vector<uint64_t> hashes;
+    for (const auto& is : index.all_info_sets()) {
+        hashes.push_back(poker::StrategyTable::hash_id(is.id));
+    }
+    hashes.push_back(poker::StrategyTable::hash_id("missing"));
+
+    std::vector<poker::InfoSetHandle> handles(hashes.size());
+    table.find_batch(hashes, handles);
+    for (size_t i = 0; i + 1 < handles.size(); ++i) {
+        REQUIRE(handles[i] == static_cast<poker::InfoSetHandle>(i));
+    }
+    REQUIRE(handles.back() == poker::INVALID_HANDLE);
+
+    handles.pop_back();
+    std::vector<std::span<const double>> rows(handles.size());
+    table.probs_batch(handles, rows);
+    for (const auto& row : rows) {
+        REQUIRE(row.size() == 2);
+        REQUIRE_THAT(row[0], WithinAbs(0.5, 1e-12));
+    }
+}
+
+TEST_CASE("Strategy table sampling follows the probabilities", "[strategy_table]") {
+    poker::KuhnPoker kuhn;
+    poker::InfoSetIndex index = make_index(kuhn);
+
+    poker::Strategy sigma = poker::Strategy::uniform(index);
+    sigma.set_logits("P0:K:", Eigen::Vector2d(0.0, std::log(3.0)));  // check 1/4, bet 3/4
+    poker::StrategyTable table(sigma, index);
+
+    poker::InfoSetHandle h = table.find("P0:K:");
+    REQUIRE(table.sample(h, 0.0) == poker::Action::Check);
+    REQUIRE(table.sample(h, 0.2499) == poker::Action::Check);
+    REQUIRE(table.sample(h, 0.2501) == poker::Action::Bet);
+    REQUIRE(table.sample(h, 0.9999999) == poker::Action::Bet);
+}
+
+TEST_CASE("Strategy table is safe to query from many threads", "[strategy_table]") {
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::StrategyTable table(solved_leduc(leduc), index);
+
+    std::vector<uint64_t> hashes;
+    for (const auto& is : index.all_info_sets()) {
+        hashes.push_back(poker::StrategyTable::hash_id(is.id));
+    }
+
+    std::vector<int> mismatches(4, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int rep = 0; rep < 100; ++rep) {
+                for (size_t i = 0; i < hashes.size(); ++i) {
+                    if (table.find(hashes[i]) != static_cast<poker::InfoSetHandle>(i)) {
+                        ++mismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int m : mismatches) REQUIRE(m == 0);
+}
+
+TEST_CASE("Strategy file round-trips exactly at full precision", "[strategy_file]") {
+    poker::LeducPoker leduc;
+    solver::CFRPlus cfr(leduc);
+    cfr.solve(20);
+    poker::Strategy sigma = cfr.average_strategy();
+    const std::string path = temp_path("quantnet_test_strategy_f64.bin");
+
+    poker::StrategyFile::write(path, sigma, cfr.info_set_index());
+    poker::StrategyFile file(path);
+
+    const poker::InfoSetIndex& index = cfr.info_set_index();
+    REQUIRE(file.format() == poker::ProbFormat::F64);
+    REQUIRE(file.size() == static_cast<size_t>(index.num_info_sets()));
+    REQUIRE(file.num_entries() == static_cast<size_t>(index.total_dim()));
+
+    std::vector<double> probs(3);
+    for (const auto& is : index.all_info_sets()) {
+        poker::InfoSetHandle h = file.find(is.id);
+        REQUIRE(h != poker::INVALID_HANDLE);
+        REQUIRE(file.id(h) == is.id);
+        REQUIRE(file.num_actions(h) == is.legal_actions.size());
+
+        file.probs(h, probs);
+        Eigen::VectorXd expected = sigma.probs(is.id);
+        for (size_t a = 0; a < is.legal_actions.size(); ++a) {
+            REQUIRE(file.actions(h)[a] == is.legal_actions[a]);
+            REQUIRE(probs[a] == expected(static_cast<int>(a)));
+        }
+    }
+    REQUIRE(file.find("P9:none") == poker::INVALID_HANDLE);
+
+    // Back to a Strategy
+    poker::Strategy restored = file.to_strategy();
+    for (const auto& is : index.all_info_sets()) {
+        Eigen::VectorXd diff = restored.probs(is.id) - sigma.probs(is.id);
+        REQUIRE(diff.cwiseAbs().maxCoeff() < 1e-9);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Quantized strategy files stay normalized", "[strategy_file]") {
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::Strategy sigma = solved_leduc(leduc);
+
+    for (auto [format, scale] : {std::pair{poker::ProbFormat::U16, 65535.0},
+                                 std::pair{poker::ProbFormat::U8, 255.0}}) {
+        const std::string path = temp_path("quantnet_test_strategy_q.bin");
+        poker::StrategyFile::write(path, sigma, index, format);
+        poker::StrategyFile file(path);
+        REQUIRE(file.format() == format);
+
+        for (const auto& is : index.all_info_sets()) {
+            poker::InfoSetHandle h = file.find(is.id);
+            Eigen::VectorXd expected = sigma.probs(is.id);
+
+            double sum = 0.0;
+            for (size_t a = 0; a < file.num_actions(h); ++a) {
+                const double p = file.prob(h, a);
+                REQUIRE(std::abs(p - expected(static_cast<int>(a))) <= 1.0 / scale);
+                sum += p * scale;
+            }
+            REQUIRE(sum == scale);  // Exact: quantized values sum to the scale
+        }
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Strategy file without ids still serves lookups", "[strategy_file]") {
+    poker::KuhnPoker kuhn;
+    poker::InfoSetIndex index = make_index(kuhn);
+    poker::Strategy sigma = poker::Strategy::uniform(index);
+    sigma.set_logits("P1:Q:b", Eigen::Vector2d(0.0, std::log(3.0)));
+    const std::string path = temp_path("quantnet_test_strategy_noids.bin");
+
+    poker::StrategyFile::write(path, sigma, index, poker::ProbFormat::F64, false);
+    poker::StrategyFile file(path);
+
+    REQUIRE_FALSE(file.has_ids());
+    poker::InfoSetHandle h = file.find("P1:Q:b");
+    REQUIRE(h != poker::INVALID_HANDLE);
+    REQUIRE(file.id(h).empty());
+    REQUIRE_THAT(file.prob(h, 1), WithinAbs(0.75, 1e-12));
+    REQUIRE_THROWS_AS(file.to_strategy(), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Strategy file is smaller than JSON", "[strategy_file]") {
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::Strategy sigma = solved_leduc(leduc);
+
+    const std::string json_path = temp_path("quantnet_test_strategy.json");
+    {
+        std::ofstream json(json_path);
+        json << sigma.to_json().dump();
+    }
+    const auto json_size = std::filesystem::file_size(json_path);
+
+    // (format, with ids, minimum size reduction)
+    const std::vector<std::tuple<poker::ProbFormat, bool, double>> cases = {
+        {poker::ProbFormat::F64, true, 1.25},
+        {poker::ProbFormat::U8, true, 2.0},
+        {poker::ProbFormat::U8, false, 4.0},
+    };
+    for (const auto& [format, ids, reduction] : cases) {
+        const std::string path = temp_path("quantnet_test_strategy_size.bin");
+        poker::StrategyFile::write(path, sigma, index, format, ids);
+        INFO("JSON " << json_size << " bytes, binary " << std::filesystem::file_size(path));
+        REQUIRE(static_cast<double>(std::filesystem::file_size(path)) * reduction < json_size);
+        std::remove(path.c_str());
+    }
+    std::remove(json_path.c_str());
+}
+
+TEST_CASE("Invalid strategy files are rejected", "[strategy_file]") {
+    const std::string path = temp_path("quantnet_test_strategy_bad.bin");
+
+    REQUIRE_THROWS_AS(poker::StrategyFile(temp_path("quantnet_no_such_file.bin")), std::runtime_error);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a strategy file at all, just some text that is long enough to hold a header";
+        out << std::string(200, 'x');
+    }
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+
+    // Truncated valid file
+    poker::KuhnPoker kuhn;
+    poker::InfoSetIndex index = make_index(kuhn);
+    poker::StrategyFile::write(path, poker::Strategy::uniform(index), index);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+namespace {
+
+// Overwrite the value at a byte offset of a file
+template <typename T>
+void patch(const std::string& path, uint64_t offset, T value) {
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(static_cast<std::streamoff>(offset));
+    f.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_at(const std::string& path, uint64_t offset) {
+    std::ifstream f(path, std::ios::binary);
+    f.seekg(static_cast<std::streamoff>(offset));
+    T value{};
+    f.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("Corrupt strategy file counts and offsets are rejected", "[strategy_file]") {
+    // Header fields: num_info_sets at byte 24, num_entries at 32, section
+    // offsets of the entry ranges at 48 and of the id ranges at 72
+    const std::string path = temp_path("quantnet_test_strategy_corrupt.bin");
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    auto fresh = [&] {
+        poker::StrategyFile::write(path, poker::Strategy::uniform(index), index);
+        REQUIRE_NOTHROW(poker::StrategyFile(path));
+    };
+
+    // Counts whose section sizes would wrap to a small number
+    fresh();
+    patch<uint64_t>(path, 24, (uint64_t{1} << 62) + 1);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+    fresh();
+    patch<uint64_t>(path, 32, uint64_t{1} << 63);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+
+    // An entry range running backwards, and one past the entries
+    const auto offsets = read_at<uint64_t>(path, 48);
+    fresh();
+    patch<uint32_t>(path, offsets + 3 * sizeof(uint32_t), 0);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+    fresh();
+    patch<uint32_t>(path, offsets + 3 * sizeof(uint32_t), UINT32_MAX);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+
+    // The same for the id ranges
+    const auto id_offsets = read_at<uint64_t>(path, 72);
+    REQUIRE(id_offsets != 0);
+    fresh();
+    patch<uint32_t>(path, id_offsets + 2 * sizeof(uint32_t), UINT32_MAX);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+    fresh();
+    patch<uint32_t>(path, id_offsets + 5 * sizeof(uint32_t), 1);
+    REQUIRE_THROWS_AS(poker::StrategyFile(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+namespace {
+
+// Walk the game tree alongside a cursor and check it agrees at every node
+int check_cursor(const poker::GameNode* node, poker::HistoryCursor cursor,
+                 const poker::InfoSetIndex& index) {
+    int checked = 0;
+    switch (node->type) {
+        case poker::NodeType::Terminal:
+            REQUIRE(cursor.is_terminal());
+            return 0;
+
+        case poker::NodeType::Chance:
+            REQUIRE(cursor.kind() == poker::HistoryAutomaton::StateKind::Deal);
+            for (const auto& edge : node->children) {
+                poker::HistoryCursor next = cursor;
+                REQUIRE(next.deal_public(edge.card));
+                checked += check_cursor(edge.child.get(), next, index);
+            }
+            return checked;
+
+        case poker::NodeType::Player: {
+            const poker::Card own = (node->player == poker::PLAYER_0) ? node->p0_card : node->p1_card;
+            REQUIRE(cursor.to_act() == node->player);
+            REQUIRE(cursor.info_set(own) == static_cast<poker::InfoSetHandle>(index.info_set_idx(node->info_set_id)));
+            for (const auto& edge : node->children) {
+                poker::HistoryCursor next = cursor;
+                REQUIRE(next.apply(edge.action));
+                checked += check_cursor(edge.child.get(), next, index);
+            }
+            return checked + 1;
+        }
+    }
+    return checked;
+}
+
+} // namespace
+
+TEST_CASE("History automaton resolves every decision to its info set", "[history_automaton]") {
+    poker::KuhnPoker kuhn;
+    poker::LeducPoker leduc;
+
+    for (const poker::PokerGame* game : {static_cast<const poker::PokerGame*>(&kuhn),
+                                         static_cast<const poker::PokerGame*>(&leduc)}) {
+        poker::InfoSetIndex index = make_index(*game);
+        poker::HistoryAutomaton automaton(*game, index);
+
+        int decisions = 0;
+        for (const auto& deal : game->root()->children) {
+            decisions += check_cursor(deal.child.get(), automaton.start(), index);
+        }
+        REQUIRE(decisions == poker::compute_tree_stats(game->root()).player_nodes);
+    }
+}
+
+TEST_CASE("History cursor follows a Leduc hand into the strategy table", "[history_automaton]") {
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::HistoryAutomaton automaton(leduc, index);
+    poker::StrategyTable table(poker::Strategy::uniform(index), index);
+
+    poker::HistoryCursor cursor = automaton.start();
+    REQUIRE_FALSE(cursor.apply(poker::Action::Call));   // Nothing to call
+    REQUIRE_FALSE(cursor.deal_public(0));               // No deal due
+
+    REQUIRE(cursor.apply(poker::Action::Check));
+    REQUIRE(cursor.apply(poker::Action::Check));
+    REQUIRE(cursor.kind() == poker::HistoryAutomaton::StateKind::Deal);
+    REQUIRE(cursor.info_set(0) == poker::INVALID_HANDLE);
+    REQUIRE_FALSE(cursor.deal_public(poker::LeducPoker::NUM_CARDS));
+    REQUIRE(cursor.deal_public(3));                     // Qh
+
+    REQUIRE(cursor.to_act() == poker::PLAYER_0);
+    poker::InfoSetHandle h = cursor.info_set(4);        // P0 holds Ks
+    REQUIRE(table.id(h) == poker::LeducPoker::make_info_set_id(poker::PLAYER_0, 4, 3, "cc|", 2));
+    REQUIRE(table.probs(h).size() == 2);
+
+    REQUIRE(cursor.apply(poker::Action::Bet));
+    REQUIRE(cursor.apply(poker::Action::Fold));
+    REQUIRE(cursor.is_terminal());
+}
+
+// Query latency of the table vs Strategy::probs (benchmark, not a test)
+TEST_CASE("Strategy query latency", "[strategy_table][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+
+    poker::LeducPoker leduc;
+    poker::InfoSetIndex index = make_index(leduc);
+    poker::Strategy sigma = solved_leduc(leduc);
+    poker::StrategyTable table(sigma, index);
+
+    std::vector<uint64_t> hashes;
+    for (const auto& is : index.all_info_sets()) {
+        hashes.push_back(poker::StrategyTable::hash_id(is.id));
+    }
+    std::mt19937 rng(42);
+    std::vector<size_t> order(1 << 16);
+    for (auto& o : order) o = rng() % hashes.size();
+
+    // Per-query latencies, each timed over a block of 64 queries to stay
+    // well above clock resolution
+    auto percentiles = [&](auto&& query) {
+        std::vector<double> ns;
+        double sink = 0.0;
+        for (size_t b = 0; b + 64 <= order.size(); b += 64) {
+            auto t0 = Clock::now();
+            for (size_t i = b; i < b + 64; ++i) sink += query(order[i]);
+            ns.push_back(std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / 64.0);
+        }
+        std::sort(ns.begin(), ns.end());
+        if (sink < 0) std::cout << sink;  // Keep the queries alive
+        return std::make_pair(ns[ns.size() / 2], ns[ns.size() * 99 / 100]);
+    };
+
+    // Full decision from the action sequence: string id + map vs cursor + table
+    poker::HistoryAutomaton automaton(leduc, index);
+    const std::vector<poker::Action> line = {poker::Action::Check, poker::Action::Bet, poker::Action::Call};
+    auto by_string = percentiles([&](size_t i) {
+        std::string history;
+        for (poker::Action a : line) history += poker::action_to_char(a);
+        history += "|";
+        const poker::Card own = static_cast<poker::Card>(i % 6);
+        const poker::Card board = static_cast<poker::Card>((own + 1) % 6);
+        return sigma.probs(poker::LeducPoker::make_info_set_id(poker::PLAYER_0, own, board, history, 2))(0);
+    });
+    auto by_cursor = percentiles([&](size_t i) {
+        poker::HistoryCursor cursor = automaton.start();
+        for (poker::Action a : line) cursor.apply(a);
+        const poker::Card own = static_cast<poker::Card>(i % 6);
+        cursor.deal_public(static_cast<poker::Card>((own + 1) % 6));
+        return table.probs(cursor.info_set(own))[0];
+    });
+
+    auto by_map = percentiles([&](size_t i) { return sigma.probs(index.info_set(static_cast<int>(i)).id)(0); });
+    auto by_hash = percentiles([&](size_t i) { return table.probs(table.find(hashes[i]))[0]; });
+    auto by_handle = percentiles([&](size_t i) { return table.probs(static_cast<poker::InfoSetHandle>(i))[0]; });
+
+    std::cout << "\n=== Strategy query latency (" << table.size() << " info sets) ===\n";
+    std::cout << std::setw(24) << "Path" << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(24) << "Strategy::probs" << std::setw(12) << by_map.first << std::setw(12) << by_map.second << "\n";
+    std::cout << std::setw(24) << "StrategyTable by hash" << std::setw(12) << by_hash.first << std::setw(12) << by_hash.second << "\n";
+    std::cout << std::setw(24) << "StrategyTable by handle" << std::setw(12) << by_handle.first << std::setw(12) << by_handle.second << "\n";
+    std::cout << "Resolving 'cbk|' + cards from the action sequence:\n";
+    std::cout << std::setw(24) << "id string + map" << std::setw(12) << by_string.first << std::setw(12) << by_string.second << "\n";
+    std::cout << std::setw(24) << "cursor + table" << std::setw(12) << by_cursor.first << std::setw(12) << by_cursor.second << "\n";
+}
+
+// Load cost and size of a large strategy: binary file vs JSON
+// (benchmark, not a test)
+TEST_CASE("Strategy file load time vs JSON", "[strategy_file][.benchmark]") {
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+
+    // Synthetic strategy with Leduc-like ids and 3 actions per info set
+    const int num_info_sets = 200000;
+    std::vector<poker::InfoSet> info_sets;
+    for (int i = 0; i < num_info_sets; ++i) {
+        info_sets.push_back({"P" + std::to_string(i % 2) + ":K:Q:R2:cbrk|" + std::to_string(i),
+                             i % 2, {poker::Action::Fold, poker::Action::Call, poker::Action::Raise}});
+    }
+    poker::InfoSetIndex index;
+    index.build(info_sets);
+    std::mt19937 rng(1);
+    std::normal_distribution<double> normal;
+    Eigen::VectorXd w(index.total_dim());
+    for (int i = 0; i < w.size(); ++i) w(i) = normal(rng);
+    poker::Strategy sigma = poker::Strategy::from_logits(w, index);
+
+    const std::string json_path = temp_path("quantnet_bench_strategy.json");
+    {
+        std::ofstream json(json_path);
+        json << sigma.to_json().dump();
+    }
+    auto t0 = Clock::now();
+    {
+        std::ifstream json(json_path);
+        auto parsed = nlohmann::json::parse(json);
+        if (parsed.empty()) std::cout << "empty\n";
+    }
+    const double json_ms = ms_since(t0);
+
+    std::cout << "\n=== Loading " << num_info_sets << " info sets ===\n";
+    std::cout << std::setw(10) << "Format" << std::setw(14) << "Bytes" << std::setw(14) << "Load ms" << "\n";
+    std::cout << std::setw(10) << "JSON" << std::setw(14) << std::filesystem::file_size(json_path)
+              << std::setw(14) << std::fixed << std::setprecision(3) << json_ms << "  (parse only)\n";
+
+    for (auto [format, name] : {std::pair{poker::ProbFormat::F64, "f64"},
+                                std::pair{poker::ProbFormat::U16, "u16"},
+                                std::pair{poker::ProbFormat::U8, "u8"}}) {
+        for (bool ids : {true, false}) {
+            const std::string path = temp_path("quantnet_bench_strategy.bin");
+            poker::StrategyFile::write(path, sigma, index, format, ids);
+
+            t0 = Clock::now();
+            poker::StrategyFile file(path);
+            double open_ms = ms_since(t0);
+
+            // Average lookup over every info set
+            t0 = Clock::now();
+            double sink = 0.0;
+            for (const auto& is : index.all_info_sets()) {
+                sink += file.prob(file.find(is.id), 0);
+            }
+            double lookup_ns = ms_since(t0) * 1e6 / num_info_sets;
+
+            std::cout << std::setw(10) << (std::string(name) + (ids ? "" : " no-id"))
+                      << std::setw(14) << file.file_size() << std::setw(14) << open_ms
+                      << "  lookup " << lookup_ns << " ns (incl. hashing)"
+                      << (sink < 0 ? "!" : "") << "\n";
+            std::remove(path.c_str());
+        }
+    }
+    std::remove(json_path.c_str());
+}
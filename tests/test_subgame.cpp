@@ -0,0 +1,135 @@
+// Tests for depth-limited subgame re-solving
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "solver/CFR.hpp"
+#include "solver/SubgameSolver.hpp"
+#include "poker/KuhnPoker.hpp"
+#include "poker/LeducPoker.hpp"
+#include "poker/ExpectedValue.hpp"
+
+using namespace quantnet;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+// Round-two public histories of Leduc (the public card is dealt after these)
+const std::vector<std::string> LEDUC_ROUND2 = {
+    "cc|", "bk|", "cbk|", "brk|", "cbrk|", "brrk|", "cbrrk|"
+};
+
+solver::SubgameSolver::Clock::time_point far_deadline() {
+    return solver::SubgameSolver::Clock::now() + std::chrono::minutes(1);
+}
+
+} // namespace
+
+TEST_CASE("Safe re-solving does not increase exploitability", "[subgame]") {
+    poker::LeducPoker leduc;
+    solver::CFRPlus cfr(leduc);
+    cfr.solve(100);
+    poker::Strategy blueprint = cfr.average_strategy();
+
+    solver::SubgameConfig config;
+    config.max_iterations = 500;
+    solver::SubgameSolver resolver(leduc, blueprint, config);
+
+    poker::Strategy refined = blueprint;
+    for (const auto& history : LEDUC_ROUND2) {
+        for (poker::Card board = 0; board < poker::LeducPoker::NUM_CARDS; ++board) {
+            auto result = resolver.solve({history, board}, far_deadline());
+            REQUIRE(result.iterations == config.max_iterations);
+            refined = solver::overlay_strategy(refined, result.strategy);
+        }
+    }
+
+    double before = poker::compute_infoset_exploitability(leduc.root(), blueprint);
+    double after = poker::compute_infoset_exploitability(leduc.root(), refined);
+    INFO("blueprint " << before << ", refined " << after);
+    REQUIRE(after < before);
+}
+
+TEST_CASE("Re-solving an equilibrium blueprint keeps it an equilibrium", "[subgame]") {
+    poker::KuhnPoker kuhn;
+    solver::PredictiveCFRPlus cfr(kuhn);
+    cfr.solve(1000);
+    poker::Strategy blueprint = cfr.average_strategy();
+
+    solver::SubgameConfig config;
+    config.max_iterations = 1000;
+    solver::SubgameSolver resolver(kuhn, blueprint, config);
+
+    // P1 facing a bet, and P0 facing check-bet
+    poker::Strategy refined = blueprint;
+    for (const std::string history : {"b", "cb"}) {
+        auto result = resolver.solve({history, -1}, far_deadline());
+        refined = solver::overlay_strategy(refined, result.strategy);
+    }
+
+    REQUIRE(poker::compute_infoset_exploitability(kuhn.root(), refined) < 1e-3);
+}
+
+TEST_CASE("Subgame result holds only the resolving player's info sets", "[subgame]") {
+    poker::LeducPoker leduc;
+    poker::Strategy blueprint = solver::CFR(leduc).average_strategy();
+
+    solver::SubgameConfig config;
+    config.max_iterations = 10;
+    solver::SubgameSolver resolver(leduc, blueprint, config);
+
+    auto result = resolver.solve({"cc|", 0}, far_deadline());
+    REQUIRE(result.root_histories == 20);  // 5 * 4 private deals beside the board
+    REQUIRE(result.strategy.size() > 0);
+    for (const auto& id : result.strategy.info_set_ids()) {
+        REQUIRE(id.rfind("P0:", 0) == 0);  // P0 acts first in round two
+        REQUIRE(blueprint.has_info_set(id));
+        REQUIRE_THAT(result.strategy.probs(id).sum(), WithinAbs(1.0, 1e-9));
+    }
+}
+
+TEST_CASE("Subgame solver stops at the deadline", "[subgame]") {
+    poker::LeducPoker leduc;
+    poker::Strategy blueprint = solver::CFR(leduc).average_strategy();
+    solver::SubgameSolver resolver(leduc, blueprint);
+
+    auto start = solver::SubgameSolver::Clock::now();
+    auto result = resolver.solve({"", -1}, start + std::chrono::milliseconds(50));
+
+    REQUIRE(result.iterations > 0);
+    REQUIRE(result.iterations < resolver.config().max_iterations);
+    REQUIRE(result.wall_time_ms < 1000.0);
+}
+
+TEST_CASE("Depth limit cuts the subgame with blueprint values", "[subgame]") {
+    poker::LeducPoker leduc;
+    poker::Strategy blueprint = solver::CFR(leduc).average_strategy();
+
+    solver::SubgameConfig full_config;
+    solver::SubgameConfig limited_config;
+    limited_config.max_depth = 1;
+
+    auto full = solver::SubgameSolver(leduc, blueprint, full_config).build_gadget({"", -1});
+    auto limited = solver::SubgameSolver(leduc, blueprint, limited_config).build_gadget({"", -1});
+
+    auto full_stats = poker::compute_tree_stats(full->root());
+    auto limited_stats = poker::compute_tree_stats(limited->root());
+    REQUIRE(limited_stats.total_nodes < full_stats.total_nodes);
+
+    // Root decisions survive, everything below is a leaf
+    // (gadget chance -> opponent's choice -> root decision -> leaf)
+    REQUIRE(limited_stats.max_depth == 3);
+}
+
+TEST_CASE("Unknown public state throws", "[subgame]") {
+    poker::KuhnPoker kuhn;
+    poker::Strategy blueprint = solver::CFR(kuhn).average_strategy();
+    solver::SubgameSolver resolver(kuhn, blueprint);
+
+    REQUIRE_THROWS_AS(resolver.solve({"x", -1}, far_deadline()), std::invalid_argument);
+    REQUIRE_THROWS_AS(resolver.build_gadget({"bb", -1}), std::invalid_argument);
+}
@@ -0,0 +1,102 @@
+// Tests for Turn Hold'em
+// Verifies the hand pool, showdown values and info sets, and that a bucket
+// strategy carries over to the unabstracted game
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <set>
+
+#include "poker/CardAbstraction.hpp"
+#include "poker/ExpectedValue.hpp"
+#include "poker/TurnHoldem.hpp"
+#include "solver/CFR.hpp"
+
+using namespace quantnet;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Turn Hold'em deals a seeded pool of live hands", "[turn_holdem]") {
+    const poker::TurnHoldem game(poker::TurnHoldem::DEFAULT_BOARD, 40, 7);
+    REQUIRE(game.hands().size() == 40);
+    REQUIRE(game.num_labels() == 40);
+    REQUIRE(game.deck_size() == poker::DECK_SIZE);
+
+    const poker::CardSet board = poker::CardSet::of(poker::TurnHoldem::DEFAULT_BOARD);
+    std::set<int> combos;
+    for (const auto& hand : game.hands()) {
+        REQUIRE_FALSE(poker::CardSet::of(hand).intersects(board));
+        combos.insert(poker::hole_combo_index(hand[0], hand[1]));
+    }
+    REQUIRE(combos.size() == 40);
+
+    // Same seed, same pool; another seed, another pool
+    REQUIRE(poker::TurnHoldem(poker::TurnHoldem::DEFAULT_BOARD, 40, 7).hands() == game.hands());
+    REQUIRE(poker::TurnHoldem(poker::TurnHoldem::DEFAULT_BOARD, 40, 8).hands() != game.hands());
+
+    REQUIRE_THROWS_AS(poker::TurnHoldem(poker::TurnHoldem::DEFAULT_BOARD, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(poker::TurnHoldem(poker::TurnHoldem::DEFAULT_BOARD, 1129), std::invalid_argument);
+    REQUIRE_THROWS_AS(poker::TurnHoldem({38, 38, 8, 15}, 40), std::invalid_argument);
+}
+
+TEST_CASE("Turn Hold'em showdown values are antisymmetric", "[turn_holdem]") {
+    const poker::TurnHoldem game(poker::TurnHoldem::DEFAULT_BOARD, 60, 3);
+    const int n = static_cast<int>(game.hands().size());
+    for (int a = 0; a < n; ++a) {
+        REQUIRE(game.showdown_value(a, a) == 0.0);
+        for (int b = 0; b < n; ++b) {
+            REQUIRE(game.showdown_value(a, b) == -game.showdown_value(b, a));
+            REQUIRE(game.showdown_value(a, b) >= -1.0);
+            REQUIRE(game.showdown_value(a, b) <= 1.0);
+        }
+    }
+}
+
+TEST_CASE("Turn Hold'em info sets follow the labels", "[turn_holdem]") {
+    poker::PercentileAbstraction percentile(169, 50, 6, 50);
+    const poker::TurnHoldem exact(poker::TurnHoldem::DEFAULT_BOARD, 30);
+    const poker::TurnHoldem abstracted(poker::TurnHoldem::DEFAULT_BOARD, 30, 0, &percentile);
+
+    REQUIRE(exact.get_info_sets().size() == 30 * 4);
+    REQUIRE(abstracted.num_labels() <= 6);
+    REQUIRE(abstracted.get_info_sets().size() == static_cast<size_t>(abstracted.num_labels()) * 4);
+    REQUIRE(abstracted.name() == "Turn Hold'em (Percentile)");
+
+    // Every info set in the tree is among the listed ones
+    std::set<poker::InfoSetId> listed;
+    for (const auto& is : abstracted.get_info_sets()) listed.insert(is.id);
+    for (const auto& deal : abstracted.root()->children) {
+        REQUIRE(listed.count(deal.child->info_set_id) == 1);
+        for (const auto& edge : deal.child->children) {
+            if (edge.child->type == poker::NodeType::Player) REQUIRE(listed.count(edge.child->info_set_id) == 1);
+        }
+    }
+}
+
+TEST_CASE("Abstract Turn Hold'em strategies carry over to the exact game", "[turn_holdem][cfr]") {
+    poker::PercentileAbstraction percentile(169, 50, 8, 50);
+    const poker::TurnHoldem exact(poker::TurnHoldem::DEFAULT_BOARD, 30);
+    const poker::TurnHoldem abstracted(poker::TurnHoldem::DEFAULT_BOARD, 30, 0, &percentile);
+
+    solver::PredictiveCFRPlus cfr(abstracted);
+    cfr.solve(200);
+    const poker::Strategy sigma = cfr.average_strategy();
+    const poker::Strategy carried = abstracted.unabstracted(sigma);
+
+    // Each hand plays its bucket's strategy
+    for (int h = 0; h < 30; ++h) {
+        const std::string cards = exact.hand_label(h);
+        const Eigen::VectorXd bucket = sigma.probs(poker::TurnHoldem::make_info_set_id(0, abstracted.hand_label(h), ""));
+        const Eigen::VectorXd hand = carried.probs(poker::TurnHoldem::make_info_set_id(0, cards, ""));
+        REQUIRE(hand.size() == 2);
+        REQUIRE_THAT(hand(0), WithinAbs(bucket(0), 1e-6));
+    }
+
+    // Solved well in its own game, but hands sharing a bucket are exploitable
+    const double abstract_exploitability = poker::compute_infoset_exploitability(abstracted.root(), sigma);
+    const double exploitability = poker::compute_infoset_exploitability(exact.root(), carried);
+    REQUIRE(abstract_exploitability < 1e-3);
+    REQUIRE(exploitability > abstract_exploitability);
+
+    solver::PredictiveCFRPlus exact_cfr(exact);
+    exact_cfr.solve(200);
+    REQUIRE(poker::compute_infoset_exploitability(exact.root(), exact_cfr.average_strategy()) < exploitability);
+}